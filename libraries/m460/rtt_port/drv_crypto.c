@@ -7,6 +7,10 @@
 * Change Logs:
 * Date            Author         Notes
 * 2022-3-15       Wayne          First version
+* 2026-10-17      agent          Complete AES by interrupt with a request queue
+* 2026-10-17      agent          Stream SHA input in cascade without copying whole buffer
+* 2026-10-17      agent          Poll SHA status without interrupt, add software AES fallback
+* 2026-10-17      agent          Poll synchronous AES where the caller can not sleep
 *
 ******************************************************************************/
 
@@ -15,6 +19,7 @@
 #if ((defined(BSP_USING_CRYPTO) || defined(BSP_USING_TRNG) || defined(BSP_USING_CRC)) && defined(RT_USING_HWCRYPTO))
 
 #include <rtdevice.h>
+#include <rthw.h>
 #include <board.h>
 #include "NuMicro.h"
 #include <nu_bitutil.h>
@@ -35,14 +40,26 @@
 #define DBG_COLOR
 #include <rtdbg.h>
 
+#define NU_SHA_BLOCK_MAX        128     /* SHA-384/512 block size in bytes. */
+
+#if !defined(NU_SHA_STAGE_SIZE)
+    #define NU_SHA_STAGE_SIZE   1024    /* Bytes per staging buffer, multiple of NU_SHA_BLOCK_MAX. */
+#endif
+
 typedef struct
 {
-    uint8_t *pu8SHATempBuf;
+    uint32_t au32SHATempBuf[NU_SHA_BLOCK_MAX / 4];   /* Pending partial block, word aligned for DMA. */
     uint32_t u32SHATempBufLen;
     uint32_t u32DMAMode;
     uint32_t u32BlockSize;
 } S_SHA_CONTEXT;
 
+typedef struct
+{
+    uint32_t au32SwapKey[8];
+    uint32_t u32KeyGen;     /* Generation of the converted key, 0 if it is invalid. */
+} S_AES_CONTEXT;
+
 /* Private functions ------------------------------------------------------------*/
 static rt_err_t nu_hwcrypto_create(struct rt_hwcrypto_ctx *ctx);
 static void nu_hwcrypto_destroy(struct rt_hwcrypto_ctx *ctx);
@@ -65,8 +82,21 @@ static const struct rt_hwcrypto_ops nu_hwcrypto_ops =
 #define NU_HWCRYPTO_SHA_NAME    "nu_SHA"
 #define NU_HWCRYPTO_PRNG_NAME   "nu_PRNG"
 
-static struct rt_mutex s_AES_mutex;
 static struct rt_mutex s_SHA_mutex;
+static volatile uint32_t s_u32SHAIntSts = 0;
+static uint32_t s_au32SHAStage[2][NU_SHA_STAGE_SIZE / 4];  /* Ping-pong staging of input outside SRAM. */
+
+static rt_list_t s_AESReqList;
+static struct hwcrypto_symmetric_req *s_psAESReqRunning = RT_NULL;
+static uint32_t s_u32AESKeyGen = 0;         /* Last generation given to a converted key. */
+static uint32_t s_u32AESKeyLoaded = 0;      /* Generation of the key in engine. */
+
+/* Buffers of queued requests, the engine accesses them by DMA. */
+#if defined(NU_CRYPTO_AES_SOFT)
+    #define NU_AES_BUF_CAPABLE(addr)    (((rt_ubase_t)(addr) % 4) == 0)
+#else
+    #define NU_AES_BUF_CAPABLE(addr)    ((((rt_uint32_t)(addr) % 4) == 0) && ((rt_uint32_t)(addr) >= SRAM_BASE) && ((rt_uint32_t)(addr) <= SRAM_END))
+#endif
 
 static rt_err_t nu_crypto_init(void)
 {
@@ -74,10 +104,11 @@ static rt_err_t nu_crypto_init(void)
 
     /* init cipher mutex */
 #if defined(RT_HWCRYPTO_USING_AES)
-    result = rt_mutex_init(&s_AES_mutex, NU_HWCRYPTO_AES_NAME, RT_IPC_FLAG_PRIO);
-    RT_ASSERT(result == RT_EOK);
+    rt_list_init(&s_AESReqList);
+#if !defined(NU_CRYPTO_AES_SOFT)
     AES_ENABLE_INT(CRPT);
 #endif
+#endif
 
 #if defined(RT_HWCRYPTO_USING_SHA1) || defined(RT_HWCRYPTO_USING_SHA2)
     result = rt_mutex_init(&s_SHA_mutex, NU_HWCRYPTO_SHA_NAME, RT_IPC_FLAG_PRIO);
@@ -85,77 +116,521 @@ static rt_err_t nu_crypto_init(void)
     SHA_ENABLE_INT(CRPT);
 #endif
 
+    /* AES requests and SHA blocks are completed by interrupt. */
+    NVIC_EnableIRQ(CRPT_IRQn);
+
     return result;
 }
 
-static rt_err_t nu_aes_crypt_run(
-    rt_bool_t bEncrypt,
-    uint32_t u32OpMode,
-    uint8_t *pu8Key,
-    uint32_t u32KeySize,
-    uint8_t *pu8IV,
-    uint8_t *pu8InData,
-    uint8_t *pu8OutData,
-    uint32_t u32DataLen
-)
+static rt_err_t nu_aes_opmode_get(struct hwcrypto_symmetric *symmetric_ctx, uint32_t *pu32OpMode, uint32_t *pu32KeySize)
 {
-    uint32_t au32SwapKey[8];
-    uint32_t au32SwapIV[4];
-    rt_err_t result;
-
-    au32SwapKey[0] = nu_get32_be(&pu8Key[0]);
-    au32SwapKey[1] = nu_get32_be(&pu8Key[4]);
-    au32SwapKey[2] = nu_get32_be(&pu8Key[8]);
-    au32SwapKey[3] = nu_get32_be(&pu8Key[12]);
+    //Checking key length
+    if (symmetric_ctx->key_bitlen == 128)
+        *pu32KeySize = AES_KEY_SIZE_128;
+    else if (symmetric_ctx->key_bitlen == 192)
+        *pu32KeySize = AES_KEY_SIZE_192;
+    else if (symmetric_ctx->key_bitlen == 256)
+        *pu32KeySize = AES_KEY_SIZE_256;
+    else
+        return -RT_EINVAL;
 
-    if ((u32KeySize == AES_KEY_SIZE_192) || (u32KeySize == AES_KEY_SIZE_256))
+    //Select AES operation mode
+    switch (symmetric_ctx->parent.type & (HWCRYPTO_MAIN_TYPE_MASK | HWCRYPTO_SUB_TYPE_MASK))
     {
-        au32SwapKey[4] = nu_get32_be(&pu8Key[16]);
-        au32SwapKey[5] = nu_get32_be(&pu8Key[20]);
+    case HWCRYPTO_TYPE_AES_ECB:
+        *pu32OpMode = AES_MODE_ECB;
+        break;
+    case HWCRYPTO_TYPE_AES_CBC:
+        *pu32OpMode = AES_MODE_CBC;
+        break;
+    case HWCRYPTO_TYPE_AES_CFB:
+        *pu32OpMode = AES_MODE_CFB;
+        break;
+    case HWCRYPTO_TYPE_AES_OFB:
+        *pu32OpMode = AES_MODE_OFB;
+        break;
+    case HWCRYPTO_TYPE_AES_CTR:
+        *pu32OpMode = AES_MODE_CTR;
+        break;
+    default :
+        return -RT_ERROR;
     }
 
-    if (u32KeySize == AES_KEY_SIZE_256)
-    {
-        au32SwapKey[6] = nu_get32_be(&pu8Key[24]);
-        au32SwapKey[7] = nu_get32_be(&pu8Key[28]);
-    }
+    return RT_EOK;
+}
 
-    au32SwapIV[0] = nu_get32_be(&pu8IV[0]);
-    au32SwapIV[1] = nu_get32_be(&pu8IV[4]);
-    au32SwapIV[2] = nu_get32_be(&pu8IV[8]);
-    au32SwapIV[3] = nu_get32_be(&pu8IV[12]);
+/* Convert the key once after it is set, the engine skips reloading the same key. */
+static void nu_aes_key_convert(struct hwcrypto_symmetric *symmetric_ctx)
+{
+    S_AES_CONTEXT *psAESCtx = (S_AES_CONTEXT *)symmetric_ctx->parent.contex;
+    rt_base_t level;
+    int i;
 
-    result = rt_mutex_take(&s_AES_mutex, RT_WAITING_FOREVER);
-    RT_ASSERT(result == RT_EOK);
+    if (psAESCtx->u32KeyGen && !(symmetric_ctx->flags & SYMMTRIC_MODIFY_KEY))
+        return;
+
+    for (i = 0; i < (symmetric_ctx->key_bitlen / 32); i++)
+        psAESCtx->au32SwapKey[i] = nu_get32_be(&symmetric_ctx->key[i * 4]);
+
+    level = rt_hw_interrupt_disable();
+
+    if (++s_u32AESKeyGen == 0)
+        s_u32AESKeyGen = 1;
+    psAESCtx->u32KeyGen = s_u32AESKeyGen;
+
+    rt_hw_interrupt_enable(level);
+}
+
+#if !defined(NU_CRYPTO_AES_SOFT)
+/* Program the engine for a request, it is called with interrupt disabled. */
+static void nu_aes_engine_start(struct hwcrypto_symmetric_req *req, uint32_t u32OpMode, uint32_t u32KeySize, rt_bool_t bEncrypt)
+{
+    struct hwcrypto_symmetric *symmetric_ctx = req->ctx;
+    S_AES_CONTEXT *psAESCtx = (S_AES_CONTEXT *)symmetric_ctx->parent.contex;
+    uint32_t au32SwapIV[4];
+
+    au32SwapIV[0] = nu_get32_be(&symmetric_ctx->iv[0]);
+    au32SwapIV[1] = nu_get32_be(&symmetric_ctx->iv[4]);
+    au32SwapIV[2] = nu_get32_be(&symmetric_ctx->iv[8]);
+    au32SwapIV[3] = nu_get32_be(&symmetric_ctx->iv[12]);
 
-    //Using Channel 0
+    //Using Channel 0, the channel number is ignored by this engine.
     AES_Open(CRPT, 0, bEncrypt, u32OpMode, u32KeySize, AES_IN_OUT_SWAP);
-    AES_SetKey(CRPT, 0, (uint32_t *)&au32SwapKey[0], u32KeySize);
+
+    if (s_u32AESKeyLoaded != psAESCtx->u32KeyGen)
+    {
+        AES_SetKey(CRPT, 0, (uint32_t *)&psAESCtx->au32SwapKey[0], u32KeySize);
+        s_u32AESKeyLoaded = psAESCtx->u32KeyGen;
+    }
+
     AES_SetInitVect(CRPT, 0, (uint32_t *)au32SwapIV);
 
     //Setup AES DMA
-    AES_SetDMATransfer(CRPT, 0, (uint32_t)pu8InData, (uint32_t)pu8OutData, u32DataLen);
+    AES_SetDMATransfer(CRPT, 0, (uint32_t)req->info.in, (uint32_t)req->info.out, req->info.length);
     AES_CLR_INT_FLAG(CRPT);
 
     /* Start AES encryption/decryption */
     AES_Start(CRPT, 0, CRYPTO_DMA_ONE_SHOT);
+}
+#else
+/* Software AES in place of the engine, the queue runs without the engine and its interrupt. */
+static const uint8_t s_au8AESSbox[256] =
+{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
 
-    /* Wait done */
-    while (!(CRPT->INTSTS & CRPT_INTEN_AESIEN_Msk)) {};
+static const uint8_t s_au8AESInvSbox[256] =
+{
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d,
+};
 
-    if ((u32DataLen % 16) && (CRPT->AES_STS & (CRPT_AES_STS_OUTBUFEMPTY_Msk | CRPT_AES_STS_INBUFEMPTY_Msk)))
-        rt_kprintf("AES WARNING - AES Data length(%d) is not enough. -> %d \n", u32DataLen, RT_ALIGN(u32DataLen, 16));
-    else if (CRPT->INTSTS & (CRPT_INTSTS_AESEIF_Msk) || (CRPT->AES_STS & (CRPT_AES_STS_BUSERR_Msk | CRPT_AES_STS_CNTERR_Msk)))
-        rt_kprintf("AES ERROR - CRPT->INTSTS-%08x, CRPT->AES_STS-%08x\n", CRPT->INTSTS, CRPT->AES_STS);
+static uint8_t nu_aes_soft_xtime(uint8_t u8X)
+{
+    return (uint8_t)((u8X << 1) ^ ((u8X & 0x80) ? 0x1b : 0));
+}
 
-    /* Clear AES interrupt status */
-    AES_CLR_INT_FLAG(CRPT);
+/* Expand the key to round keys, return the number of rounds. */
+static int nu_aes_soft_expand(const uint8_t *pu8Key, uint32_t u32KeyBits, uint8_t *pu8RoundKey)
+{
+    int i32Nk = u32KeyBits / 32;
+    int i32Nr = i32Nk + 6;
+    uint8_t au8Word[4], u8Rcon = 1, u8Tmp;
+    int i, j;
 
-    result = rt_mutex_release(&s_AES_mutex);
-    RT_ASSERT(result == RT_EOK);
+    rt_memcpy(pu8RoundKey, pu8Key, i32Nk * 4);
+
+    for (i = i32Nk; i < (4 * (i32Nr + 1)); i++)
+    {
+        rt_memcpy(au8Word, &pu8RoundKey[(i - 1) * 4], 4);
+
+        if ((i % i32Nk) == 0)
+        {
+            u8Tmp = au8Word[0];
+            au8Word[0] = s_au8AESSbox[au8Word[1]] ^ u8Rcon;
+            au8Word[1] = s_au8AESSbox[au8Word[2]];
+            au8Word[2] = s_au8AESSbox[au8Word[3]];
+            au8Word[3] = s_au8AESSbox[u8Tmp];
+            u8Rcon = nu_aes_soft_xtime(u8Rcon);
+        }
+        else if ((i32Nk > 6) && ((i % i32Nk) == 4))
+        {
+            for (j = 0; j < 4; j++)
+                au8Word[j] = s_au8AESSbox[au8Word[j]];
+        }
+
+        for (j = 0; j < 4; j++)
+            pu8RoundKey[i * 4 + j] = pu8RoundKey[(i - i32Nk) * 4 + j] ^ au8Word[j];
+    }
+
+    return i32Nr;
+}
+
+/* One block, the state is column major and the output may overlap the input. */
+static void nu_aes_soft_encrypt(const uint8_t *pu8RoundKey, int i32Nr, const uint8_t *pu8In, uint8_t *pu8Out)
+{
+    uint8_t au8State[16], au8Tmp[16], u8X;
+    int i, r;
+
+    for (i = 0; i < 16; i++)
+        au8State[i] = pu8In[i] ^ pu8RoundKey[i];
+
+    for (r = 1; r <= i32Nr; r++)
+    {
+        /* SubBytes and ShiftRows */
+        for (i = 0; i < 16; i++)
+            au8Tmp[i] = s_au8AESSbox[au8State[(i + 4 * (i % 4)) % 16]];
+
+        /* MixColumns */
+        if (r < i32Nr)
+        {
+            for (i = 0; i < 16; i += 4)
+            {
+                uint8_t a0 = au8Tmp[i], a1 = au8Tmp[i + 1], a2 = au8Tmp[i + 2], a3 = au8Tmp[i + 3];
+
+                u8X = a0 ^ a1 ^ a2 ^ a3;
+                au8Tmp[i] = a0 ^ u8X ^ nu_aes_soft_xtime(a0 ^ a1);
+                au8Tmp[i + 1] = a1 ^ u8X ^ nu_aes_soft_xtime(a1 ^ a2);
+                au8Tmp[i + 2] = a2 ^ u8X ^ nu_aes_soft_xtime(a2 ^ a3);
+                au8Tmp[i + 3] = a3 ^ u8X ^ nu_aes_soft_xtime(a3 ^ a0);
+            }
+        }
+
+        for (i = 0; i < 16; i++)
+            au8State[i] = au8Tmp[i] ^ pu8RoundKey[r * 16 + i];
+    }
+
+    rt_memcpy(pu8Out, au8State, 16);
+}
+
+static void nu_aes_soft_decrypt(const uint8_t *pu8RoundKey, int i32Nr, const uint8_t *pu8In, uint8_t *pu8Out)
+{
+    uint8_t au8State[16], au8Tmp[16], u8U, u8V;
+    int i, r;
+
+    for (i = 0; i < 16; i++)
+        au8State[i] = pu8In[i] ^ pu8RoundKey[i32Nr * 16 + i];
+
+    for (r = i32Nr - 1; r >= 0; r--)
+    {
+        /* InvShiftRows, InvSubBytes and AddRoundKey */
+        for (i = 0; i < 16; i++)
+            au8Tmp[i] = s_au8AESInvSbox[au8State[(i + 12 * (i % 4)) % 16]] ^ pu8RoundKey[r * 16 + i];
+
+        /* InvMixColumns, a pre-multiplication then MixColumns */
+        if (r > 0)
+        {
+            for (i = 0; i < 16; i += 4)
+            {
+                uint8_t a0, a1, a2, a3, u8X;
+
+                u8U = nu_aes_soft_xtime(nu_aes_soft_xtime(au8Tmp[i] ^ au8Tmp[i + 2]));
+                u8V = nu_aes_soft_xtime(nu_aes_soft_xtime(au8Tmp[i + 1] ^ au8Tmp[i + 3]));
+                a0 = au8Tmp[i] ^ u8U;
+                a1 = au8Tmp[i + 1] ^ u8V;
+                a2 = au8Tmp[i + 2] ^ u8U;
+                a3 = au8Tmp[i + 3] ^ u8V;
+
+                u8X = a0 ^ a1 ^ a2 ^ a3;
+                au8Tmp[i] = a0 ^ u8X ^ nu_aes_soft_xtime(a0 ^ a1);
+                au8Tmp[i + 1] = a1 ^ u8X ^ nu_aes_soft_xtime(a1 ^ a2);
+                au8Tmp[i + 2] = a2 ^ u8X ^ nu_aes_soft_xtime(a2 ^ a3);
+                au8Tmp[i + 3] = a3 ^ u8X ^ nu_aes_soft_xtime(a3 ^ a0);
+            }
+        }
+
+        rt_memcpy(au8State, au8Tmp, 16);
+    }
+
+    rt_memcpy(pu8Out, au8State, 16);
+}
+
+/* Run a request as the engine does, the IV of context is not updated here. */
+static rt_err_t nu_aes_soft_crypt(struct hwcrypto_symmetric_req *req)
+{
+    struct hwcrypto_symmetric *symmetric_ctx = req->ctx;
+    uint8_t au8RoundKey[240], au8IV[16], au8Block[16], u8In;
+    const uint8_t *pu8In = req->info.in;
+    uint8_t *pu8Out = req->info.out;
+    uint32_t u32Len = req->info.length;
+    uint32_t u32OpMode, u32KeySize, u32BlockLen, i;
+    rt_bool_t bEncrypt = (req->info.mode == HWCRYPTO_MODE_ENCRYPT) ? TRUE : FALSE;
+    int i32Nr;
+
+    if (nu_aes_opmode_get(symmetric_ctx, &u32OpMode, &u32KeySize) != RT_EOK)
+        return -RT_EINVAL;
+
+    /* Block modes take whole blocks only. */
+    if (((u32OpMode == AES_MODE_ECB) || (u32OpMode == AES_MODE_CBC)) && (u32Len % 16))
+        return -RT_EINVAL;
+
+    i32Nr = nu_aes_soft_expand(symmetric_ctx->key, symmetric_ctx->key_bitlen, au8RoundKey);
+    rt_memcpy(au8IV, symmetric_ctx->iv, 16);
+
+    while (u32Len)
+    {
+        u32BlockLen = (u32Len < 16) ? u32Len : 16;
+
+        switch (u32OpMode)
+        {
+        case AES_MODE_ECB:
+            if (bEncrypt)
+                nu_aes_soft_encrypt(au8RoundKey, i32Nr, pu8In, pu8Out);
+            else
+                nu_aes_soft_decrypt(au8RoundKey, i32Nr, pu8In, pu8Out);
+            break;
+
+        case AES_MODE_CBC:
+            if (bEncrypt)
+            {
+                for (i = 0; i < 16; i++)
+                    au8Block[i] = pu8In[i] ^ au8IV[i];
+                nu_aes_soft_encrypt(au8RoundKey, i32Nr, au8Block, pu8Out);
+                rt_memcpy(au8IV, pu8Out, 16);
+            }
+            else
+            {
+                /* Keep the cipher block, it is the next IV. */
+                rt_memcpy(au8Block, pu8In, 16);
+                nu_aes_soft_decrypt(au8RoundKey, i32Nr, pu8In, pu8Out);
+                for (i = 0; i < 16; i++)
+                    pu8Out[i] ^= au8IV[i];
+                rt_memcpy(au8IV, au8Block, 16);
+            }
+            break;
+
+        case AES_MODE_CFB:
+            nu_aes_soft_encrypt(au8RoundKey, i32Nr, au8IV, au8Block);
+            for (i = 0; i < u32BlockLen; i++)
+            {
+                u8In = pu8In[i];
+                pu8Out[i] = u8In ^ au8Block[i];
+                au8IV[i] = bEncrypt ? pu8Out[i] : u8In;
+            }
+            break;
+
+        case AES_MODE_OFB:
+            nu_aes_soft_encrypt(au8RoundKey, i32Nr, au8IV, au8IV);
+            for (i = 0; i < u32BlockLen; i++)
+                pu8Out[i] = pu8In[i] ^ au8IV[i];
+            break;
+
+        case AES_MODE_CTR:
+            nu_aes_soft_encrypt(au8RoundKey, i32Nr, au8IV, au8Block);
+            for (i = 0; i < u32BlockLen; i++)
+                pu8Out[i] = pu8In[i] ^ au8Block[i];
+
+            /* 128-bit big endian counter */
+            for (i = 16; i > 0; i--)
+                if (++au8IV[i - 1] != 0)
+                    break;
+            break;
+
+        default:
+            return -RT_EINVAL;
+        }
+
+        pu8In += u32BlockLen;
+        pu8Out += u32BlockLen;
+        u32Len -= u32BlockLen;
+    }
 
     return RT_EOK;
 }
+#endif /* !NU_CRYPTO_AES_SOFT */
+
+/* Start the next request in queue, it is called with interrupt disabled. */
+static void nu_aes_req_start(void)
+{
+    struct hwcrypto_symmetric_req *req;
+    struct hwcrypto_symmetric *symmetric_ctx;
+    uint32_t u32OpMode, u32KeySize;
+    rt_bool_t bEncrypt;
+
+    if (rt_list_isempty(&s_AESReqList))
+    {
+        s_psAESReqRunning = RT_NULL;
+        return;
+    }
+
+    req = rt_list_first_entry(&s_AESReqList, struct hwcrypto_symmetric_req, list);
+    rt_list_remove(&req->list);
+    s_psAESReqRunning = req;
+
+    symmetric_ctx = req->ctx;
+    nu_aes_opmode_get(symmetric_ctx, &u32OpMode, &u32KeySize);
+    bEncrypt = (req->info.mode == HWCRYPTO_MODE_ENCRYPT) ? TRUE : FALSE;
+
+    /* The last cipher block is the next IV, save it before in-place decryption. */
+    if ((u32OpMode == AES_MODE_CBC) && !bEncrypt)
+        rt_memcpy(req->iv_next, req->info.in + (((req->info.length - 1) / 16) * 16), 16);
+
+#if !defined(NU_CRYPTO_AES_SOFT)
+    nu_aes_engine_start(req, u32OpMode, u32KeySize, bEncrypt);
+#endif
+}
+
+/* Finish the running request and start the next one, it is called in CRPT_IRQHandler or nu_aes_soft_service. */
+static void nu_aes_req_finish(uint32_t u32IntSts, uint32_t u32AESSts)
+{
+    struct hwcrypto_symmetric_req *req = s_psAESReqRunning;
+    struct hwcrypto_symmetric *symmetric_ctx;
+    rt_err_t result = RT_EOK;
+    rt_base_t level;
+
+    if (req == RT_NULL)
+        return;
+
+    symmetric_ctx = req->ctx;
+
+    if ((u32IntSts & CRPT_INTSTS_AESEIF_Msk) || (u32AESSts & (CRPT_AES_STS_BUSERR_Msk | CRPT_AES_STS_CNTERR_Msk)))
+    {
+        result = -RT_EIO;
+    }
+    else if ((symmetric_ctx->parent.type & (HWCRYPTO_MAIN_TYPE_MASK | HWCRYPTO_SUB_TYPE_MASK)) == HWCRYPTO_TYPE_AES_CBC)
+    {
+        /* Chain IV for the next request of this context. */
+        if (req->info.mode == HWCRYPTO_MODE_DECRYPT)
+            rt_memcpy(symmetric_ctx->iv, req->iv_next, 16);
+        else
+            rt_memcpy(symmetric_ctx->iv, req->info.out + (((req->info.length - 1) / 16) * 16), 16);
+    }
+
+    /* Keep the engine busy before calling back. */
+    level = rt_hw_interrupt_disable();
+    nu_aes_req_start();
+    rt_hw_interrupt_enable(level);
+
+    rt_hwcrypto_symmetric_done(req, result);
+}
+
+#if defined(NU_CRYPTO_AES_SOFT)
+/* Stand in for the engine interrupt, the submitting thread runs the queue until it is empty. */
+static void nu_aes_soft_service(void)
+{
+    static int bIsServicing = 0;
+    struct hwcrypto_symmetric_req *req;
+    rt_base_t level;
+    rt_err_t result;
+
+    level = rt_hw_interrupt_disable();
+    if (bIsServicing)
+    {
+        /* The running service takes the request. */
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+    bIsServicing = 1;
+
+    while ((req = s_psAESReqRunning) != RT_NULL)
+    {
+        rt_hw_interrupt_enable(level);
+
+        result = nu_aes_soft_crypt(req);
+        nu_aes_req_finish((result == RT_EOK) ? CRPT_INTSTS_AESIF_Msk : CRPT_INTSTS_AESEIF_Msk, 0);
+
+        level = rt_hw_interrupt_disable();
+    }
+
+    bIsServicing = 0;
+    rt_hw_interrupt_enable(level);
+}
+#endif
+
+static rt_err_t nu_aes_req_submit(struct hwcrypto_symmetric *symmetric_ctx, struct hwcrypto_symmetric_req *req)
+{
+    uint32_t u32OpMode, u32KeySize;
+    rt_err_t result;
+    rt_base_t level;
+
+    if ((result = nu_aes_opmode_get(symmetric_ctx, &u32OpMode, &u32KeySize)) != RT_EOK)
+        return result;
+
+    if ((req->info.length == 0) || (req->info.length % 4) != 0)
+        return -RT_EINVAL;
+
+    //The engine accesses buffers by DMA, they must be word aligned in SRAM.
+    if (!NU_AES_BUF_CAPABLE(req->info.in) || !NU_AES_BUF_CAPABLE(req->info.out))
+        return -RT_EINVAL;
+
+    nu_aes_key_convert(symmetric_ctx);
+
+    req->ctx = symmetric_ctx;
+
+    level = rt_hw_interrupt_disable();
+
+    rt_list_insert_before(&s_AESReqList, &req->list);
+
+    if (s_psAESReqRunning == RT_NULL)
+        nu_aes_req_start();
+
+    rt_hw_interrupt_enable(level);
+
+#if defined(NU_CRYPTO_AES_SOFT)
+    nu_aes_soft_service();
+#endif
+
+    return RT_EOK;
+}
+
+void CRPT_IRQHandler(void)
+{
+    uint32_t u32IntSts;
+
+    /* enter interrupt */
+    rt_interrupt_enter();
+
+    u32IntSts = CRPT->INTSTS;
+
+    if (u32IntSts & (CRPT_INTSTS_AESIF_Msk | CRPT_INTSTS_AESEIF_Msk))
+    {
+        uint32_t u32AESSts = CRPT->AES_STS;
+
+        /* Clear AES interrupt status */
+        AES_CLR_INT_FLAG(CRPT);
+
+        nu_aes_req_finish(u32IntSts, u32AESSts);
+    }
+
+    if (u32IntSts & (CRPT_INTSTS_HMACIF_Msk | CRPT_INTSTS_HMACEIF_Msk))
+    {
+        /* Clear SHA interrupt status, SHABlockUpdate waits for it. */
+        SHA_CLR_INT_FLAG(CRPT);
+        s_u32SHAIntSts = u32IntSts;
+    }
+
+    /* leave interrupt */
+    rt_interrupt_leave();
+}
 
 static rt_err_t nu_prng_init(void)
 {
@@ -184,14 +659,64 @@ static rt_uint32_t nu_prng_rand(struct hwcrypto_rng *ctx)
     return au32RNGValue[0] ^ au32RNGValue[1] ^ au32RNGValue[2] ^ au32RNGValue[3];
 }
 
+/* CRPT_IRQHandler can't run when interrupts are masked, before NVIC enabling or in a handler. */
+static int nu_crypto_irq_ready(void)
+{
+    return NVIC_GetEnableIRQ(CRPT_IRQn) && !__get_PRIMASK() && (rt_interrupt_get_nest() == 0);
+}
+
+/* Run the queue up to req without CRPT_IRQHandler, requests ahead of it are called back here too. */
+static void nu_aes_req_poll(struct hwcrypto_symmetric_req *req)
+{
+#if defined(NU_CRYPTO_AES_SOFT)
+    /* nu_aes_req_submit ran it already unless a preempted thread is servicing the queue. */
+    while (*(volatile rt_err_t *)&req->result == -RT_EBUSY)
+        nu_aes_soft_service();
+#else
+    uint32_t u32IntSts, u32AESSts;
+    rt_base_t level;
+
+    while (*(volatile rt_err_t *)&req->result == -RT_EBUSY)
+    {
+        /* Take the flags with interrupt disabled, CRPT_IRQHandler may still preempt a handler. */
+        level = rt_hw_interrupt_disable();
+        u32IntSts = CRPT->INTSTS;
+        if ((u32IntSts & (CRPT_INTSTS_AESIF_Msk | CRPT_INTSTS_AESEIF_Msk)) == 0)
+        {
+            rt_hw_interrupt_enable(level);
+            continue;
+        }
+
+        u32AESSts = CRPT->AES_STS;
+        AES_CLR_INT_FLAG(CRPT);
+        rt_hw_interrupt_enable(level);
+
+        nu_aes_req_finish(u32IntSts, u32AESSts);
+    }
+#endif
+}
+
+static void nu_aes_crypt_done(struct hwcrypto_symmetric_req *req, rt_err_t result)
+{
+    rt_completion_done((struct rt_completion *)req->user_data);
+}
+
+static rt_err_t nu_aes_crypt_async(struct hwcrypto_symmetric *symmetric_ctx, struct hwcrypto_symmetric_req *req)
+{
+    RT_ASSERT(symmetric_ctx != RT_NULL);
+    RT_ASSERT(req != RT_NULL);
+
+    return nu_aes_req_submit(symmetric_ctx, req);
+}
+
 static rt_err_t nu_aes_crypt(struct hwcrypto_symmetric *symmetric_ctx, struct hwcrypto_symmetric_info *symmetric_info)
 {
-    uint32_t u32AESOpMode;
-    uint32_t u32AESKeySize;
+    struct hwcrypto_symmetric_req sReq;
+    struct rt_completion sCompletion;
     unsigned char *in, *out;
     unsigned char in_align_flag = 0;
     unsigned char out_align_flag = 0;
-    unsigned char iv_temp[16];
+    rt_err_t result;
     RT_ASSERT(symmetric_ctx != RT_NULL);
     RT_ASSERT(symmetric_info != RT_NULL);
 
@@ -200,51 +725,11 @@ static rt_err_t nu_aes_crypt(struct hwcrypto_symmetric *symmetric_ctx, struct hw
         return -RT_EINVAL;
     }
 
-    //Checking key length
-    if (symmetric_ctx->key_bitlen == 128)
-    {
-        u32AESKeySize = AES_KEY_SIZE_128;
-    }
-    else if (symmetric_ctx->key_bitlen == 192)
-    {
-        u32AESKeySize = AES_KEY_SIZE_192;
-    }
-    else if (symmetric_ctx->key_bitlen == 256)
-    {
-        u32AESKeySize = AES_KEY_SIZE_256;
-    }
-    else
-    {
-        return -RT_EINVAL;
-    }
-
-    //Select AES operation mode
-    switch (symmetric_ctx->parent.type & (HWCRYPTO_MAIN_TYPE_MASK | HWCRYPTO_SUB_TYPE_MASK))
-    {
-    case HWCRYPTO_TYPE_AES_ECB:
-        u32AESOpMode = AES_MODE_ECB;
-        break;
-    case HWCRYPTO_TYPE_AES_CBC:
-        u32AESOpMode = AES_MODE_CBC;
-        break;
-    case HWCRYPTO_TYPE_AES_CFB:
-        u32AESOpMode = AES_MODE_CFB;
-        break;
-    case HWCRYPTO_TYPE_AES_OFB:
-        u32AESOpMode = AES_MODE_OFB;
-        break;
-    case HWCRYPTO_TYPE_AES_CTR:
-        u32AESOpMode = AES_MODE_CTR;
-        break;
-    default :
-        return -RT_ERROR;
-    }
-
     in = (unsigned char *)symmetric_info->in;
     out = (unsigned char *)symmetric_info->out;
 
     //Checking in/out data buffer address not alignment or out of SRAM
-    if (((rt_uint32_t)in % 4) != 0 || ((rt_uint32_t)in < SRAM_BASE) || ((rt_uint32_t)in > SRAM_END))
+    if (!NU_AES_BUF_CAPABLE(in))
     {
         in = rt_malloc(symmetric_info->length);
         if (in == RT_NULL)
@@ -257,7 +742,7 @@ static rt_err_t nu_aes_crypt(struct hwcrypto_symmetric *symmetric_ctx, struct hw
         in_align_flag = 1;
     }
 
-    if (((rt_uint32_t)out % 4) != 0 || ((rt_uint32_t)out < SRAM_BASE) || ((rt_uint32_t)out > SRAM_END))
+    if (!NU_AES_BUF_CAPABLE(out))
     {
         out = rt_malloc(symmetric_info->length);
         if (out == RT_NULL)
@@ -271,34 +756,29 @@ static rt_err_t nu_aes_crypt(struct hwcrypto_symmetric *symmetric_ctx, struct hw
         out_align_flag = 1;
     }
 
-    if ((u32AESOpMode == AES_MODE_CBC) && (symmetric_info->mode == HWCRYPTO_MODE_DECRYPT))
-    {
-        uint32_t loop;
-
-        loop = (symmetric_info->length - 1) / 16;
-        rt_memcpy(iv_temp, in + (loop * 16), 16);
-    }
-
-    nu_aes_crypt_run(symmetric_info->mode == HWCRYPTO_MODE_ENCRYPT ? TRUE : FALSE, u32AESOpMode, symmetric_ctx->key, u32AESKeySize, symmetric_ctx->iv, in, out, symmetric_info->length);
+    /* Queue it behind asynchronous requests. */
+    sReq.info = *symmetric_info;
+    sReq.info.in = in;
+    sReq.info.out = out;
+    sReq.result = -RT_EBUSY;
+    sReq.done = nu_aes_crypt_done;
+    sReq.user_data = &sCompletion;
+    rt_completion_init(&sCompletion);
 
-    if (u32AESOpMode == AES_MODE_CBC)
+    if ((result = nu_aes_req_submit(symmetric_ctx, &sReq)) == RT_EOK)
     {
-        if (symmetric_info->mode == HWCRYPTO_MODE_DECRYPT)
-        {
-            rt_memcpy(symmetric_ctx->iv, iv_temp, 16);
-        }
+        /* Sleep until the interrupt, or poll in a handler, with interrupts masked or before scheduling. */
+        if (nu_crypto_irq_ready() && (rt_thread_self() != RT_NULL))
+            rt_completion_wait(&sCompletion, RT_WAITING_FOREVER);
         else
-        {
-            uint32_t loop;
-
-            loop = (symmetric_info->length - 1) / 16;
-            rt_memcpy(symmetric_ctx->iv, out + (loop * 16), 16);
-        }
+            nu_aes_req_poll(&sReq);
+        result = sReq.result;
     }
 
     if (out_align_flag)
     {
-        rt_memcpy(symmetric_info->out, out, symmetric_info->length);
+        if (result == RT_EOK)
+            rt_memcpy(symmetric_info->out, out, symmetric_info->length);
         rt_free(out);
     }
 
@@ -307,10 +787,10 @@ static rt_err_t nu_aes_crypt(struct hwcrypto_symmetric *symmetric_ctx, struct hw
         rt_free(in);
     }
 
-    return RT_EOK;
+    return result;
 }
 
-static void SHABlockUpdate(uint32_t u32OpMode, uint32_t u32SrcAddr, uint32_t u32Len, uint32_t u32Mode)
+static void SHABlockStart(uint32_t u32OpMode, uint32_t u32SrcAddr, uint32_t u32Len, uint32_t u32Mode)
 {
     SHA_Open(CRPT, u32OpMode, SHA_IN_OUT_SWAP, 0);
 
@@ -322,27 +802,102 @@ static void SHABlockUpdate(uint32_t u32OpMode, uint32_t u32SrcAddr, uint32_t u32
     else
         CRPT->HMAC_CTL &= ~CRPT_HMAC_CTL_DMAFIRST_Msk;
     //Start SHA
+    s_u32SHAIntSts = 0;
     SHA_CLR_INT_FLAG(CRPT);
     SHA_Start(CRPT, u32Mode);
+}
 
-    /* Wait done */
-    while (!(CRPT->INTSTS & CRPT_INTSTS_HMACIF_Msk)) {};
+static rt_err_t SHABlockWait(void)
+{
+    uint32_t u32IntSts;
 
-    if (CRPT->INTSTS & (CRPT_INTSTS_HMACEIF_Msk) || (CRPT->HMAC_STS & (CRPT_HMAC_STS_DMAERR_Msk)))
-        rt_kprintf("SHA ERROR - CRPT->INTSTS-%08x, CRPT->HMAC_STS-%08x\n", CRPT->INTSTS, CRPT->HMAC_STS);
+    if (nu_crypto_irq_ready())
+    {
+        /* Wait done, the flags are taken by CRPT_IRQHandler. */
+        while ((u32IntSts = s_u32SHAIntSts) == 0) {};
+    }
+    else
+    {
+        /* Poll the engine and take the flags here. */
+        while (((u32IntSts = CRPT->INTSTS) & (CRPT_INTSTS_HMACIF_Msk | CRPT_INTSTS_HMACEIF_Msk)) == 0) {};
+        SHA_CLR_INT_FLAG(CRPT);
+    }
 
-    /* Clear SHA interrupt status */
-    SHA_CLR_INT_FLAG(CRPT);
+    if (u32IntSts & (CRPT_INTSTS_HMACEIF_Msk) || (CRPT->HMAC_STS & (CRPT_HMAC_STS_DMAERR_Msk)))
+    {
+        rt_kprintf("SHA ERROR - CRPT->INTSTS-%08x, CRPT->HMAC_STS-%08x\n", u32IntSts, CRPT->HMAC_STS);
+        return -RT_EIO;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t SHABlockUpdate(uint32_t u32OpMode, uint32_t u32SrcAddr, uint32_t u32Len, uint32_t u32Mode)
+{
+    SHABlockStart(u32OpMode, u32SrcAddr, u32Len, u32Mode);
+
+    return SHABlockWait();
+}
+
+/* SHA DMA fetches words from SRAM only. */
+static int nu_sha_dma_capable(const uint8_t *pu8Addr, uint32_t u32Len)
+{
+    return (((uint32_t)pu8Addr % 4) == 0) &&
+           ((uint32_t)pu8Addr >= SRAM_BASE) &&
+           (((uint32_t)pu8Addr + u32Len - 1) <= SRAM_END);
+}
+
+/* Hash whole blocks in cascade, directly from input or staged through SRAM. */
+static rt_err_t nu_sha_bulk_update(S_SHA_CONTEXT *psSHACtx, uint32_t u32OpMode, const uint8_t *pu8SrcAddr, uint32_t u32DataLen)
+{
+    rt_err_t result = RT_EOK;
+    uint32_t u32Stage = 0;
+    uint32_t u32CopyLen;
+
+    if (nu_sha_dma_capable(pu8SrcAddr, u32DataLen))
+    {
+        result = SHABlockUpdate(u32OpMode, (uint32_t)pu8SrcAddr, u32DataLen, psSHACtx->u32DMAMode);
+        psSHACtx->u32DMAMode = CRYPTO_DMA_CONTINUE;
+        return result;
+    }
+
+    u32CopyLen = (u32DataLen < NU_SHA_STAGE_SIZE) ? u32DataLen : NU_SHA_STAGE_SIZE;
+    rt_memcpy(s_au32SHAStage[u32Stage], pu8SrcAddr, u32CopyLen);
+
+    while (u32DataLen)
+    {
+        SHABlockStart(u32OpMode, (uint32_t)s_au32SHAStage[u32Stage], u32CopyLen, psSHACtx->u32DMAMode);
+        psSHACtx->u32DMAMode = CRYPTO_DMA_CONTINUE;
+
+        pu8SrcAddr += u32CopyLen;
+        u32DataLen -= u32CopyLen;
+
+        /* Fill the other stage while the engine is hashing this one. */
+        u32Stage ^= 1;
+        if (u32DataLen)
+        {
+            u32CopyLen = (u32DataLen < NU_SHA_STAGE_SIZE) ? u32DataLen : NU_SHA_STAGE_SIZE;
+            rt_memcpy(s_au32SHAStage[u32Stage], pu8SrcAddr, u32CopyLen);
+        }
+
+        result = SHABlockWait();
+        if (result != RT_EOK)
+            break;
+    }
+
+    return result;
 }
 
 static rt_err_t nu_sha_hash_run(
     S_SHA_CONTEXT *psSHACtx,
     uint32_t u32OpMode,
-    uint8_t *pu8InData,
+    const uint8_t *pu8InData,
     uint32_t u32DataLen
 )
 {
-    rt_err_t result;
+    uint8_t *pu8TempBuf;
+    uint32_t u32CopyLen;
+    rt_err_t result, ret = RT_EOK;
 
     RT_ASSERT(psSHACtx != RT_NULL);
     RT_ASSERT(pu8InData != RT_NULL);
@@ -350,96 +905,54 @@ static rt_err_t nu_sha_hash_run(
     result = rt_mutex_take(&s_SHA_mutex, RT_WAITING_FOREVER);
     RT_ASSERT(result == RT_EOK);
 
-    uint8_t *pu8SrcAddr = (uint8_t *)pu8InData;
-    uint32_t u32CopyLen = 0;
+    pu8TempBuf = (uint8_t *)psSHACtx->au32SHATempBuf;
 
-    while ((psSHACtx->u32SHATempBufLen + u32DataLen) > psSHACtx->u32BlockSize)
+    /* Complete the pending block, it is hashed only if more data follows. */
+    if (psSHACtx->u32SHATempBufLen)
     {
-        if (psSHACtx->pu8SHATempBuf)
-        {
-            if (psSHACtx->u32SHATempBufLen == psSHACtx->u32BlockSize)
-            {
-                //Trigger SHA block update
-                SHABlockUpdate(u32OpMode, (uint32_t)psSHACtx->pu8SHATempBuf, psSHACtx->u32BlockSize, psSHACtx->u32DMAMode);
-                psSHACtx->u32DMAMode = CRYPTO_DMA_CONTINUE;
-                //free SHATempBuff
-                rt_free(psSHACtx->pu8SHATempBuf);
-                psSHACtx->pu8SHATempBuf = NULL;
-                psSHACtx->u32SHATempBufLen = 0;
-                continue;
-            }
-            else
-            {
-                u32CopyLen = psSHACtx->u32BlockSize - psSHACtx->u32SHATempBufLen;
-                if (u32DataLen < u32CopyLen)
-                    u32CopyLen = u32DataLen;
-                rt_memcpy(psSHACtx->pu8SHATempBuf + psSHACtx->u32SHATempBufLen, pu8SrcAddr, u32CopyLen);
-                psSHACtx->u32SHATempBufLen += u32CopyLen;
-                pu8SrcAddr += u32CopyLen;
-                u32DataLen -= u32CopyLen;
-                continue;
-            }
-        }
-
-        if ((uint32_t) pu8SrcAddr & 3)  //address not aligned 4
-        {
-            psSHACtx->pu8SHATempBuf = rt_malloc(psSHACtx->u32BlockSize);
-
-            if (psSHACtx->pu8SHATempBuf == RT_NULL)
-            {
-                LOG_E("fun[%s] memory allocate %d bytes failed!", __FUNCTION__, psSHACtx->u32BlockSize);
-                result = rt_mutex_release(&s_SHA_mutex);
-                RT_ASSERT(result == RT_EOK);
-                return -RT_ENOMEM;
-            }
-
-            rt_memcpy(psSHACtx->pu8SHATempBuf, pu8SrcAddr, psSHACtx->u32BlockSize);
-            psSHACtx->u32SHATempBufLen = psSHACtx->u32BlockSize;
-            pu8SrcAddr += psSHACtx->u32BlockSize;
-            u32DataLen -= psSHACtx->u32BlockSize;
-            continue;
-        }
-
-        //Trigger SHA block update
-        SHABlockUpdate(u32OpMode, (uint32_t)pu8SrcAddr, psSHACtx->u32BlockSize, psSHACtx->u32DMAMode);
+        u32CopyLen = psSHACtx->u32BlockSize - psSHACtx->u32SHATempBufLen;
+        if (u32DataLen < u32CopyLen)
+            u32CopyLen = u32DataLen;
+        rt_memcpy(pu8TempBuf + psSHACtx->u32SHATempBufLen, pu8InData, u32CopyLen);
+        psSHACtx->u32SHATempBufLen += u32CopyLen;
+        pu8InData += u32CopyLen;
+        u32DataLen -= u32CopyLen;
+
+        if (u32DataLen == 0)
+            goto exit_nu_sha_hash_run;
+
+        ret = SHABlockUpdate(u32OpMode, (uint32_t)pu8TempBuf, psSHACtx->u32BlockSize, psSHACtx->u32DMAMode);
         psSHACtx->u32DMAMode = CRYPTO_DMA_CONTINUE;
-
-        pu8SrcAddr += psSHACtx->u32BlockSize;
-        u32DataLen -= psSHACtx->u32BlockSize;
+        psSHACtx->u32SHATempBufLen = 0;
+        if (ret != RT_EOK)
+            goto exit_nu_sha_hash_run;
     }
 
-    if (u32DataLen)
+    /* Whole blocks, keep the last 1 ~ u32BlockSize bytes for nu_sha_finish. */
+    if (u32DataLen > psSHACtx->u32BlockSize)
     {
-        if (psSHACtx->pu8SHATempBuf == NULL)
-        {
-            psSHACtx->pu8SHATempBuf = rt_malloc(psSHACtx->u32BlockSize);
-
-            if (psSHACtx->pu8SHATempBuf == RT_NULL)
-            {
-                LOG_E("fun[%s] memory allocate %d bytes failed!", __FUNCTION__, psSHACtx->u32BlockSize);
-                result = rt_mutex_release(&s_SHA_mutex);
-                RT_ASSERT(result == RT_EOK);
-                return -RT_ENOMEM;
-            }
+        u32CopyLen = ((u32DataLen - 1) / psSHACtx->u32BlockSize) * psSHACtx->u32BlockSize;
+        ret = nu_sha_bulk_update(psSHACtx, u32OpMode, pu8InData, u32CopyLen);
+        pu8InData += u32CopyLen;
+        u32DataLen -= u32CopyLen;
+        if (ret != RT_EOK)
+            goto exit_nu_sha_hash_run;
+    }
 
-            psSHACtx->u32SHATempBufLen = 0;
-        }
+    rt_memcpy(pu8TempBuf, pu8InData, u32DataLen);
+    psSHACtx->u32SHATempBufLen = u32DataLen;
 
-        rt_memcpy(psSHACtx->pu8SHATempBuf, pu8SrcAddr, u32DataLen);
-        psSHACtx->u32SHATempBufLen += u32DataLen;
-    }
+exit_nu_sha_hash_run:
 
     result = rt_mutex_release(&s_SHA_mutex);
     RT_ASSERT(result == RT_EOK);
 
-    return RT_EOK;
+    return ret;
 }
 
 static rt_err_t nu_sha_update(struct hwcrypto_hash *hash_ctx, const rt_uint8_t *in, rt_size_t length)
 {
     uint32_t u32SHAOpMode;
-    unsigned char *nu_in;
-    unsigned char in_align_flag = 0;
     RT_ASSERT(hash_ctx != RT_NULL);
     RT_ASSERT(in != RT_NULL);
 
@@ -465,30 +978,8 @@ static rt_err_t nu_sha_update(struct hwcrypto_hash *hash_ctx, const rt_uint8_t *
         return -RT_ERROR;
     }
 
-    nu_in = (unsigned char *)in;
-
-    //Checking in data buffer address not alignment or out of SRAM
-    if (((rt_uint32_t)nu_in % 4) != 0 || ((rt_uint32_t)nu_in < SRAM_BASE) || ((rt_uint32_t)nu_in > SRAM_END))
-    {
-        nu_in = rt_malloc(length);
-        if (nu_in == RT_NULL)
-        {
-            LOG_E("fun[%s] memory allocate %d bytes failed!", __FUNCTION__, length);
-            return -RT_ENOMEM;
-        }
-
-        rt_memcpy(nu_in, in, length);
-        in_align_flag = 1;
-    }
-
-    nu_sha_hash_run(hash_ctx->parent.contex, u32SHAOpMode, nu_in, length);
-
-    if (in_align_flag)
-    {
-        rt_free(nu_in);
-    }
-
-    return RT_EOK;
+    /* Input at any address and alignment is streamed, only partial blocks are copied into context. */
+    return nu_sha_hash_run(hash_ctx->parent.contex, u32SHAOpMode, in, length);
 }
 
 static rt_err_t nu_sha_finish(struct hwcrypto_hash *hash_ctx, rt_uint8_t *out, rt_size_t length)
@@ -497,6 +988,7 @@ static rt_err_t nu_sha_finish(struct hwcrypto_hash *hash_ctx, rt_uint8_t *out, r
     unsigned char out_align_flag = 0;
     uint32_t u32SHAOpMode;
     S_SHA_CONTEXT *psSHACtx = RT_NULL;
+    rt_err_t result, ret;
     RT_ASSERT(hash_ctx != RT_NULL);
     RT_ASSERT(out != RT_NULL);
 
@@ -559,37 +1051,41 @@ static rt_err_t nu_sha_finish(struct hwcrypto_hash *hash_ctx, rt_uint8_t *out, r
         out_align_flag = 1;
     }
 
-    if (psSHACtx->pu8SHATempBuf)
+    result = rt_mutex_take(&s_SHA_mutex, RT_WAITING_FOREVER);
+    RT_ASSERT(result == RT_EOK);
+
+    if (psSHACtx->u32SHATempBufLen)
     {
         if (psSHACtx->u32DMAMode ==  CRYPTO_DMA_FIRST)
-            SHABlockUpdate(u32SHAOpMode, (uint32_t)psSHACtx->pu8SHATempBuf, psSHACtx->u32SHATempBufLen, CRYPTO_DMA_ONE_SHOT);
+            ret = SHABlockUpdate(u32SHAOpMode, (uint32_t)psSHACtx->au32SHATempBuf, psSHACtx->u32SHATempBufLen, CRYPTO_DMA_ONE_SHOT);
         else
-            SHABlockUpdate(u32SHAOpMode, (uint32_t)psSHACtx->pu8SHATempBuf, psSHACtx->u32SHATempBufLen, CRYPTO_DMA_LAST);
+            ret = SHABlockUpdate(u32SHAOpMode, (uint32_t)psSHACtx->au32SHATempBuf, psSHACtx->u32SHATempBufLen, CRYPTO_DMA_LAST);
 
-        //free SHATempBuf
-        rt_free(psSHACtx->pu8SHATempBuf);
-        psSHACtx->pu8SHATempBuf = RT_NULL;
         psSHACtx->u32SHATempBufLen = 0;
     }
     else
     {
-        SHABlockUpdate(u32SHAOpMode, (uint32_t)NULL, 0, CRYPTO_DMA_LAST);
+        ret = SHABlockUpdate(u32SHAOpMode, (uint32_t)NULL, 0, CRYPTO_DMA_LAST);
     }
 
     SHA_Read(CRPT, (uint32_t *)nu_out);
 
+    result = rt_mutex_release(&s_SHA_mutex);
+    RT_ASSERT(result == RT_EOK);
+
     if (out_align_flag)
     {
         rt_memcpy(out, nu_out, length);
         rt_free(nu_out);
     }
 
-    return RT_EOK;
+    return ret;
 }
 
 static const struct hwcrypto_symmetric_ops nu_aes_ops =
 {
     .crypt = nu_aes_crypt,
+    .crypt_async = nu_aes_crypt_async,
 };
 
 static const struct hwcrypto_hash_ops nu_sha_ops =
@@ -597,6 +1093,160 @@ static const struct hwcrypto_hash_ops nu_sha_ops =
     .update = nu_sha_update,
     .finish = nu_sha_finish,
 };
+
+#if defined(RT_USING_FINSH)
+#include <stdlib.h>
+
+#define NU_AES_BENCH_DEPTH      4
+
+static void nu_aes_bench_done(struct hwcrypto_symmetric_req *req, rt_err_t result)
+{
+    if (req->user_data)
+        rt_completion_done((struct rt_completion *)req->user_data);
+}
+
+/* Operations done in a window of ticks, one by one or queued. */
+static uint32_t nu_aes_bench_run(struct rt_hwcrypto_ctx *ctx, uint8_t *pu8Buf, uint32_t u32Len, rt_tick_t window, int bQueued)
+{
+    struct hwcrypto_symmetric_req asReq[NU_AES_BENCH_DEPTH];
+    struct rt_completion sCompletion;
+    uint32_t u32Ops = 0;
+    rt_tick_t start;
+    int i;
+
+    /* Align to tick boundary. */
+    start = rt_tick_get();
+    while (rt_tick_get() == start);
+
+    start = rt_tick_get();
+    while ((rt_tick_get() - start) < window)
+    {
+        if (bQueued)
+        {
+            rt_completion_init(&sCompletion);
+            for (i = 0; i < NU_AES_BENCH_DEPTH; i++)
+                rt_hwcrypto_symmetric_crypt_async(ctx, &asReq[i], HWCRYPTO_MODE_ENCRYPT, u32Len, pu8Buf, pu8Buf,
+                                                  nu_aes_bench_done, (i == (NU_AES_BENCH_DEPTH - 1)) ? &sCompletion : RT_NULL);
+            rt_completion_wait(&sCompletion, RT_WAITING_FOREVER);
+            u32Ops += NU_AES_BENCH_DEPTH;
+        }
+        else
+        {
+            rt_hwcrypto_symmetric_crypt(ctx, HWCRYPTO_MODE_ENCRYPT, u32Len, pu8Buf, pu8Buf);
+            u32Ops++;
+        }
+    }
+
+    return u32Ops;
+}
+
+static int aes_bench(int argc, char *argv[])
+{
+    const uint32_t u32MaxLen = 4096;
+    const rt_tick_t window = RT_TICK_PER_SECOND / 5;
+    struct rt_hwcrypto_ctx *ctx;
+    uint8_t au8Key[16] = {0}, au8IV[16] = {0};
+    uint8_t *pu8Buf;
+    uint32_t u32Len;
+
+    ctx = rt_hwcrypto_symmetric_create(rt_hwcrypto_dev_default(), HWCRYPTO_TYPE_AES_CBC);
+    pu8Buf = rt_malloc(u32MaxLen);
+    if (!ctx || !pu8Buf)
+        goto exit_aes_bench;
+
+    rt_hwcrypto_symmetric_setkey(ctx, au8Key, 128);
+    rt_hwcrypto_symmetric_setiv(ctx, au8IV, sizeof(au8IV));
+    rt_memset(pu8Buf, 0x5a, u32MaxLen);
+
+    rt_kprintf("AES-128-CBC encryption, %d requests queued\n", NU_AES_BENCH_DEPTH);
+    rt_kprintf("%8s %12s %12s %14s\n", "bytes", "latency(us)", "sync(KB/s)", "queued(KB/s)");
+    for (u32Len = 16; u32Len <= u32MaxLen; u32Len <<= 2)
+    {
+        uint32_t u32SyncOps = nu_aes_bench_run(ctx, pu8Buf, u32Len, window, 0);
+        uint32_t u32QueuedOps = nu_aes_bench_run(ctx, pu8Buf, u32Len, window, 1);
+
+        rt_kprintf("%8d %12d %12d %14d\n", u32Len,
+                   (window * (1000000 / RT_TICK_PER_SECOND)) / u32SyncOps,
+                   (u32SyncOps * u32Len / 1024) * RT_TICK_PER_SECOND / window,
+                   (u32QueuedOps * u32Len / 1024) * RT_TICK_PER_SECOND / window);
+    }
+
+exit_aes_bench:
+
+    if (pu8Buf)
+        rt_free(pu8Buf);
+    if (ctx)
+        rt_hwcrypto_symmetric_destroy(ctx);
+
+    return 0;
+}
+MSH_CMD_EXPORT(aes_bench, measure AES latency and throughput);
+
+/* Hash a region with SHA-256 in one update, report time and heap peak growth. */
+static void nu_sha_bench_run(const char *pcName, const uint8_t *pu8Src, uint32_t u32Len)
+{
+    struct rt_hwcrypto_ctx *ctx;
+    uint32_t au32Digest[8];
+    rt_size_t total, used, max_used_before, max_used_after;
+    rt_tick_t ticks;
+    rt_err_t result;
+
+    ctx = rt_hwcrypto_hash_create(rt_hwcrypto_dev_default(), HWCRYPTO_TYPE_SHA256);
+    if (!ctx)
+        return;
+
+    rt_memory_info(&total, &used, &max_used_before);
+
+    ticks = rt_tick_get();
+    result = rt_hwcrypto_hash_update(ctx, pu8Src, u32Len);
+    if (result == RT_EOK)
+        result = rt_hwcrypto_hash_finish(ctx, (rt_uint8_t *)au32Digest, sizeof(au32Digest));
+    ticks = rt_tick_get() - ticks;
+
+    rt_memory_info(&total, &used, &max_used_after);
+
+    if (ticks == 0)
+        ticks = 1;
+
+    rt_kprintf("%-10s %8d %8d %10d %12d   %08x%s\n", pcName, u32Len,
+               ticks * 1000 / RT_TICK_PER_SECOND,
+               (u32Len / 1024) * RT_TICK_PER_SECOND / ticks,
+               max_used_after - max_used_before,
+               nu_get32_be((uint8_t *)au32Digest),
+               (result == RT_EOK) ? "" : " failed");
+
+    rt_hwcrypto_hash_destroy(ctx);
+}
+
+static int sha_bench(int argc, char *argv[])
+{
+    const uint32_t u32BufLen = 64 * 1024;
+    uint8_t *pu8Buf;
+
+    rt_kprintf("SHA-256 of a region in one update\n");
+    rt_kprintf("%-10s %8s %8s %10s %12s   %s\n", "source", "bytes", "ms", "KB/s", "heap-peak+", "digest");
+
+    if (argc == 3)
+    {
+        /* Any mapped region, e.g. an image in SPI flash or HyperRAM. */
+        nu_sha_bench_run("region", (const uint8_t *)strtoul(argv[1], NULL, 0), strtoul(argv[2], NULL, 0));
+        return 0;
+    }
+
+    pu8Buf = rt_malloc(u32BufLen + 4);
+    if (!pu8Buf)
+        return -RT_ENOMEM;
+
+    rt_memset(pu8Buf, 0x5a, u32BufLen + 4);
+    nu_sha_bench_run("sram", pu8Buf, u32BufLen);
+    nu_sha_bench_run("sram+1", pu8Buf + 1, u32BufLen);
+
+    rt_free(pu8Buf);
+
+    return 0;
+}
+MSH_CMD_EXPORT(sha_bench, measure SHA-256 throughput and heap peak: sha_bench [addr len]);
+#endif /* RT_USING_FINSH */
 #endif
 
 /* CRC operation ------------------------------------------------------------*/
@@ -643,7 +1293,12 @@ static rt_err_t nu_hwcrypto_create(struct rt_hwcrypto_ctx *ctx)
 #if defined(BSP_USING_CRYPTO)
     case HWCRYPTO_TYPE_AES:
     {
-        ctx->contex = RT_NULL;
+        ctx->contex = rt_malloc(sizeof(S_AES_CONTEXT));
+
+        if (ctx->contex == RT_NULL)
+            return -RT_ERROR;
+
+        rt_memset(ctx->contex, 0, sizeof(S_AES_CONTEXT));
         //Setup AES operation
         ((struct hwcrypto_symmetric *)ctx)->ops = &nu_aes_ops;
         break;
@@ -690,7 +1345,10 @@ static rt_err_t nu_hwcrypto_clone(struct rt_hwcrypto_ctx *des, const struct rt_h
 
     if (des->contex && src->contex)
     {
-        rt_memcpy(des->contex, src->contex, sizeof(struct rt_hwcrypto_ctx));
+        if ((src->type & HWCRYPTO_MAIN_TYPE_MASK) == HWCRYPTO_TYPE_AES)
+            rt_memcpy(des->contex, src->contex, sizeof(S_AES_CONTEXT));
+        else
+            rt_memcpy(des->contex, src->contex, sizeof(S_SHA_CONTEXT));
     }
     else
         return -RT_EINVAL;
@@ -702,17 +1360,21 @@ static void nu_hwcrypto_reset(struct rt_hwcrypto_ctx *ctx)
     switch (ctx->type & HWCRYPTO_MAIN_TYPE_MASK)
     {
 #if defined(BSP_USING_CRYPTO)
+    case HWCRYPTO_TYPE_AES:
+    {
+        S_AES_CONTEXT *psAESCtx = (S_AES_CONTEXT *)ctx->contex;
+
+        /* Convert the key again on next use. */
+        if (psAESCtx)
+            psAESCtx->u32KeyGen = 0;
+        break;
+    }
+
     case HWCRYPTO_TYPE_SHA1:
     case HWCRYPTO_TYPE_SHA2:
     {
         S_SHA_CONTEXT *psSHACtx = (S_SHA_CONTEXT *)ctx->contex;
 
-        if (psSHACtx->pu8SHATempBuf)
-        {
-            rt_free(psSHACtx->pu8SHATempBuf);
-        }
-
-        psSHACtx->pu8SHATempBuf = RT_NULL;
         psSHACtx->u32SHATempBufLen = 0;
         psSHACtx->u32DMAMode = CRYPTO_DMA_FIRST;
 
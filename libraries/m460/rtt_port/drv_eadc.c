@@ -6,15 +6,25 @@
 * Change Logs:
 * Date            Author       Notes
 * 2022-3-16       Wayne        First version
+* 2026-10-17      agent        Add triggered streaming by PDMA into a ring of blocks
+* 2026-10-17      agent        Take only timers free of other drivers, drop ADINT triggers
 *
 ******************************************************************************/
 
 #include <rtconfig.h>
 #include <rtdevice.h>
+#include <rthw.h>
 #include "NuMicro.h"
 
 #if defined(BSP_USING_EADC)
 
+#include "drv_eadc.h"
+
+#if defined(BSP_USING_PDMA)
+    #include "drv_pdma.h"
+    #include "drv_eadc_ring.h"
+#endif
+
 /* Private define ---------------------------------------------------------------*/
 enum
 {
@@ -32,6 +42,20 @@ enum
 };
 
 /* Private Typedef --------------------------------------------------------------*/
+#if defined(BSP_USING_PDMA)
+struct nu_eadc_stream
+{
+    int             i32PdmaChan;    /* -1 if stream is stopped */
+    nu_pdma_desc_t  apsDesc[NU_EADC_STREAM_BLKNUM];
+    struct nu_eadc_ring sRing;
+    struct rt_semaphore sReady;
+    uint32_t        u32ModMsk;      /* Sample modules of scan group */
+    uint32_t        u32TrgSrc;
+    int32_t         i32Timer;       /* Index of timer started by stream, -1 if none */
+};
+typedef struct nu_eadc_stream *nu_eadc_stream_t;
+#endif
+
 struct nu_eadc
 {
     struct rt_adc_device dev;
@@ -39,6 +63,10 @@ struct nu_eadc
     EADC_T     *base;
     uint32_t    chn_msk;
     uint32_t    max_chn_num;
+#if defined(BSP_USING_PDMA)
+    int16_t     pdma_perp;
+    struct nu_eadc_stream stream;
+#endif
 };
 typedef struct nu_eadc *nu_eadc_t;
 
@@ -60,6 +88,9 @@ static struct nu_eadc nu_eadc_arr [] =
         .base = EADC0,
         .chn_msk = 0,
         .max_chn_num = 16,
+#if defined(BSP_USING_PDMA)
+        .pdma_perp = PDMA_EADC0_RX,
+#endif
     },
 #endif
 #if defined(BSP_USING_EADC1)
@@ -68,6 +99,9 @@ static struct nu_eadc nu_eadc_arr [] =
         .base = EADC1,
         .chn_msk = 0,
         .max_chn_num = 16,
+#if defined(BSP_USING_PDMA)
+        .pdma_perp = PDMA_EADC1_RX,
+#endif
     },
 #endif
 #if defined(BSP_USING_EADC2)
@@ -76,6 +110,9 @@ static struct nu_eadc nu_eadc_arr [] =
         .base = EADC2,
         .chn_msk = 0,
         .max_chn_num = 16,
+#if defined(BSP_USING_PDMA)
+        .pdma_perp = PDMA_EADC2_RX,
+#endif
     },
 #endif
 };
@@ -88,6 +125,15 @@ static const struct rt_adc_ops nu_adc_ops =
 typedef struct rt_adc_ops *rt_adc_ops_t;
 
 
+static rt_bool_t nu_eadc_is_streaming(nu_eadc_t psNuEADC)
+{
+#if defined(BSP_USING_PDMA)
+    return (psNuEADC->stream.i32PdmaChan >= 0) ? RT_TRUE : RT_FALSE;
+#else
+    return RT_FALSE;
+#endif
+}
+
 /* nu_adc_enabled - Enable ADC clock and wait for ready */
 static rt_err_t nu_eadc_enabled(struct rt_adc_device *device, rt_uint32_t channel, rt_bool_t enabled)
 {
@@ -111,7 +157,7 @@ static rt_err_t nu_eadc_enabled(struct rt_adc_device *device, rt_uint32_t channe
     {
         psNuEADC->chn_msk &= ~(0x1 << channel);
 
-        if (psNuEADC->chn_msk == 0)
+        if ((psNuEADC->chn_msk == 0) && !nu_eadc_is_streaming(psNuEADC))
         {
             EADC_Close(psNuEADC->base);
         }
@@ -142,6 +188,14 @@ static rt_err_t nu_get_eadc_value(struct rt_adc_device *device, rt_uint32_t chan
         goto exit_nu_get_eadc_value;
     }
 
+    /* Sample module 0 belongs to stream. */
+    if (nu_eadc_is_streaming(psNuEADC))
+    {
+        *value = 0xFFFFFFFF;
+        ret = RT_EBUSY;
+        goto exit_nu_get_eadc_value;
+    }
+
     EADC_ConfigSampleModule(psNuEADC->base, 0, EADC_SOFTWARE_TRIGGER, channel);
 
     EADC_CLR_INT_FLAG(psNuEADC->base, EADC_STATUS2_ADIF0_Msk);
@@ -172,6 +226,11 @@ int rt_hw_eadc_init(void)
 
     for (i = (EADC_START + 1); i < EADC_CNT; i++)
     {
+#if defined(BSP_USING_PDMA)
+        nu_eadc_arr[i].stream.i32PdmaChan = -1;
+        nu_eadc_arr[i].stream.i32Timer = -1;
+#endif
+
         result = rt_hw_adc_register(&nu_eadc_arr[i].dev, nu_eadc_arr[i].name, &nu_adc_ops, NULL);
         RT_ASSERT(result == RT_EOK);
     }
@@ -180,4 +239,478 @@ int rt_hw_eadc_init(void)
 }
 INIT_BOARD_EXPORT(rt_hw_eadc_init);
 
+#if defined(BSP_USING_PDMA)
+
+/* Timers enabled for hwtimer, TPWM or capture driver, streams never program them. */
+static const uint32_t nu_eadc_timer_owned = 0
+#if defined(BSP_USING_TMR0)
+        | BIT0
+#endif
+#if defined(BSP_USING_TMR1)
+        | BIT1
+#endif
+#if defined(BSP_USING_TMR2)
+        | BIT2
+#endif
+#if defined(BSP_USING_TMR3)
+        | BIT3
+#endif
+        ;
+
+/* Timers taken by running streams. */
+static uint32_t nu_eadc_timer_busy = 0;
+
+static const struct
+{
+    TIMER_T    *base;
+    uint32_t    modid;
+    uint32_t    clksel;
+} nu_eadc_timer_arr[] =
+{
+    { TIMER0, TMR0_MODULE, CLK_CLKSEL1_TMR0SEL_HXT },
+    { TIMER1, TMR1_MODULE, CLK_CLKSEL1_TMR1SEL_HXT },
+    { TIMER2, TMR2_MODULE, CLK_CLKSEL1_TMR2SEL_HXT },
+    { TIMER3, TMR3_MODULE, CLK_CLKSEL1_TMR3SEL_HXT },
+};
+
+/* Take a timer nobody else uses, -RT_EBUSY if it is owned by another driver or stream. */
+static rt_err_t nu_eadc_timer_take(int32_t i32Timer)
+{
+    rt_err_t result = -RT_EBUSY;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (((nu_eadc_timer_owned | nu_eadc_timer_busy) & (1 << i32Timer)) == 0)
+    {
+        nu_eadc_timer_busy |= (1 << i32Timer);
+        result = RT_EOK;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+
+static void nu_eadc_timer_give(int32_t i32Timer)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    nu_eadc_timer_busy &= ~(1 << i32Timer);
+    rt_hw_interrupt_enable(level);
+}
+
+/* The clock of a timer not enabled in BSP is off, clock it as BSP does. */
+static void nu_eadc_timer_start(int32_t i32Timer, uint32_t u32Freq)
+{
+    TIMER_T *timer = nu_eadc_timer_arr[i32Timer].base;
+    uint32_t u32RegLockLevel = SYS_IsRegLocked();
+
+    /* Unlock protected registers */
+    if (u32RegLockLevel)
+        SYS_UnlockReg();
+
+    CLK_EnableModuleClock(nu_eadc_timer_arr[i32Timer].modid);
+    CLK_SetModuleClock(nu_eadc_timer_arr[i32Timer].modid, nu_eadc_timer_arr[i32Timer].clksel, MODULE_NoMsk);
+
+    /* Lock protected registers */
+    if (u32RegLockLevel)
+        SYS_LockReg();
+
+    TIMER_Open(timer, TIMER_PERIODIC_MODE, u32Freq);
+    TIMER_SetTriggerSource(timer, TIMER_TRGSRC_TIMEOUT_EVENT);
+    TIMER_SetTriggerTarget(timer, TIMER_TRG_TO_EADC);
+    TIMER_Start(timer);
+}
+
+static void nu_eadc_timer_stop(int32_t i32Timer)
+{
+    TIMER_T *timer = nu_eadc_timer_arr[i32Timer].base;
+
+    TIMER_SetTriggerTarget(timer, 0);
+    TIMER_Close(timer);
+    CLK_DisableModuleClock(nu_eadc_timer_arr[i32Timer].modid);
+}
+
+static void nu_pdma_eadc_stream_cb(void *pvUserData, uint32_t u32Events)
+{
+    nu_eadc_t psNuEADC = (nu_eadc_t)pvUserData;
+    nu_eadc_stream_t psStream = &psNuEADC->stream;
+
+    if (u32Events & NU_PDMA_EVENT_TRANSFER_DONE)
+    {
+        nu_eadc_ring_filled(&psStream->sRing, rt_tick_get());
+        rt_sem_release(&psStream->sReady);
+    }
+}
+
+static void nu_eadc_stream_free(nu_eadc_t psNuEADC)
+{
+    nu_eadc_stream_t psStream = &psNuEADC->stream;
+
+    if (psStream->i32PdmaChan >= 0)
+    {
+        nu_pdma_channel_free(psStream->i32PdmaChan);
+        psStream->i32PdmaChan = -1;
+    }
+
+    if (psStream->apsDesc[0])
+        nu_pdma_sgtbls_free(&psStream->apsDesc[0], NU_EADC_STREAM_BLKNUM);
+
+    if (psStream->sRing.pu8Pool)
+        rt_free_align(psStream->sRing.pu8Pool);
+
+    if (psStream->i32Timer >= 0)
+    {
+        nu_eadc_timer_give(psStream->i32Timer);
+        psStream->i32Timer = -1;
+    }
+
+    rt_memset(psStream->apsDesc, 0, sizeof(psStream->apsDesc));
+    psStream->sRing.pu8Pool = RT_NULL;
+}
+
+rt_err_t nu_eadc_stream_start(rt_device_t eadc, nu_eadc_stream_cfg_t psCfg)
+{
+    nu_eadc_t psNuEADC = (nu_eadc_t)eadc;
+    nu_eadc_stream_t psStream;
+    EADC_T *base;
+    uint32_t u32ChnNum = 0, u32Samples, u32Chn, u32Mod = 0;
+    uint8_t *pu8Pool;
+    rt_err_t result;
+    int i;
+
+    RT_ASSERT(eadc);
+    RT_ASSERT(psCfg);
+
+    psStream = &psNuEADC->stream;
+    base = psNuEADC->base;
+
+    if (nu_eadc_is_streaming(psNuEADC))
+        return -RT_EBUSY;
+
+    for (u32Chn = 0; u32Chn < psNuEADC->max_chn_num; u32Chn++)
+        if (psCfg->u32ChnMsk & (1 << u32Chn))
+            u32ChnNum++;
+
+    /* Scan group takes sample modules 0 ~ (u32ChnNum - 1). */
+    u32Samples = u32ChnNum * psCfg->u32BlkFrames;
+    if ((u32ChnNum == 0) || (psCfg->u32ChnMsk >> psNuEADC->max_chn_num) ||
+            (psCfg->u32BlkFrames == 0) || (u32Samples > NU_PDMA_MAX_TXCNT) ||
+            (psCfg->u32TrgSrc == EADC_SOFTWARE_TRIGGER))
+        return -RT_EINVAL;
+
+    /* An ADINTx trigger needs ADIFx cleared by CPU after each group, it can't run unattended. */
+    if ((psCfg->u32TrgSrc == EADC_ADINT0_TRIGGER) || (psCfg->u32TrgSrc == EADC_ADINT1_TRIGGER))
+        return -RT_EINVAL;
+
+    psStream->i32Timer = -1;
+    if ((psCfg->u32TrgSrc >= EADC_TIMER0_TRIGGER) && (psCfg->u32TrgSrc <= EADC_TIMER3_TRIGGER) && psCfg->u32SampleRate)
+    {
+        int32_t i32Timer = (psCfg->u32TrgSrc - EADC_TIMER0_TRIGGER) >> EADC_SCTL_TRGSEL_Pos;
+
+        if (nu_eadc_timer_take(i32Timer) != RT_EOK)
+            return -RT_EBUSY;
+        psStream->i32Timer = i32Timer;
+    }
+
+    /* 16-bit results of all blocks. */
+    pu8Pool = rt_malloc_align(NU_EADC_STREAM_BLKNUM * u32Samples * sizeof(rt_uint16_t), 4);
+    if (pu8Pool == RT_NULL)
+    {
+        result = -RT_ENOMEM;
+        goto exit_nu_eadc_stream_start;
+    }
+
+    nu_eadc_ring_reset(&psStream->sRing, pu8Pool, u32Samples * sizeof(rt_uint16_t), psCfg->u32BlkFrames);
+
+    psStream->i32PdmaChan = nu_pdma_channel_allocate(psNuEADC->pdma_perp);
+    if (psStream->i32PdmaChan < 0)
+    {
+        result = -RT_EBUSY;
+        goto exit_nu_eadc_stream_start;
+    }
+
+    result = nu_pdma_sgtbls_allocate(&psStream->apsDesc[0], NU_EADC_STREAM_BLKNUM);
+    if (result != RT_EOK)
+        goto exit_nu_eadc_stream_start;
+
+    /* Link the blocks into a ring, each block raises a transfer-done event. */
+    for (i = 0; i < NU_EADC_STREAM_BLKNUM; i++)
+    {
+        result = nu_pdma_desc_setup(psStream->i32PdmaChan,
+                                    psStream->apsDesc[i],
+                                    16,
+                                    (uint32_t)&base->CURDAT,
+                                    (uint32_t)&pu8Pool[i * psStream->sRing.u32BlkSize],
+                                    u32Samples,
+                                    psStream->apsDesc[(i + 1) % NU_EADC_STREAM_BLKNUM],
+                                    0);
+        if (result != RT_EOK)
+            goto exit_nu_eadc_stream_start;
+    }
+
+    {
+        struct nu_pdma_chn_cb sChnCB;
+
+        sChnCB.m_eCBType = eCBType_Event;
+        sChnCB.m_pfnCBHandler = nu_pdma_eadc_stream_cb;
+        sChnCB.m_pvUserData = (void *)psNuEADC;
+
+        nu_pdma_filtering_set(psStream->i32PdmaChan, NU_PDMA_EVENT_TRANSFER_DONE);
+        result = nu_pdma_callback_register(psStream->i32PdmaChan, &sChnCB);
+        if (result != RT_EOK)
+            goto exit_nu_eadc_stream_start;
+    }
+
+    rt_sem_init(&psStream->sReady, psNuEADC->name, 0, RT_IPC_FLAG_FIFO);
+
+    if (psNuEADC->chn_msk == 0)
+        EADC_Open(base, EADC_CTL_DIFFEN_SINGLE_END);
+
+    /* One sample module per channel, converted in module order on each trigger. */
+    psStream->u32ModMsk = 0;
+    psStream->u32TrgSrc = psCfg->u32TrgSrc;
+    for (u32Chn = 0; u32Chn < psNuEADC->max_chn_num; u32Chn++)
+    {
+        if (psCfg->u32ChnMsk & (1 << u32Chn))
+        {
+            EADC_ConfigSampleModule(base, u32Mod, psCfg->u32TrgSrc, u32Chn);
+            psStream->u32ModMsk |= (1 << u32Mod);
+            u32Mod++;
+        }
+    }
+
+    EADC_ENABLE_SAMPLE_MODULE_PDMA(base, psStream->u32ModMsk);
+
+    /* Assign head descriptor & go. */
+    result = nu_pdma_sg_transfer(psStream->i32PdmaChan, psStream->apsDesc[0], 0);
+    if (result != RT_EOK)
+    {
+        EADC_DISABLE_SAMPLE_MODULE_PDMA(base, psStream->u32ModMsk);
+        for (u32Mod = 0; psStream->u32ModMsk >> u32Mod; u32Mod++)
+            EADC_ConfigSampleModule(base, u32Mod, EADC_SOFTWARE_TRIGGER, 0);
+
+        if (psNuEADC->chn_msk == 0)
+            EADC_Close(base);
+
+        rt_sem_detach(&psStream->sReady);
+        goto exit_nu_eadc_stream_start;
+    }
+
+    if (psStream->i32Timer >= 0)
+        nu_eadc_timer_start(psStream->i32Timer, psCfg->u32SampleRate);
+
+    return RT_EOK;
+
+exit_nu_eadc_stream_start:
+
+    nu_eadc_stream_free(psNuEADC);
+
+    return result;
+}
+
+rt_err_t nu_eadc_stream_stop(rt_device_t eadc)
+{
+    nu_eadc_t psNuEADC = (nu_eadc_t)eadc;
+    nu_eadc_stream_t psStream;
+    EADC_T *base;
+    uint32_t u32Mod;
+
+    RT_ASSERT(eadc);
+
+    psStream = &psNuEADC->stream;
+    base = psNuEADC->base;
+
+    if (!nu_eadc_is_streaming(psNuEADC))
+        return -RT_ERROR;
+
+    if (psStream->i32Timer >= 0)
+        nu_eadc_timer_stop(psStream->i32Timer);
+
+    /* Detach the scan group from trigger. */
+    for (u32Mod = 0; u32Mod < psNuEADC->max_chn_num; u32Mod++)
+        if (psStream->u32ModMsk & (1 << u32Mod))
+            EADC_ConfigSampleModule(base, u32Mod, EADC_SOFTWARE_TRIGGER, 0);
+
+    EADC_DISABLE_SAMPLE_MODULE_PDMA(base, psStream->u32ModMsk);
+
+    nu_pdma_channel_terminate(psStream->i32PdmaChan);
+
+    nu_eadc_stream_free(psNuEADC);
+
+    /* Readers waiting for block are woken up with error. */
+    rt_sem_detach(&psStream->sReady);
+
+    if (psNuEADC->chn_msk == 0)
+        EADC_Close(base);
+
+    return RT_EOK;
+}
+
+rt_err_t nu_eadc_stream_read(rt_device_t eadc, nu_eadc_blk_t psBlk, rt_int32_t timeout)
+{
+    nu_eadc_t psNuEADC = (nu_eadc_t)eadc;
+    rt_err_t result;
+    rt_base_t level;
+
+    RT_ASSERT(eadc);
+    RT_ASSERT(psBlk);
+
+    if (!nu_eadc_is_streaming(psNuEADC))
+        return -RT_ERROR;
+
+    level = rt_hw_interrupt_disable();
+    result = nu_eadc_ring_get(&psNuEADC->stream.sRing, psBlk);
+    rt_hw_interrupt_enable(level);
+
+    /* The semaphore may count blocks dropped by overrun, try again on empty. */
+    while (result == -RT_EEMPTY)
+    {
+        result = rt_sem_take(&psNuEADC->stream.sReady, timeout);
+        if (result != RT_EOK)
+            break;
+
+        level = rt_hw_interrupt_disable();
+        result = nu_eadc_ring_get(&psNuEADC->stream.sRing, psBlk);
+        rt_hw_interrupt_enable(level);
+    }
+
+    return result;
+}
+
+rt_err_t nu_eadc_stream_release(rt_device_t eadc, nu_eadc_blk_t psBlk)
+{
+    nu_eadc_t psNuEADC = (nu_eadc_t)eadc;
+    rt_err_t result;
+    rt_base_t level;
+
+    RT_ASSERT(eadc);
+    RT_ASSERT(psBlk);
+
+    level = rt_hw_interrupt_disable();
+    result = nu_eadc_ring_put(&psNuEADC->stream.sRing, psBlk);
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+
+rt_uint32_t nu_eadc_stream_overrun_get(rt_device_t eadc)
+{
+    nu_eadc_t psNuEADC = (nu_eadc_t)eadc;
+
+    RT_ASSERT(eadc);
+
+    return psNuEADC->stream.sRing.u32Overrun;
+}
+
+#if defined(RT_USING_FINSH) && defined(RT_USING_IDLE_HOOK)
+#include <stdlib.h>
+
+static volatile uint32_t s_u32EADCBenchIdle = 0;
+
+static void nu_eadc_bench_idle_hook(void)
+{
+    s_u32EADCBenchIdle++;
+}
+
+/* Idle hook calls in a period, the idle thread is the only one running when CPU is free. */
+static uint32_t nu_eadc_bench_idle_count(rt_tick_t period)
+{
+    s_u32EADCBenchIdle = 0;
+    rt_thread_delay(period);
+    return s_u32EADCBenchIdle;
+}
+
+static int eadc_bench(int argc, char *argv[])
+{
+    struct nu_eadc_stream_cfg sCfg;
+    struct nu_eadc_blk sBlk;
+    rt_device_t eadc;
+    uint32_t u32ChnNum = 0, u32Timer, u32Seconds = 5;
+    uint32_t u32IdleBase, u32Idle, u32Blks = 0, u32Broken = 0;
+    uint64_t u64Frames = 0, u64NextSeq = 0, u64Lost = 0;
+    rt_tick_t start, elapsed;
+    rt_err_t result;
+    int i;
+
+    if (argc < 5)
+    {
+        rt_kprintf("Usage: eadc_bench <eadcN> <channel mask> <timer 0~3 not enabled in BSP> <frames per second> [seconds]\n");
+        return -RT_EINVAL;
+    }
+
+    eadc = rt_device_find(argv[1]);
+    if (eadc == RT_NULL)
+        return -RT_EINVAL;
+
+    sCfg.u32ChnMsk = strtoul(argv[2], NULL, 0);
+    u32Timer = atoi(argv[3]);
+    sCfg.u32SampleRate = atoi(argv[4]);
+    if (argc > 5)
+        u32Seconds = atoi(argv[5]);
+
+    if ((u32Timer > 3) || (sCfg.u32SampleRate == 0) || (u32Seconds == 0))
+        return -RT_EINVAL;
+
+    for (i = 0; i < 32; i++)
+        if (sCfg.u32ChnMsk & (1 << i))
+            u32ChnNum++;
+
+    /* 10ms per block. */
+    sCfg.u32TrgSrc = EADC_TIMER0_TRIGGER + (u32Timer << EADC_SCTL_TRGSEL_Pos);
+    sCfg.u32BlkFrames = (sCfg.u32SampleRate / 100) ? (sCfg.u32SampleRate / 100) : 1;
+
+    rt_thread_idle_sethook(nu_eadc_bench_idle_hook);
+    u32IdleBase = nu_eadc_bench_idle_count(RT_TICK_PER_SECOND);
+
+    result = nu_eadc_stream_start(eadc, &sCfg);
+    if (result != RT_EOK)
+    {
+        rt_kprintf("Failed to start stream: %d\n", result);
+        goto exit_eadc_bench;
+    }
+
+    s_u32EADCBenchIdle = 0;
+    start = rt_tick_get();
+    while ((elapsed = rt_tick_get() - start) < (u32Seconds * RT_TICK_PER_SECOND))
+    {
+        if (nu_eadc_stream_read(eadc, &sBlk, RT_TICK_PER_SECOND) != RT_EOK)
+            break;
+
+        /* Frames of dropped blocks are lost. */
+        if (sBlk.u64FrameSeq != u64NextSeq)
+            u64Lost += sBlk.u64FrameSeq - u64NextSeq;
+        u64NextSeq = sBlk.u64FrameSeq + sBlk.u32Frames;
+        u64Frames += sBlk.u32Frames;
+        u32Blks++;
+
+        if (nu_eadc_stream_release(eadc, &sBlk) != RT_EOK)
+            u32Broken++;
+    }
+    u32Idle = s_u32EADCBenchIdle;
+
+    nu_eadc_stream_stop(eadc);
+
+    if (elapsed == 0)
+        elapsed = 1;
+
+    rt_kprintf("%s: %d channels, %d frames/s by TIMER%d, %d frames per block\n",
+               argv[1], u32ChnNum, sCfg.u32SampleRate, u32Timer, sCfg.u32BlkFrames);
+    rt_kprintf("blocks: %d, frames: %d, lost frames: %d, broken blocks: %d\n",
+               u32Blks, (uint32_t)u64Frames, (uint32_t)u64Lost, u32Broken);
+    rt_kprintf("sustained: %d samples/s, CPU load: %d%%\n",
+               (uint32_t)((u64Frames + u64Lost) * u32ChnNum * RT_TICK_PER_SECOND / elapsed),
+               u32IdleBase ? (100 - (uint32_t)((uint64_t)u32Idle * 100 * RT_TICK_PER_SECOND / elapsed / u32IdleBase)) : 0);
+
+exit_eadc_bench:
+
+    rt_thread_idle_delhook(nu_eadc_bench_idle_hook);
+
+    return 0;
+}
+MSH_CMD_EXPORT(eadc_bench, measure EADC streaming rate and CPU load);
+#endif /* RT_USING_FINSH && RT_USING_IDLE_HOOK */
+
+#endif /* BSP_USING_PDMA */
+
 #endif //#if defined(BSP_USING_EADC)
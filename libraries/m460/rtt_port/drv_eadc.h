@@ -0,0 +1,55 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author           Notes
+* 2026-10-17      agent            First version
+*
+* Tips:
+* Streaming converts a scan group of channels on each hardware trigger, the
+* sample modules 0 ~ (channel number - 1) are taken in ascending channel order.
+* PDMA moves the 16-bit results into a ring of blocks, a filled block is lent
+* to reader by nu_eadc_stream_read() and must be given back by
+* nu_eadc_stream_release() before PDMA comes around to it again.
+*
+******************************************************************************/
+
+#ifndef __DRV_EADC_H__
+#define __DRV_EADC_H__
+
+#include <rtthread.h>
+
+#if !defined(NU_EADC_STREAM_BLKNUM)
+    #define NU_EADC_STREAM_BLKNUM   4
+#endif
+
+struct nu_eadc_stream_cfg
+{
+    rt_uint32_t u32ChnMsk;          /* Channels of scan group */
+    rt_uint32_t u32TrgSrc;          /* EADC_xxx_TRIGGER in nu_eadc.h except EADC_SOFTWARE_TRIGGER and EADC_ADINTx_TRIGGER */
+    rt_uint32_t u32SampleRate;      /* Frames per second of a TIMER trigger, 0 if the trigger source is set up by user.
+                                       A timer enabled in BSP belongs to its driver and is refused with -RT_EBUSY. */
+    rt_uint32_t u32BlkFrames;       /* Frames of a block */
+};
+typedef struct nu_eadc_stream_cfg *nu_eadc_stream_cfg_t;
+
+/* A frame holds one sample of each channel in ascending channel order. */
+struct nu_eadc_blk
+{
+    rt_uint16_t *pu16Samples;
+    rt_uint32_t  u32Frames;
+    rt_uint64_t  u64FrameSeq;       /* Sequence number of first frame since stream start */
+    rt_tick_t    tick;              /* Tick when the block was filled */
+};
+typedef struct nu_eadc_blk *nu_eadc_blk_t;
+
+rt_err_t nu_eadc_stream_start(rt_device_t eadc, nu_eadc_stream_cfg_t psCfg);
+rt_err_t nu_eadc_stream_stop(rt_device_t eadc);
+rt_err_t nu_eadc_stream_read(rt_device_t eadc, nu_eadc_blk_t psBlk, rt_int32_t timeout);
+rt_err_t nu_eadc_stream_release(rt_device_t eadc, nu_eadc_blk_t psBlk);
+rt_uint32_t nu_eadc_stream_overrun_get(rt_device_t eadc);
+
+#endif // __DRV_EADC_H___
@@ -0,0 +1,87 @@
+/**************************************************************************//**
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent        First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_USING_EADC)
+
+#include <rtthread.h>
+#include "drv_eadc_ring.h"
+
+void nu_eadc_ring_reset(nu_eadc_ring_t psRing, rt_uint8_t *pu8Pool, rt_uint32_t u32BlkSize, rt_uint32_t u32BlkFrames)
+{
+    rt_memset(psRing, 0, sizeof(struct nu_eadc_ring));
+    psRing->pu8Pool = pu8Pool;
+    psRing->u32BlkSize = u32BlkSize;
+    psRing->u32BlkFrames = u32BlkFrames;
+    psRing->i32LentIdx = -1;
+}
+
+/* PDMA filled a block and went on to the next one, called in interrupt context. */
+void nu_eadc_ring_filled(nu_eadc_ring_t psRing, rt_tick_t tick)
+{
+    rt_uint32_t u32Idx = psRing->u32FillIdx;
+
+    psRing->au64FrameSeq[u32Idx] = psRing->u64FillSeq;
+    psRing->au32Tick[u32Idx] = tick;
+    psRing->u64FillSeq += psRing->u32BlkFrames;
+
+    psRing->u32FillIdx = (u32Idx + 1) % NU_EADC_STREAM_BLKNUM;
+    psRing->u32Ready++;
+
+    /* Keep the block PDMA is filling out of reader's hands. */
+    if (psRing->u32Ready >= NU_EADC_STREAM_BLKNUM)
+    {
+        psRing->u32ReadIdx = (psRing->u32ReadIdx + 1) % NU_EADC_STREAM_BLKNUM;
+        psRing->u32Ready--;
+        psRing->u32Overrun++;
+    }
+
+    if (psRing->i32LentIdx == (rt_int32_t)psRing->u32FillIdx)
+        psRing->u32LentBroken = 1;
+}
+
+/* Lend the oldest filled block, interrupt must be disabled by caller. */
+rt_err_t nu_eadc_ring_get(nu_eadc_ring_t psRing, nu_eadc_blk_t psBlk)
+{
+    rt_uint32_t u32Idx = psRing->u32ReadIdx;
+
+    if (psRing->i32LentIdx >= 0)
+        return -RT_EBUSY;
+    else if (psRing->u32Ready == 0)
+        return -RT_EEMPTY;
+
+    psBlk->pu16Samples = (rt_uint16_t *)(psRing->pu8Pool + u32Idx * psRing->u32BlkSize);
+    psBlk->u32Frames = psRing->u32BlkFrames;
+    psBlk->u64FrameSeq = psRing->au64FrameSeq[u32Idx];
+    psBlk->tick = psRing->au32Tick[u32Idx];
+
+    psRing->i32LentIdx = u32Idx;
+    psRing->u32LentBroken = 0;
+    psRing->u32ReadIdx = (u32Idx + 1) % NU_EADC_STREAM_BLKNUM;
+    psRing->u32Ready--;
+
+    return RT_EOK;
+}
+
+/* Give back the lent block, -RT_EFULL if PDMA refilled it before release. */
+rt_err_t nu_eadc_ring_put(nu_eadc_ring_t psRing, nu_eadc_blk_t psBlk)
+{
+    if ((psRing->i32LentIdx < 0) ||
+            ((rt_uint8_t *)psBlk->pu16Samples != (psRing->pu8Pool + psRing->i32LentIdx * psRing->u32BlkSize)))
+        return -RT_EINVAL;
+
+    psRing->i32LentIdx = -1;
+
+    return psRing->u32LentBroken ? -RT_EFULL : RT_EOK;
+}
+
+#endif /* BSP_USING_EADC */
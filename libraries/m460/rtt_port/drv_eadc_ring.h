@@ -0,0 +1,47 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author           Notes
+* 2026-10-17      agent            First version
+*
+* Tips:
+* The block ring of EADC streaming, it touches no register so it can be built
+* and tested on a host. nu_eadc_ring_filled() is called in interrupt context,
+* the others must be called with interrupt disabled.
+*
+******************************************************************************/
+
+#ifndef __DRV_EADC_RING_H__
+#define __DRV_EADC_RING_H__
+
+#include <rtthread.h>
+#include "drv_eadc.h"
+
+/* A ring of PDMA blocks, filled blocks are lent to reader in order. */
+struct nu_eadc_ring
+{
+    rt_uint8_t  *pu8Pool;
+    rt_uint32_t  u32BlkSize;        /* Bytes of a block */
+    rt_uint32_t  u32BlkFrames;      /* Frames of a block */
+    rt_uint32_t  u32FillIdx;        /* Index of the block PDMA is filling */
+    rt_uint32_t  u32ReadIdx;        /* Index of the oldest filled block */
+    rt_uint32_t  u32Ready;          /* Number of filled blocks not lent yet */
+    rt_int32_t   i32LentIdx;        /* Index of the block lent to reader, -1 if none */
+    rt_uint32_t  u32LentBroken;     /* The lent block is being refilled by PDMA */
+    rt_uint32_t  u32Overrun;        /* Dropped blocks when reader is too slow */
+    rt_uint64_t  u64FillSeq;        /* Frame sequence of the block PDMA is filling */
+    rt_uint64_t  au64FrameSeq[NU_EADC_STREAM_BLKNUM];
+    rt_tick_t    au32Tick[NU_EADC_STREAM_BLKNUM];
+};
+typedef struct nu_eadc_ring *nu_eadc_ring_t;
+
+void nu_eadc_ring_reset(nu_eadc_ring_t psRing, rt_uint8_t *pu8Pool, rt_uint32_t u32BlkSize, rt_uint32_t u32BlkFrames);
+void nu_eadc_ring_filled(nu_eadc_ring_t psRing, rt_tick_t tick);
+rt_err_t nu_eadc_ring_get(nu_eadc_ring_t psRing, nu_eadc_blk_t psBlk);
+rt_err_t nu_eadc_ring_put(nu_eadc_ring_t psRing, nu_eadc_blk_t psBlk);
+
+#endif // __DRV_EADC_RING_H__
@@ -7,6 +7,9 @@
 * Change Logs:
 * Date            Author           Notes
 * 2022-3-15       Wayne            First version
+* 2026-10-17      agent            Add scatter-gather transfer from ring block buffer
+* 2026-10-17      agent            Add asynchronous memcpy/memset queue
+* 2026-10-17      agent            Move memcpy/memset queue segmentation to drv_pdma_memq.c
 *
 ******************************************************************************/
 
@@ -18,6 +21,7 @@
 #include <rthw.h>
 #include <rtthread.h>
 #include <drv_pdma.h>
+#include "drv_pdma_memq.h"
 #include <nu_bitutil.h>
 #include "drv_sys.h"
 
@@ -76,6 +80,18 @@ struct nu_pdma_memfun_actor
 } ;
 typedef struct nu_pdma_memfun_actor *nu_pdma_memfun_actor_t;
 
+struct nu_pdma_memq
+{
+    int                 m_i32ChannID;
+    rt_list_t           m_sReqList;
+    nu_pdma_desc_t      m_apsSgtbls[NU_PDMA_MEMQ_SGTBL_NUM];
+    volatile int        m_bBusy;
+    nu_pdma_memreq_t    m_psBatchLast;      /* Last request in flight. */
+    uint32_t            m_u32BatchOffset;   /* Offset of the last request after this batch. */
+    rt_size_t           m_u32Threshold;
+    int                 m_bInited;          /* Channel and tables are taken by first request for PDMA. */
+};
+
 /* Private functions ------------------------------------------------------------*/
 static int nu_pdma_peripheral_set(uint32_t u32PeriphType);
 static void nu_pdma_init(void);
@@ -88,6 +104,7 @@ static rt_size_t nu_pdma_memfun(void *dest, void *src, uint32_t u32DataWidth, un
 static void nu_pdma_memfun_cb(void *pvUserData, uint32_t u32Events);
 static void nu_pdma_memfun_actor_init(void);
 static int nu_pdma_memfun_employ(void);
+static void nu_pdma_memq_init(void);
 static int nu_pdma_non_transfer_count_get(int32_t i32ChannID);
 
 /* Public functions -------------------------------------------------------------*/
@@ -101,6 +118,12 @@ static volatile uint32_t nu_pdma_memfun_actor_mask = 0;
 static volatile uint32_t nu_pdma_memfun_actor_maxnum = 0;
 static rt_sem_t nu_pdma_memfun_actor_pool_sem = RT_NULL;
 static rt_mutex_t nu_pdma_memfun_actor_pool_lock = RT_NULL;
+static struct nu_pdma_memq nu_pdma_memq =
+{
+    .m_i32ChannID = -1,
+    .m_sReqList = RT_LIST_OBJECT_INIT(nu_pdma_memq.m_sReqList),
+    .m_u32Threshold = NU_PDMA_MEMQ_CPU_THRESHOLD,
+};
 
 const static struct nu_module nu_pdma_arr[] =
 {
@@ -214,6 +237,7 @@ static const nu_pdma_periph_ctl_t g_nu_pdma_peripheral_ctl_pool[ ] =
 
     { PDMA_EADC0_RX, eMemCtl_SrcFix_DstInc },
     { PDMA_EADC1_RX, eMemCtl_SrcFix_DstInc },
+    { PDMA_EADC2_RX, eMemCtl_SrcFix_DstInc },
 };
 #define NU_PERIPHERAL_SIZE ( sizeof(g_nu_pdma_peripheral_ctl_pool) / sizeof(g_nu_pdma_peripheral_ctl_pool[0]) )
 
@@ -987,6 +1011,253 @@ exit_nu_pdma_sg_transfer:
     return -(ret);
 }
 
+/* Build a scatter-gather list from block queues of a ring block buffer, each queue is split by NU_PDMA_MAX_TXCNT. */
+int nu_pdma_rbb_sg_build(int i32ChannID, uint32_t u32DataWidth, uint32_t u32AddrPeriph, rt_rbb_blk_queue_t psBlkQueues,
+                         int i32QueueNum, nu_pdma_desc_t *ppsSgtbls, int i32SgtblNum)
+{
+    int i, i32SgtblIdx = 0, i32SgtblCnt = 0;
+    uint32_t u32WidthBytes = u32DataWidth / 8;
+    nu_pdma_memctrl_t eMemCtl;
+
+    if (!psBlkQueues || !ppsSgtbls)
+        return -RT_EINVAL;
+    else if (!(u32DataWidth == 8 || u32DataWidth == 16 || u32DataWidth == 32))
+        return -RT_EINVAL;
+
+    /* Count descriptors first, a partial list must not be linked. */
+    for (i = 0; i < i32QueueNum; i++)
+    {
+        uint32_t u32Addr = (uint32_t)rt_rbb_blk_queue_buf(&psBlkQueues[i]);
+        rt_size_t u32Len = rt_rbb_blk_queue_len(&psBlkQueues[i]);
+
+        if ((u32Addr % u32WidthBytes) || (u32Len % u32WidthBytes))
+            return -RT_EINVAL;
+
+        i32SgtblCnt += (u32Len / u32WidthBytes + NU_PDMA_MAX_TXCNT - 1) / NU_PDMA_MAX_TXCNT;
+    }
+
+    if (i32SgtblCnt == 0)
+        return 0;
+    else if (i32SgtblCnt > i32SgtblNum)
+        return -RT_EFULL;
+
+    eMemCtl = nu_pdma_channel_memctrl_get(i32ChannID);
+
+    for (i = 0; i < i32QueueNum; i++)
+    {
+        uint32_t u32Addr = (uint32_t)rt_rbb_blk_queue_buf(&psBlkQueues[i]);
+        uint32_t u32TXCnt = rt_rbb_blk_queue_len(&psBlkQueues[i]) / u32WidthBytes;
+
+        while (u32TXCnt > 0)
+        {
+            uint32_t u32Cnt = (u32TXCnt > NU_PDMA_MAX_TXCNT) ? NU_PDMA_MAX_TXCNT : u32TXCnt;
+            int bIsLast = ((i32SgtblIdx + 1) == i32SgtblCnt);
+            rt_err_t ret;
+
+            /* Only the last descriptor raises transfer-done interrupt. */
+            if (eMemCtl == eMemCtl_SrcFix_DstInc)
+                ret = nu_pdma_desc_setup(i32ChannID, ppsSgtbls[i32SgtblIdx], u32DataWidth, u32AddrPeriph, u32Addr, u32Cnt,
+                                         bIsLast ? NULL : ppsSgtbls[i32SgtblIdx + 1], !bIsLast);
+            else
+                ret = nu_pdma_desc_setup(i32ChannID, ppsSgtbls[i32SgtblIdx], u32DataWidth, u32Addr, u32AddrPeriph, u32Cnt,
+                                         bIsLast ? NULL : ppsSgtbls[i32SgtblIdx + 1], !bIsLast);
+
+            if (ret != RT_EOK)
+                return ret;
+
+            u32Addr += u32Cnt * u32WidthBytes;
+            u32TXCnt -= u32Cnt;
+            i32SgtblIdx++;
+        }
+    }
+
+    return i32SgtblCnt;
+}
+
+/* Return the first put block, it will be the head of next block queue. */
+static rt_rbb_blk_t nu_pdma_rbb_first_put(rt_rbb_t psRbb)
+{
+    rt_slist_t *node;
+
+    rt_slist_for_each(node, &psRbb->blk_list)
+    {
+        rt_rbb_blk_t psBlk = rt_slist_entry(node, struct rt_rbb_blk, list);
+        if (psBlk->status == RT_RBB_BLK_PUT)
+            return psBlk;
+    }
+
+    return RT_NULL;
+}
+
+static void nu_pdma_rbb_cb(void *pvUserData, uint32_t u32Events)
+{
+    nu_pdma_rbb_t psPdmaRbb = (nu_pdma_rbb_t)pvUserData;
+    rt_size_t u32Len;
+    rt_base_t level;
+    int i;
+
+    if (u32Events & NU_PDMA_EVENT_ABORT)
+        nu_pdma_channel_terminate(psPdmaRbb->m_i32ChannID);
+
+    level = rt_hw_interrupt_disable();
+
+    /* Hand blocks back to the ring, the producer may allocate them again. */
+    for (i = 0; i < psPdmaRbb->m_i32BlkQueueNum; i++)
+        rt_rbb_blk_queue_free(psPdmaRbb->m_psRbb, &psPdmaRbb->m_asBlkQueue[i]);
+
+    u32Len = psPdmaRbb->m_u32Len;
+    psPdmaRbb->m_i32BlkQueueNum = 0;
+    psPdmaRbb->m_u32Len = 0;
+
+    rt_hw_interrupt_enable(level);
+
+    if (psPdmaRbb->m_pfnDone)
+        psPdmaRbb->m_pfnDone(psPdmaRbb->m_pvUserData, u32Events, u32Len);
+
+    /* Continue with blocks put during the transfer. */
+    nu_pdma_rbb_kick(psPdmaRbb);
+}
+
+rt_err_t nu_pdma_rbb_open(nu_pdma_rbb_t psPdmaRbb, rt_rbb_t psRbb, int i32ChannID, uint32_t u32DataWidth,
+                          uint32_t u32AddrPeriph, nu_pdma_rbb_done_t pfnDone, void *pvUserData)
+{
+    struct nu_pdma_chn_cb sChnCB;
+    rt_err_t ret;
+
+    RT_ASSERT(psPdmaRbb != RT_NULL);
+    RT_ASSERT(psRbb != RT_NULL);
+
+    if (nu_pdma_check_is_nonallocated(i32ChannID))
+        return -RT_EINVAL;
+    else if (!(u32DataWidth == 8 || u32DataWidth == 16 || u32DataWidth == 32))
+        return -RT_EINVAL;
+
+    rt_memset(psPdmaRbb, 0, sizeof(struct nu_pdma_rbb));
+
+    if ((ret = nu_pdma_sgtbls_allocate(&psPdmaRbb->m_apsSgtbls[0], NU_PDMA_RBB_SGTBL_NUM)) != RT_EOK)
+        return ret;
+
+    psPdmaRbb->m_psRbb = psRbb;
+    psPdmaRbb->m_i32ChannID = i32ChannID;
+    psPdmaRbb->m_u32DataWidth = u32DataWidth;
+    psPdmaRbb->m_u32AddrPeriph = u32AddrPeriph;
+    psPdmaRbb->m_pfnDone = pfnDone;
+    psPdmaRbb->m_pvUserData = pvUserData;
+
+    /* Register ISR callback function */
+    sChnCB.m_eCBType = eCBType_Event;
+    sChnCB.m_pfnCBHandler = nu_pdma_rbb_cb;
+    sChnCB.m_pvUserData = (void *)psPdmaRbb;
+
+    nu_pdma_filtering_set(i32ChannID, NU_PDMA_EVENT_ABORT | NU_PDMA_EVENT_TRANSFER_DONE);
+    nu_pdma_callback_register(i32ChannID, &sChnCB);
+
+    return RT_EOK;
+}
+
+void nu_pdma_rbb_close(nu_pdma_rbb_t psPdmaRbb)
+{
+    struct nu_pdma_chn_cb sChnCB;
+    rt_base_t level;
+    int i;
+
+    RT_ASSERT(psPdmaRbb != RT_NULL);
+
+    /* Unregister ISR callback function */
+    sChnCB.m_eCBType = eCBType_Event;
+    sChnCB.m_pfnCBHandler = RT_NULL;
+    sChnCB.m_pvUserData = RT_NULL;
+    nu_pdma_callback_register(psPdmaRbb->m_i32ChannID, &sChnCB);
+
+    level = rt_hw_interrupt_disable();
+
+    if (psPdmaRbb->m_i32BlkQueueNum)
+    {
+        nu_pdma_channel_terminate(psPdmaRbb->m_i32ChannID);
+
+        for (i = 0; i < psPdmaRbb->m_i32BlkQueueNum; i++)
+            rt_rbb_blk_queue_free(psPdmaRbb->m_psRbb, &psPdmaRbb->m_asBlkQueue[i]);
+
+        psPdmaRbb->m_i32BlkQueueNum = 0;
+        psPdmaRbb->m_u32Len = 0;
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    nu_pdma_sgtbls_free(&psPdmaRbb->m_apsSgtbls[0], NU_PDMA_RBB_SGTBL_NUM);
+}
+
+/* Start to transfer put blocks if the channel is idle, it is safe to be called in ISR. */
+rt_err_t nu_pdma_rbb_kick(nu_pdma_rbb_t psPdmaRbb)
+{
+    rt_size_t u32DescBytes, u32Len;
+    rt_rbb_blk_t psBlk = RT_NULL;
+    rt_base_t level;
+    int i, i32QueueNum = 0, i32SgtblFree = NU_PDMA_RBB_SGTBL_NUM, i32SgtblCnt;
+
+    RT_ASSERT(psPdmaRbb != RT_NULL);
+
+    u32DescBytes = NU_PDMA_MAX_TXCNT * (psPdmaRbb->m_u32DataWidth / 8);
+
+    level = rt_hw_interrupt_disable();
+
+    /* Busy, the completion callback will kick it again. */
+    if (psPdmaRbb->m_i32BlkQueueNum)
+    {
+        rt_hw_interrupt_enable(level);
+        return RT_EOK;
+    }
+
+    /*
+     * A block queue never crosses the end of ring buffer, so the blocks after
+     * the wraparound go to the second queue. Each queue is limited to what the
+     * remaining descriptors can carry. The first block of a queue is taken
+     * regardless of the limit in rt_rbb_blk_queue_get(), check it here.
+     */
+    while ((i32QueueNum < NU_PDMA_RBB_QUEUE_MAX) &&
+            ((psBlk = nu_pdma_rbb_first_put(psPdmaRbb->m_psRbb)) != RT_NULL) &&
+            (psBlk->size <= i32SgtblFree * u32DescBytes))
+    {
+        u32Len = rt_rbb_blk_queue_get(psPdmaRbb->m_psRbb, i32SgtblFree * u32DescBytes, &psPdmaRbb->m_asBlkQueue[i32QueueNum]);
+        if (u32Len == 0)
+            break;
+
+        psPdmaRbb->m_u32Len += u32Len;
+        i32SgtblFree -= (u32Len + u32DescBytes - 1) / u32DescBytes;
+        i32QueueNum++;
+    }
+
+    psPdmaRbb->m_i32BlkQueueNum = i32QueueNum;
+
+    rt_hw_interrupt_enable(level);
+
+    if (i32QueueNum == 0)
+    {
+        /* A block larger than all descriptors can carry stalls the ring. */
+        return (psBlk != RT_NULL) ? -RT_EFULL : RT_EOK;
+    }
+
+    i32SgtblCnt = nu_pdma_rbb_sg_build(psPdmaRbb->m_i32ChannID,
+                                       psPdmaRbb->m_u32DataWidth,
+                                       psPdmaRbb->m_u32AddrPeriph,
+                                       &psPdmaRbb->m_asBlkQueue[0],
+                                       i32QueueNum,
+                                       &psPdmaRbb->m_apsSgtbls[0],
+                                       NU_PDMA_RBB_SGTBL_NUM);
+    if (i32SgtblCnt > 0)
+        return nu_pdma_sg_transfer(psPdmaRbb->m_i32ChannID, psPdmaRbb->m_apsSgtbls[0], 0);
+
+    /* Unaligned blocks can't be transferred, drop them to avoid stalling the ring. */
+    level = rt_hw_interrupt_disable();
+    for (i = 0; i < i32QueueNum; i++)
+        rt_rbb_blk_queue_free(psPdmaRbb->m_psRbb, &psPdmaRbb->m_asBlkQueue[i]);
+    psPdmaRbb->m_i32BlkQueueNum = 0;
+    psPdmaRbb->m_u32Len = 0;
+    rt_hw_interrupt_enable(level);
+
+    return (i32SgtblCnt < 0) ? i32SgtblCnt : -RT_ERROR;
+}
+
 void PDMA_IRQHandler(PDMA_T *PDMA)
 {
     int i;
@@ -1251,37 +1522,326 @@ rt_size_t nu_pdma_mempush(void *dest, void *src, uint32_t data_width, unsigned i
     return 0;
 }
 
-void *nu_pdma_memcpy(void *dest, void *src, unsigned int count)
+static void nu_pdma_memreq_complete(nu_pdma_memreq_t psReq, rt_err_t result)
 {
-    int i = 0;
-    uint32_t u32Offset = 0;
-    uint32_t u32Remaining = count;
+    /* The request may be released by its owner once the completion is done. */
+    nu_pdma_memreq_done_t pfnDone = psReq->m_pfnDone;
+    void *pvUserData = psReq->m_pvUserData;
+
+    psReq->m_i32Result = result;
+    rt_completion_done(&psReq->m_sCompletion);
 
-    for (i = 4; (i > 0) && (u32Remaining > 0) ; i >>= 1)
+    if (pfnDone)
+        pfnDone(pvUserData, result);
+}
+
+static void nu_pdma_memq_kick(void)
+{
+    struct nu_pdma_memq_seg asSegs[NU_PDMA_MEMQ_SGTBL_NUM];
+    rt_base_t level;
+    int i, i32SegCnt;
+
+    level = rt_hw_interrupt_disable();
+
+    if (nu_pdma_memq.m_bBusy || rt_list_isempty(&nu_pdma_memq.m_sReqList))
     {
-        uint32_t u32src   = (uint32_t)src + u32Offset;
-        uint32_t u32dest  = (uint32_t)dest + u32Offset;
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    nu_pdma_memq.m_bBusy = 1;
+    i32SegCnt = nu_pdma_memq_collect(&nu_pdma_memq.m_sReqList, &asSegs[0], NU_PDMA_MEMQ_SGTBL_NUM,
+                                     &nu_pdma_memq.m_psBatchLast, &nu_pdma_memq.m_u32BatchOffset);
 
-        if (((u32src % i) == (u32dest % i)) &&
-                ((u32src % i) == 0) &&
-                (RT_ALIGN_DOWN(u32Remaining, i) >= i))
+    rt_hw_interrupt_enable(level);
+
+    /* Chain all segments, only the last one raises transfer-done interrupt. */
+    for (i = 0; i < i32SegCnt; i++)
+    {
+        int bIsLast = ((i + 1) == i32SegCnt);
+        nu_pdma_desc_t psDesc = nu_pdma_memq.m_apsSgtbls[i];
+
+        nu_pdma_desc_setup(nu_pdma_memq.m_i32ChannID,
+                           psDesc,
+                           asSegs[i].m_u32DataWidth,
+                           asSegs[i].m_u32Src,
+                           asSegs[i].m_u32Dst,
+                           asSegs[i].m_u32TransferCnt,
+                           bIsLast ? NULL : nu_pdma_memq.m_apsSgtbls[i + 1],
+                           !bIsLast);
+
+        if (asSegs[i].m_u32SrcFix)
+            psDesc->CTL = (psDesc->CTL & ~PDMA_DSCT_CTL_SAINC_Msk) | PDMA_SAR_FIX;
+    }
+
+    nu_pdma_sg_transfer(nu_pdma_memq.m_i32ChannID, nu_pdma_memq.m_apsSgtbls[0], 0);
+}
+
+static void nu_pdma_memq_cb(void *pvUserData, uint32_t u32Events)
+{
+    rt_err_t result = (u32Events & NU_PDMA_EVENT_TRANSFER_DONE) ? RT_EOK : -RT_EIO;
+    nu_pdma_memreq_t psReq, psBatchLast = nu_pdma_memq.m_psBatchLast;
+    rt_base_t level;
+
+    if (u32Events & NU_PDMA_EVENT_ABORT)
+        nu_pdma_channel_terminate(nu_pdma_memq.m_i32ChannID);
+
+    do
+    {
+        level = rt_hw_interrupt_disable();
+
+        psReq = rt_list_first_entry(&nu_pdma_memq.m_sReqList, struct nu_pdma_memreq, m_sNode);
+
+        /* A long request stays in queue for next batch. */
+        if ((psReq == psBatchLast) && (result == RT_EOK) &&
+                (nu_pdma_memq.m_u32BatchOffset < psReq->m_u32Len))
         {
-            uint32_t u32TXCnt = u32Remaining / i;
-            if (u32TXCnt != nu_pdma_memfun((void *)u32dest, (void *)u32src, i * 8, u32TXCnt, eMemCtl_SrcInc_DstInc))
-                goto exit_nu_pdma_memcpy;
+            psReq->m_u32Offset = nu_pdma_memq.m_u32BatchOffset;
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        rt_list_remove(&psReq->m_sNode);
+
+        rt_hw_interrupt_enable(level);
+
+        nu_pdma_memreq_complete(psReq, result);
+    }
+    while (psReq != psBatchLast);
+
+    nu_pdma_memq.m_bBusy = 0;
+
+    nu_pdma_memq_kick();
+}
+
+static rt_err_t nu_pdma_memq_submit(nu_pdma_memreq_t psReq)
+{
+    rt_base_t level;
+
+    rt_completion_init(&psReq->m_sCompletion);
+    psReq->m_u32Offset = 0;
+    psReq->m_i32Result = -RT_EBUSY;
+
+    level = rt_hw_interrupt_disable();
+
+    /* Boards that never queue a request for PDMA don't spend a channel on it. */
+    if (!nu_pdma_memq.m_bInited && (psReq->m_u32Len >= nu_pdma_memq.m_u32Threshold))
+    {
+        nu_pdma_memq.m_bInited = 1;
+        nu_pdma_memq_init();
+    }
+
+    /* Short requests are cheaper by CPU, but never overtake queued requests. */
+    if ((nu_pdma_memq.m_i32ChannID < 0) || (psReq->m_u32Len == 0) ||
+            ((psReq->m_u32Len < nu_pdma_memq.m_u32Threshold) &&
+             !nu_pdma_memq.m_bBusy &&
+             rt_list_isempty(&nu_pdma_memq.m_sReqList)))
+    {
+        rt_hw_interrupt_enable(level);
+
+        if (psReq->m_u8IsMemset)
+            rt_memset((void *)psReq->m_u32Dst, psReq->m_u32Pattern & 0xff, psReq->m_u32Len);
+        else
+            rt_memcpy((void *)psReq->m_u32Dst, (void *)psReq->m_u32Src, psReq->m_u32Len);
+
+        nu_pdma_memreq_complete(psReq, RT_EOK);
+
+        return RT_EOK;
+    }
+
+    rt_list_insert_before(&nu_pdma_memq.m_sReqList, &psReq->m_sNode);
+
+    rt_hw_interrupt_enable(level);
+
+    nu_pdma_memq_kick();
+
+    return RT_EOK;
+}
+
+rt_err_t nu_pdma_memcpy_async(nu_pdma_memreq_t psReq, void *dest, const void *src, rt_size_t count,
+                              nu_pdma_memreq_done_t pfnDone, void *pvUserData)
+{
+    RT_ASSERT(psReq != RT_NULL);
+
+    if (!dest || !src)
+        return -RT_EINVAL;
+
+    psReq->m_u32Dst = (uint32_t)dest;
+    psReq->m_u32Src = (uint32_t)src;
+    psReq->m_u32Len = count;
+    psReq->m_u8IsMemset = 0;
+    psReq->m_pfnDone = pfnDone;
+    psReq->m_pvUserData = pvUserData;
+
+    return nu_pdma_memq_submit(psReq);
+}
+
+rt_err_t nu_pdma_memset_async(nu_pdma_memreq_t psReq, void *dest, int c, rt_size_t count,
+                              nu_pdma_memreq_done_t pfnDone, void *pvUserData)
+{
+    RT_ASSERT(psReq != RT_NULL);
+
+    if (!dest)
+        return -RT_EINVAL;
+
+    psReq->m_u32Dst = (uint32_t)dest;
+    psReq->m_u32Src = 0;
+    psReq->m_u32Pattern = (uint8_t)c * 0x01010101UL;
+    psReq->m_u32Len = count;
+    psReq->m_u8IsMemset = 1;
+    psReq->m_pfnDone = pfnDone;
+    psReq->m_pvUserData = pvUserData;
+
+    return nu_pdma_memq_submit(psReq);
+}
+
+rt_err_t nu_pdma_memreq_wait(nu_pdma_memreq_t psReq, rt_int32_t timeout)
+{
+    rt_err_t result;
 
-            u32Offset += (u32TXCnt * i);
-            u32Remaining -= (u32TXCnt * i);
+    RT_ASSERT(psReq != RT_NULL);
+
+    if ((result = rt_completion_wait(&psReq->m_sCompletion, timeout)) != RT_EOK)
+        return result;
+
+    return psReq->m_i32Result;
+}
+
+void nu_pdma_memq_threshold_set(rt_size_t u32Threshold)
+{
+    nu_pdma_memq.m_u32Threshold = u32Threshold;
+}
+
+rt_size_t nu_pdma_memq_threshold_get(void)
+{
+    return nu_pdma_memq.m_u32Threshold;
+}
+
+void *nu_pdma_memcpy(void *dest, void *src, unsigned int count)
+{
+    struct nu_pdma_memreq sReq;
+
+    if (nu_pdma_memcpy_async(&sReq, dest, src, count, RT_NULL, RT_NULL) != RT_EOK)
+        return NULL;
+
+    return (nu_pdma_memreq_wait(&sReq, RT_WAITING_FOREVER) == RT_EOK) ? dest : NULL;
+}
+
+/* Called once with interrupts disabled, requests go to CPU if it fails. */
+static void nu_pdma_memq_init(void)
+{
+    struct nu_pdma_chn_cb sChnCB;
+
+    nu_pdma_init();
+
+    if ((nu_pdma_memq.m_i32ChannID = nu_pdma_channel_allocate(PDMA_MEM)) < 0)
+        return;
+
+    if (nu_pdma_sgtbls_allocate(&nu_pdma_memq.m_apsSgtbls[0], NU_PDMA_MEMQ_SGTBL_NUM) != RT_EOK)
+    {
+        nu_pdma_channel_free(nu_pdma_memq.m_i32ChannID);
+        nu_pdma_memq.m_i32ChannID = -1;
+        return;
+    }
+
+    /* Register ISR callback function */
+    sChnCB.m_eCBType = eCBType_Event;
+    sChnCB.m_pfnCBHandler = nu_pdma_memq_cb;
+    sChnCB.m_pvUserData = RT_NULL;
+
+    nu_pdma_filtering_set(nu_pdma_memq.m_i32ChannID, NU_PDMA_EVENT_ABORT | NU_PDMA_EVENT_TRANSFER_DONE);
+    nu_pdma_callback_register(nu_pdma_memq.m_i32ChannID, &sChnCB);
+}
+
+#if defined(RT_USING_FINSH) && defined(RT_USING_HEAP)
+#include <stdlib.h>
+
+/* Average time of one copy in nanoseconds, measured over a window of ticks. */
+static uint32_t nu_pdma_memq_bench_ns(uint8_t *pu8Dst, uint8_t *pu8Src, uint32_t u32Len, int bByDMA)
+{
+    struct nu_pdma_memreq asReq[4];
+    rt_tick_t start, window = RT_TICK_PER_SECOND / 10;
+    uint32_t u32Iter = 0;
+    int i;
+
+    /* Align to tick boundary. */
+    start = rt_tick_get();
+    while (rt_tick_get() == start);
+
+    start = rt_tick_get();
+    while ((rt_tick_get() - start) < window)
+    {
+        if (bByDMA)
+        {
+            /* Queue several requests, they are chained in one transfer. */
+            for (i = 0; i < 4; i++)
+                nu_pdma_memcpy_async(&asReq[i], pu8Dst, pu8Src, u32Len, RT_NULL, RT_NULL);
+            nu_pdma_memreq_wait(&asReq[3], RT_WAITING_FOREVER);
+        }
+        else
+        {
+            for (i = 0; i < 4; i++)
+                rt_memcpy(pu8Dst, pu8Src, u32Len);
         }
+        u32Iter += 4;
+    }
+
+    return (window * (1000000000UL / RT_TICK_PER_SECOND)) / u32Iter;
+}
+
+static int pdma_memq_bench(int argc, char *argv[])
+{
+    const uint32_t u32MaxLen = 16384;
+    rt_size_t u32Threshold = 0, u32Saved = nu_pdma_memq_threshold_get();
+    uint8_t *pu8Src, *pu8Dst;
+    uint32_t u32Len;
+
+    if (argc > 1)
+    {
+        nu_pdma_memq_threshold_set(atoi(argv[1]));
+        rt_kprintf("threshold: %d bytes\n", nu_pdma_memq_threshold_get());
+        return 0;
     }
 
-    if (count == u32Offset)
-        return dest;
+    pu8Src = rt_malloc(u32MaxLen);
+    pu8Dst = rt_malloc(u32MaxLen);
+    if (!pu8Src || !pu8Dst)
+        goto exit_pdma_memq_bench;
 
-exit_nu_pdma_memcpy:
+    /* Force all requests to PDMA while measuring. */
+    nu_pdma_memq_threshold_set(0);
 
-    return NULL;
+    rt_kprintf("%8s %10s %10s\n", "bytes", "cpu(ns)", "pdma(ns)");
+    for (u32Len = 16; u32Len <= u32MaxLen; u32Len <<= 1)
+    {
+        uint32_t u32CpuNs = nu_pdma_memq_bench_ns(pu8Dst, pu8Src, u32Len, 0);
+        uint32_t u32DmaNs = nu_pdma_memq_bench_ns(pu8Dst, pu8Src, u32Len, 1);
+
+        rt_kprintf("%8d %10d %10d\n", u32Len, u32CpuNs, u32DmaNs);
+
+        /* The smallest length from which PDMA always wins. */
+        if (u32DmaNs >= u32CpuNs)
+            u32Threshold = 0;
+        else if (u32Threshold == 0)
+            u32Threshold = u32Len;
+    }
+
+    u32Saved = u32Threshold ? u32Threshold : (u32MaxLen << 1);
+    rt_kprintf("threshold: %d bytes\n", u32Saved);
+
+exit_pdma_memq_bench:
+
+    nu_pdma_memq_threshold_set(u32Saved);
+
+    if (pu8Src)
+        rt_free(pu8Src);
+    if (pu8Dst)
+        rt_free(pu8Dst);
+
+    return 0;
 }
+MSH_CMD_EXPORT(pdma_memq_bench, measure memcpy by CPU and PDMA and set threshold: pdma_memq_bench [threshold]);
+#endif
 
 /**
  * PDMA memfun actor initialization
@@ -7,6 +7,8 @@
 * Change Logs:
 * Date            Author           Notes
 * 2020-2-7        Wayne            First version
+* 2026-10-17      agent            Add scatter-gather transfer from ring block buffer
+* 2026-10-17      agent            Add asynchronous memcpy/memset queue
 *
 ******************************************************************************/
 
@@ -15,12 +17,29 @@
 
 #include <rtconfig.h>
 #include <rtthread.h>
+#include <rtdevice.h>
 #include "NuMicro.h"
 
 #ifndef NU_PDMA_SGTBL_POOL_SIZE
     #define NU_PDMA_SGTBL_POOL_SIZE (16)
 #endif
 
+#ifndef NU_PDMA_RBB_SGTBL_NUM
+    #define NU_PDMA_RBB_SGTBL_NUM   (4)
+#endif
+
+/* A wrapped ring block buffer gives at most two contiguous block queues. */
+#define NU_PDMA_RBB_QUEUE_MAX       (2)
+
+#ifndef NU_PDMA_MEMQ_SGTBL_NUM
+    #define NU_PDMA_MEMQ_SGTBL_NUM  (6)
+#endif
+
+/* Requests shorter than this are copied by CPU when the queue is idle. */
+#ifndef NU_PDMA_MEMQ_CPU_THRESHOLD
+    #define NU_PDMA_MEMQ_CPU_THRESHOLD  (128)
+#endif
+
 #define NU_PDMA_CAP_NONE    (0 << 0)
 
 #define NU_PDMA_EVENT_ABORT          (1 << 0)
@@ -64,6 +83,44 @@ struct nu_pdma_chn_cb
 };
 typedef struct nu_pdma_chn_cb *nu_pdma_chn_cb_t;
 
+typedef void (*nu_pdma_rbb_done_t)(void *pvUserData, uint32_t u32Events, rt_size_t u32Len);
+
+struct nu_pdma_rbb
+{
+    rt_rbb_t                  m_psRbb;
+    int                       m_i32ChannID;
+    uint32_t                  m_u32DataWidth;
+    uint32_t                  m_u32AddrPeriph;
+
+    nu_pdma_desc_t            m_apsSgtbls[NU_PDMA_RBB_SGTBL_NUM];
+    struct rt_rbb_blk_queue   m_asBlkQueue[NU_PDMA_RBB_QUEUE_MAX];
+    int                       m_i32BlkQueueNum;     /* Number of block queues in flight, 0 if idle. */
+    rt_size_t                 m_u32Len;             /* Bytes in flight. */
+
+    nu_pdma_rbb_done_t        m_pfnDone;
+    void                     *m_pvUserData;
+};
+typedef struct nu_pdma_rbb *nu_pdma_rbb_t;
+
+typedef void (*nu_pdma_memreq_done_t)(void *pvUserData, rt_err_t result);
+
+struct nu_pdma_memreq
+{
+    rt_list_t                 m_sNode;
+    uint32_t                  m_u32Dst;
+    uint32_t                  m_u32Src;
+    uint32_t                  m_u32Pattern;         /* Fill word of memset, it is the fixed source. */
+    uint32_t                  m_u32Len;
+    uint32_t                  m_u32Offset;          /* Bytes finished by earlier batches. */
+    uint8_t                   m_u8IsMemset;
+    rt_err_t                  m_i32Result;
+
+    nu_pdma_memreq_done_t     m_pfnDone;
+    void                     *m_pvUserData;
+    struct rt_completion      m_sCompletion;
+};
+typedef struct nu_pdma_memreq *nu_pdma_memreq_t;
+
 int nu_pdma_channel_allocate(int32_t i32PeripType);
 rt_err_t nu_pdma_channel_free(int i32ChannID);
 rt_err_t nu_pdma_callback_register(int i32ChannID, nu_pdma_chn_cb_t psChnCb);
@@ -83,8 +140,21 @@ rt_err_t nu_pdma_sg_transfer(int i32ChannID, nu_pdma_desc_t head, uint32_t u32Id
 rt_err_t nu_pdma_sgtbls_allocate(nu_pdma_desc_t *ppsSgtbls, int num);
 void nu_pdma_sgtbls_free(nu_pdma_desc_t *ppsSgtbls, int num);
 
+// For scatter-gather DMA from ring block buffer
+int nu_pdma_rbb_sg_build(int i32ChannID, uint32_t u32DataWidth, uint32_t u32AddrPeriph, rt_rbb_blk_queue_t psBlkQueues, int i32QueueNum, nu_pdma_desc_t *ppsSgtbls, int i32SgtblNum);
+rt_err_t nu_pdma_rbb_open(nu_pdma_rbb_t psPdmaRbb, rt_rbb_t psRbb, int i32ChannID, uint32_t u32DataWidth, uint32_t u32AddrPeriph, nu_pdma_rbb_done_t pfnDone, void *pvUserData);
+void nu_pdma_rbb_close(nu_pdma_rbb_t psPdmaRbb);
+rt_err_t nu_pdma_rbb_kick(nu_pdma_rbb_t psPdmaRbb);
+
 // For memory actor
 void *nu_pdma_memcpy(void *dest, void *src, unsigned int count);
 rt_size_t nu_pdma_mempush(void *dest, void *src, uint32_t data_width, unsigned int transfer_count);
 
+// For asynchronous memory actor, the request must be kept until it is done.
+rt_err_t nu_pdma_memcpy_async(nu_pdma_memreq_t psReq, void *dest, const void *src, rt_size_t count, nu_pdma_memreq_done_t pfnDone, void *pvUserData);
+rt_err_t nu_pdma_memset_async(nu_pdma_memreq_t psReq, void *dest, int c, rt_size_t count, nu_pdma_memreq_done_t pfnDone, void *pvUserData);
+rt_err_t nu_pdma_memreq_wait(nu_pdma_memreq_t psReq, rt_int32_t timeout);
+void nu_pdma_memq_threshold_set(rt_size_t u32Threshold);
+rt_size_t nu_pdma_memq_threshold_get(void);
+
 #endif // __DRV_PDMA_H___
@@ -0,0 +1,99 @@
+/**************************************************************************//**
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent        First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_USING_PDMA)
+
+#include <rtthread.h>
+#include "drv_pdma_memq.h"
+
+/* Get the next segment of a request from u32Offset, return its length in bytes. */
+uint32_t nu_pdma_memq_segment(nu_pdma_memreq_t psReq, uint32_t u32Offset, nu_pdma_memq_seg_t psSeg)
+{
+    uint32_t u32Dst = psReq->m_u32Dst + u32Offset;
+    uint32_t u32Remaining = psReq->m_u32Len - u32Offset;
+    uint32_t u32Align, u32Bytes;
+
+    if (psReq->m_u8IsMemset)
+    {
+        /* The fill word is aligned, only the destination matters. */
+        u32Align = 4;
+        psSeg->m_u32Src = (uint32_t)&psReq->m_u32Pattern;
+        psSeg->m_u32SrcFix = 1;
+    }
+    else
+    {
+        uint32_t u32Diff = psReq->m_u32Src ^ psReq->m_u32Dst;
+        u32Align = ((u32Diff % 4) == 0) ? 4 : ((u32Diff % 2) == 0) ? 2 : 1;
+        psSeg->m_u32Src = psReq->m_u32Src + u32Offset;
+        psSeg->m_u32SrcFix = 0;
+    }
+
+    if (u32Dst % u32Align)
+    {
+        /* Head bytes until the destination is aligned. */
+        u32Bytes = u32Align - (u32Dst % u32Align);
+        u32Bytes = (u32Bytes > u32Remaining) ? u32Remaining : u32Bytes;
+        psSeg->m_u32DataWidth = 8;
+        psSeg->m_u32TransferCnt = u32Bytes;
+    }
+    else if (u32Remaining >= u32Align)
+    {
+        /* Body in the widest width. */
+        psSeg->m_u32TransferCnt = u32Remaining / u32Align;
+        if (psSeg->m_u32TransferCnt > NU_PDMA_MAX_TXCNT)
+            psSeg->m_u32TransferCnt = NU_PDMA_MAX_TXCNT;
+        psSeg->m_u32DataWidth = u32Align * 8;
+        u32Bytes = psSeg->m_u32TransferCnt * u32Align;
+    }
+    else
+    {
+        /* Tail bytes. */
+        u32Bytes = u32Remaining;
+        psSeg->m_u32DataWidth = 8;
+        psSeg->m_u32TransferCnt = u32Bytes;
+    }
+
+    psSeg->m_u32Dst = u32Dst;
+
+    return u32Bytes;
+}
+
+/*
+ * Collect segments from the head of queue, a request is picked up from its
+ * m_u32Offset. Give the last request touched and its offset after this batch.
+ */
+int nu_pdma_memq_collect(rt_list_t *psReqList, nu_pdma_memq_seg_t psSegs, int i32SegNum, nu_pdma_memreq_t *ppsBatchLast, uint32_t *pu32BatchOffset)
+{
+    rt_list_t *node;
+    int i32SegCnt = 0;
+
+    rt_list_for_each(node, psReqList)
+    {
+        nu_pdma_memreq_t psReq = rt_list_entry(node, struct nu_pdma_memreq, m_sNode);
+        uint32_t u32Offset = psReq->m_u32Offset;
+
+        while ((i32SegCnt < i32SegNum) && (u32Offset < psReq->m_u32Len))
+            u32Offset += nu_pdma_memq_segment(psReq, u32Offset, &psSegs[i32SegCnt++]);
+
+        /* Completion handler finishes requests up to this one. */
+        *ppsBatchLast = psReq;
+        *pu32BatchOffset = u32Offset;
+
+        if (i32SegCnt == i32SegNum)
+            break;
+    }
+
+    return i32SegCnt;
+}
+
+#endif /* BSP_USING_PDMA */
@@ -0,0 +1,38 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author           Notes
+* 2026-10-17      agent            First version
+*
+* Tips:
+* Segmentation of the asynchronous memcpy/memset queue, it touches no register
+* so it can be built and tested on a host. nu_pdma_memq_collect() must be
+* called with interrupt disabled.
+*
+******************************************************************************/
+
+#ifndef __DRV_PDMA_MEMQ_H__
+#define __DRV_PDMA_MEMQ_H__
+
+#include <rtthread.h>
+#include "drv_pdma.h"
+
+/* One descriptor worth of a request. */
+struct nu_pdma_memq_seg
+{
+    uint32_t    m_u32Src;
+    uint32_t    m_u32Dst;
+    uint32_t    m_u32DataWidth;
+    uint32_t    m_u32TransferCnt;
+    uint32_t    m_u32SrcFix;
+};
+typedef struct nu_pdma_memq_seg *nu_pdma_memq_seg_t;
+
+uint32_t nu_pdma_memq_segment(nu_pdma_memreq_t psReq, uint32_t u32Offset, nu_pdma_memq_seg_t psSeg);
+int nu_pdma_memq_collect(rt_list_t *psReqList, nu_pdma_memq_seg_t psSegs, int i32SegNum, nu_pdma_memreq_t *ppsBatchLast, uint32_t *pu32BatchOffset);
+
+#endif // __DRV_PDMA_MEMQ_H__
@@ -7,6 +7,8 @@
 * Change Logs:
 * Date            Author           Notes
 * 2020-2-7        Wayne            First version
+* 2026-10-17      agent            Bounce non-aligned transfer in multi-sector chunks
+* 2026-10-17      agent            Never write back sectors of a failed read in sdh_bench
 *
 ******************************************************************************/
 
@@ -78,6 +80,10 @@ enum
 
 #define SDH_BLOCK_SIZE   512ul
 
+#if !defined(NU_SDH_BOUNCE_BLKS)
+    #define NU_SDH_BOUNCE_BLKS  16      /* Sectors per chunk of non-aligned transfer. */
+#endif
+
 #if defined(NU_SDH_HOTPLUG)
     #define NU_SDH_TID_STACK_SIZE  1024
 #endif
@@ -103,7 +109,7 @@ struct nu_sdh
     uint32_t              is_card_inserted;
     SDH_INFO_T           *info;
     struct rt_semaphore   lock;
-    uint8_t              *pbuf;
+    uint8_t              *pbuf;         /* Bounce buffer of NU_SDH_BOUNCE_BLKS sectors. */
 };
 typedef struct nu_sdh *nu_sdh_t;
 
@@ -272,9 +278,18 @@ static rt_err_t nu_sdh_close(rt_device_t dev)
     return RT_EOK;
 }
 
+/* Bounce buffer of non-aligned transfer, allocated at first use and kept. */
+static uint8_t *nu_sdh_bounce_get(nu_sdh_t sdh)
+{
+    if (sdh->pbuf == RT_NULL)
+        sdh->pbuf = rt_malloc_align(NU_SDH_BOUNCE_BLKS * SDH_BLOCK_SIZE, 4);
+
+    return sdh->pbuf;
+}
+
 static rt_size_t nu_sdh_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t blk_nb)
 {
-    rt_uint32_t ret = 0;
+    rt_uint32_t ret = Fail;
     nu_sdh_t sdh = (nu_sdh_t)dev;
     rt_err_t result;
 
@@ -287,26 +302,29 @@ static rt_size_t nu_sdh_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_siz
     /* Check alignment. */
     if (((uint32_t)buffer & 0x03) != 0)
     {
-        /* Non-aligned. */
-        uint32_t i;
+        /* Non-aligned, read in chunks of multiple sectors through bounce buffer. */
+        uint32_t u32BlkLeft = blk_nb, u32BlkNum;
         uint8_t *copy_buffer = (uint8_t *)buffer;
 
-        sdh->pbuf = rt_malloc(SDH_BLOCK_SIZE);
-        if (sdh->pbuf == RT_NULL)
+        if (nu_sdh_bounce_get(sdh) == RT_NULL)
             goto exit_nu_sdh_read;
 
-        for (i = 0; i < blk_nb; i++)
+        ret = Successful;
+        while (u32BlkLeft)
         {
+            u32BlkNum = (u32BlkLeft < NU_SDH_BOUNCE_BLKS) ? u32BlkLeft : NU_SDH_BOUNCE_BLKS;
+
             /* Read to temp buffer from specified sector. */
-            ret = SDH_Read(sdh->base, &sdh->pbuf[0], pos, 1);
+            ret = SDH_Read(sdh->base, &sdh->pbuf[0], pos, u32BlkNum);
             if (ret != Successful)
                 goto exit_nu_sdh_read;
 
             /* Move to user's buffer */
-            NU_SDH_MEMCPY((void *)copy_buffer, (void *)&sdh->pbuf[0], SDH_BLOCK_SIZE);
+            NU_SDH_MEMCPY((void *)copy_buffer, (void *)&sdh->pbuf[0], u32BlkNum * SDH_BLOCK_SIZE);
 
-            pos ++;
-            copy_buffer += SDH_BLOCK_SIZE;
+            pos += u32BlkNum;
+            copy_buffer += u32BlkNum * SDH_BLOCK_SIZE;
+            u32BlkLeft -= u32BlkNum;
         }
     }
     else
@@ -317,12 +335,6 @@ static rt_size_t nu_sdh_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_siz
 
 exit_nu_sdh_read:
 
-    if (sdh->pbuf)
-    {
-        rt_free(sdh->pbuf);
-        sdh->pbuf = RT_NULL;
-    }
-
     result = rt_sem_release(&sdh->lock);
     RT_ASSERT(result == RT_EOK);
 
@@ -336,7 +348,7 @@ exit_nu_sdh_read:
 
 static rt_size_t nu_sdh_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t blk_nb)
 {
-    rt_uint32_t ret = 0;
+    rt_uint32_t ret = Fail;
     nu_sdh_t sdh = (nu_sdh_t)dev;
     rt_err_t result;
 
@@ -349,24 +361,27 @@ static rt_size_t nu_sdh_write(rt_device_t dev, rt_off_t pos, const void *buffer,
     /* Check alignment. */
     if (((uint32_t)buffer & 0x03) != 0)
     {
-        /* Non-aligned. */
-        uint32_t i;
+        /* Non-aligned, write in chunks of multiple sectors through bounce buffer. */
+        uint32_t u32BlkLeft = blk_nb, u32BlkNum;
         uint8_t *copy_buffer = (uint8_t *)buffer;
 
-        sdh->pbuf = rt_malloc(SDH_BLOCK_SIZE);
-        if (sdh->pbuf == RT_NULL)
+        if (nu_sdh_bounce_get(sdh) == RT_NULL)
             goto exit_nu_sdh_write;
 
-        for (i = 0; i < blk_nb; i++)
+        ret = Successful;
+        while (u32BlkLeft)
         {
-            NU_SDH_MEMCPY((void *)&sdh->pbuf[0], copy_buffer, SDH_BLOCK_SIZE);
+            u32BlkNum = (u32BlkLeft < NU_SDH_BOUNCE_BLKS) ? u32BlkLeft : NU_SDH_BOUNCE_BLKS;
+
+            NU_SDH_MEMCPY((void *)&sdh->pbuf[0], copy_buffer, u32BlkNum * SDH_BLOCK_SIZE);
 
-            ret = SDH_Write(sdh->base, (uint8_t *)&sdh->pbuf[0], pos, 1);
+            ret = SDH_Write(sdh->base, (uint8_t *)&sdh->pbuf[0], pos, u32BlkNum);
             if (ret != Successful)
                 goto exit_nu_sdh_write;
 
-            pos++;
-            copy_buffer += SDH_BLOCK_SIZE;
+            pos += u32BlkNum;
+            copy_buffer += u32BlkNum * SDH_BLOCK_SIZE;
+            u32BlkLeft -= u32BlkNum;
         }
     }
     else
@@ -377,12 +392,6 @@ static rt_size_t nu_sdh_write(rt_device_t dev, rt_off_t pos, const void *buffer,
 
 exit_nu_sdh_write:
 
-    if (sdh->pbuf)
-    {
-        rt_free(sdh->pbuf);
-        sdh->pbuf = RT_NULL;
-    }
-
     result = rt_sem_release(&sdh->lock);
     RT_ASSERT(result == RT_EOK);
 
@@ -454,6 +463,112 @@ static int rt_hw_sdh_init(void)
 }
 INIT_BOARD_EXPORT(rt_hw_sdh_init);
 
+#if defined(RT_USING_FINSH)
+#include <stdlib.h>
+
+#define NU_SDH_BENCH_ROUNDS     8
+
+/* KB/s of transferring u32BlkNum sectors at pos NU_SDH_BENCH_ROUNDS times, 0 if failed. */
+static uint32_t nu_sdh_bench_run(rt_device_t dev, rt_off_t pos, uint8_t *pu8Buf, uint32_t u32BlkNum, int bWrite)
+{
+    rt_tick_t ticks;
+    rt_size_t ret;
+    int i;
+
+    ticks = rt_tick_get();
+    for (i = 0; i < NU_SDH_BENCH_ROUNDS; i++)
+    {
+        if (bWrite)
+            ret = rt_device_write(dev, pos, pu8Buf, u32BlkNum);
+        else
+            ret = rt_device_read(dev, pos, pu8Buf, u32BlkNum);
+
+        if (ret != u32BlkNum)
+            return 0;
+    }
+    ticks = rt_tick_get() - ticks;
+
+    if (ticks == 0)
+        ticks = 1;
+
+    return (NU_SDH_BENCH_ROUNDS * u32BlkNum * SDH_BLOCK_SIZE / 1024) * RT_TICK_PER_SECOND / ticks;
+}
+
+/* The sectors are read first and written back with the same data. */
+static int sdh_bench(int argc, char *argv[])
+{
+    rt_device_t dev;
+    rt_off_t pos;
+    uint32_t u32BlkNum = 64 * 1024 / SDH_BLOCK_SIZE;
+    uint32_t au32KBps[4];
+    uint8_t *pu8Buf;
+    int i;
+
+    if (argc < 3)
+    {
+        rt_kprintf("Usage: sdh_bench <device> <sector> [KiB]\n");
+        return -RT_EINVAL;
+    }
+
+    dev = rt_device_find(argv[1]);
+    if (dev == RT_NULL || dev->type != RT_Device_Class_Block)
+    {
+        rt_kprintf("Block device %s not found.\n", argv[1]);
+        return -RT_EINVAL;
+    }
+
+    pos = strtoul(argv[2], NULL, 0);
+    if (argc > 3)
+        u32BlkNum = atoi(argv[3]) * 1024 / SDH_BLOCK_SIZE;
+
+    if (u32BlkNum == 0)
+        return -RT_EINVAL;
+
+    /* One more word for non-aligned buffer. */
+    pu8Buf = rt_malloc_align(u32BlkNum * SDH_BLOCK_SIZE + 4, 4);
+    if (pu8Buf == RT_NULL)
+        return -RT_ENOMEM;
+
+    if (rt_device_open(dev, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        rt_free_align(pu8Buf);
+        return -RT_ERROR;
+    }
+
+    /* Read before write in each pair, so the content of card is kept. A failed read skips its write. */
+    rt_memset(au32KBps, 0, sizeof(au32KBps));
+    for (i = 0; i < 2; i++)
+    {
+        au32KBps[i * 2] = nu_sdh_bench_run(dev, pos, pu8Buf + i, u32BlkNum, 0);
+        if (au32KBps[i * 2] == 0)
+        {
+            rt_kprintf("Failed to read %d sectors from %d, write skipped.\n", u32BlkNum, pos);
+            break;
+        }
+        au32KBps[i * 2 + 1] = nu_sdh_bench_run(dev, pos, pu8Buf + i, u32BlkNum, 1);
+        if (au32KBps[i * 2 + 1] == 0)
+        {
+            rt_kprintf("Failed to write %d sectors to %d.\n", u32BlkNum, pos);
+            break;
+        }
+    }
+
+    rt_device_close(dev);
+    rt_free_align(pu8Buf);
+
+    if (i < 2)
+        return -RT_EIO;
+
+    rt_kprintf("%s: %d sectors from %d, %d rounds, bounce %d sectors\n", argv[1], u32BlkNum, pos, NU_SDH_BENCH_ROUNDS, NU_SDH_BOUNCE_BLKS);
+    rt_kprintf("%-10s %12s %12s\n", "buffer", "read(KB/s)", "write(KB/s)");
+    rt_kprintf("%-10s %12d %12d\n", "aligned", au32KBps[0], au32KBps[1]);
+    rt_kprintf("%-10s %12d %12d\n", "unaligned", au32KBps[2], au32KBps[3]);
+
+    return 0;
+}
+MSH_CMD_EXPORT(sdh_bench, measure sequential read / write: sdh_bench <device> <sector> [KiB]);
+#endif /* RT_USING_FINSH */
+
 #if defined(NU_SDH_HOTPLUG)
 static rt_bool_t nu_sdh_hotplug_is_mounted(const char *mounting_path)
 {
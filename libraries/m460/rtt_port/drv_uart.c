@@ -7,6 +7,7 @@
 * Change Logs:
 * Date            Author       Notes
 * 2022-3-15       Wayne            First version
+* 2026-10-17      agent            Add zero-copy RX with scatter-gather PDMA blocks
 *
 ******************************************************************************/
 
@@ -72,6 +73,26 @@ struct nu_rxbuf_ctx
 };
 typedef struct nu_rxbuf_ctx *nu_rxbuf_ctx_t;
 
+#if defined(RT_SERIAL_USING_DMA) && defined(BSP_USING_UART_RX_ZEROCOPY)
+#define NU_UART_RXZC_BLKNUM     BSP_UART_RX_ZEROCOPY_BLOCK_NUM
+#define NU_UART_RXZC_BLKSIZE    BSP_UART_RX_ZEROCOPY_BLOCK_SIZE
+#define NU_UART_RXZC_POOLSIZE   (NU_UART_RXZC_BLKNUM * NU_UART_RXZC_BLKSIZE)
+
+/* A ring of PDMA blocks, received data is lent to reader in place. */
+struct nu_rxzc_ctx
+{
+    uint8_t *pu8Pool;
+    uint32_t u32DoneBlk;    /* Index of the block PDMA is filling */
+    uint32_t u32PutOff;     /* Offset of received data end in pool */
+    uint32_t u32GetOff;     /* Offset of unreleased data start in pool */
+    uint32_t u32Avail;      /* Length of unreleased data */
+    uint32_t u32Overrun;    /* Dropped bytes when reader is too slow */
+    uint8_t *pu8Lent;       /* Start of data lent to reader, or NULL */
+    uint32_t u32LentBroken; /* Lent data was dropped before release */
+};
+typedef struct nu_rxzc_ctx *nu_rxzc_ctx_t;
+#endif
+
 /* Private typedef --------------------------------------------------------------*/
 struct nu_uart
 {
@@ -91,6 +112,11 @@ struct nu_uart
 
     nu_pdma_desc_t pdma_rx_desc;
     struct nu_rxbuf_ctx dmabuf;
+
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+    nu_pdma_desc_t pdma_rx_zc_desc[NU_UART_RXZC_BLKNUM];
+    struct nu_rxzc_ctx rxzc;
+#endif
 #endif
 
 };
@@ -107,6 +133,10 @@ static void nu_uart_isr(nu_uart_t serial);
     static rt_size_t nu_uart_dma_transmit(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size, int direction);
     static void nu_pdma_uart_rx_cb(void *pvOwner, uint32_t u32Events);
     static void nu_pdma_uart_tx_cb(void *pvOwner, uint32_t u32Events);
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+    static rt_size_t nu_uart_rx_buf_get(struct rt_serial_device *serial, rt_uint8_t **buf);
+    static rt_err_t nu_uart_rx_buf_release(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size);
+#endif
 #endif
 
 /* Public functions ------------------------------------------------------------*/
@@ -120,9 +150,13 @@ static const struct rt_uart_ops nu_uart_ops =
     .putc = nu_uart_send,
     .getc = nu_uart_receive,
 #if defined(RT_SERIAL_USING_DMA)
-    .dma_transmit = nu_uart_dma_transmit
+    .dma_transmit = nu_uart_dma_transmit,
 #else
-    .dma_transmit = RT_NULL
+    .dma_transmit = RT_NULL,
+#endif
+#if defined(RT_SERIAL_USING_DMA) && defined(BSP_USING_UART_RX_ZEROCOPY)
+    .rx_buf_get = nu_uart_rx_buf_get,
+    .rx_buf_release = nu_uart_rx_buf_release,
 #endif
 };
 
@@ -660,7 +694,189 @@ static void nu_pdma_uart_rxbuf_free(nu_uart_t psNuUart)
     psNuUart->dmabuf.pu8RxBuf = RT_NULL;
     psNuUart->dmabuf.bufsize = 0;
     psNuUart->dmabuf.put_index = 0;
+
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+    if (psNuUart->rxzc.pu8Pool)
+        rt_free_align(psNuUart->rxzc.pu8Pool);
+
+    psNuUart->rxzc.pu8Pool = RT_NULL;
+    psNuUart->rxzc.u32Avail = 0;
+#endif
+}
+
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+static rt_err_t nu_pdma_uart_rxzc_config(nu_uart_t psNuUart, uint32_t u32IdleTimeoutInUs)
+{
+    int i;
+    rt_err_t result;
+    nu_rxzc_ctx_t psRxZc = &psNuUart->rxzc;
+
+    /* Get base address of uart register */
+    UART_T *base = psNuUart->base;
+
+    if (!psRxZc->pu8Pool)
+    {
+        psRxZc->pu8Pool = rt_malloc_align(NU_UART_RXZC_POOLSIZE, 4);
+        if (!psRxZc->pu8Pool)
+            return -RT_ENOMEM;
+    }
+
+    psRxZc->u32DoneBlk = 0;
+    psRxZc->u32PutOff = 0;
+    psRxZc->u32GetOff = 0;
+    psRxZc->u32Avail = 0;
+    psRxZc->u32Overrun = 0;
+    psRxZc->pu8Lent = RT_NULL;
+    psRxZc->u32LentBroken = 0;
+
+    /* Link the blocks into a ring, each block raises a transfer-done event. */
+    for (i = 0; i < NU_UART_RXZC_BLKNUM; i++)
+    {
+        result = nu_pdma_desc_setup(psNuUart->pdma_chanid_rx,
+                                    psNuUart->pdma_rx_zc_desc[i],
+                                    8,
+                                    (uint32_t)&base->DAT,
+                                    (uint32_t)&psRxZc->pu8Pool[i * NU_UART_RXZC_BLKSIZE],
+                                    NU_UART_RXZC_BLKSIZE,
+                                    psNuUart->pdma_rx_zc_desc[(i + 1) % NU_UART_RXZC_BLKNUM],
+                                    0);
+        if (result != RT_EOK)
+            return result;
+    }
+
+    /* Assign head descriptor & go, the partial block is flushed by idle-timeout. */
+    return nu_pdma_sg_transfer(psNuUart->pdma_chanid_rx, psNuUart->pdma_rx_zc_desc[0], u32IdleTimeoutInUs);
+}
+
+static void nu_pdma_uart_rxzc_cb(nu_uart_t psNuUart, uint32_t u32Events)
+{
+    nu_rxzc_ctx_t psRxZc = &psNuUart->rxzc;
+    uint32_t u32PutOff, u32RecvLen, u32Limit;
+    int i32Partial;
+
+    /* Get base address of uart register */
+    UART_T *base = psNuUart->base;
+
+    if (u32Events & NU_PDMA_EVENT_TRANSFER_DONE)
+    {
+        psRxZc->u32DoneBlk = (psRxZc->u32DoneBlk + 1) % NU_UART_RXZC_BLKNUM;
+        u32PutOff = psRxZc->u32DoneBlk * NU_UART_RXZC_BLKSIZE;
+    }
+    else if (u32Events & NU_PDMA_EVENT_TIMEOUT)
+    {
+        if (!UART_GET_RX_EMPTY(base))
+            return;
+
+        /* Idle-timeout, flush the filled part of current block. */
+        i32Partial = nu_pdma_transferred_byte_get(psNuUart->pdma_chanid_rx, NU_UART_RXZC_BLKSIZE);
+        if ((i32Partial <= 0) || (i32Partial >= NU_UART_RXZC_BLKSIZE))
+            return;
+
+        u32PutOff = psRxZc->u32DoneBlk * NU_UART_RXZC_BLKSIZE + i32Partial;
+    }
+    else
+    {
+        return;
+    }
+
+    u32RecvLen = (u32PutOff + NU_UART_RXZC_POOLSIZE - psRxZc->u32PutOff) % NU_UART_RXZC_POOLSIZE;
+    if (u32RecvLen == 0)
+        return;
+
+    psRxZc->u32PutOff = u32PutOff;
+    psRxZc->u32Avail += u32RecvLen;
+
+    /*
+     * PDMA never stops, it already writes the next block when this event is served.
+     * Keep the filling block and the one after it out of reader's hands, so the
+     * oldest data is dropped a block ahead of PDMA reaching it. Data lent at the
+     * drop point is marked broken and its release fails with -RT_EFULL.
+     */
+    u32Limit = NU_UART_RXZC_POOLSIZE - 2 * NU_UART_RXZC_BLKSIZE;
+    if (psRxZc->u32Avail > u32Limit)
+    {
+        uint32_t u32Drop = psRxZc->u32Avail - u32Limit;
+
+        psRxZc->u32GetOff = (psRxZc->u32GetOff + u32Drop) % NU_UART_RXZC_POOLSIZE;
+        psRxZc->u32Avail = u32Limit;
+        psRxZc->u32Overrun += u32Drop;
+
+        if (psRxZc->pu8Lent)
+            psRxZc->u32LentBroken = 1;
+    }
+
+    rt_hw_serial_isr(&psNuUart->dev, RT_SERIAL_EVENT_RX_DMADONE | (u32RecvLen << 8));
+}
+
+static rt_size_t nu_uart_rx_buf_get(struct rt_serial_device *serial, rt_uint8_t **buf)
+{
+    nu_uart_t psNuUart = (nu_uart_t)serial;
+    nu_rxzc_ctx_t psRxZc = &psNuUart->rxzc;
+    rt_size_t size;
+    rt_base_t level;
+
+    RT_ASSERT(serial);
+    RT_ASSERT(buf);
+
+    level = rt_hw_interrupt_disable();
+
+    size = NU_UART_RXZC_POOLSIZE - psRxZc->u32GetOff;
+    if (size > psRxZc->u32Avail)
+        size = psRxZc->u32Avail;
+    *buf = psRxZc->pu8Pool + psRxZc->u32GetOff;
+
+    /* A new lend replaces the unreleased one. */
+    psRxZc->pu8Lent = size ? *buf : RT_NULL;
+    psRxZc->u32LentBroken = 0;
+
+    rt_hw_interrupt_enable(level);
+
+    return size;
+}
+
+/* Give back the lent data, -RT_EFULL if it was dropped by overrun before release. */
+static rt_err_t nu_uart_rx_buf_release(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size)
+{
+    nu_uart_t psNuUart = (nu_uart_t)serial;
+    nu_rxzc_ctx_t psRxZc = &psNuUart->rxzc;
+    uint32_t u32Dropped;
+    rt_err_t result = RT_EOK;
+    rt_base_t level;
+
+    RT_ASSERT(serial);
+
+    level = rt_hw_interrupt_disable();
+
+    if ((psRxZc->pu8Lent == RT_NULL) || (buf != psRxZc->pu8Lent) ||
+            (size > NU_UART_RXZC_POOLSIZE - (uint32_t)(buf - psRxZc->pu8Pool)))
+    {
+        result = -RT_EINVAL;
+        goto exit_nu_uart_rx_buf_release;
+    }
+
+    if (psRxZc->u32LentBroken)
+    {
+        /* Overrun already moved the start past a part of the lent data. */
+        u32Dropped = (psRxZc->u32GetOff + NU_UART_RXZC_POOLSIZE - (uint32_t)(buf - psRxZc->pu8Pool)) % NU_UART_RXZC_POOLSIZE;
+        size = (size > u32Dropped) ? (size - u32Dropped) : 0;
+        result = -RT_EFULL;
+    }
+
+    if (size > psRxZc->u32Avail)
+        size = psRxZc->u32Avail;
+
+    psRxZc->u32GetOff = (psRxZc->u32GetOff + size) % NU_UART_RXZC_POOLSIZE;
+    psRxZc->u32Avail -= size;
+    psRxZc->pu8Lent = RT_NULL;
+    psRxZc->u32LentBroken = 0;
+
+exit_nu_uart_rx_buf_release:
+
+    rt_hw_interrupt_enable(level);
+
+    return result;
 }
+#endif
 
 static rt_err_t nu_pdma_uart_rx_config(nu_uart_t psNuUart, uint8_t *pu8Buf, int32_t i32TriggerLen)
 {
@@ -711,6 +927,16 @@ static rt_err_t nu_pdma_uart_rx_config(nu_uart_t psNuUart, uint8_t *pu8Buf, int3
             goto exit_nu_pdma_uart_rx_config;
         }
     }
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+    else
+    {
+        result = nu_pdma_uart_rxzc_config(psNuUart, u32IdleTimeoutInUs);
+        if (result != RT_EOK)
+        {
+            goto exit_nu_pdma_uart_rx_config;
+        }
+    }
+#else
     else
     {
         struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *)serial->serial_rx;
@@ -738,6 +964,7 @@ static rt_err_t nu_pdma_uart_rx_config(nu_uart_t psNuUart, uint8_t *pu8Buf, int3
             goto exit_nu_pdma_uart_rx_config;
         }
     }
+#endif
 
     /* Enable Receive Line interrupt & Start DMA RX transfer. */
     UART_ENABLE_INT(base, UART_INTEN_RLSIEN_Msk | UART_INTEN_RXPDMAEN_Msk);
@@ -756,6 +983,14 @@ static void nu_pdma_uart_rx_cb(void *pvOwner, uint32_t u32Events)
 
     RT_ASSERT(psNuUart);
 
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+    if (serial->config.bufsz != 0)
+    {
+        nu_pdma_uart_rxzc_cb(psNuUart, u32Events);
+        return;
+    }
+#endif
+
     /* Get base address of uart register */
     UART_T *base = psNuUart->base;
     nu_rxbuf_ctx_t psNuRxBufCtx = &psNuUart->dmabuf;
@@ -885,7 +1120,11 @@ static int nu_hw_uart_dma_allocate(nu_uart_t psNuUart)
         {
             rt_err_t ret = RT_EOK;
             psNuUart->dma_flag |= RT_DEVICE_FLAG_DMA_RX;
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+            ret = nu_pdma_sgtbls_allocate(&psNuUart->pdma_rx_zc_desc[0], NU_UART_RXZC_BLKNUM);
+#else
             ret = nu_pdma_sgtbls_allocate(&psNuUart->pdma_rx_desc, 1);
+#endif
             RT_ASSERT(ret == RT_EOK);
         }
     }
@@ -967,8 +1206,13 @@ static rt_err_t nu_uart_control(struct rt_serial_device *serial, int cmd, void *
     case RT_DEVICE_CTRL_CONFIG:
         if (ctrl_arg == RT_DEVICE_FLAG_DMA_RX) /* Configure and trigger DMA-RX */
         {
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+            /* Blocks are allocated by driver, serial framework has no rx fifo. */
+            result = nu_pdma_uart_rx_config(psNuUart, RT_NULL, serial->config.bufsz);  // Config & trigger
+#else
             struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *)serial->serial_rx;
             result = nu_pdma_uart_rx_config(psNuUart, rx_fifo->buffer, serial->config.bufsz);  // Config & trigger
+#endif
         }
         else if (ctrl_arg == RT_DEVICE_FLAG_DMA_TX) /* Configure DMA-TX */
         {
@@ -0,0 +1,317 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent            First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_CRYPTO_AES_QUEUE_TC)
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+#if !defined(UTEST_CMD_PREFIX)
+    #define UTEST_CMD_PREFIX    "bsp.nuvoton.utest."
+#endif
+
+#define AES_TC_BUF_SIZE         256
+#define AES_TC_REQ_NUM          6
+#define AES_TC_TIMEOUT          rt_tick_from_millisecond(1000)
+
+typedef struct
+{
+    hwcrypto_type eType;
+    uint32_t u32KeyBits;
+    const uint8_t *pu8Key;
+    const uint8_t *pu8IV;
+    const uint8_t *pu8Plain;
+    const uint8_t *pu8Cipher;
+    uint32_t u32Len;
+} S_AES_TC_VECTOR;
+
+/* FIPS-197 appendix C */
+static const uint8_t au8Key256[32] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+};
+
+static const uint8_t au8FipsPlain[16] =
+{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+};
+
+static const uint8_t au8FipsCipher128[16] =
+{
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a,
+};
+
+static const uint8_t au8FipsCipher192[16] =
+{
+    0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0, 0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91,
+};
+
+static const uint8_t au8FipsCipher256[16] =
+{
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89,
+};
+
+/* NIST SP 800-38A appendix F, AES-128 */
+static const uint8_t au8SPKey[16] =
+{
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+};
+
+static const uint8_t au8SPIV[16] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+static const uint8_t au8SPCounter[16] =
+{
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff,
+};
+
+static const uint8_t au8SPPlain[64] =
+{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+};
+
+static const uint8_t au8SPCipherCBC[64] =
+{
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+    0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+    0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7,
+};
+
+static const uint8_t au8SPCipherCFB[64] =
+{
+    0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+    0xc8, 0xa6, 0x45, 0x37, 0xa0, 0xb3, 0xa9, 0x3f, 0xcd, 0xe3, 0xcd, 0xad, 0x9f, 0x1c, 0xe5, 0x8b,
+    0x26, 0x75, 0x1f, 0x67, 0xa3, 0xcb, 0xb1, 0x40, 0xb1, 0x80, 0x8c, 0xf1, 0x87, 0xa4, 0xf4, 0xdf,
+    0xc0, 0x4b, 0x05, 0x35, 0x7c, 0x5d, 0x1c, 0x0e, 0xea, 0xc4, 0xc6, 0x6f, 0x9f, 0xf7, 0xf2, 0xe6,
+};
+
+static const uint8_t au8SPCipherOFB[64] =
+{
+    0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+    0x77, 0x89, 0x50, 0x8d, 0x16, 0x91, 0x8f, 0x03, 0xf5, 0x3c, 0x52, 0xda, 0xc5, 0x4e, 0xd8, 0x25,
+    0x97, 0x40, 0x05, 0x1e, 0x9c, 0x5f, 0xec, 0xf6, 0x43, 0x44, 0xf7, 0xa8, 0x22, 0x60, 0xed, 0xcc,
+    0x30, 0x4c, 0x65, 0x28, 0xf6, 0x59, 0xc7, 0x78, 0x66, 0xa5, 0x10, 0xd9, 0xc1, 0xd6, 0xae, 0x5e,
+};
+
+static const uint8_t au8SPCipherCTR[64] =
+{
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+    0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+    0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+    0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee,
+};
+
+static const S_AES_TC_VECTOR asVectors[] =
+{
+    { HWCRYPTO_TYPE_AES_ECB, 128, au8Key256, RT_NULL,      au8FipsPlain, au8FipsCipher128, 16 },
+    { HWCRYPTO_TYPE_AES_ECB, 192, au8Key256, RT_NULL,      au8FipsPlain, au8FipsCipher192, 16 },
+    { HWCRYPTO_TYPE_AES_ECB, 256, au8Key256, RT_NULL,      au8FipsPlain, au8FipsCipher256, 16 },
+    { HWCRYPTO_TYPE_AES_CBC, 128, au8SPKey,  au8SPIV,      au8SPPlain,   au8SPCipherCBC,   64 },
+    { HWCRYPTO_TYPE_AES_CFB, 128, au8SPKey,  au8SPIV,      au8SPPlain,   au8SPCipherCFB,   64 },
+    { HWCRYPTO_TYPE_AES_OFB, 128, au8SPKey,  au8SPIV,      au8SPPlain,   au8SPCipherOFB,   64 },
+    { HWCRYPTO_TYPE_AES_CTR, 128, au8SPKey,  au8SPCounter, au8SPPlain,   au8SPCipherCTR,   64 },
+};
+
+static uint8_t *pu8Buf;
+static struct rt_semaphore sDoneSem;
+static rt_uint32_t au32Order[AES_TC_REQ_NUM];
+static rt_err_t ai32Result[AES_TC_REQ_NUM];
+static volatile rt_uint32_t u32DoneCnt;
+static rt_uint32_t u32WaitCnt;
+
+static struct rt_hwcrypto_ctx *aes_tc_ctx_create(hwcrypto_type eType, const uint8_t *pu8Key, uint32_t u32KeyBits, const uint8_t *pu8IV)
+{
+    struct rt_hwcrypto_ctx *ctx;
+
+    ctx = rt_hwcrypto_symmetric_create(rt_hwcrypto_dev_default(), eType);
+    if (ctx == RT_NULL)
+        return RT_NULL;
+
+    rt_hwcrypto_symmetric_setkey(ctx, pu8Key, u32KeyBits);
+    if (pu8IV)
+        rt_hwcrypto_symmetric_setiv(ctx, pu8IV, 16);
+
+    return ctx;
+}
+
+static void test_aes_known_answer(void)
+{
+    const S_AES_TC_VECTOR *psVec;
+    struct rt_hwcrypto_ctx *ctx;
+    int i;
+
+    for (i = 0; i < sizeof(asVectors) / sizeof(asVectors[0]); i++)
+    {
+        psVec = &asVectors[i];
+
+        ctx = aes_tc_ctx_create(psVec->eType, psVec->pu8Key, psVec->u32KeyBits, psVec->pu8IV);
+        uassert_not_null(ctx);
+        if (ctx == RT_NULL)
+            return;
+
+        uassert_int_equal(rt_hwcrypto_symmetric_crypt(ctx, HWCRYPTO_MODE_ENCRYPT, psVec->u32Len, psVec->pu8Plain, pu8Buf), RT_EOK);
+        uassert_buf_equal(pu8Buf, psVec->pu8Cipher, psVec->u32Len);
+
+        /* Decrypt in place from the same IV. */
+        if (psVec->pu8IV)
+            rt_hwcrypto_symmetric_setiv(ctx, psVec->pu8IV, 16);
+        uassert_int_equal(rt_hwcrypto_symmetric_crypt(ctx, HWCRYPTO_MODE_DECRYPT, psVec->u32Len, pu8Buf, pu8Buf), RT_EOK);
+        uassert_buf_equal(pu8Buf, psVec->pu8Plain, psVec->u32Len);
+
+        rt_hwcrypto_symmetric_destroy(ctx);
+    }
+}
+
+static void aes_tc_done(struct hwcrypto_symmetric_req *req, rt_err_t result)
+{
+    rt_uint32_t u32Idx = u32DoneCnt++;
+
+    /* Maybe called in interrupt context. */
+    if (u32Idx < AES_TC_REQ_NUM)
+    {
+        au32Order[u32Idx] = (rt_uint32_t)(rt_ubase_t)req->user_data;
+        ai32Result[u32Idx] = result;
+    }
+
+    if (u32DoneCnt == u32WaitCnt)
+        rt_sem_release(&sDoneSem);
+}
+
+static rt_err_t aes_tc_wait(rt_uint32_t u32Num)
+{
+    rt_base_t level;
+    rt_bool_t bDone;
+
+    level = rt_hw_interrupt_disable();
+    u32WaitCnt = u32Num;
+    bDone = (u32DoneCnt >= u32Num) ? RT_TRUE : RT_FALSE;
+    rt_hw_interrupt_enable(level);
+
+    return bDone ? RT_EOK : rt_sem_take(&sDoneSem, AES_TC_TIMEOUT);
+}
+
+/*
+ * Queue requests of a CBC-128 and an ECB-256 context in turn: they complete in
+ * submit order, the IV chains across the CBC requests and each context gets
+ * its own key back in the engine.
+ */
+static void test_aes_queue(void)
+{
+    struct hwcrypto_symmetric_req asReq[AES_TC_REQ_NUM];
+    struct rt_hwcrypto_ctx *psCBC, *psECB;
+    uint8_t *pu8ECBOut = pu8Buf + 64;
+    uint8_t *pu8CBCIn = pu8Buf + 128;
+    uint8_t *pu8ECBIn = pu8Buf + 192;
+    int i, i32CBCBlk = 0;
+
+    psCBC = aes_tc_ctx_create(HWCRYPTO_TYPE_AES_CBC, au8SPKey, 128, au8SPIV);
+    psECB = aes_tc_ctx_create(HWCRYPTO_TYPE_AES_ECB, au8Key256, 256, RT_NULL);
+    uassert_not_null(psCBC);
+    uassert_not_null(psECB);
+    if (!psCBC || !psECB)
+        goto exit_test_aes_queue;
+
+    /* The engine reads by DMA from SRAM only. */
+    rt_memset(pu8Buf, 0, AES_TC_BUF_SIZE);
+    rt_memcpy(pu8CBCIn, au8SPPlain, 64);
+    rt_memcpy(pu8ECBIn, au8FipsPlain, 16);
+    u32DoneCnt = 0;
+    u32WaitCnt = 0;
+    rt_sem_control(&sDoneSem, RT_IPC_CMD_RESET, RT_NULL);
+
+    /* C E C E C C */
+    for (i = 0; i < AES_TC_REQ_NUM; i++)
+    {
+        if ((i == 1) || (i == 3))
+        {
+            uassert_int_equal(rt_hwcrypto_symmetric_crypt_async(psECB, &asReq[i], HWCRYPTO_MODE_ENCRYPT, 16,
+                              pu8ECBIn, pu8ECBOut + (i / 2) * 16, aes_tc_done, (void *)(rt_ubase_t)i), RT_EOK);
+        }
+        else
+        {
+            uassert_int_equal(rt_hwcrypto_symmetric_crypt_async(psCBC, &asReq[i], HWCRYPTO_MODE_ENCRYPT, 16,
+                              pu8CBCIn + i32CBCBlk * 16, pu8Buf + i32CBCBlk * 16, aes_tc_done, (void *)(rt_ubase_t)i), RT_EOK);
+            i32CBCBlk++;
+        }
+    }
+
+    uassert_int_equal(aes_tc_wait(AES_TC_REQ_NUM), RT_EOK);
+    for (i = 0; i < AES_TC_REQ_NUM; i++)
+    {
+        uassert_int_equal(au32Order[i], i);
+        uassert_int_equal(ai32Result[i], RT_EOK);
+    }
+    uassert_buf_equal(pu8Buf, au8SPCipherCBC, 64);
+    uassert_buf_equal(pu8ECBOut, au8FipsCipher256, 16);
+    uassert_buf_equal(pu8ECBOut + 16, au8FipsCipher256, 16);
+
+    /* Decrypt in place by two chained requests. */
+    u32DoneCnt = 0;
+    u32WaitCnt = 0;
+    rt_hwcrypto_symmetric_setiv(psCBC, au8SPIV, 16);
+    for (i = 0; i < 2; i++)
+        uassert_int_equal(rt_hwcrypto_symmetric_crypt_async(psCBC, &asReq[i], HWCRYPTO_MODE_DECRYPT, 32,
+                          pu8Buf + i * 32, pu8Buf + i * 32, aes_tc_done, (void *)(rt_ubase_t)i), RT_EOK);
+    uassert_int_equal(aes_tc_wait(2), RT_EOK);
+    uassert_buf_equal(pu8Buf, au8SPPlain, 64);
+
+    /* Lengths and buffers the engine can't take are rejected at submit. */
+    uassert_int_equal(rt_hwcrypto_symmetric_crypt_async(psCBC, &asReq[0], HWCRYPTO_MODE_ENCRYPT, 6,
+                      pu8Buf, pu8Buf, aes_tc_done, RT_NULL), -RT_EINVAL);
+    uassert_int_equal(rt_hwcrypto_symmetric_crypt_async(psCBC, &asReq[0], HWCRYPTO_MODE_ENCRYPT, 16,
+                      pu8Buf + 1, pu8Buf, aes_tc_done, RT_NULL), -RT_EINVAL);
+    uassert_int_equal(u32DoneCnt, 2);
+
+exit_test_aes_queue:
+
+    if (psCBC)
+        rt_hwcrypto_symmetric_destroy(psCBC);
+    if (psECB)
+        rt_hwcrypto_symmetric_destroy(psECB);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    pu8Buf = rt_malloc_align(AES_TC_BUF_SIZE, 4);
+    if (pu8Buf == RT_NULL)
+        return -RT_ENOMEM;
+
+    return rt_sem_init(&sDoneSem, "aestc", 0, RT_IPC_FLAG_FIFO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&sDoneSem);
+    rt_free_align(pu8Buf);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_aes_known_answer);
+    UTEST_UNIT_RUN(test_aes_queue);
+}
+UTEST_TC_EXPORT(testcase, UTEST_CMD_PREFIX "crypto_aes_queue", utest_tc_init, utest_tc_cleanup, 10);
+
+#endif /* #if defined(BSP_CRYPTO_AES_QUEUE_TC) */
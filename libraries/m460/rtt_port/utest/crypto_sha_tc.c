@@ -0,0 +1,271 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent        First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_CRYPTO_SHA_TC)
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+#if !defined(UTEST_CMD_PREFIX)
+    #define UTEST_CMD_PREFIX    "bsp.nuvoton.utest."
+#endif
+
+#define SHA_TC_PATTERN_LEN      5000
+#define SHA_TC_BUF_SIZE         (SHA_TC_PATTERN_LEN + 8)
+#define SHA_TC_MILLION          1000000
+#define SHA_TC_DIGEST_LEN       32
+#define SHA_TC_BLOCK_LEN        64
+
+/* FIPS 180-2 appendix B */
+static const uint8_t au8DigestAbc[SHA_TC_DIGEST_LEN] =
+{
+    0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+};
+
+static const char acTwoBlock[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+static const uint8_t au8DigestTwoBlock[SHA_TC_DIGEST_LEN] =
+{
+    0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+    0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1,
+};
+
+/* One million of 'a' */
+static const uint8_t au8DigestMillion[SHA_TC_DIGEST_LEN] =
+{
+    0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+    0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0,
+};
+
+/* sha_tc_pattern() of SHA_TC_PATTERN_LEN bytes */
+static const uint8_t au8DigestPattern[SHA_TC_DIGEST_LEN] =
+{
+    0x54, 0x56, 0x17, 0x2e, 0xc8, 0x5b, 0x9a, 0x8a, 0xe2, 0x50, 0xeb, 0x17, 0x74, 0x83, 0xeb, 0x92,
+    0x11, 0x15, 0xde, 0x37, 0x96, 0x69, 0x68, 0xf0, 0xbd, 0xd2, 0xf1, 0xeb, 0x4c, 0x74, 0x77, 0xa9,
+};
+
+static uint8_t *pu8Buf;
+
+#if defined(RT_USING_HOOK)
+/* The largest heap block taken while hashing. */
+static volatile rt_size_t u32HeapMax;
+
+static void sha_tc_malloc_hook(void *ptr, rt_size_t size)
+{
+    if (size > u32HeapMax)
+        u32HeapMax = size;
+}
+#endif
+
+static void sha_tc_pattern(uint8_t *pu8Dst, uint32_t u32Len)
+{
+    uint32_t i;
+
+    for (i = 0; i < u32Len; i++)
+        pu8Dst[i] = (uint8_t)((i * 7 + 3) ^ (i >> 8));
+}
+
+/* SHA-256 of u32Len bytes at pu8Src fed in u32Chunk byte updates, the source is passed u32Times. */
+static rt_err_t sha_tc_hash(const uint8_t *pu8Src, uint32_t u32Len, uint32_t u32Chunk, uint32_t u32Times, uint8_t *pu8Digest)
+{
+    struct rt_hwcrypto_ctx *ctx;
+    rt_err_t result = RT_EOK;
+    uint32_t u32Off, u32Size;
+
+    ctx = rt_hwcrypto_hash_create(rt_hwcrypto_dev_default(), HWCRYPTO_TYPE_SHA256);
+    if (ctx == RT_NULL)
+        return -RT_ENOMEM;
+
+#if defined(RT_USING_HOOK)
+    u32HeapMax = 0;
+    rt_malloc_sethook(sha_tc_malloc_hook);
+#endif
+
+    while (u32Times-- && (result == RT_EOK))
+    {
+        for (u32Off = 0; (u32Off < u32Len) && (result == RT_EOK); u32Off += u32Size)
+        {
+            u32Size = ((u32Len - u32Off) < u32Chunk) ? (u32Len - u32Off) : u32Chunk;
+            result = rt_hwcrypto_hash_update(ctx, pu8Src + u32Off, u32Size);
+        }
+    }
+
+    if (result == RT_EOK)
+        result = rt_hwcrypto_hash_finish(ctx, pu8Digest, SHA_TC_DIGEST_LEN);
+
+#if defined(RT_USING_HOOK)
+    rt_malloc_sethook(RT_NULL);
+#endif
+
+    rt_hwcrypto_hash_destroy(ctx);
+
+    return result;
+}
+
+static void test_sha_known_answer(void)
+{
+    uint8_t au8Digest[SHA_TC_DIGEST_LEN];
+    uint32_t u32Off;
+
+    for (u32Off = 0; u32Off < 4; u32Off++)
+    {
+        rt_memcpy(pu8Buf + u32Off, "abc", 3);
+        uassert_int_equal(sha_tc_hash(pu8Buf + u32Off, 3, 3, 1, au8Digest), RT_EOK);
+        uassert_buf_equal(au8Digest, au8DigestAbc, SHA_TC_DIGEST_LEN);
+
+        rt_memcpy(pu8Buf + u32Off, acTwoBlock, sizeof(acTwoBlock) - 1);
+        uassert_int_equal(sha_tc_hash(pu8Buf + u32Off, sizeof(acTwoBlock) - 1, sizeof(acTwoBlock) - 1, 1, au8Digest), RT_EOK);
+        uassert_buf_equal(au8Digest, au8DigestTwoBlock, SHA_TC_DIGEST_LEN);
+
+        /* Byte by byte, always through the pending block. */
+        uassert_int_equal(sha_tc_hash(pu8Buf + u32Off, sizeof(acTwoBlock) - 1, 1, 1, au8Digest), RT_EOK);
+        uassert_buf_equal(au8Digest, au8DigestTwoBlock, SHA_TC_DIGEST_LEN);
+    }
+}
+
+/*
+ * An aligned source in SRAM goes to the engine in one cascade, others go
+ * through the 1 KiB staging buffers, 5000 bytes cross them several times.
+ */
+static void test_sha_cascade(void)
+{
+    const uint32_t au32Chunk[] = { SHA_TC_PATTERN_LEN, 4097, 1024, 1000, 129, 64, 63 };
+    uint8_t au8Digest[SHA_TC_DIGEST_LEN];
+    uint32_t u32Off, i;
+
+    for (u32Off = 0; u32Off < 4; u32Off++)
+    {
+        sha_tc_pattern(pu8Buf + u32Off, SHA_TC_PATTERN_LEN);
+
+        for (i = 0; i < sizeof(au32Chunk) / sizeof(au32Chunk[0]); i++)
+        {
+            rt_memset(au8Digest, 0, sizeof(au8Digest));
+            uassert_int_equal(sha_tc_hash(pu8Buf + u32Off, SHA_TC_PATTERN_LEN, au32Chunk[i], 1, au8Digest), RT_EOK);
+            if (rt_memcmp(au8Digest, au8DigestPattern, SHA_TC_DIGEST_LEN))
+                LOG_E("offset %d, %d bytes per update: wrong digest", u32Off, au32Chunk[i]);
+            uassert_buf_equal(au8Digest, au8DigestPattern, SHA_TC_DIGEST_LEN);
+        }
+    }
+}
+
+/* One million bytes in 5000 byte updates, report the speed and the heap taken against the previous copy of each update. */
+static void test_sha_million(void)
+{
+    uint8_t au8Digest[SHA_TC_DIGEST_LEN];
+    rt_tick_t ticks;
+    uint32_t u32Off;
+
+    rt_memset(pu8Buf, 'a', SHA_TC_BUF_SIZE);
+
+    for (u32Off = 0; u32Off < 2; u32Off++)
+    {
+        ticks = rt_tick_get();
+        uassert_int_equal(sha_tc_hash(pu8Buf + u32Off, SHA_TC_PATTERN_LEN, SHA_TC_PATTERN_LEN,
+                                      SHA_TC_MILLION / SHA_TC_PATTERN_LEN, au8Digest), RT_EOK);
+        ticks = rt_tick_get() - ticks;
+        uassert_buf_equal(au8Digest, au8DigestMillion, SHA_TC_DIGEST_LEN);
+
+        if (ticks == 0)
+            ticks = 1;
+
+#if defined(RT_USING_HOOK)
+        /* The previous implementation took its pending block from the heap and copied each unaligned update there. */
+        LOG_I("%s source: %d KB/s, largest heap block %d bytes, previously %d bytes",
+              u32Off ? "unaligned" : "aligned", (SHA_TC_MILLION / 1024) * RT_TICK_PER_SECOND / ticks,
+              u32HeapMax, u32Off ? SHA_TC_PATTERN_LEN : SHA_TC_BLOCK_LEN);
+        uassert_true(u32HeapMax < SHA_TC_PATTERN_LEN);
+#else
+        LOG_I("%s source: %d KB/s", u32Off ? "unaligned" : "aligned", (SHA_TC_MILLION / 1024) * RT_TICK_PER_SECOND / ticks);
+#endif
+    }
+}
+
+#if (BSP_CRYPTO_SHA_TC_REGION_SIZE > 0)
+/* A region outside SRAM in one update, e.g. an image in SPI flash or HyperRAM, against a copy of it through SRAM. */
+static void test_sha_region(void)
+{
+    const uint8_t *pu8Region = (const uint8_t *)BSP_CRYPTO_SHA_TC_REGION_ADDR;
+    uint8_t au8Digest[SHA_TC_DIGEST_LEN], au8Expect[SHA_TC_DIGEST_LEN];
+    struct rt_hwcrypto_ctx *ctx;
+    uint32_t u32Off, u32Size;
+    rt_tick_t ticks;
+
+    ticks = rt_tick_get();
+    uassert_int_equal(sha_tc_hash(pu8Region, BSP_CRYPTO_SHA_TC_REGION_SIZE, BSP_CRYPTO_SHA_TC_REGION_SIZE, 1, au8Digest), RT_EOK);
+    ticks = rt_tick_get() - ticks;
+
+    if (ticks == 0)
+        ticks = 1;
+
+#if defined(RT_USING_HOOK)
+    LOG_I("region 0x%08x, %d bytes: %d KB/s, largest heap block %d bytes, previously %d bytes",
+          BSP_CRYPTO_SHA_TC_REGION_ADDR, BSP_CRYPTO_SHA_TC_REGION_SIZE,
+          (BSP_CRYPTO_SHA_TC_REGION_SIZE / 1024) * RT_TICK_PER_SECOND / ticks,
+          u32HeapMax, BSP_CRYPTO_SHA_TC_REGION_SIZE);
+    uassert_true(u32HeapMax < BSP_CRYPTO_SHA_TC_REGION_SIZE);
+#else
+    LOG_I("region 0x%08x, %d bytes: %d KB/s", BSP_CRYPTO_SHA_TC_REGION_ADDR, BSP_CRYPTO_SHA_TC_REGION_SIZE,
+          (BSP_CRYPTO_SHA_TC_REGION_SIZE / 1024) * RT_TICK_PER_SECOND / ticks);
+#endif
+
+    /* The same bytes copied to an aligned SRAM buffer first, so they go directly to the engine. */
+    ctx = rt_hwcrypto_hash_create(rt_hwcrypto_dev_default(), HWCRYPTO_TYPE_SHA256);
+    uassert_not_null(ctx);
+    if (ctx == RT_NULL)
+        return;
+
+    for (u32Off = 0; u32Off < BSP_CRYPTO_SHA_TC_REGION_SIZE; u32Off += u32Size)
+    {
+        u32Size = ((BSP_CRYPTO_SHA_TC_REGION_SIZE - u32Off) < SHA_TC_PATTERN_LEN) ? (BSP_CRYPTO_SHA_TC_REGION_SIZE - u32Off) : SHA_TC_PATTERN_LEN;
+        rt_memcpy(pu8Buf, pu8Region + u32Off, u32Size);
+        if (rt_hwcrypto_hash_update(ctx, pu8Buf, u32Size) != RT_EOK)
+            break;
+    }
+    uassert_int_equal(rt_hwcrypto_hash_finish(ctx, au8Expect, SHA_TC_DIGEST_LEN), RT_EOK);
+    rt_hwcrypto_hash_destroy(ctx);
+
+    uassert_buf_equal(au8Digest, au8Expect, SHA_TC_DIGEST_LEN);
+}
+#endif
+
+static rt_err_t utest_tc_init(void)
+{
+    pu8Buf = rt_malloc_align(SHA_TC_BUF_SIZE, 4);
+    if (pu8Buf == RT_NULL)
+        return -RT_ENOMEM;
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free_align(pu8Buf);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_sha_known_answer);
+    UTEST_UNIT_RUN(test_sha_cascade);
+    UTEST_UNIT_RUN(test_sha_million);
+#if (BSP_CRYPTO_SHA_TC_REGION_SIZE > 0)
+    UTEST_UNIT_RUN(test_sha_region);
+#endif
+}
+UTEST_TC_EXPORT(testcase, UTEST_CMD_PREFIX "crypto_sha", utest_tc_init, utest_tc_cleanup, 30);
+
+#endif /* #if defined(BSP_CRYPTO_SHA_TC) */
@@ -0,0 +1,249 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent        First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_EADC_RING_TC)
+
+#include <rtthread.h>
+#include "drv_eadc_ring.h"
+#include "utest.h"
+
+#if !defined(UTEST_CMD_PREFIX)
+    #define UTEST_CMD_PREFIX    "bsp.nuvoton.utest."
+#endif
+
+#define RING_TC_FRAMES          8
+#define RING_TC_CHNS            2
+#define RING_TC_BLK_SIZE        (RING_TC_FRAMES * RING_TC_CHNS * sizeof(rt_uint16_t))
+#define RING_TC_ROUNDS          20000
+
+/* The block being written by the fake PDMA. */
+#define RING_TC_FILLING         0xFFFF
+
+static struct nu_eadc_ring sRing;
+static rt_uint8_t *pu8Pool;
+
+static rt_uint32_t ring_tc_rand(rt_uint32_t *pu32Seed)
+{
+    *pu32Seed = *pu32Seed * 1103515245 + 12345;
+    return (*pu32Seed >> 16) & 0x7FFF;
+}
+
+static rt_uint16_t *ring_tc_blk(rt_uint32_t u32Idx)
+{
+    return (rt_uint16_t *)(pu8Pool + u32Idx * RING_TC_BLK_SIZE);
+}
+
+/* Fake PDMA: tag the finished block with its sequence, then start on the next one. */
+static void ring_tc_fill(void)
+{
+    rt_uint16_t *pu16Blk = ring_tc_blk(sRing.u32FillIdx);
+    int i;
+
+    for (i = 0; i < RING_TC_FRAMES * RING_TC_CHNS; i++)
+        pu16Blk[i] = (rt_uint16_t)(sRing.u64FillSeq / RING_TC_FRAMES);
+
+    nu_eadc_ring_filled(&sRing, (rt_tick_t)sRing.u64FillSeq);
+
+    pu16Blk = ring_tc_blk(sRing.u32FillIdx);
+    for (i = 0; i < RING_TC_FRAMES * RING_TC_CHNS; i++)
+        pu16Blk[i] = RING_TC_FILLING;
+}
+
+static rt_bool_t ring_tc_blk_intact(nu_eadc_blk_t psBlk)
+{
+    int i;
+
+    for (i = 0; i < RING_TC_FRAMES * RING_TC_CHNS; i++)
+        if (psBlk->pu16Samples[i] != (rt_uint16_t)(psBlk->u64FrameSeq / RING_TC_FRAMES))
+            return RT_FALSE;
+
+    return RT_TRUE;
+}
+
+static void ring_tc_reset(void)
+{
+    int i;
+
+    nu_eadc_ring_reset(&sRing, pu8Pool, RING_TC_BLK_SIZE, RING_TC_FRAMES);
+    for (i = 0; i < RING_TC_FRAMES * RING_TC_CHNS; i++)
+        ring_tc_blk(0)[i] = RING_TC_FILLING;
+}
+
+static void test_eadc_ring_basic(void)
+{
+    struct nu_eadc_blk sBlk, sOther;
+    int i;
+
+    ring_tc_reset();
+
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sBlk), -RT_EEMPTY);
+
+    /* Nothing lent yet. */
+    sBlk.pu16Samples = ring_tc_blk(0);
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), -RT_EINVAL);
+
+    ring_tc_fill();
+    ring_tc_fill();
+
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sBlk), RT_EOK);
+    uassert_true(sBlk.pu16Samples == ring_tc_blk(0));
+    uassert_int_equal(sBlk.u32Frames, RING_TC_FRAMES);
+    uassert_int_equal(sBlk.u64FrameSeq, 0);
+    uassert_true(ring_tc_blk_intact(&sBlk));
+
+    /* One block at a time. */
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sOther), -RT_EBUSY);
+
+    /* Only the lent block is taken back. */
+    sOther.pu16Samples = ring_tc_blk(1);
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sOther), -RT_EINVAL);
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), RT_EOK);
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), -RT_EINVAL);
+
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sBlk), RT_EOK);
+    uassert_true(sBlk.pu16Samples == ring_tc_blk(1));
+    uassert_int_equal(sBlk.u64FrameSeq, RING_TC_FRAMES);
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), RT_EOK);
+
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sBlk), -RT_EEMPTY);
+
+    /* A slow reader loses the oldest blocks, the filling one is never offered. */
+    for (i = 0; i < NU_EADC_STREAM_BLKNUM + 2; i++)
+        ring_tc_fill();
+
+    uassert_int_equal(sRing.u32Overrun, 3);
+    uassert_int_equal(sRing.u32Ready, NU_EADC_STREAM_BLKNUM - 1);
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sBlk), RT_EOK);
+    uassert_int_equal(sBlk.u64FrameSeq, 5 * RING_TC_FRAMES);
+    uassert_true(sBlk.pu16Samples != ring_tc_blk(sRing.u32FillIdx));
+    uassert_true(ring_tc_blk_intact(&sBlk));
+
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), RT_EOK);
+    while (nu_eadc_ring_get(&sRing, &sBlk) == RT_EOK)
+        uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), RT_EOK);
+
+    /* With an empty ring, the lent block survives all other blocks being filled. */
+    ring_tc_fill();
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sBlk), RT_EOK);
+    for (i = 0; i < NU_EADC_STREAM_BLKNUM - 2; i++)
+        ring_tc_fill();
+    uassert_true(ring_tc_blk_intact(&sBlk));
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), RT_EOK);
+
+    /* PDMA comes around to the lent block before it is released. */
+    uassert_int_equal(nu_eadc_ring_get(&sRing, &sBlk), RT_EOK);
+    while (sBlk.pu16Samples != ring_tc_blk(sRing.u32FillIdx))
+        ring_tc_fill();
+    uassert_false(ring_tc_blk_intact(&sBlk));
+    uassert_int_equal(nu_eadc_ring_put(&sRing, &sBlk), -RT_EFULL);
+}
+
+/* Random interleaving of producer and reader, an RT_EOK release means the data was never touched. */
+static void test_eadc_ring_random(void)
+{
+    struct nu_eadc_blk sBlk;
+    rt_uint32_t u32Seed = 0x5EED, u32Round, u32Got = 0, u32Broken = 0, u32Errs = 0;
+    rt_uint64_t u64LastSeq = 0;
+    rt_bool_t bIsLent = RT_FALSE, bIsIntact = RT_FALSE;
+    rt_err_t result;
+
+    ring_tc_reset();
+
+    for (u32Round = 0; u32Round < RING_TC_ROUNDS; u32Round++)
+    {
+        switch (ring_tc_rand(&u32Seed) % 3)
+        {
+        case 0:
+            ring_tc_fill();
+            break;
+
+        case 1:
+            if (bIsLent)
+                break;
+
+            result = nu_eadc_ring_get(&sRing, &sBlk);
+            if (result == -RT_EEMPTY)
+            {
+                if (sRing.u32Ready != 0)
+                    u32Errs++;
+                break;
+            }
+            else if (result != RT_EOK)
+            {
+                u32Errs++;
+                break;
+            }
+
+            /* In order and never the block being filled. */
+            if ((u32Got && (sBlk.u64FrameSeq <= u64LastSeq)) ||
+                    (sBlk.u64FrameSeq % RING_TC_FRAMES) ||
+                    (sBlk.pu16Samples == ring_tc_blk(sRing.u32FillIdx)))
+                u32Errs++;
+
+            bIsIntact = ring_tc_blk_intact(&sBlk);
+            if (!bIsIntact)
+                u32Errs++;
+
+            u64LastSeq = sBlk.u64FrameSeq;
+            u32Got++;
+            bIsLent = RT_TRUE;
+            break;
+
+        default:
+            if (!bIsLent)
+                break;
+
+            bIsIntact = ring_tc_blk_intact(&sBlk);
+            result = nu_eadc_ring_put(&sRing, &sBlk);
+            if (result == -RT_EFULL)
+                u32Broken++;
+            else if ((result != RT_EOK) || !bIsIntact)
+                u32Errs++;
+
+            bIsLent = RT_FALSE;
+            break;
+        }
+    }
+
+    LOG_I("%d blocks read, %d refilled while lent, %d dropped", u32Got, u32Broken, sRing.u32Overrun);
+
+    uassert_int_equal(u32Errs, 0);
+    uassert_true(u32Got > 0);
+    uassert_true(sRing.u32Overrun > 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    pu8Pool = rt_malloc(NU_EADC_STREAM_BLKNUM * RING_TC_BLK_SIZE);
+    if (pu8Pool == RT_NULL)
+        return -RT_ENOMEM;
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(pu8Pool);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_eadc_ring_basic);
+    UTEST_UNIT_RUN(test_eadc_ring_random);
+}
+UTEST_TC_EXPORT(testcase, UTEST_CMD_PREFIX "eadc_ring", utest_tc_init, utest_tc_cleanup, 10);
+
+#endif /* #if defined(BSP_EADC_RING_TC) */
@@ -0,0 +1,396 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent        First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_PDMA_MEMQ_TC)
+
+#include <rtthread.h>
+#include "drv_pdma_memq.h"
+#include "utest.h"
+
+#if !defined(UTEST_CMD_PREFIX)
+    #define UTEST_CMD_PREFIX    "bsp.nuvoton.utest."
+#endif
+
+#define MEMQ_TC_BUF_SIZE        256
+#define MEMQ_TC_SEG_MAX         64
+#define MEMQ_TC_BATCH_SEGS      4
+
+/* Far from any buffer, only the segment addresses are checked there. */
+#define MEMQ_TC_FAR_SRC         0x20010000
+#define MEMQ_TC_FAR_DST         0x20100000
+
+static rt_uint8_t *pu8Src, *pu8Dst, *pu8Expect;
+static struct nu_pdma_memreq sReq;
+static struct nu_pdma_memq_seg asSegs[MEMQ_TC_SEG_MAX];
+
+static void memq_tc_req(nu_pdma_memreq_t psReq, uint32_t u32Dst, uint32_t u32Src, uint32_t u32Len)
+{
+    rt_memset(psReq, 0, sizeof(struct nu_pdma_memreq));
+    rt_list_init(&psReq->m_sNode);
+    psReq->m_u32Dst = u32Dst;
+    psReq->m_u32Src = u32Src;
+    psReq->m_u32Len = u32Len;
+}
+
+static void memq_tc_memset_req(nu_pdma_memreq_t psReq, uint32_t u32Dst, rt_uint8_t u8Value, uint32_t u32Len)
+{
+    memq_tc_req(psReq, u32Dst, 0, u32Len);
+    psReq->m_u32Pattern = u8Value * 0x01010101;
+    psReq->m_u8IsMemset = 1;
+}
+
+/* Segments of a whole request, they must be contiguous. Return the segment count, -1 on a gap. */
+static int memq_tc_split(nu_pdma_memreq_t psReq)
+{
+    uint32_t u32Offset = 0, u32Bytes;
+    int i32SegCnt = 0;
+
+    while ((u32Offset < psReq->m_u32Len) && (i32SegCnt < MEMQ_TC_SEG_MAX))
+    {
+        nu_pdma_memq_seg_t psSeg = &asSegs[i32SegCnt++];
+
+        u32Bytes = nu_pdma_memq_segment(psReq, u32Offset, psSeg);
+        if ((u32Bytes == 0) ||
+                (u32Bytes != psSeg->m_u32TransferCnt * (psSeg->m_u32DataWidth / 8)) ||
+                (psSeg->m_u32Dst != psReq->m_u32Dst + u32Offset))
+            return -1;
+
+        if (!psReq->m_u8IsMemset && (psSeg->m_u32Src != psReq->m_u32Src + u32Offset))
+            return -1;
+
+        u32Offset += u32Bytes;
+    }
+
+    return (u32Offset == psReq->m_u32Len) ? i32SegCnt : -1;
+}
+
+/* Run a segment in software as the memory channel would do it, every beat in its own width. */
+static void memq_tc_seg_run(nu_pdma_memq_seg_t psSeg)
+{
+    uint32_t u32Width = psSeg->m_u32DataWidth / 8;
+    uint32_t u32Src = psSeg->m_u32Src, u32Dst = psSeg->m_u32Dst;
+    uint32_t i;
+
+    for (i = 0; i < psSeg->m_u32TransferCnt; i++)
+    {
+        switch (u32Width)
+        {
+        case 4:
+            *(volatile uint32_t *)u32Dst = *(volatile uint32_t *)u32Src;
+            break;
+        case 2:
+            *(volatile uint16_t *)u32Dst = *(volatile uint16_t *)u32Src;
+            break;
+        default:
+            *(volatile uint8_t *)u32Dst = *(volatile uint8_t *)u32Src;
+            break;
+        }
+
+        u32Dst += u32Width;
+        if (!psSeg->m_u32SrcFix)
+            u32Src += u32Width;
+    }
+}
+
+/* Widest width is taken from how source and destination are aligned to each other. */
+static void test_memq_width(void)
+{
+    uint32_t u32SrcOff, u32DstOff, u32Len, u32Align;
+    uint32_t u32Errs = 0;
+    int i, i32SegCnt;
+
+    for (i = 0; i < MEMQ_TC_BUF_SIZE; i++)
+        pu8Src[i] = (rt_uint8_t)(i * 13 + 7);
+
+    for (u32SrcOff = 0; u32SrcOff < 4; u32SrcOff++)
+    {
+        for (u32DstOff = 0; u32DstOff < 4; u32DstOff++)
+        {
+            u32Align = ((u32SrcOff ^ u32DstOff) % 4 == 0) ? 4 : ((u32SrcOff ^ u32DstOff) % 2 == 0) ? 2 : 1;
+
+            for (u32Len = 1; u32Len <= 67; u32Len += (u32Len < 9) ? 1 : 29)
+            {
+                uint32_t u32Head = (u32Align - (u32DstOff % u32Align)) % u32Align;
+
+                rt_memset(pu8Dst, 0, MEMQ_TC_BUF_SIZE);
+                memq_tc_req(&sReq, (uint32_t)(pu8Dst + u32DstOff), (uint32_t)(pu8Src + u32SrcOff), u32Len);
+
+                i32SegCnt = memq_tc_split(&sReq);
+                if (i32SegCnt <= 0)
+                {
+                    LOG_E("src +%d, dst +%d, %d bytes: broken segments", u32SrcOff, u32DstOff, u32Len);
+                    u32Errs++;
+                    continue;
+                }
+
+                /* At most head, body and tail, the body in the widest width and aligned for it. */
+                if (i32SegCnt > 3)
+                    u32Errs++;
+
+                for (i = 0; i < i32SegCnt; i++)
+                {
+                    if (asSegs[i].m_u32SrcFix)
+                        u32Errs++;
+
+                    if (asSegs[i].m_u32DataWidth == u32Align * 8)
+                    {
+                        if ((asSegs[i].m_u32Dst % u32Align) || (asSegs[i].m_u32Src % u32Align))
+                            u32Errs++;
+                    }
+                    else if (asSegs[i].m_u32DataWidth != 8)
+                        u32Errs++;
+                    else if ((i == 0) && u32Head && (asSegs[i].m_u32TransferCnt > u32Head))
+                        u32Errs++;
+                }
+
+                if ((u32Len >= u32Head + u32Align) && (asSegs[u32Head ? 1 : 0].m_u32DataWidth != u32Align * 8))
+                {
+                    LOG_E("src +%d, dst +%d, %d bytes: body is %d bits", u32SrcOff, u32DstOff, u32Len,
+                          asSegs[u32Head ? 1 : 0].m_u32DataWidth);
+                    u32Errs++;
+                }
+
+                for (i = 0; i < i32SegCnt; i++)
+                    memq_tc_seg_run(&asSegs[i]);
+
+                rt_memset(pu8Expect, 0, MEMQ_TC_BUF_SIZE);
+                rt_memcpy(pu8Expect + u32DstOff, pu8Src + u32SrcOff, u32Len);
+                if (rt_memcmp(pu8Dst, pu8Expect, MEMQ_TC_BUF_SIZE))
+                {
+                    LOG_E("src +%d, dst +%d, %d bytes: wrong copy", u32SrcOff, u32DstOff, u32Len);
+                    u32Errs++;
+                }
+            }
+        }
+    }
+
+    uassert_int_equal(u32Errs, 0);
+}
+
+/* A body longer than one descriptor can count is split at NU_PDMA_MAX_TXCNT. */
+static void test_memq_max_txcnt(void)
+{
+    int i32SegCnt;
+
+    /* Two full descriptors, a partial one and a tail. */
+    memq_tc_req(&sReq, MEMQ_TC_FAR_DST, MEMQ_TC_FAR_SRC, NU_PDMA_MAX_TXCNT * 4 * 2 + 10);
+    i32SegCnt = memq_tc_split(&sReq);
+    uassert_int_equal(i32SegCnt, 4);
+    uassert_int_equal(asSegs[0].m_u32DataWidth, 32);
+    uassert_int_equal(asSegs[0].m_u32TransferCnt, NU_PDMA_MAX_TXCNT);
+    uassert_int_equal(asSegs[1].m_u32DataWidth, 32);
+    uassert_int_equal(asSegs[1].m_u32TransferCnt, NU_PDMA_MAX_TXCNT);
+    uassert_int_equal(asSegs[2].m_u32DataWidth, 32);
+    uassert_int_equal(asSegs[2].m_u32TransferCnt, 2);
+    uassert_int_equal(asSegs[3].m_u32DataWidth, 8);
+    uassert_int_equal(asSegs[3].m_u32TransferCnt, 2);
+
+    /* Exactly one descriptor, nothing left over. */
+    memq_tc_req(&sReq, MEMQ_TC_FAR_DST, MEMQ_TC_FAR_SRC, NU_PDMA_MAX_TXCNT * 4);
+    uassert_int_equal(memq_tc_split(&sReq), 1);
+    uassert_int_equal(asSegs[0].m_u32TransferCnt, NU_PDMA_MAX_TXCNT);
+
+    /* Byte copies are split the same way, in bytes. */
+    memq_tc_req(&sReq, MEMQ_TC_FAR_DST + 1, MEMQ_TC_FAR_SRC, NU_PDMA_MAX_TXCNT + 1);
+    uassert_int_equal(memq_tc_split(&sReq), 2);
+    uassert_int_equal(asSegs[0].m_u32DataWidth, 8);
+    uassert_int_equal(asSegs[0].m_u32TransferCnt, NU_PDMA_MAX_TXCNT);
+    uassert_int_equal(asSegs[1].m_u32TransferCnt, 1);
+}
+
+/* Memset reads the fill word from a fixed source, only the destination sets the width. */
+static void test_memq_memset(void)
+{
+    uint32_t u32DstOff, u32Len;
+    uint32_t u32Errs = 0;
+    int i, i32SegCnt;
+
+    for (u32DstOff = 0; u32DstOff < 4; u32DstOff++)
+    {
+        for (u32Len = 1; u32Len <= 67; u32Len += (u32Len < 9) ? 1 : 29)
+        {
+            rt_memset(pu8Dst, 0, MEMQ_TC_BUF_SIZE);
+            memq_tc_memset_req(&sReq, (uint32_t)(pu8Dst + u32DstOff), 0xA5, u32Len);
+
+            i32SegCnt = memq_tc_split(&sReq);
+            if (i32SegCnt <= 0)
+            {
+                u32Errs++;
+                continue;
+            }
+
+            for (i = 0; i < i32SegCnt; i++)
+            {
+                if (!asSegs[i].m_u32SrcFix || (asSegs[i].m_u32Src != (uint32_t)&sReq.m_u32Pattern))
+                    u32Errs++;
+                if ((asSegs[i].m_u32DataWidth == 32) && (asSegs[i].m_u32Dst % 4))
+                    u32Errs++;
+            }
+
+            /* Anything with a whole aligned word in it has a word body. */
+            if ((u32Len >= ((4 - u32DstOff) % 4) + 4) &&
+                    (asSegs[(u32DstOff % 4) ? 1 : 0].m_u32DataWidth != 32))
+                u32Errs++;
+
+            for (i = 0; i < i32SegCnt; i++)
+                memq_tc_seg_run(&asSegs[i]);
+
+            rt_memset(pu8Expect, 0, MEMQ_TC_BUF_SIZE);
+            rt_memset(pu8Expect + u32DstOff, 0xA5, u32Len);
+            if (rt_memcmp(pu8Dst, pu8Expect, MEMQ_TC_BUF_SIZE))
+            {
+                LOG_E("dst +%d, %d bytes: wrong fill", u32DstOff, u32Len);
+                u32Errs++;
+            }
+        }
+    }
+
+    uassert_int_equal(u32Errs, 0);
+
+    /* A long fill is split at NU_PDMA_MAX_TXCNT words. */
+    memq_tc_memset_req(&sReq, MEMQ_TC_FAR_DST + 3, 0, 1 + NU_PDMA_MAX_TXCNT * 4 + 4 + 2);
+    uassert_int_equal(memq_tc_split(&sReq), 4);
+    uassert_int_equal(asSegs[0].m_u32DataWidth, 8);
+    uassert_int_equal(asSegs[0].m_u32TransferCnt, 1);
+    uassert_int_equal(asSegs[1].m_u32DataWidth, 32);
+    uassert_int_equal(asSegs[1].m_u32TransferCnt, NU_PDMA_MAX_TXCNT);
+    uassert_int_equal(asSegs[2].m_u32DataWidth, 32);
+    uassert_int_equal(asSegs[2].m_u32TransferCnt, 1);
+    uassert_int_equal(asSegs[3].m_u32DataWidth, 8);
+    uassert_int_equal(asSegs[3].m_u32TransferCnt, 2);
+}
+
+/*
+ * Batches of MEMQ_TC_BATCH_SEGS segments over a queue of requests. A request
+ * which does not fit stays queued with its offset moved, as the completion
+ * handler does, and the next batch picks it up from there.
+ */
+static void test_memq_batch(void)
+{
+    struct nu_pdma_memreq asReq[4];
+    struct nu_pdma_memq_seg asBatch[MEMQ_TC_BATCH_SEGS];
+    nu_pdma_memreq_t psLast = RT_NULL;
+    rt_list_t sReqList, sEmpty;
+    uint32_t u32LastOffset = 0, au32Done[4] = { 0 };
+    int i, j, i32SegCnt, i32Batches = 0;
+    uint32_t u32Errs = 0;
+
+    rt_list_init(&sReqList);
+
+    /* 1 segment, 7 segments ending on the second batch, 2 segments, 3 segments. */
+    memq_tc_req(&asReq[0], MEMQ_TC_FAR_DST + 1, MEMQ_TC_FAR_SRC + 2, 7);
+    memq_tc_memset_req(&asReq[1], MEMQ_TC_FAR_DST + 0x1001, 0x5A, 3 + NU_PDMA_MAX_TXCNT * 4 * 5 + 2);
+    memq_tc_req(&asReq[2], MEMQ_TC_FAR_DST + 0x80000, MEMQ_TC_FAR_SRC, NU_PDMA_MAX_TXCNT * 4 * 2);
+    memq_tc_req(&asReq[3], MEMQ_TC_FAR_DST + 0x90003, MEMQ_TC_FAR_SRC + 1, 6);
+
+    for (i = 0; i < 4; i++)
+        rt_list_insert_before(&sReqList, &asReq[i].m_sNode);
+
+    /* Empty queue. */
+    rt_list_init(&sEmpty);
+    uassert_int_equal(nu_pdma_memq_collect(&sEmpty, asBatch, MEMQ_TC_BATCH_SEGS, &psLast, &u32LastOffset), 0);
+
+    while (!rt_list_isempty(&sReqList) && (i32Batches < 32))
+    {
+        nu_pdma_memreq_t psReq = rt_list_first_entry(&sReqList, struct nu_pdma_memreq, m_sNode);
+
+        i32SegCnt = nu_pdma_memq_collect(&sReqList, asBatch, MEMQ_TC_BATCH_SEGS, &psLast, &u32LastOffset);
+        i32Batches++;
+
+        if ((i32SegCnt == 0) || (i32SegCnt > MEMQ_TC_BATCH_SEGS))
+        {
+            u32Errs++;
+            break;
+        }
+
+        /* Segments follow the requests in queue order, each one from where it stopped. */
+        for (j = 0; j < i32SegCnt; j++)
+        {
+            int k = (int)(psReq - &asReq[0]);
+
+            if (asBatch[j].m_u32Dst != psReq->m_u32Dst + au32Done[k])
+            {
+                LOG_E("batch %d, segment %d: dst 0x%08x, want 0x%08x", i32Batches, j,
+                      asBatch[j].m_u32Dst, psReq->m_u32Dst + au32Done[k]);
+                u32Errs++;
+            }
+
+            au32Done[k] += asBatch[j].m_u32TransferCnt * (asBatch[j].m_u32DataWidth / 8);
+
+            if ((au32Done[k] == psReq->m_u32Len) && (j + 1 < i32SegCnt))
+                psReq = rt_list_entry(psReq->m_sNode.next, struct nu_pdma_memreq, m_sNode);
+        }
+
+        if ((psLast != psReq) || (u32LastOffset != au32Done[psReq - &asReq[0]]))
+        {
+            LOG_E("batch %d: last request %d at %d", i32Batches, (int)(psLast - &asReq[0]), u32LastOffset);
+            u32Errs++;
+        }
+
+        /* Completion: finish requests up to the last one, keep it if it is not done. */
+        do
+        {
+            psReq = rt_list_first_entry(&sReqList, struct nu_pdma_memreq, m_sNode);
+
+            if ((psReq == psLast) && (u32LastOffset < psReq->m_u32Len))
+            {
+                psReq->m_u32Offset = u32LastOffset;
+                break;
+            }
+
+            rt_list_remove(&psReq->m_sNode);
+        }
+        while (psReq != psLast);
+    }
+
+    LOG_I("%d requests in %d batches of %d segments", 4, i32Batches, MEMQ_TC_BATCH_SEGS);
+
+    uassert_int_equal(u32Errs, 0);
+    uassert_true(rt_list_isempty(&sReqList));
+    for (i = 0; i < 4; i++)
+        uassert_int_equal(au32Done[i], asReq[i].m_u32Len);
+
+    /* 13 segments, a batch never starts with a finished request. */
+    uassert_int_equal(i32Batches, 4);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    pu8Src = rt_malloc_align(MEMQ_TC_BUF_SIZE * 3, 4);
+    if (pu8Src == RT_NULL)
+        return -RT_ENOMEM;
+
+    pu8Dst = pu8Src + MEMQ_TC_BUF_SIZE;
+    pu8Expect = pu8Dst + MEMQ_TC_BUF_SIZE;
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free_align(pu8Src);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_memq_width);
+    UTEST_UNIT_RUN(test_memq_max_txcnt);
+    UTEST_UNIT_RUN(test_memq_memset);
+    UTEST_UNIT_RUN(test_memq_batch);
+}
+UTEST_TC_EXPORT(testcase, UTEST_CMD_PREFIX "pdma_memq", utest_tc_init, utest_tc_cleanup, 10);
+
+#endif /* #if defined(BSP_PDMA_MEMQ_TC) */
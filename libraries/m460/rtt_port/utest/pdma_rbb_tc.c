@@ -0,0 +1,361 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent            First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_PDMA_RBB_TC)
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "drv_pdma.h"
+#include "utest.h"
+
+#if !defined(UTEST_CMD_PREFIX)
+    #define UTEST_CMD_PREFIX    "bsp.nuvoton.utest."
+#endif
+
+#define RBB_TC_BUF_SIZE         4096
+#define RBB_TC_BLK_MAX          16
+#define RBB_TC_ROUNDS           2000
+#define RBB_TC_STREAM_BYTES     (64 * 1024)
+#define RBB_TC_TIMEOUT          rt_tick_from_millisecond(1000)
+
+static int i32ChannID = -1;
+static nu_pdma_desc_t apsSgtbls[NU_PDMA_RBB_SGTBL_NUM];
+static rt_uint8_t *pu8Stream;
+static rt_size_t u32StreamLen;
+
+static rt_uint32_t rbb_tc_rand(rt_uint32_t *pu32Seed)
+{
+    *pu32Seed = *pu32Seed * 1103515245 + 12345;
+
+    return *pu32Seed >> 16;
+}
+
+static nu_pdma_desc_t rbb_tc_desc_next(nu_pdma_desc_t psDesc)
+{
+    PDMA_T *PDMA = (i32ChannID >= PDMA_CH_MAX) ? PDMA1 : PDMA0;
+
+    return (nu_pdma_desc_t)(PDMA->SCATBA + psDesc->NEXT);
+}
+
+/*
+ * Run a descriptor chain in software, as the M2P channel would do it: append
+ * what each descriptor reads into the stream. Return the descriptor count.
+ */
+static int rbb_tc_desc_run(uint32_t u32DataWidth, uint32_t u32AddrPeriph, int i32SgtblCnt)
+{
+    nu_pdma_desc_t psDesc = apsSgtbls[0];
+    uint32_t u32WidthBytes = u32DataWidth / 8;
+    uint32_t u32Width, u32TXCnt;
+    int i;
+
+    u32Width = (u32DataWidth == 8) ? PDMA_WIDTH_8 : (u32DataWidth == 16) ? PDMA_WIDTH_16 : PDMA_WIDTH_32;
+
+    for (i = 0; i < i32SgtblCnt; i++)
+    {
+        int bIsLast = ((i + 1) == i32SgtblCnt);
+
+        if (psDesc != apsSgtbls[i] ||
+                psDesc->DA != u32AddrPeriph ||
+                (psDesc->CTL & PDMA_DSCT_CTL_TXWIDTH_Msk) != u32Width ||
+                (psDesc->CTL & PDMA_DSCT_CTL_DAINC_Msk) != PDMA_DAR_FIX ||
+                (psDesc->CTL & PDMA_DSCT_CTL_SAINC_Msk) != PDMA_SAR_INC)
+            return -RT_ERROR;
+
+        /* Linked in order, only the last one raises transfer-done interrupt. */
+        if (bIsLast != ((psDesc->CTL & PDMA_DSCT_CTL_OPMODE_Msk) == PDMA_OP_BASIC) ||
+                bIsLast == ((psDesc->CTL & PDMA_DSCT_CTL_TBINTDIS_Msk) != 0))
+            return -RT_ERROR;
+
+        u32TXCnt = ((psDesc->CTL & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1;
+        if (u32StreamLen + u32TXCnt * u32WidthBytes > RBB_TC_BUF_SIZE * 2)
+            return -RT_ERROR;
+
+        rt_memcpy(&pu8Stream[u32StreamLen], (void *)psDesc->SA, u32TXCnt * u32WidthBytes);
+        u32StreamLen += u32TXCnt * u32WidthBytes;
+
+        if (!bIsLast)
+            psDesc = rbb_tc_desc_next(psDesc);
+    }
+
+    return i;
+}
+
+static void test_pdma_rbb_sg_build(void)
+{
+    struct rt_rbb_blk_queue asBlkQueue[NU_PDMA_RBB_QUEUE_MAX];
+    uint32_t u32AddrPeriph = (uint32_t)&u32StreamLen;
+    rt_rbb_blk_t psBlk;
+    rt_rbb_t psRbb;
+    int i32SgtblCnt;
+
+    psRbb = rt_rbb_create(RBB_TC_BUF_SIZE, RBB_TC_BLK_MAX);
+    uassert_not_null(psRbb);
+    if (psRbb == RT_NULL)
+        return;
+
+    /* Two blocks in one queue, one descriptor. */
+    rt_rbb_blk_put(rt_rbb_blk_alloc(psRbb, 48));
+    rt_rbb_blk_put(rt_rbb_blk_alloc(psRbb, 16));
+    uassert_int_equal(rt_rbb_blk_queue_get(psRbb, RBB_TC_BUF_SIZE, &asBlkQueue[0]), 64);
+
+    i32SgtblCnt = nu_pdma_rbb_sg_build(i32ChannID, 8, u32AddrPeriph, asBlkQueue, 1, apsSgtbls, NU_PDMA_RBB_SGTBL_NUM);
+    uassert_int_equal(i32SgtblCnt, 1);
+    u32StreamLen = 0;
+    uassert_int_equal(rbb_tc_desc_run(8, u32AddrPeriph, i32SgtblCnt), 1);
+    uassert_int_equal(u32StreamLen, 64);
+
+    i32SgtblCnt = nu_pdma_rbb_sg_build(i32ChannID, 32, u32AddrPeriph, asBlkQueue, 1, apsSgtbls, NU_PDMA_RBB_SGTBL_NUM);
+    uassert_int_equal(i32SgtblCnt, 1);
+    uassert_int_equal(((apsSgtbls[0]->CTL & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1, 16);
+
+    /* Not enough descriptors, nothing is linked. */
+    uassert_int_equal(nu_pdma_rbb_sg_build(i32ChannID, 8, u32AddrPeriph, asBlkQueue, 1, apsSgtbls, 0), -RT_EFULL);
+    rt_rbb_blk_queue_free(psRbb, &asBlkQueue[0]);
+
+    /* A length not aligned to the data width. */
+    psBlk = rt_rbb_blk_alloc(psRbb, 6);
+    rt_rbb_blk_put(psBlk);
+    uassert_int_equal(rt_rbb_blk_queue_get(psRbb, RBB_TC_BUF_SIZE, &asBlkQueue[0]), 6);
+    uassert_int_equal(nu_pdma_rbb_sg_build(i32ChannID, 32, u32AddrPeriph, asBlkQueue, 1, apsSgtbls, NU_PDMA_RBB_SGTBL_NUM), -RT_EINVAL);
+    rt_rbb_blk_queue_free(psRbb, &asBlkQueue[0]);
+
+    /* Nothing to transfer. */
+    uassert_int_equal(nu_pdma_rbb_sg_build(i32ChannID, 8, u32AddrPeriph, asBlkQueue, 0, apsSgtbls, NU_PDMA_RBB_SGTBL_NUM), 0);
+
+    rt_rbb_destroy(psRbb);
+}
+
+/*
+ * Random producer and consumer over a small ring: the consumer takes the blocks
+ * before and after the wraparound in two queues, as nu_pdma_rbb_kick() does, and
+ * the chains must carry the byte stream intact and in order.
+ */
+static void test_pdma_rbb_sg_wrap(void)
+{
+    static const uint32_t au32Width[] = { 8, 16, 32 };
+    struct rt_rbb_blk_queue asBlkQueue[NU_PDMA_RBB_QUEUE_MAX];
+    uint32_t u32AddrPeriph = (uint32_t)&u32StreamLen;
+    uint32_t u32Seed = 1, u32PutSeq, u32GetSeq, u32Wraps;
+    rt_size_t u32Len, u32Size, k;
+    rt_rbb_blk_t psBlk;
+    rt_rbb_t psRbb;
+    int i, j, n, i32QueueNum, i32SgtblCnt;
+
+    psRbb = rt_rbb_create(RBB_TC_BUF_SIZE, RBB_TC_BLK_MAX);
+    uassert_not_null(psRbb);
+    if (psRbb == RT_NULL)
+        return;
+
+    for (j = 0; j < sizeof(au32Width) / sizeof(au32Width[0]); j++)
+    {
+        u32PutSeq = u32GetSeq = u32Wraps = 0;
+
+        for (i = 0; i < RBB_TC_ROUNDS; i++)
+        {
+            /* Put some blocks of 1..60 units. */
+            for (n = rbb_tc_rand(&u32Seed) % 6; n > 0; n--)
+            {
+                u32Size = (rbb_tc_rand(&u32Seed) % 60 + 1) * (au32Width[j] / 8);
+                if ((psBlk = rt_rbb_blk_alloc(psRbb, u32Size)) == RT_NULL)
+                    break;
+
+                for (k = 0; k < u32Size; k++)
+                    psBlk->buf[k] = (rt_uint8_t)u32PutSeq++;
+                rt_rbb_blk_put(psBlk);
+            }
+
+            /*
+             * The consumer lags behind now and then and takes part of the blocks,
+             * as the descriptors limit it, so the ring is not drained to its start
+             * and the queues span the wraparound.
+             */
+            if (rbb_tc_rand(&u32Seed) % 3 == 0)
+                continue;
+
+            u32Len = rbb_tc_rand(&u32Seed) % (RBB_TC_BUF_SIZE / 2) + 1;
+            for (i32QueueNum = 0; i32QueueNum < NU_PDMA_RBB_QUEUE_MAX; i32QueueNum++)
+            {
+                if (rt_rbb_blk_queue_get(psRbb, u32Len, &asBlkQueue[i32QueueNum]) == 0)
+                    break;
+            }
+            if (i32QueueNum == 0)
+                continue;
+            else if (i32QueueNum > 1)
+                u32Wraps++;
+
+            i32SgtblCnt = nu_pdma_rbb_sg_build(i32ChannID, au32Width[j], u32AddrPeriph, asBlkQueue, i32QueueNum,
+                                               apsSgtbls, NU_PDMA_RBB_SGTBL_NUM);
+
+            u32StreamLen = 0;
+            if (i32SgtblCnt != i32QueueNum || rbb_tc_desc_run(au32Width[j], u32AddrPeriph, i32SgtblCnt) != i32SgtblCnt)
+            {
+                LOG_E("width %d, round %d: %d queues, %d descriptors", au32Width[j], i, i32QueueNum, i32SgtblCnt);
+                uassert_true(RT_FALSE);
+                goto exit_test_pdma_rbb_sg_wrap;
+            }
+
+            for (u32Len = 0, n = 0; n < i32QueueNum; n++)
+                u32Len += rt_rbb_blk_queue_len(&asBlkQueue[n]);
+            uassert_int_equal(u32StreamLen, u32Len);
+
+            for (k = 0; k < u32StreamLen; k++)
+            {
+                if (pu8Stream[k] != (rt_uint8_t)u32GetSeq++)
+                {
+                    LOG_E("width %d, round %d: byte %d is 0x%02x", au32Width[j], i, k, pu8Stream[k]);
+                    uassert_true(RT_FALSE);
+                    goto exit_test_pdma_rbb_sg_wrap;
+                }
+            }
+
+            for (n = 0; n < i32QueueNum; n++)
+                rt_rbb_blk_queue_free(psRbb, &asBlkQueue[n]);
+        }
+
+        /* Drain the ring. */
+        while (rt_rbb_blk_queue_get(psRbb, RBB_TC_BUF_SIZE, &asBlkQueue[0]))
+        {
+            u32GetSeq += rt_rbb_blk_queue_len(&asBlkQueue[0]);
+            rt_rbb_blk_queue_free(psRbb, &asBlkQueue[0]);
+        }
+
+        LOG_I("width %d: %d bytes, %d transfers across the wraparound", au32Width[j], u32PutSeq, u32Wraps);
+        uassert_int_equal(u32GetSeq, u32PutSeq);
+        uassert_true(u32Wraps > 0);
+    }
+
+exit_test_pdma_rbb_sg_wrap:
+
+    rt_rbb_destroy(psRbb);
+}
+
+static struct rt_semaphore sRbbDone;
+static rt_size_t u32RbbDoneLen;
+static uint32_t u32RbbDoneEvents;
+static volatile uint8_t u8RbbSink;
+
+static void rbb_tc_done(void *pvUserData, uint32_t u32Events, rt_size_t u32Len)
+{
+    u32RbbDoneEvents |= u32Events;
+    u32RbbDoneLen += u32Len;
+    rt_sem_release(&sRbbDone);
+}
+
+/* Stream blocks to a fixed address by PDMA, blocks come back from the completion interrupt. */
+static void test_pdma_rbb_stream(void)
+{
+    struct nu_pdma_rbb sPdmaRbb;
+    rt_size_t u32Put = 0, u32Size, k;
+    uint32_t u32Seed = 7;
+    uint8_t u8Last = 0;
+    rt_rbb_blk_t psBlk;
+    rt_rbb_t psRbb;
+    rt_tick_t start;
+
+    psRbb = rt_rbb_create(RBB_TC_BUF_SIZE, RBB_TC_BLK_MAX);
+    uassert_not_null(psRbb);
+    if (psRbb == RT_NULL)
+        return;
+
+    u32RbbDoneLen = 0;
+    u32RbbDoneEvents = 0;
+    rt_sem_init(&sRbbDone, "rbbtc", 0, RT_IPC_FLAG_FIFO);
+
+    uassert_int_equal(nu_pdma_rbb_open(&sPdmaRbb, psRbb, i32ChannID, 8, (uint32_t)&u8RbbSink, rbb_tc_done, RT_NULL), RT_EOK);
+
+    start = rt_tick_get();
+    while (u32Put < RBB_TC_STREAM_BYTES)
+    {
+        u32Size = rbb_tc_rand(&u32Seed) % 1024 + 1;
+        if ((psBlk = rt_rbb_blk_alloc(psRbb, u32Size)) == RT_NULL)
+        {
+            /* The ring is full, wait for a completion. */
+            if (rt_sem_take(&sRbbDone, RBB_TC_TIMEOUT) != RT_EOK)
+                break;
+            continue;
+        }
+
+        for (k = 0; k < u32Size; k++)
+            psBlk->buf[k] = u8Last = (uint8_t)(u32Put + k);
+        rt_rbb_blk_put(psBlk);
+        u32Put += u32Size;
+
+        uassert_int_equal(nu_pdma_rbb_kick(&sPdmaRbb), RT_EOK);
+    }
+
+    while (u32RbbDoneLen < u32Put)
+    {
+        if (rt_sem_take(&sRbbDone, RBB_TC_TIMEOUT) != RT_EOK)
+            break;
+    }
+
+    LOG_I("stream: %d bytes in %d ms", u32RbbDoneLen, (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND);
+    uassert_int_equal(u32RbbDoneLen, u32Put);
+    uassert_int_equal(u32RbbDoneEvents & NU_PDMA_EVENT_ABORT, 0);
+    uassert_int_equal(u8RbbSink, u8Last);
+
+    /* Every block is back in the ring. */
+    psBlk = rt_rbb_blk_alloc(psRbb, RBB_TC_BUF_SIZE);
+    uassert_not_null(psBlk);
+    if (psBlk)
+        rt_rbb_blk_free(psRbb, psBlk);
+
+    nu_pdma_rbb_close(&sPdmaRbb);
+    rt_sem_detach(&sRbbDone);
+    rt_rbb_destroy(psRbb);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    i32ChannID = nu_pdma_channel_allocate(PDMA_MEM);
+    if (i32ChannID < 0)
+        return -RT_ERROR;
+
+    /* The memory channel stands for an M2P channel, a fixed destination. */
+    if (nu_pdma_channel_memctrl_set(i32ChannID, eMemCtl_SrcInc_DstFix) != RT_EOK ||
+            nu_pdma_sgtbls_allocate(&apsSgtbls[0], NU_PDMA_RBB_SGTBL_NUM) != RT_EOK)
+    {
+        nu_pdma_channel_free(i32ChannID);
+        return -RT_ERROR;
+    }
+
+    pu8Stream = rt_malloc(RBB_TC_BUF_SIZE * 2);
+    if (pu8Stream == RT_NULL)
+    {
+        nu_pdma_sgtbls_free(&apsSgtbls[0], NU_PDMA_RBB_SGTBL_NUM);
+        nu_pdma_channel_free(i32ChannID);
+        return -RT_ENOMEM;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(pu8Stream);
+    nu_pdma_sgtbls_free(&apsSgtbls[0], NU_PDMA_RBB_SGTBL_NUM);
+    nu_pdma_channel_free(i32ChannID);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_pdma_rbb_sg_build);
+    UTEST_UNIT_RUN(test_pdma_rbb_sg_wrap);
+    UTEST_UNIT_RUN(test_pdma_rbb_stream);
+}
+UTEST_TC_EXPORT(testcase, UTEST_CMD_PREFIX "pdma_rbb", utest_tc_init, utest_tc_cleanup, 30);
+
+#endif /* #if defined(BSP_PDMA_RBB_TC) */
@@ -0,0 +1,173 @@
+/**************************************************************************//**
+*
+* @copyright (C) 2020 Nuvoton Technology Corp. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Change Logs:
+* Date            Author       Notes
+* 2026-10-17      agent            First version
+*
+******************************************************************************/
+
+#include <rtconfig.h>
+
+#if defined(BSP_UART_PDMA_LOOPBACK_TC)
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+#if !defined(UTEST_CMD_PREFIX)
+    #define UTEST_CMD_PREFIX    "bsp.nuvoton.utest."
+#endif
+
+#define LOOPBACK_BAUD_RATE      BAUD_RATE_921600
+#define LOOPBACK_LENGTH         (16 * 1024)
+#define LOOPBACK_TIMEOUT        rt_tick_from_millisecond(2000)
+
+static struct rt_serial_device *serial;
+static struct rt_semaphore rx_sem;
+static rt_uint8_t *tx_buf, *rx_buf;
+
+static rt_err_t loopback_rx_ind(rt_device_t dev, rt_size_t size)
+{
+    rt_sem_release(&rx_sem);
+
+    return RT_EOK;
+}
+
+static void loopback_check(const char *name, rt_size_t length, rt_tick_t elapsed)
+{
+    rt_size_t i;
+
+    uassert_int_equal(length, LOOPBACK_LENGTH);
+    for (i = 0; i < length; i++)
+    {
+        if (rx_buf[i] != tx_buf[i])
+        {
+            LOG_E("%s: byte %d is 0x%02x, 0x%02x sent", name, i, rx_buf[i], tx_buf[i]);
+            uassert_true(RT_FALSE);
+            break;
+        }
+    }
+
+    if (elapsed == 0)
+        elapsed = 1;
+    LOG_I("%s: %d bytes in %d ms, %d bytes/s", name, length,
+          elapsed * 1000 / RT_TICK_PER_SECOND, length * RT_TICK_PER_SECOND / elapsed);
+}
+
+#if !defined(BSP_USING_UART_RX_ZEROCOPY)
+/* PDMA TX and RX into the serial rx fifo, rt_device_read copies out */
+static void test_uart_pdma_loopback_copy(void)
+{
+    rt_size_t received = 0, length;
+    rt_tick_t start;
+
+    rt_memset(rx_buf, 0, LOOPBACK_LENGTH);
+
+    start = rt_tick_get();
+    uassert_int_equal(rt_device_write(&serial->parent, 0, tx_buf, LOOPBACK_LENGTH), LOOPBACK_LENGTH);
+
+    while (received < LOOPBACK_LENGTH)
+    {
+        length = rt_device_read(&serial->parent, 0, rx_buf + received, LOOPBACK_LENGTH - received);
+        if (length == 0 && rt_sem_take(&rx_sem, LOOPBACK_TIMEOUT) != RT_EOK)
+            break;
+        received += length;
+    }
+
+    loopback_check("copy", received, rt_tick_get() - start);
+}
+#else
+/* PDMA TX and RX into the scatter-gather blocks, the received data is lent in place */
+static void test_uart_pdma_loopback_zerocopy(void)
+{
+    rt_size_t received = 0, length;
+    rt_uint8_t *buffer;
+    rt_tick_t start;
+
+    rt_memset(rx_buf, 0, LOOPBACK_LENGTH);
+
+    start = rt_tick_get();
+    uassert_int_equal(rt_device_write(&serial->parent, 0, tx_buf, LOOPBACK_LENGTH), LOOPBACK_LENGTH);
+
+    while (received < LOOPBACK_LENGTH)
+    {
+        length = rt_serial_rx_buffer_get(serial, &buffer, LOOPBACK_TIMEOUT);
+        if (length == 0)
+            break;
+        if (length > LOOPBACK_LENGTH - received)
+            length = LOOPBACK_LENGTH - received;
+
+        rt_memcpy(rx_buf + received, buffer, length);
+        /* -RT_EFULL, PDMA overran the data while it was lent */
+        uassert_int_equal(rt_serial_rx_buffer_release(serial, buffer, length), RT_EOK);
+        received += length;
+    }
+
+    loopback_check("zero-copy", received, rt_tick_get() - start);
+}
+#endif
+
+static rt_err_t utest_tc_init(void)
+{
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    rt_size_t i;
+
+    serial = (struct rt_serial_device *)rt_device_find(BSP_UART_PDMA_LOOPBACK_DEVNAME);
+    if (serial == RT_NULL)
+    {
+        LOG_E("%s not found", BSP_UART_PDMA_LOOPBACK_DEVNAME);
+        return -RT_ERROR;
+    }
+
+    tx_buf = rt_malloc(LOOPBACK_LENGTH * 2);
+    if (tx_buf == RT_NULL)
+        return -RT_ENOMEM;
+    rx_buf = tx_buf + LOOPBACK_LENGTH;
+
+    /* not a multiple of the block size, a pattern that shows shifted data */
+    for (i = 0; i < LOOPBACK_LENGTH; i++)
+        tx_buf[i] = (rt_uint8_t)(i * 7 + (i >> 8));
+
+    rt_sem_init(&rx_sem, "lpbk", 0, RT_IPC_FLAG_FIFO);
+
+    config.baud_rate = LOOPBACK_BAUD_RATE;
+    config.bufsz = serial->config.bufsz;
+    rt_device_control(&serial->parent, RT_DEVICE_CTRL_CONFIG, &config);
+
+    if (rt_device_open(&serial->parent, RT_DEVICE_FLAG_DMA_RX | RT_DEVICE_FLAG_DMA_TX) != RT_EOK)
+    {
+        LOG_E("%s can't be opened with PDMA TX and RX", BSP_UART_PDMA_LOOPBACK_DEVNAME);
+        rt_sem_detach(&rx_sem);
+        rt_free(tx_buf);
+        return -RT_ERROR;
+    }
+    rt_device_set_rx_indicate(&serial->parent, loopback_rx_ind);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_device_set_rx_indicate(&serial->parent, RT_NULL);
+    rt_device_close(&serial->parent);
+    rt_sem_detach(&rx_sem);
+    rt_free(tx_buf);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+#if defined(BSP_USING_UART_RX_ZEROCOPY)
+    UTEST_UNIT_RUN(test_uart_pdma_loopback_zerocopy);
+#else
+    UTEST_UNIT_RUN(test_uart_pdma_loopback_copy);
+#endif
+}
+UTEST_TC_EXPORT(testcase, UTEST_CMD_PREFIX "uart_pdma_loopback", utest_tc_init, utest_tc_cleanup, 30);
+
+#endif /* #if defined(BSP_UART_PDMA_LOOPBACK_TC) */
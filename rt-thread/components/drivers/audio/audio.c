@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2017-05-09     Urey         first version
  * 2019-07-09     Zero-Free    improve device ops interface and data flows
+ * 2026-10-17     agent        fetch and free replay blocks in batch
  */
 
 #include <stdio.h>
@@ -22,6 +23,13 @@
 #define MIN(a, b)         ((a) < (b) ? (a) : (b))
 #endif
 
+/* the max number of replay blocks fetched from replay queue at one time */
+#if RT_AUDIO_REPLAY_MP_BLOCK_COUNT < 4
+#define AUDIO_REPLAY_BATCH_NR   RT_AUDIO_REPLAY_MP_BLOCK_COUNT
+#else
+#define AUDIO_REPLAY_BATCH_NR   4
+#endif
+
 enum
 {
     REPLAY_EVT_NONE  = 0x00,
@@ -29,12 +37,37 @@ enum
     REPLAY_EVT_STOP  = 0x02,
 };
 
+/* release the replay blocks consumed, they are at the head of replay queue */
+static void _audio_release_replay_blocks(struct rt_audio_device *audio, rt_uint16_t count)
+{
+    const void *data[AUDIO_REPLAY_BATCH_NR];
+    rt_size_t size[AUDIO_REPLAY_BATCH_NR];
+    rt_ssize_t nr, i;
+
+    if (count == 0)
+        return;
+
+    /* pop all of them with one lock and one wakeup */
+    nr = rt_data_queue_pop_batch(&audio->replay->queue, data, size, count, RT_WAITING_NO);
+    for (i = 0; i < nr; i++)
+    {
+        /* free memory */
+        rt_mp_free((void *)data[i]);
+
+        /* notify transmitted complete. */
+        if (audio->parent.tx_complete != RT_NULL)
+            audio->parent.tx_complete(&audio->parent, (void *)data[i]);
+    }
+}
+
 static rt_err_t _audio_send_replay_frame(struct rt_audio_device *audio)
 {
     rt_err_t result = RT_EOK;
-    rt_uint8_t *data;
-    rt_size_t dst_size, src_size;
-    rt_uint16_t position, remain_bytes = 0, index = 0;
+    const void *data[AUDIO_REPLAY_BATCH_NR];
+    rt_size_t src_size[AUDIO_REPLAY_BATCH_NR];
+    rt_size_t dst_size;
+    rt_ssize_t nr;
+    rt_uint16_t position, remain_bytes = 0, index = 0, done = 0;
     struct rt_audio_buf_info *buf_info;
 
     RT_ASSERT(audio != RT_NULL);
@@ -45,7 +78,8 @@ static rt_err_t _audio_send_replay_frame(struct rt_audio_device *audio)
     dst_size = buf_info->block_size;
 
     /* check replay queue is empty */
-    if (rt_data_queue_peek(&audio->replay->queue, (const void **)&data, &src_size) != RT_EOK)
+    nr = rt_data_queue_peek_batch(&audio->replay->queue, data, src_size, AUDIO_REPLAY_BATCH_NR);
+    if (nr <= 0)
     {
         /* ack stop event */
         if (audio->replay->event & REPLAY_EVT_STOP)
@@ -64,39 +98,43 @@ static rt_err_t _audio_send_replay_frame(struct rt_audio_device *audio)
         /* copy data from memory pool to hardware device fifo */
         while (index < dst_size)
         {
-            result = rt_data_queue_peek(&audio->replay->queue, (const void **)&data, &src_size);
-            if (result != RT_EOK)
+            if (done == nr)
             {
-                LOG_D("under run %d, remain %d", audio->replay->pos, remain_bytes);
-                audio->replay->pos -= remain_bytes;
-                audio->replay->pos += dst_size;
-                audio->replay->pos %= buf_info->total_size;
-                audio->replay->read_index = 0;
-                result = -RT_EEMPTY;
-                break;
+                /* all the blocks fetched are consumed, fetch more */
+                _audio_release_replay_blocks(audio, done);
+                done = 0;
+
+                nr = rt_data_queue_peek_batch(&audio->replay->queue, data, src_size, AUDIO_REPLAY_BATCH_NR);
+                if (nr <= 0)
+                {
+                    LOG_D("under run %d, remain %d", audio->replay->pos, remain_bytes);
+                    audio->replay->pos -= remain_bytes;
+                    audio->replay->pos += dst_size;
+                    audio->replay->pos %= buf_info->total_size;
+                    audio->replay->read_index = 0;
+                    result = -RT_EEMPTY;
+                    break;
+                }
             }
 
-            remain_bytes = MIN((dst_size - index), (src_size - audio->replay->read_index));
+            remain_bytes = MIN((dst_size - index), (src_size[done] - audio->replay->read_index));
             rt_memcpy(&buf_info->buffer[audio->replay->pos],
-                   &data[audio->replay->read_index], remain_bytes);
+                   &((rt_uint8_t *)data[done])[audio->replay->read_index], remain_bytes);
 
             index += remain_bytes;
             audio->replay->read_index += remain_bytes;
             audio->replay->pos += remain_bytes;
             audio->replay->pos %= buf_info->total_size;
 
-            if (audio->replay->read_index == src_size)
+            if (audio->replay->read_index == src_size[done])
             {
-                /* free memory */
                 audio->replay->read_index = 0;
-                rt_data_queue_pop(&audio->replay->queue, (const void **)&data, &src_size, RT_WAITING_NO);
-                rt_mp_free(data);
-
-                /* notify transmitted complete. */
-                if (audio->parent.tx_complete != RT_NULL)
-                    audio->parent.tx_complete(&audio->parent, (void *)data);
+                done ++;
             }
         }
+
+        /* free the blocks consumed in this frame */
+        _audio_release_replay_blocks(audio, done);
     }
 
     if (audio->ops->transmit != RT_NULL)
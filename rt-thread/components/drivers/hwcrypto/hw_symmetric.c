@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-04-25     tyx          the first version
+ * 2026-10-17     agent        add asynchronous crypt request
  */
 
 #include <rtthread.h>
@@ -83,6 +84,83 @@ rt_err_t rt_hwcrypto_symmetric_crypt(struct rt_hwcrypto_ctx *ctx, hwcrypto_mode
     return err;
 }
 
+/**
+ * @brief           This function queues a symmetric encryption or decryption operation
+ *
+ * @param ctx       Symmetric crypto context
+ * @param req       The request, it must be kept until done
+ * @param mode      Operation mode. HWCRYPTO_MODE_ENCRYPT or HWCRYPTO_MODE_DECRYPT
+ * @param length    The length of the input data in Bytes. This must be a multiple of the block size
+ * @param in        The buffer holding the input data
+ * @param out       The buffer holding the output data
+ * @param done      Completion callback
+ * @param user_data User data of completion callback
+ *
+ * @return          RT_EOK on queued, the result is given to the callback.
+ */
+rt_err_t rt_hwcrypto_symmetric_crypt_async(struct rt_hwcrypto_ctx *ctx, struct hwcrypto_symmetric_req *req,
+        hwcrypto_mode mode, rt_size_t length, const rt_uint8_t *in, rt_uint8_t *out,
+        hwcrypto_symmetric_done_t done, void *user_data)
+{
+    struct hwcrypto_symmetric *symmetric_ctx;
+    rt_err_t err;
+
+    if (ctx == RT_NULL || req == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
+    symmetric_ctx = (struct hwcrypto_symmetric *)ctx;
+    if (symmetric_ctx->ops->crypt == RT_NULL && symmetric_ctx->ops->crypt_async == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+    if (mode != HWCRYPTO_MODE_ENCRYPT && mode != HWCRYPTO_MODE_DECRYPT)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* Request packaging */
+    req->ctx = symmetric_ctx;
+    req->info.mode = mode;
+    req->info.in = in;
+    req->info.out = out;
+    req->info.length = length;
+    req->result = -RT_EBUSY;
+    req->done = done;
+    req->user_data = user_data;
+
+    if (symmetric_ctx->ops->crypt_async != RT_NULL)
+    {
+        err = symmetric_ctx->ops->crypt_async(symmetric_ctx, req);
+    }
+    else
+    {
+        /* The hardware can't queue, finish it in place */
+        err = symmetric_ctx->ops->crypt(symmetric_ctx, &req->info);
+        rt_hwcrypto_symmetric_done(req, err);
+        err = RT_EOK;
+    }
+
+    /* clean up flags */
+    symmetric_ctx->flags &= ~(SYMMTRIC_MODIFY_KEY | SYMMTRIC_MODIFY_IV | SYMMTRIC_MODIFY_IVOFF);
+    return err;
+}
+
+/**
+ * @brief           Hardware driver usage, complete an asynchronous request
+ *
+ * @param req       The request
+ * @param result    The result of request
+ */
+void rt_hwcrypto_symmetric_done(struct hwcrypto_symmetric_req *req, rt_err_t result)
+{
+    req->result = result;
+    if (req->done != RT_NULL)
+    {
+        req->done(req, result);
+    }
+}
+
 /**
  * @brief           Set Symmetric Encryption and Decryption Key
  *
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2019-04-25     tyx          the first version
+ * 2026-10-17     agent        add asynchronous crypt request
  */
 
 #ifndef __HW_SYMMETRIC_H__
@@ -30,13 +31,18 @@ extern "C" {
 
 struct hwcrypto_symmetric;
 struct hwcrypto_symmetric_info;
+struct hwcrypto_symmetric_req;
 
 struct hwcrypto_symmetric_ops
 {
     rt_err_t (*crypt)(struct hwcrypto_symmetric *symmetric_ctx,
                       struct hwcrypto_symmetric_info *symmetric_info);  /**< Hardware Symmetric Encryption and Decryption Callback */
+    rt_err_t (*crypt_async)(struct hwcrypto_symmetric *symmetric_ctx,
+                            struct hwcrypto_symmetric_req *req);        /**< Queue a request and return, optional */
 };
 
+typedef void (*hwcrypto_symmetric_done_t)(struct hwcrypto_symmetric_req *req, rt_err_t result);
+
 /**
  * @brief           Hardware driver usage, including input and output information
  */
@@ -63,6 +69,21 @@ struct hwcrypto_symmetric
     const struct hwcrypto_symmetric_ops *ops;           /**< !! Hardware initializes this value when creating context !! */
 };
 
+/**
+ * @brief           Asynchronous request. It belongs to the caller and must be kept until done.
+ *                  The key and IV of the context must not be changed while its requests are pending.
+ */
+struct hwcrypto_symmetric_req
+{
+    rt_list_t list;                                     /**< Hardware driver usage, node of request queue */
+    struct hwcrypto_symmetric *ctx;                     /**< Symmetric crypto context */
+    struct hwcrypto_symmetric_info info;                /**< Input and output information */
+    rt_uint8_t iv_next[RT_HWCRYPTO_IV_MAX_SIZE];        /**< Hardware driver usage, the chained IV saved before running */
+    rt_err_t result;                                    /**< The result of request */
+    hwcrypto_symmetric_done_t done;                     /**< Completion callback, maybe called in interrupt context */
+    void *user_data;                                    /**< User data of completion callback */
+};
+
 /**
  * @brief           Creating Symmetric Encryption and Decryption Context
  *
@@ -95,6 +116,32 @@ void rt_hwcrypto_symmetric_destroy(struct rt_hwcrypto_ctx *ctx);
 rt_err_t rt_hwcrypto_symmetric_crypt(struct rt_hwcrypto_ctx *ctx, hwcrypto_mode mode,
                                      rt_size_t length, const rt_uint8_t *in, rt_uint8_t *out);
 
+/**
+ * @brief           This function queues a symmetric encryption or decryption operation
+ *
+ * @param ctx       Symmetric crypto context
+ * @param req       The request, it must be kept until done
+ * @param mode      Operation mode. HWCRYPTO_MODE_ENCRYPT or HWCRYPTO_MODE_DECRYPT
+ * @param length    The length of the input data in Bytes. This must be a multiple of the block size
+ * @param in        The buffer holding the input data
+ * @param out       The buffer holding the output data
+ * @param done      Completion callback
+ * @param user_data User data of completion callback
+ *
+ * @return          RT_EOK on queued, the result is given to the callback.
+ */
+rt_err_t rt_hwcrypto_symmetric_crypt_async(struct rt_hwcrypto_ctx *ctx, struct hwcrypto_symmetric_req *req,
+        hwcrypto_mode mode, rt_size_t length, const rt_uint8_t *in, rt_uint8_t *out,
+        hwcrypto_symmetric_done_t done, void *user_data);
+
+/**
+ * @brief           Hardware driver usage, complete an asynchronous request
+ *
+ * @param req       The request
+ * @param result    The result of request
+ */
+void rt_hwcrypto_symmetric_done(struct hwcrypto_symmetric_req *req, rt_err_t result);
+
 /**
  * @brief           Set Symmetric Encryption and Decryption Key
  *
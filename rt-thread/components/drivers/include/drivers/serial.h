@@ -9,6 +9,8 @@
  * 2012-05-28     bernard      change interfaces
  * 2013-02-20     bernard      use RT_SERIAL_RB_BUFSZ to define
  *                             the size of ring buffer.
+ * 2026-10-17     agent        lock-free rx fifo and rx span interface
+ * 2026-10-17     agent        zero-copy dma rx buffer interface
  */
 
 #ifndef __SERIAL_H__
@@ -111,15 +113,33 @@ struct serial_configure
 
 /*
  * Serial FIFO mode
+ *
+ * In interrupt rx mode one byte of the fifo is kept free to tell full from
+ * empty, and the bytes lost while the fifo is full are counted in overflow.
+ * The isr overwrites the oldest data by moving get_index, or with
+ * RT_SERIAL_RX_DROP_NEWEST drops the new data: the fifo is then a
+ * single-producer/single-consumer ring, put_index is only written by the
+ * isr and get_index only by the reader.
  */
 struct rt_serial_rx_fifo
 {
     /* software fifo */
     rt_uint8_t *buffer;
 
-    rt_uint16_t put_index, get_index;
+    volatile rt_uint16_t put_index, get_index;
 
     rt_bool_t is_full;
+
+    rt_uint32_t overflow;
+};
+
+/*
+ * a contiguous span of received data in the rx fifo
+ */
+struct rt_serial_rx_span
+{
+    rt_uint8_t *data;
+    rt_size_t   length;
 };
 
 struct rt_serial_tx_fifo
@@ -133,6 +153,9 @@ struct rt_serial_tx_fifo
 struct rt_serial_rx_dma
 {
     rt_bool_t activated;
+
+    /* zero-copy mode, done when new data is lent by the driver */
+    struct rt_completion completion;
 };
 
 struct rt_serial_tx_dma
@@ -165,10 +188,24 @@ struct rt_uart_ops
     int (*getc)(struct rt_serial_device *serial);
 
     rt_size_t (*dma_transmit)(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size, int direction);
+
+    /* optional, lend received dma data in place when config.bufsz != 0 */
+    rt_size_t (*rx_buf_get)(struct rt_serial_device *serial, rt_uint8_t **buf);
+    rt_err_t (*rx_buf_release)(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size);
 };
 
 void rt_hw_serial_isr(struct rt_serial_device *serial, int event);
 
+#ifdef RT_SERIAL_RX_DROP_NEWEST
+rt_size_t rt_serial_rx_span_get(struct rt_serial_device *serial, struct rt_serial_rx_span span[2]);
+void rt_serial_rx_span_release(struct rt_serial_device *serial, rt_size_t length);
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
+
+#ifdef RT_SERIAL_USING_DMA
+rt_size_t rt_serial_rx_buffer_get(struct rt_serial_device *serial, rt_uint8_t **buffer, rt_int32_t timeout);
+rt_err_t rt_serial_rx_buffer_release(struct rt_serial_device *serial, rt_uint8_t *buffer, rt_size_t length);
+#endif /* RT_SERIAL_USING_DMA */
+
 rt_err_t rt_hw_serial_register(struct rt_serial_device *serial,
                                const char              *name,
                                rt_uint32_t              flag,
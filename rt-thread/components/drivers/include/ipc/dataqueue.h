@@ -5,6 +5,7 @@
  *
  * Change Logs:
  * Date           Author       Notes
+ * 2026-10-17     agent        add batch interfaces and high water mark
  */
 #ifndef DATAQUEUE_H__
 #define DATAQUEUE_H__
@@ -15,6 +16,7 @@
 #define RT_DATAQUEUE_EVENT_POP       0x01
 #define RT_DATAQUEUE_EVENT_PUSH      0x02
 #define RT_DATAQUEUE_EVENT_LWM       0x03
+#define RT_DATAQUEUE_EVENT_HWM       0x04
 
 struct rt_data_item;
 
@@ -25,6 +27,7 @@ struct rt_data_queue
 
     rt_uint16_t size;
     rt_uint16_t lwm;
+    rt_uint16_t hwm;    /* 0 if there is no high water mark */
 
     rt_uint16_t get_index : 15;
     rt_uint16_t is_empty  : 1;
@@ -58,6 +61,23 @@ rt_err_t rt_data_queue_pop(struct rt_data_queue *queue,
 rt_err_t rt_data_queue_peek(struct rt_data_queue *queue,
                             const void          **data_ptr,
                             rt_size_t            *size);
+rt_ssize_t rt_data_queue_push_batch(struct rt_data_queue *queue,
+                                    const void          **data_ptr,
+                                    const rt_size_t      *data_size,
+                                    rt_uint16_t           count,
+                                    rt_int32_t            timeout);
+rt_ssize_t rt_data_queue_pop_batch(struct rt_data_queue *queue,
+                                   const void          **data_ptr,
+                                   rt_size_t            *size,
+                                   rt_uint16_t           count,
+                                   rt_int32_t            timeout);
+rt_ssize_t rt_data_queue_peek_batch(struct rt_data_queue *queue,
+                                    const void          **data_ptr,
+                                    rt_size_t            *size,
+                                    rt_uint16_t           count);
+void rt_data_queue_set_watermark(struct rt_data_queue *queue,
+                                 rt_uint16_t           lwm,
+                                 rt_uint16_t           hwm);
 void rt_data_queue_reset(struct rt_data_queue *queue);
 rt_err_t rt_data_queue_deinit(struct rt_data_queue *queue);
 rt_uint16_t rt_data_queue_len(struct rt_data_queue *queue);
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        first version
+ */
+#ifndef RINGBUFFER32_H__
+#define RINGBUFFER32_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <rtthread.h>
+
+/* ring buffer with 32 bit index */
+struct rt_ringbuffer32
+{
+    rt_uint8_t *buffer_ptr;
+    /* The read_index is only written by the consumer and the write_index is
+     * only written by the producer, so one producer and one consumer could
+     * work on the buffer at the same time without any lock, also from
+     * different cores: the data and the indexes are ordered by rt_hw_dmb().
+     *
+     * When the buffer size is a power of two, the indexes are free running
+     * and wrap around naturally at 2^32, the offset in buffer is taken by
+     * index_mask. Otherwise the indexes run in [0, 2 * buffer_size), which
+     * is the same idea as the mirror bit of struct rt_ringbuffer: the same
+     * offset in a different lap means full, in the same lap means empty. */
+    volatile rt_uint32_t read_index;
+    volatile rt_uint32_t write_index;
+    rt_uint32_t buffer_size;
+    /* buffer_size - 1 in power-of-two mode, 0 otherwise. */
+    rt_uint32_t index_mask;
+};
+
+/**
+ * RingBuffer with 32 bit index for large buffers
+ *
+ * Please note that it has no thread wait or resume feature, and it is
+ * single-producer/single-consumer: the put side and the get side must
+ * each be called from one context only.
+ */
+void rt_ringbuffer32_init(struct rt_ringbuffer32 *rb, rt_uint8_t *pool, rt_uint32_t size);
+void rt_ringbuffer32_reset(struct rt_ringbuffer32 *rb);
+rt_size_t rt_ringbuffer32_put(struct rt_ringbuffer32 *rb, const rt_uint8_t *ptr, rt_uint32_t length);
+rt_size_t rt_ringbuffer32_putchar(struct rt_ringbuffer32 *rb, const rt_uint8_t ch);
+rt_size_t rt_ringbuffer32_get(struct rt_ringbuffer32 *rb, rt_uint8_t *ptr, rt_uint32_t length);
+rt_size_t rt_ringbuffer32_getchar(struct rt_ringbuffer32 *rb, rt_uint8_t *ch);
+rt_size_t rt_ringbuffer32_data_len(struct rt_ringbuffer32 *rb);
+rt_size_t rt_ringbuffer32_space_len(struct rt_ringbuffer32 *rb);
+
+/* producer side span, fill the returned span in place then commit it */
+rt_size_t rt_ringbuffer32_put_peek(struct rt_ringbuffer32 *rb, rt_uint8_t **ptr);
+void rt_ringbuffer32_put_commit(struct rt_ringbuffer32 *rb, rt_uint32_t length);
+/* consumer side span, use the returned span in place then commit it */
+rt_size_t rt_ringbuffer32_get_peek(struct rt_ringbuffer32 *rb, rt_uint8_t **ptr);
+void rt_ringbuffer32_get_commit(struct rt_ringbuffer32 *rb, rt_uint32_t length);
+
+#ifdef RT_USING_HEAP
+struct rt_ringbuffer32 *rt_ringbuffer32_create(rt_uint32_t size);
+void rt_ringbuffer32_destroy(struct rt_ringbuffer32 *rb);
+#endif
+
+/**
+ * @brief Get the buffer size of the ring buffer object.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ *
+ * @return  Buffer size.
+ */
+rt_inline rt_uint32_t rt_ringbuffer32_get_size(struct rt_ringbuffer32 *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+    return rb->buffer_size;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
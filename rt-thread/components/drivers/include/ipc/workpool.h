@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        first version
+ */
+#ifndef WORKPOOL_H__
+#define WORKPOOL_H__
+
+#include <rtthread.h>
+#include "workqueue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef RT_USING_WORKPOOL
+
+#ifndef RT_WORKPOOL_CLASS_NUM
+#define RT_WORKPOOL_CLASS_NUM           3
+#endif
+
+/**
+ * work pool priority classes, the smaller the value the higher the class.
+ */
+enum
+{
+    RT_WORKPOOL_CLASS_HIGH   = 0,
+    RT_WORKPOOL_CLASS_NORMAL = (RT_WORKPOOL_CLASS_NUM - 1) / 2,
+    RT_WORKPOOL_CLASS_LOW    = RT_WORKPOOL_CLASS_NUM - 1,
+};
+
+struct rt_workpool;
+
+/* worker of work pool, each worker owns a queue per priority class */
+struct rt_workpool_worker
+{
+    rt_list_t work_list[RT_WORKPOOL_CLASS_NUM];
+    struct rt_work *work_current;   /* current work */
+
+    rt_thread_t work_thread;
+    struct rt_workpool *pool;
+
+    rt_uint32_t executed;           /* number of executed works */
+    rt_uint32_t stolen;             /* number of works stolen from other workers */
+};
+
+/* work pool implementation */
+struct rt_workpool
+{
+    char name[RT_NAME_MAX];
+    rt_list_t list;                 /* node of work pool list */
+    rt_list_t delayed_list;
+
+    struct rt_semaphore sem;        /* work completion for cancel_work_sync */
+    rt_uint16_t sync_waiting;       /* number of threads waiting on sem */
+
+    rt_uint16_t worker_num;
+    rt_uint16_t worker_next;        /* round robin worker for outside submission */
+    struct rt_workpool_worker *workers;
+
+    rt_tick_t delay_max;            /* max queueing delay in ticks */
+    rt_uint64_t delay_sum;          /* sum of queueing delay in ticks */
+};
+
+/**
+ * WorkPool for DeviceDriver
+ */
+struct rt_workpool *rt_workpool_create(const char *name, rt_uint16_t worker_num,
+                                       rt_uint16_t stack_size, rt_uint8_t priority);
+rt_err_t rt_workpool_destroy(struct rt_workpool *pool);
+rt_err_t rt_workpool_dowork(struct rt_workpool *pool, struct rt_work *work);
+rt_err_t rt_workpool_submit_work(struct rt_workpool *pool, struct rt_work *work,
+                                 rt_uint8_t work_class, rt_tick_t ticks);
+rt_err_t rt_workpool_cancel_work(struct rt_workpool *pool, struct rt_work *work);
+rt_err_t rt_workpool_cancel_work_sync(struct rt_workpool *pool, struct rt_work *work);
+rt_err_t rt_workpool_cancel_all_work(struct rt_workpool *pool);
+
+#endif /* RT_USING_WORKPOOL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
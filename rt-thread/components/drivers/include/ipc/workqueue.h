@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2021-08-01     Meco Man     remove rt_delayed_work_init() and rt_delayed_work structure
  * 2021-08-14     Jackistang   add comments for rt_work_init()
+ * 2026-10-17     agent        add work pool fields to rt_work
  */
 #ifndef WORKQUEUE_H__
 #define WORKQUEUE_H__
@@ -52,6 +53,11 @@ struct rt_work
     rt_uint16_t type;
     struct rt_timer timer;
     struct rt_workqueue *workqueue;
+#ifdef RT_USING_WORKPOOL
+    struct rt_workpool *workpool;   /* work pool the work is submitted to */
+    rt_tick_t enqueue_tick;         /* tick when the work became ready */
+    rt_uint8_t work_class;          /* priority class in the work pool */
+#endif /* RT_USING_WORKPOOL */
 };
 
 #ifdef RT_USING_HEAP
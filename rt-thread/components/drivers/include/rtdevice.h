@@ -7,6 +7,8 @@
  * Date           Author       Notes
  * 2012-01-08     bernard      first version.
  * 2014-07-12     bernard      Add workqueue implementation.
+ * 2026-10-17     agent        Add ringbuffer with 32 bit index.
+ * 2026-10-17     agent        Add work pool.
  */
 
 #ifndef __RT_DEVICE_H__
@@ -15,9 +17,11 @@
 #include <rtthread.h>
 
 #include "ipc/ringbuffer.h"
+#include "ipc/ringbuffer32.h"
 #include "ipc/completion.h"
 #include "ipc/dataqueue.h"
 #include "ipc/workqueue.h"
+#include "ipc/workpool.h"
 #include "ipc/waitqueue.h"
 #include "ipc/pipe.h"
 #include "ipc/poll.h"
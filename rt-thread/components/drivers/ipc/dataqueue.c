@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2012-09-30     Bernard      first version.
  * 2016-10-31     armink       fix some resume push and pop thread bugs
+ * 2026-10-17     agent        add batch interfaces and high water mark
  */
 
 #include <rtthread.h>
@@ -21,6 +22,78 @@ struct rt_data_item
     rt_size_t data_size;
 };
 
+/* the number of data in queue, interrupt must be disabled */
+rt_inline rt_uint16_t _data_queue_len(struct rt_data_queue *queue)
+{
+    if (queue->is_empty)
+        return 0;
+
+    if (queue->put_index > queue->get_index)
+        return queue->put_index - queue->get_index;
+
+    return queue->size + queue->put_index - queue->get_index;
+}
+
+/*
+ * suspend the current thread on a waiting list of queue until it's resumed
+ * or timeout. Interrupt is disabled on entry and on return, the level is
+ * updated with the one disabled again.
+ */
+static rt_err_t _data_queue_wait(rt_list_t *list, rt_int32_t timeout, rt_base_t *level)
+{
+    rt_thread_t thread;
+
+    thread = rt_thread_self();
+
+    /* reset thread error number */
+    thread->error = RT_EOK;
+
+    /* suspend thread on the list */
+    rt_thread_suspend(thread);
+    rt_list_insert_before(list, &(thread->tlist));
+    /* start timer */
+    if (timeout > 0)
+    {
+        /* reset the timeout of thread timer and start it */
+        rt_timer_control(&(thread->thread_timer),
+                         RT_TIMER_CTRL_SET_TIME,
+                         &timeout);
+        rt_timer_start(&(thread->thread_timer));
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(*level);
+
+    /* do schedule */
+    rt_schedule();
+
+    /* thread is waked up */
+    *level = rt_hw_interrupt_disable();
+
+    return thread->error;
+}
+
+/*
+ * resume at most number threads on a waiting list of queue, interrupt must
+ * be disabled. Return the number of resumed threads.
+ */
+static rt_uint16_t _data_queue_wakeup(rt_list_t *list, rt_uint16_t number)
+{
+    rt_uint16_t resumed = 0;
+    rt_thread_t thread;
+
+    while (resumed < number && !rt_list_isempty(list))
+    {
+        thread = rt_list_entry(list->next, struct rt_thread, tlist);
+
+        /* resume it, it will be removed from the list */
+        rt_thread_resume(thread);
+        resumed ++;
+    }
+
+    return resumed;
+}
+
 /**
  * @brief    This function will initialize the data queue. Calling this function will
  *           initialize the data queue control block and set the notification callback function.
@@ -52,6 +125,7 @@ rt_data_queue_init(struct rt_data_queue *queue,
     queue->magic = DATAQUEUE_MAGIC;
     queue->size = size;
     queue->lwm = lwm;
+    queue->hwm = 0;
 
     queue->get_index = 0;
     queue->put_index = 0;
@@ -179,6 +253,9 @@ __exit:
     if ((result == RT_EOK) && queue->evt_notify != RT_NULL)
     {
         queue->evt_notify(queue, RT_DATAQUEUE_EVENT_PUSH);
+
+        if (queue->hwm != 0 && rt_data_queue_len(queue) >= queue->hwm)
+            queue->evt_notify(queue, RT_DATAQUEUE_EVENT_HWM);
     }
 
     return result;
@@ -351,6 +428,302 @@ rt_err_t rt_data_queue_peek(struct rt_data_queue *queue,
 }
 RTM_EXPORT(rt_data_queue_peek);
 
+/**
+ * @brief    This function will write a batch of data to the data queue. If the data queue is full,
+ *           the thread will suspend for the specified amount of time.
+ *
+ * @note     The data is written under one interrupt lock, and the threads waiting for reading data
+ *           are resumed with one schedule. The push event, and the high water mark event if the number
+ *           of data reaches the high water mark, are notified once for the batch.
+ *           The function returns as soon as some data is written, the data which does not fit in the
+ *           data queue is not written.
+ *
+ * @param    queue is a pointer to the data queue object.
+ *
+ * @param    data_ptr is an array of the buffer pointers of the data to be written.
+ *
+ * @param    data_size is an array of the sizes in bytes of the data to be written.
+ *
+ * @param    count is the number of data to be written.
+ *
+ * @param    timeout is the waiting time.
+ *
+ * @return   Return the number of data written. When the return value is -RT_ETIMEOUT, it means the
+ *           specified time out. When the return value is -RT_ERROR, it means the data queue is reset.
+ */
+rt_ssize_t rt_data_queue_push_batch(struct rt_data_queue *queue,
+                                    const void **data_ptr,
+                                    const rt_size_t *data_size,
+                                    rt_uint16_t count,
+                                    rt_int32_t timeout)
+{
+    rt_base_t level;
+    rt_err_t result;
+    rt_uint16_t len, index;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
+    RT_ASSERT(data_ptr != RT_NULL);
+    RT_ASSERT(data_size != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    if (count == 0)
+        return 0;
+
+    level = rt_hw_interrupt_disable();
+    while (queue->is_full)
+    {
+        /* queue is full */
+        if (timeout == 0)
+        {
+            rt_hw_interrupt_enable(level);
+            return -RT_ETIMEOUT;
+        }
+
+        result = _data_queue_wait(&(queue->suspended_push_list), timeout, &level);
+        if (result != RT_EOK)
+        {
+            rt_hw_interrupt_enable(level);
+            return result;
+        }
+    }
+
+    len = _data_queue_len(queue);
+    if (count > queue->size - len)
+        count = queue->size - len;
+
+    for (index = 0; index < count; index ++)
+    {
+        queue->queue[queue->put_index].data_ptr  = data_ptr[index];
+        queue->queue[queue->put_index].data_size = data_size[index];
+        queue->put_index += 1;
+        if (queue->put_index == queue->size)
+        {
+            queue->put_index = 0;
+        }
+    }
+    len += count;
+    queue->is_empty = 0;
+    if (queue->put_index == queue->get_index)
+    {
+        queue->is_full = 1;
+    }
+
+    /* a thread could read one data at least */
+    index = _data_queue_wakeup(&(queue->suspended_pop_list), count);
+    rt_hw_interrupt_enable(level);
+
+    if (index > 0)
+        rt_schedule();
+
+    if (queue->evt_notify != RT_NULL)
+    {
+        queue->evt_notify(queue, RT_DATAQUEUE_EVENT_PUSH);
+
+        if (queue->hwm != 0 && len >= queue->hwm)
+            queue->evt_notify(queue, RT_DATAQUEUE_EVENT_HWM);
+    }
+
+    return count;
+}
+RTM_EXPORT(rt_data_queue_push_batch);
+
+/**
+ * @brief    This function will pop a batch of data from the data queue. If the data queue is empty,
+ *           the thread will suspend for the specified amount of time.
+ *
+ * @note     The data is fetched under one interrupt lock. When the number of data in the data queue is
+ *           less than lwm(low water mark), the threads waiting for writing data are resumed with one
+ *           schedule, and the low water mark event is notified once for the batch. Otherwise the pop
+ *           event is notified once for the batch.
+ *           The function returns as soon as some data is fetched.
+ *
+ * @param    queue is a pointer to the data queue object.
+ *
+ * @param    data_ptr is an array to store the buffer pointers of the data fetched.
+ *
+ * @param    size is an array to store the sizes in bytes of the data fetched.
+ *
+ * @param    count is the max number of data to be fetched.
+ *
+ * @param    timeout is the waiting time.
+ *
+ * @return   Return the number of data fetched. When the return value is -RT_ETIMEOUT, it means the
+ *           specified time out. When the return value is -RT_ERROR, it means the data queue is reset.
+ */
+rt_ssize_t rt_data_queue_pop_batch(struct rt_data_queue *queue,
+                                   const void **data_ptr,
+                                   rt_size_t *size,
+                                   rt_uint16_t count,
+                                   rt_int32_t timeout)
+{
+    rt_base_t level;
+    rt_err_t result;
+    rt_uint16_t len, index;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
+    RT_ASSERT(data_ptr != RT_NULL);
+    RT_ASSERT(size != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    if (count == 0)
+        return 0;
+
+    level = rt_hw_interrupt_disable();
+    while (queue->is_empty)
+    {
+        /* queue is empty */
+        if (timeout == 0)
+        {
+            rt_hw_interrupt_enable(level);
+            return -RT_ETIMEOUT;
+        }
+
+        result = _data_queue_wait(&(queue->suspended_pop_list), timeout, &level);
+        if (result != RT_EOK)
+        {
+            rt_hw_interrupt_enable(level);
+            return result;
+        }
+    }
+
+    len = _data_queue_len(queue);
+    if (count > len)
+        count = len;
+
+    for (index = 0; index < count; index ++)
+    {
+        data_ptr[index] = queue->queue[queue->get_index].data_ptr;
+        size[index]     = queue->queue[queue->get_index].data_size;
+        queue->get_index += 1;
+        if (queue->get_index == queue->size)
+        {
+            queue->get_index = 0;
+        }
+    }
+    len -= count;
+    queue->is_full = 0;
+    if (queue->put_index == queue->get_index)
+    {
+        queue->is_empty = 1;
+    }
+
+    if (len <= queue->lwm)
+    {
+        /* a thread could write one data at least */
+        index = _data_queue_wakeup(&(queue->suspended_push_list), count);
+        rt_hw_interrupt_enable(level);
+
+        if (index > 0)
+            rt_schedule();
+
+        if (queue->evt_notify != RT_NULL)
+            queue->evt_notify(queue, RT_DATAQUEUE_EVENT_LWM);
+
+        return count;
+    }
+
+    rt_hw_interrupt_enable(level);
+    if (queue->evt_notify != RT_NULL)
+    {
+        queue->evt_notify(queue, RT_DATAQUEUE_EVENT_POP);
+    }
+
+    return count;
+}
+RTM_EXPORT(rt_data_queue_pop_batch);
+
+/**
+ * @brief    This function will fetch but retaining a batch of data in the data queue.
+ *
+ * @param    queue is a pointer to the data queue object.
+ *
+ * @param    data_ptr is an array to store the buffer pointers of the data fetched.
+ *
+ * @param    size is an array to store the sizes in bytes of the data fetched.
+ *
+ * @param    count is the max number of data to be fetched.
+ *
+ * @return   Return the number of data fetched from the head of data queue.
+ *           When the return value is -RT_EEMPTY, it means the data queue is empty.
+ */
+rt_ssize_t rt_data_queue_peek_batch(struct rt_data_queue *queue,
+                                    const void **data_ptr,
+                                    rt_size_t *size,
+                                    rt_uint16_t count)
+{
+    rt_base_t level;
+    rt_uint16_t len, index, get_index;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
+    RT_ASSERT(data_ptr != RT_NULL);
+    RT_ASSERT(size != RT_NULL);
+
+    if (queue->is_empty)
+    {
+        return -RT_EEMPTY;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    len = _data_queue_len(queue);
+    if (count > len)
+        count = len;
+
+    get_index = queue->get_index;
+    for (index = 0; index < count; index ++)
+    {
+        data_ptr[index] = queue->queue[get_index].data_ptr;
+        size[index]     = queue->queue[get_index].data_size;
+        get_index += 1;
+        if (get_index == queue->size)
+        {
+            get_index = 0;
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+
+    return count;
+}
+RTM_EXPORT(rt_data_queue_peek_batch);
+
+/**
+ * @brief    This function will set the water marks of the data queue.
+ *
+ * @param    queue is a pointer to the data queue object.
+ *
+ * @param    lwm is low water mark.
+ *           When the number of data in the data queue is less than this value after a pop, the threads
+ *           waiting for write data are waked up and RT_DATAQUEUE_EVENT_LWM is notified.
+ *
+ * @param    hwm is high water mark, 0 to disable it.
+ *           When the number of data in the data queue is not less than this value after a push,
+ *           RT_DATAQUEUE_EVENT_HWM is notified.
+ */
+void rt_data_queue_set_watermark(struct rt_data_queue *queue,
+                                 rt_uint16_t lwm,
+                                 rt_uint16_t hwm)
+{
+    rt_base_t level;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
+    RT_ASSERT(hwm <= queue->size);
+
+    level = rt_hw_interrupt_disable();
+    queue->lwm = lwm;
+    queue->hwm = hwm;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_data_queue_set_watermark);
+
 /**
  * @brief    This function will reset the data queue.
  *
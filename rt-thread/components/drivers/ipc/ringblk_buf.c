@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-08-25     armink       the first version
+ * 2026-10-17     agent        fix NULL dereference at the end of block list in rt_rbb_blk_queue_get()
  */
 
 #include <rthw.h>
@@ -413,7 +414,7 @@ rt_size_t rt_rbb_blk_queue_get(rt_rbb_t rbb, rt_size_t queue_data_len, rt_rbb_bl
     {
         tmp = rt_slist_next(node);
     }
-    for (; node; node = tmp, tmp = rt_slist_next(node))
+    for (; node; node = tmp, tmp = node ? rt_slist_next(node) : RT_NULL)
     {
         if (!last_block)
         {
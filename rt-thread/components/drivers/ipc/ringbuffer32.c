@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        first version
+ * 2026-10-17     agent        use memory barriers for producer and consumer on different cores
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <string.h>
+
+/*
+ * the data is accessed only after the index which hands it over is read,
+ * and the index is written only after the data is accessed
+ */
+#define RB32_BARRIER()      rt_hw_dmb()
+
+rt_inline rt_uint32_t _rb32_offset(struct rt_ringbuffer32 *rb, rt_uint32_t index)
+{
+    if (rb->index_mask)
+        return index & rb->index_mask;
+
+    return index < rb->buffer_size ? index : index - rb->buffer_size;
+}
+
+rt_inline rt_uint32_t _rb32_advance(struct rt_ringbuffer32 *rb, rt_uint32_t index, rt_uint32_t length)
+{
+    index += length;
+
+    /* the free running index of power-of-two mode wraps by itself */
+    if (rb->index_mask == 0 && index >= 2 * rb->buffer_size)
+        index -= 2 * rb->buffer_size;
+
+    return index;
+}
+
+rt_inline rt_uint32_t _rb32_data_len(struct rt_ringbuffer32 *rb, rt_uint32_t write_index, rt_uint32_t read_index)
+{
+    if (rb->index_mask || write_index >= read_index)
+        return write_index - read_index;
+
+    return write_index + 2 * rb->buffer_size - read_index;
+}
+
+/**
+ * @brief Initialize the ring buffer object. The power-of-two mode is used
+ *        when the size is a power of two.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param pool      A pointer to the buffer.
+ * @param size      The size of the buffer in bytes, no more than 2GiB.
+ */
+void rt_ringbuffer32_init(struct rt_ringbuffer32 *rb,
+                          rt_uint8_t             *pool,
+                          rt_uint32_t             size)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(size > 0 && size <= 0x80000000UL);
+
+    rb->read_index = 0;
+    rb->write_index = 0;
+
+    rb->buffer_ptr = pool;
+    rb->buffer_size = size;
+    rb->index_mask = (size & (size - 1)) == 0 ? size - 1 : 0;
+}
+RTM_EXPORT(rt_ringbuffer32_init);
+
+/**
+ * @brief Reset the ring buffer object, and clear all contents in the buffer.
+ *        Neither the producer nor the consumer may be running.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ */
+void rt_ringbuffer32_reset(struct rt_ringbuffer32 *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    rb->read_index = 0;
+    rb->write_index = 0;
+}
+RTM_EXPORT(rt_ringbuffer32_reset);
+
+/**
+ * @brief Get the size of data in the ring buffer in bytes.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ *
+ * @return Return the size of data in the ring buffer in bytes.
+ */
+rt_size_t rt_ringbuffer32_data_len(struct rt_ringbuffer32 *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    return _rb32_data_len(rb, rb->write_index, rb->read_index);
+}
+RTM_EXPORT(rt_ringbuffer32_data_len);
+
+/**
+ * @brief Get the size of empty space in the ring buffer in bytes.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ *
+ * @return Return the size of empty space in the ring buffer in bytes.
+ */
+rt_size_t rt_ringbuffer32_space_len(struct rt_ringbuffer32 *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    return rb->buffer_size - _rb32_data_len(rb, rb->write_index, rb->read_index);
+}
+RTM_EXPORT(rt_ringbuffer32_space_len);
+
+/**
+ * @brief Get the contiguous empty space of the ring buffer for the producer
+ *        to fill in place. The space is published by rt_ringbuffer32_put_commit().
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ptr       A pointer to the start of the empty space.
+ *
+ * @return Return the size of the contiguous empty space in bytes.
+ */
+rt_size_t rt_ringbuffer32_put_peek(struct rt_ringbuffer32 *rb, rt_uint8_t **ptr)
+{
+    rt_uint32_t write_index, space, offset;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    write_index = rb->write_index;
+    space = rb->buffer_size - _rb32_data_len(rb, write_index, rb->read_index);
+    offset = _rb32_offset(rb, write_index);
+
+    *ptr = &rb->buffer_ptr[offset];
+    RB32_BARRIER();
+
+    if (space > rb->buffer_size - offset)
+        space = rb->buffer_size - offset;
+
+    return space;
+}
+RTM_EXPORT(rt_ringbuffer32_put_peek);
+
+/**
+ * @brief Publish the data filled by the producer to the consumer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The size of data in bytes, no more than the empty space.
+ */
+void rt_ringbuffer32_put_commit(struct rt_ringbuffer32 *rb, rt_uint32_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rt_ringbuffer32_space_len(rb));
+
+    RB32_BARRIER();
+    rb->write_index = _rb32_advance(rb, rb->write_index, length);
+}
+RTM_EXPORT(rt_ringbuffer32_put_commit);
+
+/**
+ * @brief Get the contiguous data of the ring buffer for the consumer to use
+ *        in place. The data is released by rt_ringbuffer32_get_commit().
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ptr       A pointer to the start of the data.
+ *
+ * @return Return the size of the contiguous data in bytes.
+ */
+rt_size_t rt_ringbuffer32_get_peek(struct rt_ringbuffer32 *rb, rt_uint8_t **ptr)
+{
+    rt_uint32_t read_index, size, offset;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    read_index = rb->read_index;
+    size = _rb32_data_len(rb, rb->write_index, read_index);
+    offset = _rb32_offset(rb, read_index);
+
+    *ptr = &rb->buffer_ptr[offset];
+    RB32_BARRIER();
+
+    if (size > rb->buffer_size - offset)
+        size = rb->buffer_size - offset;
+
+    return size;
+}
+RTM_EXPORT(rt_ringbuffer32_get_peek);
+
+/**
+ * @brief Release the data used by the consumer back to the producer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The size of data in bytes, no more than the data size.
+ */
+void rt_ringbuffer32_get_commit(struct rt_ringbuffer32 *rb, rt_uint32_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rt_ringbuffer32_data_len(rb));
+
+    RB32_BARRIER();
+    rb->read_index = _rb32_advance(rb, rb->read_index, length);
+}
+RTM_EXPORT(rt_ringbuffer32_get_commit);
+
+/**
+ * @brief Put a block of data into the ring buffer. If the capacity of ring buffer is insufficient, it will discard out-of-range data.
+ *
+ * @param rb            A pointer to the ring buffer object.
+ * @param ptr           A pointer to the data buffer.
+ * @param length        The size of data in bytes.
+ *
+ * @return Return the data size we put into the ring buffer.
+ */
+rt_size_t rt_ringbuffer32_put(struct rt_ringbuffer32 *rb,
+                              const rt_uint8_t       *ptr,
+                              rt_uint32_t             length)
+{
+    rt_uint32_t write_index, space, offset, first;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    write_index = rb->write_index;
+    space = rb->buffer_size - _rb32_data_len(rb, write_index, rb->read_index);
+
+    /* drop some data */
+    if (length > space)
+        length = space;
+
+    if (length == 0)
+        return 0;
+
+    RB32_BARRIER();
+    offset = _rb32_offset(rb, write_index);
+    first = rb->buffer_size - offset;
+    if (first > length)
+        first = length;
+
+    rt_memcpy(&rb->buffer_ptr[offset], ptr, first);
+    if (length > first)
+        rt_memcpy(&rb->buffer_ptr[0], &ptr[first], length - first);
+
+    RB32_BARRIER();
+    rb->write_index = _rb32_advance(rb, write_index, length);
+
+    return length;
+}
+RTM_EXPORT(rt_ringbuffer32_put);
+
+/**
+ * @brief Get data from the ring buffer.
+ *
+ * @param rb            A pointer to the ring buffer.
+ * @param ptr           A pointer to the data buffer.
+ * @param length        The size of the data we want to read from the ring buffer.
+ *
+ * @return Return the data size we read from the ring buffer.
+ */
+rt_size_t rt_ringbuffer32_get(struct rt_ringbuffer32 *rb,
+                              rt_uint8_t             *ptr,
+                              rt_uint32_t             length)
+{
+    rt_uint32_t read_index, size, offset, first;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    read_index = rb->read_index;
+    size = _rb32_data_len(rb, rb->write_index, read_index);
+
+    /* less data */
+    if (length > size)
+        length = size;
+
+    if (length == 0)
+        return 0;
+
+    RB32_BARRIER();
+    offset = _rb32_offset(rb, read_index);
+    first = rb->buffer_size - offset;
+    if (first > length)
+        first = length;
+
+    rt_memcpy(ptr, &rb->buffer_ptr[offset], first);
+    if (length > first)
+        rt_memcpy(&ptr[first], &rb->buffer_ptr[0], length - first);
+
+    RB32_BARRIER();
+    rb->read_index = _rb32_advance(rb, read_index, length);
+
+    return length;
+}
+RTM_EXPORT(rt_ringbuffer32_get);
+
+/**
+ * @brief Put a byte into the ring buffer. If ring buffer is full, this operation will fail.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ch        A byte put into the ring buffer.
+ *
+ * @return Return the data size we put into the ring buffer. The ring buffer is full if returns 0. Otherwise, it will return 1.
+ */
+rt_size_t rt_ringbuffer32_putchar(struct rt_ringbuffer32 *rb, const rt_uint8_t ch)
+{
+    rt_uint32_t write_index;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    write_index = rb->write_index;
+
+    /* whether has enough space */
+    if (_rb32_data_len(rb, write_index, rb->read_index) == rb->buffer_size)
+        return 0;
+
+    RB32_BARRIER();
+    rb->buffer_ptr[_rb32_offset(rb, write_index)] = ch;
+
+    RB32_BARRIER();
+    rb->write_index = _rb32_advance(rb, write_index, 1);
+
+    return 1;
+}
+RTM_EXPORT(rt_ringbuffer32_putchar);
+
+/**
+ * @brief Get a byte from the ring buffer.
+ *
+ * @param rb        The pointer to the ring buffer object.
+ * @param ch        A pointer to the buffer, used to store one byte.
+ *
+ * @return 0    The ring buffer is empty.
+ * @return 1    Success
+ */
+rt_size_t rt_ringbuffer32_getchar(struct rt_ringbuffer32 *rb, rt_uint8_t *ch)
+{
+    rt_uint32_t read_index;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    read_index = rb->read_index;
+
+    /* ringbuffer is empty */
+    if (rb->write_index == read_index)
+        return 0;
+
+    RB32_BARRIER();
+    *ch = rb->buffer_ptr[_rb32_offset(rb, read_index)];
+
+    RB32_BARRIER();
+    rb->read_index = _rb32_advance(rb, read_index, 1);
+
+    return 1;
+}
+RTM_EXPORT(rt_ringbuffer32_getchar);
+
+#ifdef RT_USING_HEAP
+
+/**
+ * @brief Create a ring buffer object with a given size.
+ *
+ * @param size      The size of the buffer in bytes.
+ *
+ * @return Return a pointer to ring buffer object. When the return value is RT_NULL, it means this creation failed.
+ */
+struct rt_ringbuffer32 *rt_ringbuffer32_create(rt_uint32_t size)
+{
+    struct rt_ringbuffer32 *rb;
+    rt_uint8_t *pool;
+
+    RT_ASSERT(size > 0);
+
+    rb = (struct rt_ringbuffer32 *)rt_malloc(sizeof(struct rt_ringbuffer32));
+    if (rb == RT_NULL)
+        goto exit;
+
+    pool = (rt_uint8_t *)rt_malloc(size);
+    if (pool == RT_NULL)
+    {
+        rt_free(rb);
+        rb = RT_NULL;
+        goto exit;
+    }
+    rt_ringbuffer32_init(rb, pool, size);
+
+exit:
+    return rb;
+}
+RTM_EXPORT(rt_ringbuffer32_create);
+
+/**
+ * @brief Destroy the ring buffer object, which is created by rt_ringbuffer32_create() .
+ *
+ * @param rb        A pointer to the ring buffer object.
+ */
+void rt_ringbuffer32_destroy(struct rt_ringbuffer32 *rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    rt_free(rb->buffer_ptr);
+    rt_free(rb);
+}
+RTM_EXPORT(rt_ringbuffer32_destroy);
+
+#endif
@@ -0,0 +1,587 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#ifdef RT_USING_WORKPOOL
+
+static rt_list_t _workpool_list = RT_LIST_OBJECT_INIT(_workpool_list);
+
+static void _workpool_delayed_timeout_handler(void *parameter);
+
+rt_inline rt_bool_t _workpool_worker_is_idle(struct rt_workpool_worker *worker)
+{
+    return worker->work_current == RT_NULL &&
+           (worker->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND;
+}
+
+/* whether the work is executing by a worker, interrupt must be disabled */
+static rt_bool_t _workpool_work_is_running(struct rt_workpool *pool, struct rt_work *work)
+{
+    rt_uint16_t i;
+
+    for (i = 0; i < pool->worker_num; i++)
+    {
+        if (pool->workers[i].work_current == work)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/*
+ * Queue a ready work to a worker, interrupt must be disabled.
+ * Return whether a worker is resumed.
+ */
+static rt_bool_t _workpool_enqueue(struct rt_workpool *pool, struct rt_work *work)
+{
+    rt_uint16_t i;
+    rt_thread_t thread = rt_thread_self();
+    struct rt_workpool_worker *target = RT_NULL;
+    struct rt_workpool_worker *idle = RT_NULL;
+
+    for (i = 0; i < pool->worker_num; i++)
+    {
+        struct rt_workpool_worker *worker = &pool->workers[i];
+
+        /* a worker submitting work keeps it in its own queue */
+        if (rt_interrupt_get_nest() == 0 && worker->work_thread == thread)
+            target = worker;
+        else if (idle == RT_NULL && _workpool_worker_is_idle(worker))
+            idle = worker;
+    }
+
+    if (target == RT_NULL)
+    {
+        if (idle != RT_NULL)
+        {
+            target = idle;
+        }
+        else
+        {
+            target = &pool->workers[pool->worker_next];
+            pool->worker_next = (pool->worker_next + 1) % pool->worker_num;
+        }
+    }
+
+    rt_list_insert_before(&(target->work_list[work->work_class]), &(work->list));
+    work->flags |= RT_WORK_STATE_PENDING;
+    work->workpool = pool;
+    work->enqueue_tick = rt_tick_get();
+
+    /* the target is busy, let an idle worker steal the work */
+    if (!_workpool_worker_is_idle(target))
+        target = idle;
+
+    if (target != RT_NULL)
+    {
+        rt_thread_resume(target->work_thread);
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/*
+ * Take the next work for a worker, interrupt must be disabled. Higher class
+ * goes first. In the same class, the own queue goes first and then the oldest
+ * work of other workers is stolen.
+ */
+static struct rt_work *_workpool_dequeue(struct rt_workpool *pool, struct rt_workpool_worker *worker)
+{
+    rt_uint16_t i, index;
+    rt_uint8_t work_class;
+    struct rt_workpool_worker *victim;
+
+    index = worker - pool->workers;
+
+    for (work_class = 0; work_class < RT_WORKPOOL_CLASS_NUM; work_class++)
+    {
+        if (!rt_list_isempty(&(worker->work_list[work_class])))
+            return rt_list_first_entry(&(worker->work_list[work_class]), struct rt_work, list);
+
+        for (i = 1; i < pool->worker_num; i++)
+        {
+            victim = &pool->workers[(index + i) % pool->worker_num];
+            if (!rt_list_isempty(&(victim->work_list[work_class])))
+            {
+                worker->stolen++;
+                return rt_list_first_entry(&(victim->work_list[work_class]), struct rt_work, list);
+            }
+        }
+    }
+
+    return RT_NULL;
+}
+
+static void _workpool_thread_entry(void *parameter)
+{
+    rt_base_t level;
+    rt_tick_t delay;
+    rt_uint16_t sync_waiting;
+    struct rt_work *work;
+    struct rt_workpool *pool;
+    struct rt_workpool_worker *worker;
+
+    worker = (struct rt_workpool_worker *) parameter;
+    RT_ASSERT(worker != RT_NULL);
+    pool = worker->pool;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        work = _workpool_dequeue(pool, worker);
+        if (work == RT_NULL)
+        {
+            /* no work to do or to steal, suspend self. */
+            rt_thread_suspend(rt_thread_self());
+            rt_hw_interrupt_enable(level);
+            rt_schedule();
+            continue;
+        }
+
+        /* we have work to do with. */
+        rt_list_remove(&(work->list));
+        worker->work_current = work;
+        work->flags &= ~RT_WORK_STATE_PENDING;
+        work->workpool = RT_NULL;
+
+        delay = rt_tick_get() - work->enqueue_tick;
+        if (delay > pool->delay_max)
+            pool->delay_max = delay;
+        pool->delay_sum += delay;
+        rt_hw_interrupt_enable(level);
+
+        /* do work */
+        work->work_func(work, work->work_data);
+
+        level = rt_hw_interrupt_disable();
+        /* clean current work */
+        worker->work_current = RT_NULL;
+        worker->executed++;
+        sync_waiting = pool->sync_waiting;
+        pool->sync_waiting = 0;
+        rt_hw_interrupt_enable(level);
+
+        /* ack work completion */
+        while (sync_waiting--)
+            rt_sem_release(&(pool->sem));
+    }
+}
+
+static rt_err_t _workpool_submit_work(struct rt_workpool *pool, struct rt_work *work,
+                                      rt_uint8_t work_class, rt_tick_t ticks)
+{
+    rt_base_t level;
+    rt_err_t err;
+    rt_bool_t resumed = RT_FALSE;
+
+    level = rt_hw_interrupt_disable();
+    /* remove list */
+    rt_list_remove(&(work->list));
+    work->flags &= ~RT_WORK_STATE_PENDING;
+    work->work_class = work_class;
+
+    if (ticks == 0)
+    {
+        /* a delayed submission is replaced by this one */
+        if (work->flags & RT_WORK_STATE_SUBMITTING)
+        {
+            rt_timer_stop(&(work->timer));
+            rt_timer_detach(&(work->timer));
+            work->flags &= ~RT_WORK_STATE_SUBMITTING;
+        }
+
+        /* a work never runs on two workers at the same time */
+        if (!_workpool_work_is_running(pool, work))
+        {
+            resumed = _workpool_enqueue(pool, work);
+            err = RT_EOK;
+        }
+        else
+        {
+            work->workpool = RT_NULL;
+            err = -RT_EBUSY;
+        }
+
+        rt_hw_interrupt_enable(level);
+        if (resumed)
+            rt_schedule();
+
+        return err;
+    }
+    else if (ticks < RT_TICK_MAX / 2)
+    {
+        /* Timer started */
+        if (work->flags & RT_WORK_STATE_SUBMITTING)
+        {
+            rt_timer_stop(&work->timer);
+            rt_timer_control(&work->timer, RT_TIMER_CTRL_SET_TIME, &ticks);
+        }
+        else
+        {
+            rt_timer_init(&(work->timer), "work", _workpool_delayed_timeout_handler,
+                          work, ticks, RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_SOFT_TIMER);
+            work->flags |= RT_WORK_STATE_SUBMITTING;
+        }
+        work->workpool = pool;
+        /* insert delay work list */
+        rt_list_insert_before(&(pool->delayed_list), &(work->list));
+        rt_hw_interrupt_enable(level);
+        rt_timer_start(&(work->timer));
+        return RT_EOK;
+    }
+    rt_hw_interrupt_enable(level);
+    return -RT_ERROR;
+}
+
+static rt_err_t _workpool_cancel_work(struct rt_workpool *pool, struct rt_work *work)
+{
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&(work->list));
+    work->flags &= ~RT_WORK_STATE_PENDING;
+    /* Timer started */
+    if (work->flags & RT_WORK_STATE_SUBMITTING)
+    {
+        rt_timer_stop(&(work->timer));
+        rt_timer_detach(&(work->timer));
+        work->flags &= ~RT_WORK_STATE_SUBMITTING;
+    }
+    err = _workpool_work_is_running(pool, work) ? -RT_EBUSY : RT_EOK;
+    work->workpool = RT_NULL;
+    rt_hw_interrupt_enable(level);
+    return err;
+}
+
+static void _workpool_delayed_timeout_handler(void *parameter)
+{
+    struct rt_work *work;
+    struct rt_workpool *pool;
+    rt_base_t level;
+    rt_bool_t resumed = RT_FALSE;
+
+    work = (struct rt_work *)parameter;
+    pool = work->workpool;
+    RT_ASSERT(pool != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    rt_timer_detach(&(work->timer));
+    work->flags &= ~RT_WORK_STATE_SUBMITTING;
+    /* remove delay list */
+    rt_list_remove(&(work->list));
+    /* insert work queue of a worker */
+    if (!_workpool_work_is_running(pool, work))
+        resumed = _workpool_enqueue(pool, work);
+    else
+        work->workpool = RT_NULL;
+    rt_hw_interrupt_enable(level);
+
+    if (resumed)
+        rt_schedule();
+}
+
+/**
+ * @brief Create a work pool with several worker threads inside. The works
+ *        submitted to the pool are executed by any idle worker in the order
+ *        of their priority class.
+ *
+ * @param name is a name of the work pool, also the prefix of worker threads.
+ *
+ * @param worker_num is the number of worker threads.
+ *
+ * @param stack_size is stack size of each worker thread.
+ *
+ * @param priority is a priority of the worker threads.
+ *
+ * @return Return a pointer to the work pool object. It will return RT_NULL if failed.
+ */
+struct rt_workpool *rt_workpool_create(const char *name, rt_uint16_t worker_num,
+                                       rt_uint16_t stack_size, rt_uint8_t priority)
+{
+    rt_uint16_t i, work_class;
+    rt_base_t level;
+    char thread_name[RT_NAME_MAX];
+    struct rt_workpool *pool;
+    struct rt_workpool_worker *worker;
+
+    RT_ASSERT(name != RT_NULL);
+    RT_ASSERT(worker_num > 0);
+
+    pool = (struct rt_workpool *)RT_KERNEL_MALLOC(sizeof(struct rt_workpool));
+    if (pool == RT_NULL)
+        return RT_NULL;
+
+    rt_memset(pool, 0, sizeof(struct rt_workpool));
+    pool->workers = (struct rt_workpool_worker *)RT_KERNEL_MALLOC(worker_num * sizeof(struct rt_workpool_worker));
+    if (pool->workers == RT_NULL)
+    {
+        RT_KERNEL_FREE(pool);
+        return RT_NULL;
+    }
+
+    rt_strncpy(pool->name, name, RT_NAME_MAX);
+    rt_list_init(&(pool->delayed_list));
+    rt_sem_init(&(pool->sem), "wpool", 0, RT_IPC_FLAG_FIFO);
+    pool->worker_num = worker_num;
+
+    for (i = 0; i < worker_num; i++)
+    {
+        worker = &pool->workers[i];
+
+        for (work_class = 0; work_class < RT_WORKPOOL_CLASS_NUM; work_class++)
+            rt_list_init(&(worker->work_list[work_class]));
+        worker->work_current = RT_NULL;
+        worker->pool = pool;
+        worker->executed = 0;
+        worker->stolen = 0;
+
+        /* create the worker thread */
+        rt_snprintf(thread_name, sizeof(thread_name), "%.*s%d", RT_NAME_MAX - 3, name, i);
+        worker->work_thread = rt_thread_create(thread_name, _workpool_thread_entry, worker,
+                                               stack_size, priority, 10);
+        if (worker->work_thread == RT_NULL)
+        {
+            while (i--)
+                rt_thread_delete(pool->workers[i].work_thread);
+            rt_sem_detach(&(pool->sem));
+            RT_KERNEL_FREE(pool->workers);
+            RT_KERNEL_FREE(pool);
+            return RT_NULL;
+        }
+    }
+
+    level = rt_hw_interrupt_disable();
+    rt_list_insert_before(&_workpool_list, &(pool->list));
+    rt_hw_interrupt_enable(level);
+
+    for (i = 0; i < worker_num; i++)
+        rt_thread_startup(pool->workers[i].work_thread);
+
+    return pool;
+}
+
+/**
+ * @brief Destroy a work pool.
+ *
+ * @param pool is a pointer to the work pool object.
+ *
+ * @return RT_EOK     Success.
+ */
+rt_err_t rt_workpool_destroy(struct rt_workpool *pool)
+{
+    rt_uint16_t i;
+    rt_base_t level;
+
+    RT_ASSERT(pool != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&(pool->list));
+    rt_hw_interrupt_enable(level);
+
+    rt_workpool_cancel_all_work(pool);
+    for (i = 0; i < pool->worker_num; i++)
+        rt_thread_delete(pool->workers[i].work_thread);
+    rt_sem_detach(&(pool->sem));
+    RT_KERNEL_FREE(pool->workers);
+    RT_KERNEL_FREE(pool);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief Submit a work item to the work pool without delay in normal class.
+ *
+ * @param pool is a pointer to the work pool object.
+ *
+ * @param work is a pointer to the work item object.
+ *
+ * @return RT_EOK       Success.
+ *         -RT_EBUSY    This work item is executing.
+ */
+rt_err_t rt_workpool_dowork(struct rt_workpool *pool, struct rt_work *work)
+{
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+
+    return _workpool_submit_work(pool, work, RT_WORKPOOL_CLASS_NORMAL, 0);
+}
+
+/**
+ * @brief Submit a work item to the work pool with a delay.
+ *
+ * @param pool is a pointer to the work pool object.
+ *
+ * @param work is a pointer to the work item object.
+ *
+ * @param work_class is the priority class of the work item, RT_WORKPOOL_CLASS_HIGH
+ *                   is executed first.
+ *
+ * @param ticks is the delay ticks for the work item to be submitted to the work pool.
+ *
+ *             NOTE: The max timeout tick should be no more than (RT_TICK_MAX/2 - 1)
+ *
+ * @return RT_EOK       Success.
+ *         -RT_EBUSY    This work item is executing.
+ *         -RT_ERROR    The ticks parameter is invalid.
+ */
+rt_err_t rt_workpool_submit_work(struct rt_workpool *pool, struct rt_work *work,
+                                 rt_uint8_t work_class, rt_tick_t ticks)
+{
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+    RT_ASSERT(work_class < RT_WORKPOOL_CLASS_NUM);
+    RT_ASSERT(ticks < RT_TICK_MAX / 2);
+
+    return _workpool_submit_work(pool, work, work_class, ticks);
+}
+
+/**
+ * @brief Cancel a work item in the work pool.
+ *
+ * @param pool is a pointer to the work pool object.
+ *
+ * @param work is a pointer to the work item object.
+ *
+ * @return RT_EOK       Success.
+ *         -RT_EBUSY    This work item is executing.
+ */
+rt_err_t rt_workpool_cancel_work(struct rt_workpool *pool, struct rt_work *work)
+{
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+
+    return _workpool_cancel_work(pool, work);
+}
+
+/**
+ * @brief Cancel a work item in the work pool. If the work item is executing, this function will block until it is done.
+ *
+ * @param pool is a pointer to the work pool object.
+ *
+ * @param work is a pointer to the work item object.
+ *
+ * @return RT_EOK       Success.
+ */
+rt_err_t rt_workpool_cancel_work_sync(struct rt_workpool *pool, struct rt_work *work)
+{
+    rt_base_t level;
+
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        if (!_workpool_work_is_running(pool, work))
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+        /* wait for work completion of any worker and check again */
+        pool->sync_waiting++;
+        rt_hw_interrupt_enable(level);
+
+        rt_sem_take(&(pool->sem), RT_WAITING_FOREVER);
+    }
+
+    _workpool_cancel_work(pool, work);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief This function will cancel all work items in work pool.
+ *
+ * @param pool is a pointer to the work pool object.
+ *
+ * @return RT_EOK       Success.
+ */
+rt_err_t rt_workpool_cancel_all_work(struct rt_workpool *pool)
+{
+    rt_uint16_t i, work_class;
+    struct rt_work *work;
+    rt_list_t *work_list;
+
+    RT_ASSERT(pool != RT_NULL);
+
+    /* cancel work */
+    rt_enter_critical();
+    for (i = 0; i < pool->worker_num; i++)
+    {
+        for (work_class = 0; work_class < RT_WORKPOOL_CLASS_NUM; work_class++)
+        {
+            work_list = &(pool->workers[i].work_list[work_class]);
+            while (rt_list_isempty(work_list) == RT_FALSE)
+            {
+                work = rt_list_first_entry(work_list, struct rt_work, list);
+                _workpool_cancel_work(pool, work);
+            }
+        }
+    }
+    /* cancel delay work */
+    while (rt_list_isempty(&pool->delayed_list) == RT_FALSE)
+    {
+        work = rt_list_first_entry(&pool->delayed_list, struct rt_work, list);
+        _workpool_cancel_work(pool, work);
+    }
+    rt_exit_critical();
+
+    return RT_EOK;
+}
+
+#if defined(RT_USING_FINSH)
+static void list_workpool(void)
+{
+    rt_uint16_t i, work_class;
+    rt_base_t level;
+    rt_list_t *node;
+    struct rt_workpool *pool;
+    struct rt_workpool_worker *worker;
+    rt_uint32_t executed, stolen, pending;
+    rt_tick_t delay_max;
+    rt_uint64_t delay_sum;
+
+    rt_kprintf("workpool worker   executed   stolen pending delay avg/max(tick)\n");
+    rt_kprintf("-------- ------ ---------- -------- ------- -------------------\n");
+
+    rt_enter_critical();
+    rt_list_for_each(node, &_workpool_list)
+    {
+        pool = rt_list_entry(node, struct rt_workpool, list);
+        executed = stolen = pending = 0;
+
+        level = rt_hw_interrupt_disable();
+        for (i = 0; i < pool->worker_num; i++)
+        {
+            worker = &pool->workers[i];
+            executed += worker->executed;
+            stolen += worker->stolen;
+            for (work_class = 0; work_class < RT_WORKPOOL_CLASS_NUM; work_class++)
+                pending += rt_list_len(&(worker->work_list[work_class]));
+        }
+        delay_max = pool->delay_max;
+        delay_sum = pool->delay_sum;
+        rt_hw_interrupt_enable(level);
+
+        rt_kprintf("%-*.*s %6d %10u %8u %7u %9u/%u\n", RT_NAME_MAX, RT_NAME_MAX, pool->name,
+                   pool->worker_num, executed, stolen, pending,
+                   executed ? (rt_uint32_t)(delay_sum / executed) : 0, delay_max);
+    }
+    rt_exit_critical();
+}
+MSH_CMD_EXPORT(list_workpool, list work pool and queueing delay);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_WORKPOOL */
@@ -9,6 +9,7 @@
  * 2021-08-01     Meco Man     remove rt_delayed_work_init()
  * 2021-08-14     Jackistang   add comments for function interface
  * 2022-01-16     Meco Man     add rt_work_urgent()
+ * 2026-10-17     agent        initialize work pool fields in rt_work_init()
  */
 
 #include <rthw.h>
@@ -233,6 +234,11 @@ void rt_work_init(struct rt_work *work,
     work->workqueue = RT_NULL;
     work->flags = 0;
     work->type = 0;
+#ifdef RT_USING_WORKPOOL
+    work->workpool = RT_NULL;
+    work->enqueue_tick = 0;
+    work->work_class = 0;
+#endif /* RT_USING_WORKPOOL */
 }
 
 /**
@@ -26,6 +26,10 @@
  *                             when using interrupt tx
  * 2020-12-14     Meco Man     implement function of setting window's size(TIOCSWINSZ)
  * 2021-08-22     Meco Man     implement function of getting window's size(TIOCGWINSZ)
+ * 2026-10-17     agent        lock-free interrupt rx fifo with bulk copy and rx span interface
+ * 2026-10-17     agent        zero-copy dma rx mode with driver lent buffers
+ * 2026-10-17     agent        keep overwriting the oldest rx data unless RT_SERIAL_RX_DROP_NEWEST
+ * 2026-10-17     agent        add memory barriers to the lock-free rx fifo
  */
 
 #include <rthw.h>
@@ -36,6 +40,13 @@
 #define DBG_LVL    DBG_INFO
 #include <rtdbg.h>
 
+#ifdef RT_SERIAL_USING_DMA
+/* dma rx with fifo, the driver lends received data in place instead of filling rx fifo */
+#define _SERIAL_DMA_RX_ZEROCOPY(serial) ((serial)->ops->rx_buf_get != RT_NULL && (serial)->config.bufsz != 0)
+#else
+#define _SERIAL_DMA_RX_ZEROCOPY(serial) 0
+#endif /* RT_SERIAL_USING_DMA */
+
 #ifdef RT_USING_POSIX_STDIO
 #include <dfs_file.h>
 #include <fcntl.h>
@@ -189,6 +200,15 @@ static int serial_fops_poll(struct dfs_fd *fd, struct rt_pollreq *req)
 
         rt_poll_add(&(device->wait_queue), req);
 
+        if (_SERIAL_DMA_RX_ZEROCOPY(serial) && (device->open_flag & RT_DEVICE_FLAG_DMA_RX))
+        {
+            rt_uint8_t *buf;
+
+            if (serial->ops->rx_buf_get(serial, &buf) > 0)
+                mask |= POLLIN;
+            return mask;
+        }
+
         rx_fifo = (struct rt_serial_rx_fifo*) serial->serial_rx;
 
         level = rt_hw_interrupt_disable();
@@ -271,9 +291,95 @@ rt_inline int _serial_poll_tx(struct rt_serial_device *serial, const rt_uint8_t
 /*
  * Serial interrupt routines
  */
+
+#ifdef RT_SERIAL_RX_DROP_NEWEST
+/* the isr and the reader share no lock, order the fifo data against the indexes */
+#define _serial_rx_barrier()    rt_hw_dmb()
+#else
+/* the isr and the reader are serialized by the interrupt lock */
+#define _serial_rx_barrier()
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
+
+/*
+ * get the received data of interrupt rx fifo as at most two contiguous spans,
+ * it is only called by the reader so get_index is stable.
+ */
+rt_inline rt_size_t _serial_int_rx_spans(struct rt_serial_device *serial,
+                                         struct rt_serial_rx_fifo *rx_fifo,
+                                         struct rt_serial_rx_span span[2])
+{
+    rt_uint16_t put_index = rx_fifo->put_index;
+    rt_uint16_t get_index = rx_fifo->get_index;
+
+    /* read the data only after put_index published it */
+    _serial_rx_barrier();
+
+    span[0].data = rx_fifo->buffer + get_index;
+    span[1].data = rx_fifo->buffer;
+
+    if (put_index >= get_index)
+    {
+        span[0].length = put_index - get_index;
+        span[1].length = 0;
+    }
+    else
+    {
+        span[0].length = serial->config.bufsz - get_index;
+        span[1].length = put_index;
+    }
+
+    return span[0].length + span[1].length;
+}
+
+rt_inline void _serial_int_rx_release(struct rt_serial_device *serial,
+                                      struct rt_serial_rx_fifo *rx_fifo,
+                                      rt_size_t length)
+{
+    rt_size_t get_index = rx_fifo->get_index + length;
+
+    if (get_index >= serial->config.bufsz)
+        get_index -= serial->config.bufsz;
+
+    /* publish the free space to the isr, after the data is read */
+    _serial_rx_barrier();
+    rx_fifo->get_index = (rt_uint16_t)get_index;
+}
+
+#ifdef RT_SERIAL_RX_DROP_NEWEST
+rt_inline int _serial_int_rx(struct rt_serial_device *serial, rt_uint8_t *data, int length)
+{
+    rt_size_t size, first;
+    struct rt_serial_rx_span span[2];
+    struct rt_serial_rx_fifo* rx_fifo;
+
+    RT_ASSERT(serial != RT_NULL);
+
+    rx_fifo = (struct rt_serial_rx_fifo*) serial->serial_rx;
+    RT_ASSERT(rx_fifo != RT_NULL);
+
+    /* read from software FIFO, at most two copies at the wraparound */
+    size = _serial_int_rx_spans(serial, rx_fifo, span);
+    if (size > (rt_size_t)length) size = length;
+
+    first = size < span[0].length ? size : span[0].length;
+    rt_memcpy(data, span[0].data, first);
+    if (size > first)
+        rt_memcpy(data + first, span[1].data, size - first);
+
+    _serial_int_rx_release(serial, rx_fifo, size);
+
+    return size;
+}
+#else
+/* the bytes copied in one interrupt locked section */
+#define SERIAL_RX_COPY_CHUNK    32
+
 rt_inline int _serial_int_rx(struct rt_serial_device *serial, rt_uint8_t *data, int length)
 {
     int size;
+    rt_size_t chunk;
+    rt_base_t level;
+    struct rt_serial_rx_span span[2];
     struct rt_serial_rx_fifo* rx_fifo;
 
     RT_ASSERT(serial != RT_NULL);
@@ -282,42 +388,85 @@ rt_inline int _serial_int_rx(struct rt_serial_device *serial, rt_uint8_t *data,
     rx_fifo = (struct rt_serial_rx_fifo*) serial->serial_rx;
     RT_ASSERT(rx_fifo != RT_NULL);
 
-    /* read from software FIFO */
+    /* the isr moves get_index when it overwrites the oldest data, lock it out while copying */
     while (length)
     {
-        int ch;
-        rt_base_t level;
-
-        /* disable interrupt */
         level = rt_hw_interrupt_disable();
 
-        /* there's no data: */
-        if ((rx_fifo->get_index == rx_fifo->put_index) && (rx_fifo->is_full == RT_FALSE))
+        _serial_int_rx_spans(serial, rx_fifo, span);
+        chunk = span[0].length;
+        if (chunk > (rt_size_t)length) chunk = length;
+        if (chunk > SERIAL_RX_COPY_CHUNK) chunk = SERIAL_RX_COPY_CHUNK;
+        if (chunk == 0)
         {
-            /* no data, enable interrupt and break out */
             rt_hw_interrupt_enable(level);
             break;
         }
 
-        /* otherwise there's the data: */
-        ch = rx_fifo->buffer[rx_fifo->get_index];
-        rx_fifo->get_index += 1;
-        if (rx_fifo->get_index >= serial->config.bufsz) rx_fifo->get_index = 0;
-
-        if (rx_fifo->is_full == RT_TRUE)
-        {
-            rx_fifo->is_full = RT_FALSE;
-        }
+        rt_memcpy(data, span[0].data, chunk);
+        _serial_int_rx_release(serial, rx_fifo, chunk);
 
-        /* enable interrupt */
         rt_hw_interrupt_enable(level);
 
-        *data = ch & 0xff;
-        data ++; length --;
+        data += chunk; length -= chunk;
     }
 
     return size - length;
 }
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
+
+#ifdef RT_SERIAL_RX_DROP_NEWEST
+/**
+ * This function gets the received data of a serial device opened with
+ * RT_DEVICE_FLAG_INT_RX in place, as at most two contiguous spans of the
+ * rx fifo. The data stays valid until it is released by
+ * rt_serial_rx_span_release(). It must be called by the only reader.
+ *
+ * @param serial serial device
+ * @param span the spans of received data
+ *
+ * @return the total length of the spans
+ */
+rt_size_t rt_serial_rx_span_get(struct rt_serial_device *serial, struct rt_serial_rx_span span[2])
+{
+    struct rt_serial_rx_fifo *rx_fifo;
+
+    RT_ASSERT(serial != RT_NULL);
+    RT_ASSERT(span != RT_NULL);
+
+    span[0].length = span[1].length = 0;
+    if (!(serial->parent.open_flag & RT_DEVICE_FLAG_INT_RX))
+        return 0;
+
+    rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+    RT_ASSERT(rx_fifo != RT_NULL);
+
+    return _serial_int_rx_spans(serial, rx_fifo, span);
+}
+
+/**
+ * This function releases the received data got by rt_serial_rx_span_get().
+ *
+ * @param serial serial device
+ * @param length the length of data to release, from the beginning of the
+ *        first span and not larger than the total length of the spans
+ */
+void rt_serial_rx_span_release(struct rt_serial_device *serial, rt_size_t length)
+{
+    struct rt_serial_rx_fifo *rx_fifo;
+
+    RT_ASSERT(serial != RT_NULL);
+
+    if (!(serial->parent.open_flag & RT_DEVICE_FLAG_INT_RX) || length == 0)
+        return;
+
+    rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+    RT_ASSERT(rx_fifo != RT_NULL);
+    RT_ASSERT(length < serial->config.bufsz);
+
+    _serial_int_rx_release(serial, rx_fifo, length);
+}
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
 
 rt_inline int _serial_int_tx(struct rt_serial_device *serial, const rt_uint8_t *data, int length)
 {
@@ -488,6 +637,28 @@ rt_inline int _serial_dma_rx(struct rt_serial_device *serial, rt_uint8_t *data,
 
     RT_ASSERT((serial != RT_NULL) && (data != RT_NULL));
 
+    if (_SERIAL_DMA_RX_ZEROCOPY(serial))
+    {
+        rt_uint8_t *buf;
+        rt_size_t size, recv_len = 0;
+
+        /* copy out of the buffers lent by the driver */
+        while (recv_len < (rt_size_t)length)
+        {
+            size = serial->ops->rx_buf_get(serial, &buf);
+            if (size == 0) break;
+            if (size > length - recv_len) size = length - recv_len;
+
+            rt_memcpy(data + recv_len, buf, size);
+            /* the data was overwritten under the copy, drop it as an overrun */
+            if (serial->ops->rx_buf_release(serial, buf, size) != RT_EOK)
+                continue;
+            recv_len += size;
+        }
+
+        return recv_len;
+    }
+
     level = rt_hw_interrupt_disable();
 
     if (serial->config.bufsz == 0)
@@ -572,6 +743,64 @@ rt_inline int _serial_dma_tx(struct rt_serial_device *serial, const rt_uint8_t *
         return 0;
     }
 }
+
+/**
+ * This function gets the received data of a serial device opened with
+ * RT_DEVICE_FLAG_DMA_RX in place, from the dma buffers lent by the driver.
+ * The data stays valid until it is released by rt_serial_rx_buffer_release().
+ * It is only available when the driver implements rx_buf_get and
+ * config.bufsz is not zero, and must be called by the only reader.
+ *
+ * @param serial serial device
+ * @param buffer the start of received data
+ * @param timeout the waiting time when there is no received data
+ *
+ * @return the length of contiguous received data, 0 on timeout
+ */
+rt_size_t rt_serial_rx_buffer_get(struct rt_serial_device *serial, rt_uint8_t **buffer, rt_int32_t timeout)
+{
+    rt_size_t size;
+    struct rt_serial_rx_dma *rx_dma;
+
+    RT_ASSERT(serial != RT_NULL);
+    RT_ASSERT(buffer != RT_NULL);
+
+    if (!_SERIAL_DMA_RX_ZEROCOPY(serial) || !(serial->parent.open_flag & RT_DEVICE_FLAG_DMA_RX))
+        return 0;
+
+    rx_dma = (struct rt_serial_rx_dma *)serial->serial_rx;
+    RT_ASSERT(rx_dma != RT_NULL);
+
+    while ((size = serial->ops->rx_buf_get(serial, buffer)) == 0)
+    {
+        if (timeout == 0 || rt_completion_wait(&(rx_dma->completion), timeout) != RT_EOK)
+            break;
+    }
+
+    return size;
+}
+
+/**
+ * This function releases the received data got by rt_serial_rx_buffer_get().
+ *
+ * @param serial serial device
+ * @param buffer the buffer got by rt_serial_rx_buffer_get()
+ * @param length the length of data to release, the rest of the buffer is
+ *        returned again by the next rt_serial_rx_buffer_get()
+ *
+ * @return RT_EOK on success, -RT_EFULL if the driver dropped the data on
+ *         overrun before it was released and the buffer may have been
+ *         overwritten, -RT_EINVAL if the buffer is not the one lent.
+ */
+rt_err_t rt_serial_rx_buffer_release(struct rt_serial_device *serial, rt_uint8_t *buffer, rt_size_t length)
+{
+    RT_ASSERT(serial != RT_NULL);
+
+    if (!_SERIAL_DMA_RX_ZEROCOPY(serial) || !(serial->parent.open_flag & RT_DEVICE_FLAG_DMA_RX))
+        return -RT_ENOSYS;
+
+    return serial->ops->rx_buf_release(serial, buffer, length);
+}
 #endif /* RT_SERIAL_USING_DMA */
 
 /* RT-Thread Device Interface */
@@ -639,6 +868,7 @@ static rt_err_t rt_serial_open(struct rt_device *dev, rt_uint16_t oflag)
             rx_fifo->put_index = 0;
             rx_fifo->get_index = 0;
             rx_fifo->is_full = RT_FALSE;
+            rx_fifo->overflow = 0;
 
             serial->serial_rx = rx_fifo;
             dev->open_flag |= RT_DEVICE_FLAG_INT_RX;
@@ -648,14 +878,18 @@ static rt_err_t rt_serial_open(struct rt_device *dev, rt_uint16_t oflag)
 #ifdef RT_SERIAL_USING_DMA
         else if (oflag & RT_DEVICE_FLAG_DMA_RX)
         {
-            if (serial->config.bufsz == 0) {
+            if (serial->config.bufsz == 0 || _SERIAL_DMA_RX_ZEROCOPY(serial)) {
                 struct rt_serial_rx_dma* rx_dma;
 
                 rx_dma = (struct rt_serial_rx_dma*) rt_malloc (sizeof(struct rt_serial_rx_dma));
                 RT_ASSERT(rx_dma != RT_NULL);
                 rx_dma->activated = RT_FALSE;
+                rt_completion_init(&(rx_dma->completion));
 
                 serial->serial_rx = rx_dma;
+                /* the driver allocates and triggers its own dma buffers */
+                if (serial->config.bufsz != 0)
+                    serial->ops->control(serial, RT_DEVICE_CTRL_CONFIG, (void *) RT_DEVICE_FLAG_DMA_RX);
             } else {
                 struct rt_serial_rx_fifo* rx_fifo;
 
@@ -667,6 +901,7 @@ static rt_err_t rt_serial_open(struct rt_device *dev, rt_uint16_t oflag)
                 rx_fifo->put_index = 0;
                 rx_fifo->get_index = 0;
                 rx_fifo->is_full = RT_FALSE;
+                rx_fifo->overflow = 0;
                 serial->serial_rx = rx_fifo;
                 /* configure fifo address and length to low level device */
                 serial->ops->control(serial, RT_DEVICE_CTRL_CONFIG, (void *) RT_DEVICE_FLAG_DMA_RX);
@@ -775,7 +1010,7 @@ static rt_err_t rt_serial_close(struct rt_device *dev)
         serial->ops->control(serial, RT_DEVICE_CTRL_CLR_INT, (void *) RT_DEVICE_FLAG_DMA_RX);
         dev->open_flag &= ~RT_DEVICE_FLAG_DMA_RX;
 
-        if (serial->config.bufsz == 0)
+        if (serial->config.bufsz == 0 || _SERIAL_DMA_RX_ZEROCOPY(serial))
         {
             struct rt_serial_rx_dma* rx_dma;
 
@@ -961,7 +1196,15 @@ static void _tc_flush(struct rt_serial_device *serial, int queue)
 
             RT_ASSERT(rx_fifo != RT_NULL);
 
-            if((device->open_flag & RT_DEVICE_FLAG_INT_RX) || (device->open_flag & RT_DEVICE_FLAG_DMA_RX))
+            if (_SERIAL_DMA_RX_ZEROCOPY(serial) && (device->open_flag & RT_DEVICE_FLAG_DMA_RX))
+            {
+                rt_uint8_t *buf;
+                rt_size_t size;
+
+                while ((size = serial->ops->rx_buf_get(serial, &buf)) > 0)
+                    serial->ops->rx_buf_release(serial, buf, size);
+            }
+            else if((device->open_flag & RT_DEVICE_FLAG_INT_RX) || (device->open_flag & RT_DEVICE_FLAG_DMA_RX))
             {
                 RT_ASSERT(RT_NULL != rx_fifo);
                 level = rt_hw_interrupt_disable();
@@ -1217,9 +1460,19 @@ static rt_err_t rt_serial_control(struct rt_device *dev,
                 rt_size_t recved = 0;
                 rt_base_t level;
 
-                level = rt_hw_interrupt_disable();
-                recved = _serial_fifo_calc_recved_len(serial);
-                rt_hw_interrupt_enable(level);
+                if (_SERIAL_DMA_RX_ZEROCOPY(serial) && (dev->open_flag & RT_DEVICE_FLAG_DMA_RX))
+                {
+                    rt_uint8_t *buf;
+
+                    /* the contiguous part only */
+                    recved = serial->ops->rx_buf_get(serial, &buf);
+                }
+                else
+                {
+                    level = rt_hw_interrupt_disable();
+                    recved = _serial_fifo_calc_recved_len(serial);
+                    rt_hw_interrupt_enable(level);
+                }
 
                 *(rt_size_t *)args = recved;
             }
@@ -1295,50 +1548,78 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
         case RT_SERIAL_EVENT_RX_IND:
         {
             int ch = -1;
-            rt_base_t level;
+            rt_uint16_t put_index, get_index, next;
             struct rt_serial_rx_fifo* rx_fifo;
+#ifndef RT_SERIAL_RX_DROP_NEWEST
+            rt_base_t level;
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
 
             /* interrupt mode receive */
             rx_fifo = (struct rt_serial_rx_fifo*)serial->serial_rx;
             RT_ASSERT(rx_fifo != RT_NULL);
 
+#ifndef RT_SERIAL_RX_DROP_NEWEST
+            /* get_index is moved here too, keep the reader out */
+            level = rt_hw_interrupt_disable();
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
+
+            /* the isr is the only writer of put_index */
+            put_index = rx_fifo->put_index;
+            get_index = rx_fifo->get_index;
+            /* write the space only after get_index freed it */
+            _serial_rx_barrier();
             while (1)
             {
                 ch = serial->ops->getc(serial);
                 if (ch == -1) break;
 
+                next = put_index + 1;
+                if (next >= serial->config.bufsz) next = 0;
 
-                /* disable interrupt */
-                level = rt_hw_interrupt_disable();
-
-                rx_fifo->buffer[rx_fifo->put_index] = ch;
-                rx_fifo->put_index += 1;
-                if (rx_fifo->put_index >= serial->config.bufsz) rx_fifo->put_index = 0;
-
-                /* if the next position is read index, discard this 'read char' */
-                if (rx_fifo->put_index == rx_fifo->get_index)
+                if (next == get_index)
                 {
-                    rx_fifo->get_index += 1;
-                    rx_fifo->is_full = RT_TRUE;
-                    if (rx_fifo->get_index >= serial->config.bufsz) rx_fifo->get_index = 0;
-
+#ifdef RT_SERIAL_RX_DROP_NEWEST
+                    /* the reader may have freed space since */
+                    get_index = rx_fifo->get_index;
+                    if (next == get_index)
+                    {
+                        /* discard this 'read char' */
+                        rx_fifo->overflow ++;
+                        _serial_check_buffer_size();
+                        continue;
+                    }
+                    _serial_rx_barrier();
+#else
+                    /* discard the oldest char */
+                    get_index = next + 1;
+                    if (get_index >= serial->config.bufsz) get_index = 0;
+                    rx_fifo->get_index = get_index;
+                    rx_fifo->overflow ++;
                     _serial_check_buffer_size();
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
                 }
 
-                /* enable interrupt */
-                rt_hw_interrupt_enable(level);
+                rx_fifo->buffer[put_index] = ch;
+                put_index = next;
             }
 
+            /* publish the received data to the reader once, after it is written */
+            _serial_rx_barrier();
+            rx_fifo->put_index = put_index;
+
+#ifndef RT_SERIAL_RX_DROP_NEWEST
+            rt_hw_interrupt_enable(level);
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
+
             /* invoke callback */
             if (serial->parent.rx_indicate != RT_NULL)
             {
                 rt_size_t rx_length;
 
                 /* get rx length */
-                level = rt_hw_interrupt_disable();
-                rx_length = (rx_fifo->put_index >= rx_fifo->get_index)? (rx_fifo->put_index - rx_fifo->get_index):
-                    (serial->config.bufsz - (rx_fifo->get_index - rx_fifo->put_index));
-                rt_hw_interrupt_enable(level);
+                get_index = rx_fifo->get_index;
+                rx_length = (put_index >= get_index)? (put_index - get_index):
+                    (serial->config.bufsz - (get_index - put_index));
 
                 if (rx_length)
                 {
@@ -1392,7 +1673,19 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
             /* get DMA rx length */
             length = (event & (~0xff)) >> 8;
 
-            if (serial->config.bufsz == 0)
+            if (_SERIAL_DMA_RX_ZEROCOPY(serial))
+            {
+                struct rt_serial_rx_dma* rx_dma;
+
+                rx_dma = (struct rt_serial_rx_dma*) serial->serial_rx;
+                RT_ASSERT(rx_dma != RT_NULL);
+
+                /* the data is already lent by the driver */
+                rt_completion_done(&(rx_dma->completion));
+                if (serial->parent.rx_indicate != RT_NULL)
+                    serial->parent.rx_indicate(&(serial->parent), length);
+            }
+            else if (serial->config.bufsz == 0)
             {
                 struct rt_serial_rx_dma* rx_dma;
 
@@ -30,11 +30,17 @@
  *                             Provide protection for the "first layer of objects" when list_*
  * 2020-04-07     chenhui      add clear
  * 2022-07-02     Stanley Lwin add list command
+ * 2026-10-17     agent        add top
+ * 2026-10-17     agent        add lockstat
  */
 
 #include <rthw.h>
 #include <rtthread.h>
 #include <string.h>
+#include <stdlib.h>
+#if defined(RT_USING_LOCKSTAT) && defined(RT_USING_CPUTIME)
+#include <drivers/cputime.h>
+#endif /* defined(RT_USING_LOCKSTAT) && defined(RT_USING_CPUTIME) */
 
 #ifdef RT_USING_FINSH
 #include <finsh.h>
@@ -248,6 +254,269 @@ long list_thread(void)
     return 0;
 }
 
+#ifdef RT_USING_CPU_USAGE
+struct top_item
+{
+    char name[RT_NAME_MAX];
+    rt_uint8_t priority;
+    rt_uint8_t stat;
+    struct rt_thread_stats stats;
+};
+
+static int top_collect(struct top_item *items, int max_nr, rt_uint16_t *idle_usage)
+{
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t *)RT_NULL;
+    struct top_item item;
+    int nr = 0;
+
+    list_find_init(&find_arg, RT_Object_Class_Thread, obj_list, sizeof(obj_list) / sizeof(obj_list[0]));
+    *idle_usage = 0;
+
+    do
+    {
+        next = list_get_next(next, &find_arg);
+        {
+            int i, j;
+            for (i = 0; i < find_arg.nr_out && nr < max_nr; i++)
+            {
+                struct rt_object *obj;
+                struct rt_thread *thread;
+
+                obj = rt_list_entry(obj_list[i], struct rt_object, list);
+                /* the thread can't be deleted while scheduler is locked */
+                rt_enter_critical();
+                if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+                {
+                    rt_exit_critical();
+                    continue;
+                }
+
+                thread = (struct rt_thread *)obj;
+                rt_thread_get_stats(thread, &item.stats);
+                rt_strncpy(item.name, thread->name, RT_NAME_MAX);
+                item.priority = thread->current_priority;
+                item.stat = thread->stat & RT_THREAD_STAT_MASK;
+                if (thread == rt_thread_idle_gethandler())
+                    *idle_usage = item.stats.usage;
+                rt_exit_critical();
+
+                /* sort by cpu usage */
+                for (j = nr; j > 0 && items[j - 1].stats.usage < item.stats.usage; j--)
+                {
+                    items[j] = items[j - 1];
+                }
+                items[j] = item;
+                nr++;
+            }
+        }
+    }
+    while (next != (rt_list_t *)RT_NULL && nr < max_nr);
+
+    return nr;
+}
+
+static const char *top_stat(rt_uint8_t stat)
+{
+    if (stat == RT_THREAD_READY)        return "ready  ";
+    else if (stat == RT_THREAD_SUSPEND) return "suspend";
+    else if (stat == RT_THREAD_INIT)    return "init   ";
+    else if (stat == RT_THREAD_CLOSE)   return "close  ";
+    else if (stat == RT_THREAD_RUNNING) return "running";
+    return "unknown";
+}
+
+static int top(int argc, char **argv)
+{
+    struct top_item *items;
+    rt_int32_t interval = RT_CPU_USAGE_PERIOD;
+    rt_uint16_t idle_usage;
+    int count = 1, max_nr, nr, i;
+    const char *item_title = "thread";
+    int maxlen = RT_NAME_MAX;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-d") && i + 1 < argc)
+        {
+            interval = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+        {
+            count = atoi(argv[++i]);
+        }
+        else
+        {
+            rt_kprintf("Usage: top [-d interval_ms] [-n count]\n");
+            return -RT_EINVAL;
+        }
+    }
+    if (interval <= 0) interval = RT_CPU_USAGE_PERIOD;
+    if (count <= 0) count = 1;
+
+    max_nr = rt_object_get_length(RT_Object_Class_Thread) + LIST_FIND_OBJ_NR;
+    items = (struct top_item *)rt_malloc(max_nr * sizeof(struct top_item));
+    if (items == RT_NULL)
+    {
+        rt_kprintf("no memory\n");
+        return -RT_ENOMEM;
+    }
+
+    while (1)
+    {
+        nr = top_collect(items, max_nr, &idle_usage);
+
+        if (count > 1) clear();
+        rt_kprintf("cpu usage %3d.%02d%%, %d threads, sampling %d ms x %d\n",
+                   (10000 - idle_usage) / 100, (10000 - idle_usage) % 100,
+                   nr, RT_CPU_USAGE_PERIOD, RT_CPU_USAGE_WINDOW);
+        rt_kprintf("%-*.s pri  status    cpu%%    avg%%    max%%  stack used\n", maxlen, item_title);
+        object_split(maxlen);
+        rt_kprintf(" ---  ------- ------- ------- -------  ----------\n");
+        for (i = 0; i < nr; i++)
+        {
+            rt_kprintf("%-*.*s %3d  %s %3d.%02d %3d.%02d %3d.%02d  %4d/%-5d\n",
+                       maxlen, RT_NAME_MAX, items[i].name, items[i].priority, top_stat(items[i].stat),
+                       items[i].stats.usage / 100, items[i].stats.usage % 100,
+                       items[i].stats.usage_avg / 100, items[i].stats.usage_avg % 100,
+                       items[i].stats.usage_max / 100, items[i].stats.usage_max % 100,
+                       items[i].stats.stack_max_used, items[i].stats.stack_size);
+        }
+
+        if (--count == 0)
+            break;
+        rt_thread_mdelay(interval);
+    }
+
+    rt_free(items);
+
+    return 0;
+}
+MSH_CMD_EXPORT(top, show cpu usage of threads: top [-d interval_ms] [-n count]);
+#endif /* RT_USING_CPU_USAGE */
+
+#ifdef RT_USING_LOCKSTAT
+/* convert the time of lock statistics to microseconds */
+static rt_uint32_t lockstat_us(rt_uint64_t time)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)(time * clock_cpu_getres() / 1000);
+#else
+    return (rt_uint32_t)(time * 1000000 / RT_TICK_PER_SECOND);
+#endif /* RT_USING_CPUTIME */
+}
+
+static void lockstat_class(enum rt_object_class_type type, const char *type_name, int maxlen, rt_bool_t reset)
+{
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t *)RT_NULL;
+    struct rt_lockstat stat;
+    char name[RT_NAME_MAX];
+
+    list_find_init(&find_arg, type, obj_list, sizeof(obj_list) / sizeof(obj_list[0]));
+
+    do
+    {
+        next = list_get_next(next, &find_arg);
+        {
+            int i, j;
+            rt_uint32_t waits;
+
+            for (i = 0; i < find_arg.nr_out; i++)
+            {
+                struct rt_object *obj;
+
+                obj = rt_list_entry(obj_list[i], struct rt_object, list);
+                /* the object can't be deleted while scheduler is locked */
+                rt_enter_critical();
+                if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+                {
+                    rt_exit_critical();
+                    continue;
+                }
+
+                if (reset)
+                {
+                    rt_lockstat_reset(obj);
+                    rt_exit_critical();
+                    continue;
+                }
+
+                rt_lockstat_get(obj, &stat);
+                rt_strncpy(name, obj->name, RT_NAME_MAX);
+                rt_exit_critical();
+
+                /* skip the locks never used */
+                if (stat.acquire == 0 && stat.failed == 0)
+                    continue;
+
+                waits = stat.contended + stat.failed;
+                rt_kprintf("%-*.*s %-5s %10u %9u %6u %10u %10u",
+                           maxlen, RT_NAME_MAX, name, type_name,
+                           stat.acquire, stat.contended, stat.failed,
+                           waits ? lockstat_us(stat.wait_total / waits) : 0,
+                           lockstat_us(stat.wait_max));
+                if (type == RT_Object_Class_Mutex)
+                    rt_kprintf(" %10u\n", lockstat_us(stat.hold_max));
+                else
+                    rt_kprintf("          -\n");
+
+                for (j = 0; j < RT_LOCKSTAT_TOP_NUM; j++)
+                {
+                    if (stat.top[j].thread == RT_NULL)
+                        continue;
+
+                    rt_kprintf("    waiter %-*.*s %9u waits %10u us\n",
+                               RT_NAME_MAX, RT_NAME_MAX, stat.top[j].name,
+                               stat.top[j].count, lockstat_us(stat.top[j].wait_time));
+                }
+            }
+        }
+    }
+    while (next != (rt_list_t *)RT_NULL);
+}
+
+static int lockstat(int argc, char **argv)
+{
+    rt_bool_t reset = RT_FALSE;
+    const char *item_title = "lock";
+    int maxlen = RT_NAME_MAX;
+
+    if (argc == 2 && !strcmp(argv[1], "reset"))
+    {
+        reset = RT_TRUE;
+    }
+    else if (argc != 1)
+    {
+        rt_kprintf("Usage: lockstat [reset]\n");
+        return -RT_EINVAL;
+    }
+
+    if (!reset)
+    {
+        rt_kprintf("%-*.s type     acquire contended failed   wait avg   wait max   hold max(us)\n",
+                   maxlen, item_title);
+        object_split(maxlen);
+        rt_kprintf(" ----- ---------- --------- ------ ---------- ---------- ----------\n");
+    }
+
+#ifdef RT_USING_SEMAPHORE
+    lockstat_class(RT_Object_Class_Semaphore, "sem", maxlen, reset);
+#endif /* RT_USING_SEMAPHORE */
+#ifdef RT_USING_MUTEX
+    lockstat_class(RT_Object_Class_Mutex, "mutex", maxlen, reset);
+#endif /* RT_USING_MUTEX */
+#ifdef RT_USING_EVENT
+    lockstat_class(RT_Object_Class_Event, "event", maxlen, reset);
+#endif /* RT_USING_EVENT */
+
+    return 0;
+}
+MSH_CMD_EXPORT(lockstat, show lock contention statistics: lockstat [reset]);
+#endif /* RT_USING_LOCKSTAT */
+
 static void show_wait_queue(struct rt_list_node *list)
 {
     struct rt_thread *thread;
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        first version
+ * 2026-10-17     agent        stamp events in reservation order, mute the stream thread
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <systrace.h>
+
+#ifdef RT_USING_CPUTIME
+#include <drivers/cputime.h>
+#endif
+
+#define SYSTRACE_MASK           (SYSTRACE_BUFFER_SIZE - 1)
+
+static struct rt_systrace_event _systrace_buffer[SYSTRACE_BUFFER_SIZE];
+/* free running write index, slots are reserved by atomic increment */
+static volatile rt_base_t _systrace_head = 0;
+static volatile rt_bool_t _systrace_running = RT_FALSE;
+/* the thread printing the trace out, its own events would feed back into the trace */
+static rt_thread_t _systrace_quiet = RT_NULL;
+
+rt_inline rt_uint32_t _systrace_stamp(void)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)clock_cpu_gettime();
+#else
+    return (rt_uint32_t)rt_tick_get();
+#endif /* RT_USING_CPUTIME */
+}
+
+/**
+ * @brief This function will record one event into the trace buffer.
+ *
+ * @note It can be called from thread or interrupt context. The slot is
+ *       reserved and the timestamp is read with interrupts disabled, so the
+ *       events of a cpu are in timestamp order. When the buffer is full the
+ *       oldest event is overwritten.
+ *
+ * @param type is the event type, RT_SYSTRACE_USER and above for user events.
+ *
+ * @param arg0 is the first argument of the event.
+ *
+ * @param arg1 is the second argument of the event.
+ */
+void rt_systrace_record(rt_uint8_t type, rt_ubase_t arg0, rt_ubase_t arg1)
+{
+    rt_base_t level;
+    rt_uint32_t index, stamp;
+    volatile struct rt_systrace_event *event;
+
+    if (_systrace_running == RT_FALSE)
+        return;
+
+    /* keep the context switches of the streaming thread, they don't print anything */
+    if (_systrace_quiet != RT_NULL && type != RT_SYSTRACE_SWITCH &&
+        rt_interrupt_get_nest() == 0 && rt_thread_self() == _systrace_quiet)
+        return;
+
+    /* an interrupt between the reservation and the stamp would put a later stamp in an earlier slot */
+    level = rt_hw_interrupt_disable();
+    index = (rt_uint32_t)rt_hw_atomic_add(&_systrace_head, 1);
+    stamp = _systrace_stamp();
+    rt_hw_interrupt_enable(level);
+
+    event = &_systrace_buffer[index & SYSTRACE_MASK];
+
+    /* invalidate the slot while it is being written */
+    event->seq = 0;
+    event->timestamp = stamp;
+    event->type = type;
+#ifdef RT_USING_SMP
+    event->cpu = (rt_uint8_t)rt_hw_cpu_id();
+#else
+    event->cpu = 0;
+#endif /* RT_USING_SMP */
+    event->arg0 = (rt_uint32_t)arg0;
+    event->arg1 = (rt_uint32_t)arg1;
+    event->seq = (rt_uint16_t)(index + 1);
+}
+RTM_EXPORT(rt_systrace_record);
+
+/**
+ * @brief This function will copy committed events out of the trace buffer.
+ *
+ * @param index is the read index of the consumer, it is advanced by the
+ *        number of events consumed.
+ *
+ * @param events is the destination of the events.
+ *
+ * @param count is the maximum number of events to copy.
+ *
+ * @param lost is used to accumulate the number of events overwritten before
+ *        they could be read, can be RT_NULL.
+ *
+ * @return the number of events copied.
+ */
+rt_size_t rt_systrace_read(rt_uint32_t *index, struct rt_systrace_event *events,
+                           rt_size_t count, rt_uint32_t *lost)
+{
+    rt_size_t copied = 0;
+    rt_uint32_t head, skip = 0;
+    rt_uint16_t seq;
+    volatile struct rt_systrace_event *event;
+
+    RT_ASSERT(index != RT_NULL);
+    RT_ASSERT(events != RT_NULL);
+
+    while (copied < count)
+    {
+        head = (rt_uint32_t)_systrace_head;
+        if (head == *index)
+            break;
+
+        if (head - *index > SYSTRACE_BUFFER_SIZE)
+        {
+            /* the writer lapped the reader */
+            skip += head - *index - SYSTRACE_BUFFER_SIZE;
+            *index = head - SYSTRACE_BUFFER_SIZE;
+        }
+
+        event = &_systrace_buffer[*index & SYSTRACE_MASK];
+        seq = (rt_uint16_t)(*index + 1);
+        if (event->seq != seq)
+        {
+            /* overwritten by a newer event or not committed yet */
+            if ((rt_uint32_t)_systrace_head - *index > SYSTRACE_BUFFER_SIZE)
+                continue;
+            break;
+        }
+
+        events[copied].timestamp = event->timestamp;
+        events[copied].type = event->type;
+        events[copied].cpu = event->cpu;
+        events[copied].arg0 = event->arg0;
+        events[copied].arg1 = event->arg1;
+        events[copied].seq = seq;
+
+        /* check the slot was not reused while copying */
+        if (event->seq != seq)
+            continue;
+
+        *index += 1;
+        copied ++;
+    }
+
+    if (lost != RT_NULL)
+        *lost += skip;
+
+    return copied;
+}
+RTM_EXPORT(rt_systrace_read);
+
+/**
+ * @brief This function will return the current write index of the trace buffer.
+ *
+ * @return the write index.
+ */
+rt_uint32_t rt_systrace_head(void)
+{
+    return (rt_uint32_t)_systrace_head;
+}
+
+/**
+ * @brief This function will return the frequency of the event timestamp.
+ *
+ * @return the timestamp counts per second.
+ */
+rt_uint32_t rt_systrace_frequency(void)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)(1000000000.0f / clock_cpu_getres());
+#else
+    return RT_TICK_PER_SECOND;
+#endif /* RT_USING_CPUTIME */
+}
+
+static void _systrace_switch_hook(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_systrace_record(RT_SYSTRACE_SWITCH, (rt_ubase_t)from, (rt_ubase_t)to);
+}
+
+static void _systrace_irq_enter_hook(void)
+{
+    rt_systrace_record(RT_SYSTRACE_IRQ_ENTER, rt_interrupt_get_nest(), 0);
+}
+
+static void _systrace_irq_leave_hook(void)
+{
+    rt_systrace_record(RT_SYSTRACE_IRQ_LEAVE, rt_interrupt_get_nest(), 0);
+}
+
+static void _systrace_trytake_hook(struct rt_object *object)
+{
+    rt_systrace_record(RT_SYSTRACE_OBJ_TRYTAKE, (rt_ubase_t)object, (rt_ubase_t)rt_thread_self());
+}
+
+static void _systrace_take_hook(struct rt_object *object)
+{
+    rt_systrace_record(RT_SYSTRACE_OBJ_TAKE, (rt_ubase_t)object, (rt_ubase_t)rt_thread_self());
+}
+
+static void _systrace_put_hook(struct rt_object *object)
+{
+    rt_systrace_record(RT_SYSTRACE_OBJ_PUT, (rt_ubase_t)object, (rt_ubase_t)rt_thread_self());
+}
+
+static void _systrace_suspend_hook(rt_thread_t thread)
+{
+    rt_systrace_record(RT_SYSTRACE_THREAD_SUSPEND, (rt_ubase_t)thread, (rt_ubase_t)rt_thread_self());
+}
+
+static void _systrace_resume_hook(rt_thread_t thread)
+{
+    rt_systrace_record(RT_SYSTRACE_THREAD_RESUME, (rt_ubase_t)thread, (rt_ubase_t)rt_thread_self());
+}
+
+static void _systrace_timer_enter_hook(struct rt_timer *timer)
+{
+    rt_systrace_record(RT_SYSTRACE_TIMER_ENTER, (rt_ubase_t)timer, 0);
+}
+
+static void _systrace_timer_exit_hook(struct rt_timer *timer)
+{
+    rt_systrace_record(RT_SYSTRACE_TIMER_EXIT, (rt_ubase_t)timer, 0);
+}
+
+/**
+ * @brief This function will start tracing.
+ *
+ * @note The kernel hooks of scheduler, interrupt, ipc object, thread
+ *       suspend/resume and timer are taken over by the tracer until
+ *       rt_systrace_stop() is called.
+ */
+void rt_systrace_start(void)
+{
+    rt_scheduler_sethook(_systrace_switch_hook);
+    rt_interrupt_enter_sethook(_systrace_irq_enter_hook);
+    rt_interrupt_leave_sethook(_systrace_irq_leave_hook);
+    rt_object_trytake_sethook(_systrace_trytake_hook);
+    rt_object_take_sethook(_systrace_take_hook);
+    rt_object_put_sethook(_systrace_put_hook);
+    rt_thread_suspend_sethook(_systrace_suspend_hook);
+    rt_thread_resume_sethook(_systrace_resume_hook);
+    rt_timer_enter_sethook(_systrace_timer_enter_hook);
+    rt_timer_exit_sethook(_systrace_timer_exit_hook);
+
+    _systrace_running = RT_TRUE;
+}
+RTM_EXPORT(rt_systrace_start);
+
+/**
+ * @brief This function will stop tracing and release the kernel hooks.
+ */
+void rt_systrace_stop(void)
+{
+    _systrace_running = RT_FALSE;
+
+    rt_scheduler_sethook(RT_NULL);
+    rt_interrupt_enter_sethook(RT_NULL);
+    rt_interrupt_leave_sethook(RT_NULL);
+    rt_object_trytake_sethook(RT_NULL);
+    rt_object_take_sethook(RT_NULL);
+    rt_object_put_sethook(RT_NULL);
+    rt_thread_suspend_sethook(RT_NULL);
+    rt_thread_resume_sethook(RT_NULL);
+    rt_timer_enter_sethook(RT_NULL);
+    rt_timer_exit_sethook(RT_NULL);
+}
+RTM_EXPORT(rt_systrace_stop);
+
+/**
+ * @brief This function will drop all events in the trace buffer.
+ */
+void rt_systrace_clear(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(_systrace_buffer, 0, sizeof(_systrace_buffer));
+    _systrace_head = 0;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_systrace_clear);
+
+rt_bool_t rt_systrace_is_running(void)
+{
+    return _systrace_running;
+}
+
+int rt_systrace_init(void)
+{
+#ifdef SYSTRACE_AUTO_START
+    rt_systrace_start();
+#endif /* SYSTRACE_AUTO_START */
+
+    return 0;
+}
+INIT_COMPONENT_EXPORT(rt_systrace_init);
+
+#ifdef RT_USING_FINSH
+#include <stdlib.h>
+
+#define SYSTRACE_DUMP_BATCH     16
+
+struct _systrace_name
+{
+    rt_uint32_t object;
+    rt_uint8_t  type;
+    rt_uint8_t  priority;
+    char name[RT_NAME_MAX];
+};
+
+static void _systrace_dump_objects(enum rt_object_class_type type)
+{
+    int index, count;
+    rt_object_t *objects;
+    struct _systrace_name *names;
+
+    count = rt_object_get_length(type);
+    if (count <= 0)
+        return;
+
+    objects = (rt_object_t *)rt_malloc(count * (sizeof(rt_object_t) + sizeof(struct _systrace_name)));
+    if (objects == RT_NULL)
+        return;
+    names = (struct _systrace_name *)(objects + count);
+
+    /* copy out the names with scheduler locked, objects can't be deleted */
+    rt_enter_critical();
+    count = rt_object_get_pointers(type, objects, count);
+    for (index = 0; index < count; index ++)
+    {
+        names[index].object = (rt_uint32_t)(rt_ubase_t)objects[index];
+        names[index].type = (rt_uint8_t)type;
+        names[index].priority = 0;
+        if (type == RT_Object_Class_Thread)
+            names[index].priority = ((rt_thread_t)objects[index])->current_priority;
+        rt_strncpy(names[index].name, objects[index]->name, RT_NAME_MAX);
+    }
+    rt_exit_critical();
+
+    for (index = 0; index < count; index ++)
+    {
+        rt_kprintf("#object %08x %d %d %.*s\n", names[index].object, names[index].type,
+                   names[index].priority, RT_NAME_MAX, names[index].name);
+    }
+
+    rt_free(objects);
+}
+
+static void _systrace_dump_header(void)
+{
+    rt_kprintf("#systrace 1 freq=%u size=%d\n", rt_systrace_frequency(), SYSTRACE_BUFFER_SIZE);
+
+    _systrace_dump_objects(RT_Object_Class_Thread);
+#ifdef RT_USING_SEMAPHORE
+    _systrace_dump_objects(RT_Object_Class_Semaphore);
+#endif
+#ifdef RT_USING_MUTEX
+    _systrace_dump_objects(RT_Object_Class_Mutex);
+#endif
+#ifdef RT_USING_EVENT
+    _systrace_dump_objects(RT_Object_Class_Event);
+#endif
+#ifdef RT_USING_MAILBOX
+    _systrace_dump_objects(RT_Object_Class_MailBox);
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    _systrace_dump_objects(RT_Object_Class_MessageQueue);
+#endif
+    _systrace_dump_objects(RT_Object_Class_Timer);
+}
+
+static rt_size_t _systrace_dump_events(rt_uint32_t *index, rt_uint32_t *lost)
+{
+    rt_size_t count, total = 0, i;
+    struct rt_systrace_event events[SYSTRACE_DUMP_BATCH];
+
+    while ((count = rt_systrace_read(index, events, SYSTRACE_DUMP_BATCH, lost)) > 0)
+    {
+        for (i = 0; i < count; i ++)
+        {
+            rt_kprintf("%08x %02x %02x %08x %08x\n", events[i].timestamp, events[i].type,
+                       events[i].cpu, events[i].arg0, events[i].arg1);
+        }
+        total += count;
+    }
+
+    return total;
+}
+
+static void systrace(int argc, char **argv)
+{
+    rt_uint32_t index, lost = 0;
+
+    if (argc < 2)
+    {
+        goto _usage;
+    }
+
+    if (!rt_strcmp(argv[1], "start"))
+    {
+        rt_systrace_start();
+    }
+    else if (!rt_strcmp(argv[1], "stop"))
+    {
+        rt_systrace_stop();
+    }
+    else if (!rt_strcmp(argv[1], "clear"))
+    {
+        rt_systrace_clear();
+    }
+    else if (!rt_strcmp(argv[1], "dump"))
+    {
+        /* freeze the buffer so the snapshot is consistent */
+        rt_systrace_stop();
+
+        index = rt_systrace_head();
+        index = (index > SYSTRACE_BUFFER_SIZE) ? index - SYSTRACE_BUFFER_SIZE : 0;
+        _systrace_dump_header();
+        _systrace_dump_events(&index, &lost);
+        rt_kprintf("#end lost=%u\n", lost);
+    }
+    else if (!rt_strcmp(argv[1], "stream"))
+    {
+        rt_tick_t duration, start;
+
+        duration = rt_tick_from_millisecond(argc > 2 ? atoi(argv[2]) : 1000);
+
+        _systrace_dump_header();
+        index = rt_systrace_head();
+        /*
+         * the console is written by polling, muting this thread is enough to
+         * keep the printed events out of the trace
+         */
+        _systrace_quiet = rt_thread_self();
+        if (rt_systrace_is_running() == RT_FALSE)
+            rt_systrace_start();
+
+        start = rt_tick_get();
+        while (rt_tick_get() - start < duration)
+        {
+            if (_systrace_dump_events(&index, &lost) == 0)
+                rt_thread_mdelay(10);
+        }
+        rt_systrace_stop();
+        _systrace_quiet = RT_NULL;
+        _systrace_dump_events(&index, &lost);
+        rt_kprintf("#end lost=%u\n", lost);
+    }
+    else
+    {
+        goto _usage;
+    }
+
+    return;
+
+_usage:
+    rt_kprintf("Usage:\n");
+    rt_kprintf("systrace start        - start tracing\n");
+    rt_kprintf("systrace stop         - stop tracing\n");
+    rt_kprintf("systrace clear        - drop all recorded events\n");
+    rt_kprintf("systrace dump         - stop tracing and dump a snapshot\n");
+    rt_kprintf("systrace stream [ms]  - trace and dump events for ms milliseconds\n");
+}
+MSH_CMD_EXPORT(systrace, system trace control: systrace <start|stop|clear|dump|stream [ms]>);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        first version
+ */
+
+#ifndef __SYSTRACE_H__
+#define __SYSTRACE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SYSTRACE_BUFFER_SIZE
+#define SYSTRACE_BUFFER_SIZE            1024
+#endif
+
+#if (SYSTRACE_BUFFER_SIZE & (SYSTRACE_BUFFER_SIZE - 1)) != 0
+#error "SYSTRACE_BUFFER_SIZE must be a power of two"
+#endif
+
+/* trace event type */
+enum rt_systrace_type
+{
+    RT_SYSTRACE_NONE = 0,
+    RT_SYSTRACE_SWITCH,                 /* arg0: from thread, arg1: to thread */
+    RT_SYSTRACE_IRQ_ENTER,              /* arg0: interrupt nest */
+    RT_SYSTRACE_IRQ_LEAVE,              /* arg0: interrupt nest */
+    RT_SYSTRACE_OBJ_TRYTAKE,            /* arg0: ipc object, arg1: current thread */
+    RT_SYSTRACE_OBJ_TAKE,               /* arg0: ipc object, arg1: current thread */
+    RT_SYSTRACE_OBJ_PUT,                /* arg0: ipc object, arg1: current thread */
+    RT_SYSTRACE_THREAD_SUSPEND,         /* arg0: suspended thread, arg1: current thread */
+    RT_SYSTRACE_THREAD_RESUME,          /* arg0: resumed thread, arg1: current thread */
+    RT_SYSTRACE_TIMER_ENTER,            /* arg0: timer */
+    RT_SYSTRACE_TIMER_EXIT,             /* arg0: timer */
+    RT_SYSTRACE_USER,                   /* arg0, arg1: user defined */
+};
+
+/* trace event record, 16 bytes */
+struct rt_systrace_event
+{
+    rt_uint32_t timestamp;              /* low 32 bits of cputime */
+    rt_uint8_t  type;                   /* enum rt_systrace_type */
+    rt_uint8_t  cpu;                    /* cpu id */
+    rt_uint16_t seq;                    /* low 16 bits of (slot index + 1), written last */
+    rt_uint32_t arg0;
+    rt_uint32_t arg1;
+};
+
+int  rt_systrace_init(void);
+void rt_systrace_start(void);
+void rt_systrace_stop(void);
+void rt_systrace_clear(void);
+rt_bool_t rt_systrace_is_running(void);
+
+void rt_systrace_record(rt_uint8_t type, rt_ubase_t arg0, rt_ubase_t arg1);
+rt_size_t rt_systrace_read(rt_uint32_t *index, struct rt_systrace_event *events,
+                           rt_size_t count, rt_uint32_t *lost);
+rt_uint32_t rt_systrace_head(void);
+rt_uint32_t rt_systrace_frequency(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYSTRACE_H__ */
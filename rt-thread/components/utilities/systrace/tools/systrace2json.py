@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2022, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-17     agent        first version
+# 2026-10-17     agent        unwrap the timestamp on a large backward step only
+#
+# Convert the console output of `systrace dump` or `systrace stream` into
+# Chrome trace event JSON, which can be opened by chrome://tracing or
+# https://ui.perfetto.dev
+#
+# usage: systrace2json.py console.log [-o trace.json]
+
+import argparse
+import json
+import sys
+
+EVENT_SWITCH         = 0x01
+EVENT_IRQ_ENTER      = 0x02
+EVENT_IRQ_LEAVE      = 0x03
+EVENT_OBJ_TRYTAKE    = 0x04
+EVENT_OBJ_TAKE       = 0x05
+EVENT_OBJ_PUT        = 0x06
+EVENT_THREAD_SUSPEND = 0x07
+EVENT_THREAD_RESUME  = 0x08
+EVENT_TIMER_ENTER    = 0x09
+EVENT_TIMER_EXIT     = 0x0a
+EVENT_USER           = 0x0b
+
+# enum rt_object_class_type
+OBJECT_CLASS = {
+    1: 'thread', 2: 'sem', 3: 'mutex', 4: 'event',
+    5: 'mailbox', 6: 'mq', 10: 'timer',
+}
+
+PID = 1
+TID_IRQ = 1
+TID_TIMER = 2
+
+
+class Decoder(object):
+    def __init__(self):
+        self.freq = 1
+        self.objects = {}
+        self.threads = {}
+        self.events = []
+        self.lost = 0
+        self.last_stamp = None
+        self.last_time = 0
+        self.current = {}
+        self.irq_nest = {}
+        self.tids = {}
+
+    def tid(self, thread):
+        if thread not in self.tids:
+            self.tids[thread] = len(self.tids) + 16
+            name = self.threads.get(thread, ('%08x' % thread, 0))
+            self.events.append({'ph': 'M', 'pid': PID, 'tid': self.tids[thread],
+                                'name': 'thread_name',
+                                'args': {'name': '%s (prio %d)' % name}})
+        return self.tids[thread]
+
+    def name(self, obj):
+        if obj in self.objects:
+            return '%s %s' % self.objects[obj]
+        return '%08x' % obj
+
+    def timestamp(self, stamp):
+        # unwrap the 32 bits counter: a step of 2^31 or more backward is a wrap,
+        # a shorter one is an event stamped before the previous one (other cpu)
+        if self.last_stamp is not None:
+            delta = (stamp - self.last_stamp) & 0xffffffff
+            if delta >= 1 << 31:
+                delta -= 1 << 32
+            self.last_time += delta
+        else:
+            self.last_time = stamp
+        self.last_stamp = stamp
+        return self.last_time * 1000000.0 / self.freq
+
+    def header(self, line):
+        fields = line.split()
+        if fields[0] == '#systrace':
+            for item in fields[2:]:
+                key, _, value = item.partition('=')
+                if key == 'freq':
+                    self.freq = int(value)
+        elif fields[0] == '#object' and len(fields) >= 4:
+            obj = int(fields[1], 16)
+            cls = int(fields[2])
+            name = fields[4] if len(fields) > 4 else ''
+            if cls == 1:
+                self.threads[obj] = (name, int(fields[3]))
+            self.objects[obj] = (OBJECT_CLASS.get(cls, 'object'), name)
+        elif fields[0] == '#end':
+            for item in fields[1:]:
+                key, _, value = item.partition('=')
+                if key == 'lost':
+                    self.lost += int(value)
+
+    def begin(self, tid, name, ts, args=None):
+        event = {'ph': 'B', 'pid': PID, 'tid': tid, 'name': name, 'ts': ts}
+        if args:
+            event['args'] = args
+        self.events.append(event)
+
+    def end(self, tid, ts):
+        self.events.append({'ph': 'E', 'pid': PID, 'tid': tid, 'ts': ts})
+
+    def instant(self, tid, name, ts, args=None):
+        event = {'ph': 'i', 's': 't', 'pid': PID, 'tid': tid, 'name': name, 'ts': ts}
+        if args:
+            event['args'] = args
+        self.events.append(event)
+
+    def record(self, fields):
+        stamp, etype, cpu, arg0, arg1 = [int(x, 16) for x in fields]
+        ts = self.timestamp(stamp)
+
+        if etype == EVENT_SWITCH:
+            if cpu in self.current:
+                self.end(self.tid(self.current[cpu]), ts)
+            self.current[cpu] = arg1
+            self.begin(self.tid(arg1), 'running', ts, {'cpu': cpu, 'from': self.name(arg0)})
+        elif etype == EVENT_IRQ_ENTER:
+            self.irq_nest[cpu] = self.irq_nest.get(cpu, 0) + 1
+            self.begin(TID_IRQ, 'irq', ts, {'cpu': cpu, 'nest': arg0})
+        elif etype == EVENT_IRQ_LEAVE:
+            if self.irq_nest.get(cpu, 0) > 0:
+                self.irq_nest[cpu] -= 1
+                self.end(TID_IRQ, ts)
+        elif etype in (EVENT_OBJ_TRYTAKE, EVENT_OBJ_TAKE, EVENT_OBJ_PUT):
+            action = {EVENT_OBJ_TRYTAKE: 'trytake', EVENT_OBJ_TAKE: 'take',
+                      EVENT_OBJ_PUT: 'put'}[etype]
+            self.instant(self.tid(arg1), '%s %s' % (action, self.name(arg0)), ts)
+        elif etype == EVENT_THREAD_SUSPEND:
+            self.instant(self.tid(arg0), 'block', ts, {'by': self.name(arg1)})
+        elif etype == EVENT_THREAD_RESUME:
+            self.instant(self.tid(arg0), 'wake', ts, {'by': self.name(arg1)})
+        elif etype == EVENT_TIMER_ENTER:
+            self.begin(TID_TIMER, self.name(arg0), ts)
+        elif etype == EVENT_TIMER_EXIT:
+            self.end(TID_TIMER, ts)
+        else:
+            self.instant(self.tid(self.current.get(cpu, 0)), 'user %d' % etype, ts,
+                         {'arg0': '%08x' % arg0, 'arg1': '%08x' % arg1})
+
+    def feed(self, line):
+        line = line.strip()
+        if line.startswith('#'):
+            self.header(line)
+            return
+        fields = line.split()
+        if len(fields) != 5 or len(fields[0]) != 8:
+            return
+        try:
+            self.record(fields)
+        except ValueError:
+            pass
+
+    def result(self):
+        meta = [
+            {'ph': 'M', 'pid': PID, 'name': 'process_name', 'args': {'name': 'rt-thread'}},
+            {'ph': 'M', 'pid': PID, 'tid': TID_IRQ, 'name': 'thread_name', 'args': {'name': 'interrupt'}},
+            {'ph': 'M', 'pid': PID, 'tid': TID_TIMER, 'name': 'thread_name', 'args': {'name': 'timer'}},
+        ]
+        return {'traceEvents': meta + self.events, 'displayTimeUnit': 'ns',
+                'otherData': {'lost': self.lost, 'freq': self.freq}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='convert systrace dump to Chrome trace JSON')
+    parser.add_argument('input', help='console log with systrace dump')
+    parser.add_argument('-o', '--output', help='output json file, default stdout')
+    args = parser.parse_args()
+
+    decoder = Decoder()
+    with open(args.input, 'r', errors='ignore') as f:
+        for line in f:
+            decoder.feed(line)
+
+    if decoder.lost:
+        sys.stderr.write('warning: %d events lost\n' % decoder.lost)
+
+    output = open(args.output, 'w') if args.output else sys.stdout
+    json.dump(decoder.result(), output, indent=1)
+    if args.output:
+        output.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+/* the replay queue of the audio framework, a block pool of 8 blocks and 4 fetched at once */
+#define DQ_BENCH_BLOCKS         8
+#define DQ_BENCH_BATCH          4
+#define DQ_BENCH_FRAMES         2000
+#define DQ_BENCH_MAX_SIZE       4096
+
+#define MIN(a, b)               ((a) < (b) ? (a) : (b))
+
+static struct rt_data_queue _queue;
+static rt_uint8_t *_src, *_dst;
+static rt_uint32_t _events[RT_DATAQUEUE_EVENT_HWM + 1];
+
+static void _evt_notify(struct rt_data_queue *queue, rt_uint32_t event)
+{
+    if (event <= RT_DATAQUEUE_EVENT_HWM)
+        _events[event]++;
+}
+
+/* a batch keeps the order, stops at full or empty, and notifies once */
+static void test_dataqueue_batch(void)
+{
+    const void *data[DQ_BENCH_BLOCKS];
+    rt_size_t size[DQ_BENCH_BLOCKS];
+    int i;
+
+    rt_memset(_events, 0, sizeof(_events));
+    rt_data_queue_set_watermark(&_queue, 2, 6);
+
+    for (i = 0; i < DQ_BENCH_BLOCKS; i++)
+    {
+        data[i] = _src + i;
+        size[i] = i + 1;
+    }
+
+    uassert_int_equal(rt_data_queue_push_batch(&_queue, data, size, 5, RT_WAITING_NO), 5);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_PUSH], 1);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_HWM], 0);
+
+    /* only the free slots are taken */
+    uassert_int_equal(rt_data_queue_push_batch(&_queue, &data[5], &size[5], 5, RT_WAITING_NO), 3);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_PUSH], 2);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_HWM], 1);
+    uassert_int_equal(rt_data_queue_push_batch(&_queue, data, size, 1, RT_WAITING_NO), -RT_ETIMEOUT);
+
+    /* a peek leaves the data in the queue */
+    rt_memset(data, 0, sizeof(data));
+    uassert_int_equal(rt_data_queue_peek_batch(&_queue, data, size, DQ_BENCH_BATCH), DQ_BENCH_BATCH);
+    uassert_int_equal(rt_data_queue_len(&_queue), DQ_BENCH_BLOCKS);
+    for (i = 0; i < DQ_BENCH_BATCH; i++)
+    {
+        uassert_true(data[i] == _src + i);
+        uassert_int_equal(size[i], i + 1);
+    }
+
+    /* above the low water mark */
+    uassert_int_equal(rt_data_queue_pop_batch(&_queue, data, size, 3, RT_WAITING_NO), 3);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_POP], 1);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_LWM], 0);
+
+    /* only the queued data is fetched */
+    rt_memset(data, 0, sizeof(data));
+    uassert_int_equal(rt_data_queue_pop_batch(&_queue, data, size, DQ_BENCH_BLOCKS, RT_WAITING_NO), 5);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_POP], 1);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_LWM], 1);
+    for (i = 0; i < 5; i++)
+    {
+        uassert_true(data[i] == _src + 3 + i);
+        uassert_int_equal(size[i], 3 + i + 1);
+    }
+
+    uassert_int_equal(rt_data_queue_len(&_queue), 0);
+    uassert_int_equal(rt_data_queue_peek_batch(&_queue, data, size, 1), -RT_EEMPTY);
+    uassert_int_equal(rt_data_queue_pop_batch(&_queue, data, size, 1, RT_WAITING_NO), -RT_ETIMEOUT);
+
+    rt_data_queue_set_watermark(&_queue, 0, 0);
+}
+
+/* the frame handler before the batch calls, a peek and a pop per block */
+static rt_size_t _replay_frame(rt_size_t dst_size, rt_uint32_t *read_index)
+{
+    const void *data;
+    rt_size_t size, index = 0, remain_bytes;
+
+    while (index < dst_size)
+    {
+        if (rt_data_queue_peek(&_queue, &data, &size) != RT_EOK)
+            break;
+
+        remain_bytes = MIN(dst_size - index, size - *read_index);
+        rt_memcpy(&_dst[index], &((rt_uint8_t *)data)[*read_index], remain_bytes);
+        index += remain_bytes;
+        *read_index += remain_bytes;
+
+        if (*read_index == size)
+        {
+            *read_index = 0;
+            rt_data_queue_pop(&_queue, &data, &size, RT_WAITING_NO);
+
+            /* the writer refills the block at once */
+            rt_data_queue_push(&_queue, data, size, RT_WAITING_NO);
+        }
+    }
+
+    return index;
+}
+
+/* the frame handler of the audio framework, blocks are fetched and freed by batch */
+static rt_size_t _replay_frame_batch(rt_size_t dst_size, rt_uint32_t *read_index)
+{
+    const void *data[DQ_BENCH_BATCH];
+    rt_size_t size[DQ_BENCH_BATCH], index = 0, remain_bytes;
+    rt_ssize_t nr, done = 0;
+
+    nr = rt_data_queue_peek_batch(&_queue, data, size, DQ_BENCH_BATCH);
+    if (nr <= 0)
+        return 0;
+
+    while (index < dst_size)
+    {
+        if (done == nr)
+        {
+            rt_data_queue_pop_batch(&_queue, data, size, done, RT_WAITING_NO);
+            rt_data_queue_push_batch(&_queue, data, size, done, RT_WAITING_NO);
+            done = 0;
+
+            nr = rt_data_queue_peek_batch(&_queue, data, size, DQ_BENCH_BATCH);
+            if (nr <= 0)
+                break;
+        }
+
+        remain_bytes = MIN(dst_size - index, size[done] - *read_index);
+        rt_memcpy(&_dst[index], &((rt_uint8_t *)data[done])[*read_index], remain_bytes);
+        index += remain_bytes;
+        *read_index += remain_bytes;
+
+        if (*read_index == size[done])
+        {
+            *read_index = 0;
+            done++;
+        }
+    }
+
+    if (done > 0)
+    {
+        rt_data_queue_pop_batch(&_queue, data, size, done, RT_WAITING_NO);
+        rt_data_queue_push_batch(&_queue, data, size, done, RT_WAITING_NO);
+    }
+
+    return index;
+}
+
+/* cycles per replay frame with the queue kept full by the writer */
+static void _replay_bench(rt_size_t block_size, rt_size_t dst_size)
+{
+    rt_size_t (*frame[2])(rt_size_t, rt_uint32_t *) = { _replay_frame, _replay_frame_batch };
+    rt_uint64_t begin, cycles[2];
+    rt_uint32_t read_index, errors = 0;
+    const void *data;
+    rt_size_t size;
+    int i, j;
+
+    for (j = 0; j < 2; j++)
+    {
+        for (i = 0; i < DQ_BENCH_BLOCKS; i++)
+            rt_data_queue_push(&_queue, _src, block_size, RT_WAITING_NO);
+
+        read_index = 0;
+        begin = clock_cpu_gettime();
+        for (i = 0; i < DQ_BENCH_FRAMES; i++)
+        {
+            if (frame[j](dst_size, &read_index) != dst_size)
+                errors++;
+        }
+        cycles[j] = clock_cpu_gettime() - begin;
+
+        /* no block is lost or duplicated */
+        uassert_int_equal(rt_data_queue_len(&_queue), DQ_BENCH_BLOCKS);
+        while (rt_data_queue_pop(&_queue, &data, &size, RT_WAITING_NO) == RT_EOK);
+    }
+
+    LOG_I("block %4d frame %4d: %u cycles per frame block by block, %u cycles by batch", block_size, dst_size,
+          (rt_uint32_t)(cycles[0] / DQ_BENCH_FRAMES), (rt_uint32_t)(cycles[1] / DQ_BENCH_FRAMES));
+    uassert_int_equal(errors, 0);
+}
+
+static void test_dataqueue_replay_bench(void)
+{
+    _replay_bench(4096, 1024);
+    _replay_bench(4096, 4096);
+    _replay_bench(1024, 4096);
+    _replay_bench(512, 4096);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _src = rt_malloc(DQ_BENCH_MAX_SIZE * 2);
+    if (_src == RT_NULL)
+        return -RT_ENOMEM;
+    _dst = _src + DQ_BENCH_MAX_SIZE;
+
+    rt_memset(_src, 0x5a, DQ_BENCH_MAX_SIZE);
+
+    return rt_data_queue_init(&_queue, DQ_BENCH_BLOCKS, 0, _evt_notify);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_data_queue_deinit(&_queue);
+    rt_free(_src);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_dataqueue_batch);
+    UTEST_UNIT_RUN(test_dataqueue_replay_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.dataqueue_bench_tc", utest_tc_init, utest_tc_cleanup, 10);
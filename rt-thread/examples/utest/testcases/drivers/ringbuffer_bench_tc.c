@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+/* not a power of two runs the 32 bit ring in its mirror mode */
+#define RB_BENCH_SIZE           4000
+#define RB_BENCH_SIZE_POW2      4096
+#define RB_BENCH_BYTES          (1024 * 1024)
+#define RB_CHECK_ROUNDS         20000
+
+struct rb_bench_ops
+{
+    const char *name;
+    rt_size_t (*put)(void *rb, const rt_uint8_t *ptr, rt_uint32_t length);
+    rt_size_t (*get)(void *rb, rt_uint8_t *ptr, rt_uint32_t length);
+    void *rb;
+};
+
+static struct rt_ringbuffer _rb16;
+static struct rt_ringbuffer32 _rb32, _rb32_pow2;
+static rt_uint8_t *_pool;
+
+static rt_size_t _rb16_put(void *rb, const rt_uint8_t *ptr, rt_uint32_t length)
+{
+    return rt_ringbuffer_put(rb, ptr, length);
+}
+
+static rt_size_t _rb16_get(void *rb, rt_uint8_t *ptr, rt_uint32_t length)
+{
+    return rt_ringbuffer_get(rb, ptr, length);
+}
+
+static rt_size_t _rb32_put(void *rb, const rt_uint8_t *ptr, rt_uint32_t length)
+{
+    return rt_ringbuffer32_put(rb, ptr, length);
+}
+
+static rt_size_t _rb32_get(void *rb, rt_uint8_t *ptr, rt_uint32_t length)
+{
+    return rt_ringbuffer32_get(rb, ptr, length);
+}
+
+static const struct rb_bench_ops _bench_ops[] =
+{
+    { "rt_ringbuffer",        _rb16_put, _rb16_get, &_rb16 },
+    { "rt_ringbuffer32",      _rb32_put, _rb32_get, &_rb32 },
+    { "rt_ringbuffer32 pow2", _rb32_put, _rb32_get, &_rb32_pow2 },
+};
+
+static rt_uint32_t _rand(rt_uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+
+    return *seed >> 16;
+}
+
+/* random put, get, and span calls against the sequence number of each byte */
+static void _rb32_check(struct rt_ringbuffer32 *rb)
+{
+    rt_uint8_t data[300], *span;
+    rt_uint8_t put_seq = 0, get_seq = 0;
+    rt_uint32_t seed = 1, level = 0;
+    rt_size_t length, i;
+    int round;
+
+    for (round = 0; round < RB_CHECK_ROUNDS; round++)
+    {
+        switch (_rand(&seed) % 4)
+        {
+        case 0:
+            length = _rand(&seed) % sizeof(data);
+            for (i = 0; i < length; i++)
+                data[i] = put_seq + i;
+            length = rt_ringbuffer32_put(rb, data, length);
+            put_seq += length;
+            level += length;
+            break;
+
+        case 1:
+            length = rt_ringbuffer32_put_peek(rb, &span);
+            length = length ? _rand(&seed) % (length + 1) : 0;
+            for (i = 0; i < length; i++)
+                span[i] = put_seq++;
+            rt_ringbuffer32_put_commit(rb, length);
+            level += length;
+            break;
+
+        case 2:
+            length = rt_ringbuffer32_get(rb, data, _rand(&seed) % sizeof(data));
+            for (i = 0; i < length; i++)
+            {
+                if (data[i] != get_seq++)
+                {
+                    uassert_int_equal(data[i], (rt_uint8_t)(get_seq - 1));
+                    return;
+                }
+            }
+            level -= length;
+            break;
+
+        default:
+            length = rt_ringbuffer32_get_peek(rb, &span);
+            length = length ? _rand(&seed) % (length + 1) : 0;
+            for (i = 0; i < length; i++)
+            {
+                if (span[i] != get_seq++)
+                {
+                    uassert_int_equal(span[i], (rt_uint8_t)(get_seq - 1));
+                    return;
+                }
+            }
+            rt_ringbuffer32_get_commit(rb, length);
+            level -= length;
+            break;
+        }
+
+        if (rt_ringbuffer32_data_len(rb) != level ||
+                rt_ringbuffer32_space_len(rb) != rb->buffer_size - level)
+        {
+            uassert_int_equal(rt_ringbuffer32_data_len(rb), level);
+            return;
+        }
+    }
+
+    uassert_true(RT_TRUE);
+}
+
+static void test_ringbuffer32_check(void)
+{
+    _rb32_check(&_rb32);
+    _rb32_check(&_rb32_pow2);
+
+    /* the free running indexes of the power-of-two mode wrap at 2^32 */
+    _rb32_pow2.read_index = 0xffffff00UL;
+    _rb32_pow2.write_index = 0xffffff00UL;
+    _rb32_check(&_rb32_pow2);
+
+    rt_ringbuffer32_reset(&_rb32);
+    rt_ringbuffer32_reset(&_rb32_pow2);
+}
+
+/* KiB per second through one put and one get of chunk bytes per round */
+static rt_uint32_t _bench_run(const struct rb_bench_ops *ops, rt_uint8_t *chunk, rt_uint32_t length)
+{
+    rt_uint64_t begin, elapsed;
+    rt_uint32_t total;
+    float ns;
+
+    begin = clock_cpu_gettime();
+    for (total = 0; total < RB_BENCH_BYTES; total += length)
+    {
+        if (ops->put(ops->rb, chunk, length) != length ||
+                ops->get(ops->rb, chunk, length) != length)
+        {
+            uassert_true(RT_FALSE);
+            return 0;
+        }
+    }
+    elapsed = clock_cpu_gettime() - begin;
+
+    ns = (float)elapsed * clock_cpu_getres();
+    if (ns < 1.0f)
+        return 0;
+
+    return (rt_uint32_t)((float)total * (1000000000.0f / 1024) / ns);
+}
+
+static void test_ringbuffer_bench(void)
+{
+    static const rt_uint32_t lengths[] = { 1, 16, 256, 1000 };
+    rt_uint8_t *chunk;
+    int i, j;
+
+    chunk = rt_malloc(1000);
+    uassert_not_null(chunk);
+    if (chunk == RT_NULL)
+        return;
+
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        for (j = 0; j < sizeof(_bench_ops) / sizeof(_bench_ops[0]); j++)
+        {
+            LOG_I("%-20s chunk %4d: %u KiB/s", _bench_ops[j].name, lengths[i],
+                  _bench_run(&_bench_ops[j], chunk, lengths[i]));
+        }
+    }
+
+    rt_free(chunk);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _pool = rt_malloc(RB_BENCH_SIZE * 2 + RB_BENCH_SIZE_POW2);
+    if (_pool == RT_NULL)
+        return -RT_ENOMEM;
+
+    rt_ringbuffer_init(&_rb16, _pool, RB_BENCH_SIZE);
+    rt_ringbuffer32_init(&_rb32, _pool + RB_BENCH_SIZE, RB_BENCH_SIZE);
+    rt_ringbuffer32_init(&_rb32_pow2, _pool + RB_BENCH_SIZE * 2, RB_BENCH_SIZE_POW2);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(_pool);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_ringbuffer32_check);
+    UTEST_UNIT_RUN(test_ringbuffer_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.ringbuffer_bench_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define SERIAL_BENCH_BUFSZ      256
+#define SERIAL_BENCH_HW_FIFO    16
+#define SERIAL_BENCH_BYTES      (256 * 1024)
+
+/* a uart whose receiver holds the bytes of a counter */
+static struct rt_serial_device _serial;
+static rt_uint8_t _rx_seq;
+static rt_size_t _rx_pending;
+
+static rt_err_t _uart_configure(struct rt_serial_device *serial, struct serial_configure *cfg)
+{
+    return RT_EOK;
+}
+
+static rt_err_t _uart_control(struct rt_serial_device *serial, int cmd, void *arg)
+{
+    return RT_EOK;
+}
+
+static int _uart_putc(struct rt_serial_device *serial, char c)
+{
+    return 1;
+}
+
+static int _uart_getc(struct rt_serial_device *serial)
+{
+    if (_rx_pending == 0)
+        return -1;
+
+    _rx_pending--;
+
+    return _rx_seq++;
+}
+
+static const struct rt_uart_ops _uart_ops =
+{
+    _uart_configure,
+    _uart_control,
+    _uart_putc,
+    _uart_getc,
+    RT_NULL
+};
+
+/* the uart receives count bytes and raises its interrupt */
+static void _uart_receive(rt_size_t count)
+{
+    _rx_pending = count;
+    rt_hw_serial_isr(&_serial, RT_SERIAL_EVENT_RX_IND);
+}
+
+static void test_serial_rx_overflow(void)
+{
+    rt_uint8_t data[SERIAL_BENCH_BUFSZ];
+    struct rt_serial_rx_fifo *rx_fifo = (struct rt_serial_rx_fifo *)_serial.serial_rx;
+    rt_uint8_t first = _rx_seq;
+    rt_uint32_t overflow = rx_fifo->overflow;
+    rt_size_t length, i;
+
+    /* one byte of the fifo is kept free */
+    _uart_receive(SERIAL_BENCH_BUFSZ + 10);
+    uassert_int_equal(rx_fifo->overflow - overflow, 11);
+
+    length = rt_device_read(&_serial.parent, 0, data, sizeof(data));
+    uassert_int_equal(length, SERIAL_BENCH_BUFSZ - 1);
+
+#ifdef RT_SERIAL_RX_DROP_NEWEST
+    /* the bytes received while the fifo was full are lost */
+#else
+    /* the oldest bytes are overwritten */
+    first += 11;
+#endif /* RT_SERIAL_RX_DROP_NEWEST */
+    for (i = 0; i < length; i++)
+    {
+        if (data[i] != (rt_uint8_t)(first + i))
+        {
+            uassert_int_equal(data[i], (rt_uint8_t)(first + i));
+            break;
+        }
+    }
+
+    uassert_int_equal(rt_device_read(&_serial.parent, 0, data, sizeof(data)), 0);
+    _rx_seq = 0;
+}
+
+/* the uart fifo is drained by the isr and a reader takes whatever has arrived */
+static void test_serial_rx_bench(void)
+{
+    rt_uint8_t data[SERIAL_BENCH_BUFSZ];
+    rt_uint64_t begin, isr = 0, read = 0;
+    rt_uint8_t expect = _rx_seq;
+    rt_size_t total = 0, length, i;
+    rt_uint32_t errors = 0;
+
+    while (total < SERIAL_BENCH_BYTES)
+    {
+        /* a few uart interrupts between two reads */
+        begin = clock_cpu_gettime();
+        for (i = 0; i < 4; i++)
+            _uart_receive(SERIAL_BENCH_HW_FIFO);
+        isr += clock_cpu_gettime() - begin;
+
+        begin = clock_cpu_gettime();
+        length = rt_device_read(&_serial.parent, 0, data, sizeof(data));
+        read += clock_cpu_gettime() - begin;
+
+        for (i = 0; i < length; i++)
+        {
+            if (data[i] != expect++)
+                errors++;
+        }
+        total += length;
+    }
+
+    LOG_I("%u bytes: isr %u, rt_device_read %u cycles per 100 bytes", total,
+          (rt_uint32_t)(isr * 100 / total), (rt_uint32_t)(read * 100 / total));
+    uassert_int_equal(errors, 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+
+    config.bufsz = SERIAL_BENCH_BUFSZ;
+    _serial.ops = &_uart_ops;
+    _serial.config = config;
+    _rx_seq = 0;
+    _rx_pending = 0;
+
+    if (rt_hw_serial_register(&_serial, "sbench", RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX, RT_NULL) != RT_EOK)
+        return -RT_ERROR;
+
+    return rt_device_open(&_serial.parent, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_device_close(&_serial.parent);
+    rt_device_unregister(&_serial.parent);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_serial_rx_overflow);
+    UTEST_UNIT_RUN(test_serial_rx_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.serial_rx_bench_tc", utest_tc_init, utest_tc_cleanup, 10);
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <rtdevice.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+/* workers preempt the test thread as soon as a work is queued */
+#define WORKPOOL_PRIORITY       (UTEST_THR_PRIORITY - 1)
+#define WORKPOOL_STACK_SIZE     2048
+#define WORKPOOL_WAIT           rt_tick_from_millisecond(1000)
+
+#define BENCH_BURSTS            50
+#define BENCH_BURST_SIZE        16
+#define BENCH_SLOW_MS           2
+
+struct test_work
+{
+    struct rt_work work;
+    int id;
+    int runs;
+};
+
+struct bench_work
+{
+    struct rt_work work;
+    rt_bool_t slow;
+    rt_uint64_t submit;
+};
+
+static struct rt_semaphore _done;
+static struct rt_semaphore _gate;
+static int _order[8];
+static int _order_num;
+
+static void _test_work_func(struct rt_work *work, void *work_data)
+{
+    struct test_work *test = (struct test_work *)work_data;
+
+    test->runs++;
+    if (_order_num < sizeof(_order) / sizeof(_order[0]))
+        _order[_order_num++] = test->id;
+    rt_sem_release(&_done);
+}
+
+/* keeps its worker busy until the test opens the gate */
+static void _gate_work_func(struct rt_work *work, void *work_data)
+{
+    rt_sem_take(&_gate, RT_WAITING_FOREVER);
+    rt_sem_release(&_done);
+}
+
+static void _slow_work_func(struct rt_work *work, void *work_data)
+{
+    struct test_work *test = (struct test_work *)work_data;
+
+    test->id = 1;
+    rt_thread_mdelay(50);
+    test->runs++;
+}
+
+static void test_workpool_submit(void)
+{
+    struct rt_workpool *pool;
+    struct test_work works[8];
+    int i;
+
+    pool = rt_workpool_create("wpt", 2, WORKPOOL_STACK_SIZE, WORKPOOL_PRIORITY);
+    uassert_not_null(pool);
+    if (pool == RT_NULL)
+        return;
+
+    for (i = 0; i < 8; i++)
+    {
+        works[i].id = i;
+        works[i].runs = 0;
+        rt_work_init(&works[i].work, _test_work_func, &works[i]);
+        uassert_int_equal(rt_workpool_dowork(pool, &works[i].work), RT_EOK);
+    }
+
+    for (i = 0; i < 8; i++)
+        uassert_int_equal(rt_sem_take(&_done, WORKPOOL_WAIT), RT_EOK);
+
+    /* every work ran exactly once */
+    for (i = 0; i < 8; i++)
+        uassert_int_equal(works[i].runs, 1);
+
+    rt_workpool_destroy(pool);
+}
+
+/* works queued behind a busy worker run by class, then in submission order */
+static void test_workpool_order(void)
+{
+    static const struct
+    {
+        rt_uint8_t work_class;
+        int expected;
+    } submits[] =
+    {
+        { RT_WORKPOOL_CLASS_LOW,    4 },
+        { RT_WORKPOOL_CLASS_NORMAL, 2 },
+        { RT_WORKPOOL_CLASS_HIGH,   0 },
+        { RT_WORKPOOL_CLASS_NORMAL, 3 },
+        { RT_WORKPOOL_CLASS_HIGH,   1 },
+    };
+    struct rt_workpool *pool;
+    struct test_work works[5];
+    struct rt_work gate;
+    int i;
+
+    pool = rt_workpool_create("wpo", 1, WORKPOOL_STACK_SIZE, WORKPOOL_PRIORITY);
+    uassert_not_null(pool);
+    if (pool == RT_NULL)
+        return;
+
+    rt_work_init(&gate, _gate_work_func, RT_NULL);
+    uassert_int_equal(rt_workpool_dowork(pool, &gate), RT_EOK);
+
+    /* a running work is not submitted again */
+    uassert_int_equal(rt_workpool_dowork(pool, &gate), -RT_EBUSY);
+
+    _order_num = 0;
+    for (i = 0; i < 5; i++)
+    {
+        works[i].id = submits[i].expected;
+        works[i].runs = 0;
+        rt_work_init(&works[i].work, _test_work_func, &works[i]);
+        uassert_int_equal(rt_workpool_submit_work(pool, &works[i].work, submits[i].work_class, 0), RT_EOK);
+    }
+
+    rt_sem_release(&_gate);
+    for (i = 0; i < 6; i++)
+        uassert_int_equal(rt_sem_take(&_done, WORKPOOL_WAIT), RT_EOK);
+
+    uassert_int_equal(_order_num, 5);
+    for (i = 0; i < _order_num; i++)
+        uassert_int_equal(_order[i], i);
+
+    rt_workpool_destroy(pool);
+}
+
+static void test_workpool_cancel(void)
+{
+    struct rt_workpool *pool;
+    struct test_work queued, delayed, slow;
+    struct rt_work gate;
+
+    pool = rt_workpool_create("wpc", 1, WORKPOOL_STACK_SIZE, WORKPOOL_PRIORITY);
+    uassert_not_null(pool);
+    if (pool == RT_NULL)
+        return;
+
+    rt_work_init(&gate, _gate_work_func, RT_NULL);
+    rt_work_init(&queued.work, _test_work_func, &queued);
+    rt_work_init(&delayed.work, _test_work_func, &delayed);
+    rt_work_init(&slow.work, _slow_work_func, &slow);
+    queued.runs = delayed.runs = slow.runs = 0;
+    queued.id = delayed.id = slow.id = 0;
+
+    /* a queued work and a delayed work never run once cancelled */
+    uassert_int_equal(rt_workpool_dowork(pool, &gate), RT_EOK);
+    uassert_int_equal(rt_workpool_dowork(pool, &queued.work), RT_EOK);
+    uassert_int_equal(rt_workpool_submit_work(pool, &delayed.work, RT_WORKPOOL_CLASS_NORMAL, 10), RT_EOK);
+
+    uassert_int_equal(rt_workpool_cancel_work(pool, &queued.work), RT_EOK);
+    uassert_int_equal(rt_workpool_cancel_work(pool, &delayed.work), RT_EOK);
+    uassert_int_equal(rt_workpool_cancel_work(pool, &gate), -RT_EBUSY);
+
+    rt_sem_release(&_gate);
+    uassert_int_equal(rt_sem_take(&_done, WORKPOOL_WAIT), RT_EOK);
+    rt_thread_mdelay(50);
+    uassert_int_equal(queued.runs, 0);
+    uassert_int_equal(delayed.runs, 0);
+
+    /* cancel_work_sync returns only once the running work is done */
+    uassert_int_equal(rt_workpool_dowork(pool, &slow.work), RT_EOK);
+    while (slow.id == 0)
+        rt_thread_mdelay(1);
+    uassert_int_equal(rt_workpool_cancel_work_sync(pool, &slow.work), RT_EOK);
+    uassert_int_equal(slow.runs, 1);
+
+    rt_workpool_destroy(pool);
+}
+
+/* the queueing delay of the fast works in bursts led by a slow work */
+static struct bench_work *_bench_works;
+static rt_uint64_t _bench_sum, _bench_max;
+static rt_uint32_t _bench_count;
+
+static void _bench_work_func(struct rt_work *work, void *work_data)
+{
+    struct bench_work *bench = (struct bench_work *)work_data;
+    rt_uint64_t delay;
+    rt_base_t level;
+
+    if (bench->slow)
+    {
+        rt_thread_mdelay(BENCH_SLOW_MS);
+    }
+    else
+    {
+        delay = clock_cpu_gettime() - bench->submit;
+
+        /* the workers of a pool share the statistics */
+        level = rt_hw_interrupt_disable();
+        _bench_sum += delay;
+        if (delay > _bench_max)
+            _bench_max = delay;
+        _bench_count++;
+        rt_hw_interrupt_enable(level);
+    }
+
+    rt_sem_release(&_done);
+}
+
+static void _bench_run(const char *name, struct rt_workqueue *queue, struct rt_workpool *pool)
+{
+    int burst, i;
+
+    _bench_sum = _bench_max = 0;
+    _bench_count = 0;
+
+    for (burst = 0; burst < BENCH_BURSTS; burst++)
+    {
+        for (i = 0; i < BENCH_BURST_SIZE; i++)
+        {
+            rt_work_init(&_bench_works[i].work, _bench_work_func, &_bench_works[i]);
+            _bench_works[i].slow = (i == 0);
+            _bench_works[i].submit = clock_cpu_gettime();
+            if (queue)
+                rt_workqueue_dowork(queue, &_bench_works[i].work);
+            else
+                rt_workpool_dowork(pool, &_bench_works[i].work);
+        }
+
+        for (i = 0; i < BENCH_BURST_SIZE; i++)
+            uassert_int_equal(rt_sem_take(&_done, WORKPOOL_WAIT), RT_EOK);
+    }
+
+    uassert_int_equal(_bench_count, BENCH_BURSTS * (BENCH_BURST_SIZE - 1));
+    if (_bench_count)
+    {
+        LOG_I("%-14s queueing delay avg %u us, max %u us", name,
+              clock_cpu_microsecond((rt_uint32_t)(_bench_sum / _bench_count)),
+              clock_cpu_microsecond((rt_uint32_t)_bench_max));
+    }
+}
+
+static void test_workpool_bench(void)
+{
+    struct rt_workqueue *queue;
+    struct rt_workpool *pool;
+
+    _bench_works = rt_calloc(BENCH_BURST_SIZE, sizeof(struct bench_work));
+    uassert_not_null(_bench_works);
+    if (_bench_works == RT_NULL)
+        return;
+
+    queue = rt_workqueue_create("wqb", WORKPOOL_STACK_SIZE, WORKPOOL_PRIORITY);
+    uassert_not_null(queue);
+    if (queue)
+    {
+        _bench_run("rt_workqueue", queue, RT_NULL);
+        rt_workqueue_destroy(queue);
+    }
+
+    pool = rt_workpool_create("wpb", 2, WORKPOOL_STACK_SIZE, WORKPOOL_PRIORITY);
+    uassert_not_null(pool);
+    if (pool)
+    {
+        _bench_run("rt_workpool x2", RT_NULL, pool);
+        rt_workpool_destroy(pool);
+    }
+
+    pool = rt_workpool_create("wpb", 4, WORKPOOL_STACK_SIZE, WORKPOOL_PRIORITY);
+    uassert_not_null(pool);
+    if (pool)
+    {
+        _bench_run("rt_workpool x4", RT_NULL, pool);
+        rt_workpool_destroy(pool);
+    }
+
+    rt_free(_bench_works);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_done, "wptdone", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_gate, "wptgate", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+    rt_sem_detach(&_gate);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_workpool_submit);
+    UTEST_UNIT_RUN(test_workpool_order);
+    UTEST_UNIT_RUN(test_workpool_cancel);
+    UTEST_UNIT_RUN(test_workpool_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.workpool_tc", utest_tc_init, utest_tc_cleanup, 60);
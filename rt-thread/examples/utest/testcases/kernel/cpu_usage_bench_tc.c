@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define USAGE_BENCH_ROUNDS      20000
+#define USAGE_BENCH_PRIORITY    (UTEST_THR_PRIORITY - 1)
+
+static struct rt_semaphore _done;
+static struct rt_semaphore _go;
+
+static void _yield_entry(void *parameter)
+{
+    int i;
+
+    for (i = 0; i < USAGE_BENCH_ROUNDS; i++)
+        rt_thread_yield();
+
+    /* stay until the run time is read */
+    rt_sem_release(&_done);
+    rt_sem_take(&_go, RT_WAITING_FOREVER);
+}
+
+/* two equal priority threads yield to each other, one switch per yield */
+static void test_switch_cycles(void)
+{
+    rt_thread_t tid[2];
+    rt_uint64_t begin;
+    rt_uint32_t elapsed;
+#ifdef RT_USING_CPU_USAGE
+    rt_uint64_t run[2];
+    rt_uint32_t charged;
+#endif /* RT_USING_CPU_USAGE */
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        tid[i] = rt_thread_create("usage", _yield_entry, RT_NULL, 1024, USAGE_BENCH_PRIORITY, 10);
+        uassert_not_null(tid[i]);
+        if (tid[i] == RT_NULL)
+            return;
+    }
+
+    /* both are ready before the first one runs */
+    rt_enter_critical();
+    begin = clock_cpu_gettime();
+    rt_thread_startup(tid[0]);
+    rt_thread_startup(tid[1]);
+    rt_exit_critical();
+
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+    elapsed = (rt_uint32_t)(clock_cpu_gettime() - begin);
+
+#ifdef RT_USING_CPU_USAGE
+    LOG_I("cpu usage accounting on: %u cycles per switch", elapsed / (2 * USAGE_BENCH_ROUNDS));
+#else
+    LOG_I("cpu usage accounting off: %u cycles per switch", elapsed / (2 * USAGE_BENCH_ROUNDS));
+#endif /* RT_USING_CPU_USAGE */
+
+#ifdef RT_USING_CPU_USAGE
+    /* nearly all of the time went to the two threads */
+    run[0] = tid[0]->duration_tick;
+    run[1] = tid[1]->duration_tick;
+    charged = (rt_uint32_t)(run[0] + run[1]);
+    LOG_I("charged %u of %u cycles to the yielding threads", charged, elapsed);
+    uassert_true(charged <= elapsed);
+    uassert_true(charged >= elapsed / 10 * 9);
+#endif /* RT_USING_CPU_USAGE */
+
+    rt_sem_release(&_go);
+    rt_sem_release(&_go);
+}
+
+#ifdef RT_USING_CPU_USAGE
+static void _busy_entry(void *parameter)
+{
+    rt_tick_t end = rt_tick_get() + rt_tick_from_millisecond(RT_CPU_USAGE_PERIOD * 2 + RT_CPU_USAGE_PERIOD / 2);
+
+    while (rt_tick_get() - end >= RT_TICK_MAX / 2);
+
+    rt_sem_release(&_done);
+    rt_sem_take(&_go, RT_WAITING_FOREVER);
+}
+
+/* a busy thread fills at least one whole sampling period */
+static void test_usage_window(void)
+{
+    struct rt_thread_stats stats;
+    rt_thread_t tid;
+
+    tid = rt_thread_create("busy", _busy_entry, RT_NULL, 1024, USAGE_BENCH_PRIORITY, 10);
+    uassert_not_null(tid);
+    if (tid == RT_NULL)
+        return;
+
+    rt_thread_startup(tid);
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+
+    uassert_int_equal(rt_thread_get_stats(tid, &stats), RT_EOK);
+    LOG_I("busy thread: usage %d.%02d%%, max %d.%02d%%", stats.usage / 100, stats.usage % 100,
+          stats.usage_max / 100, stats.usage_max % 100);
+    uassert_true(stats.usage_max >= 9000);
+
+    rt_sem_release(&_go);
+}
+#endif /* RT_USING_CPU_USAGE */
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_done, "done", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_go, "go", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+    rt_sem_detach(&_go);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_switch_cycles);
+#ifdef RT_USING_CPU_USAGE
+    UTEST_UNIT_RUN(test_usage_window);
+#endif /* RT_USING_CPU_USAGE */
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.cpu_usage_bench_tc", utest_tc_init, utest_tc_cleanup, 20);
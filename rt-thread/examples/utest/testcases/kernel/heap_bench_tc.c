@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define HEAP_BENCH_THREADS      4
+#define HEAP_BENCH_OPS          20000
+#define HEAP_BENCH_SLOTS        32
+#define HEAP_BENCH_ARENA_SIZE   (128 * 1024)
+#define HEAP_BENCH_PRIORITY     (UTEST_THR_PRIORITY + 1)
+
+struct heap_bench_ops
+{
+    const char *name;
+    rt_err_t (*init)(void);
+    void (*deinit)(void);
+    void *(*alloc)(rt_size_t size);
+    void (*free)(void *ptr);
+#ifdef RT_USING_HEAP_STATS
+    rt_err_t (*stats)(struct rt_heap_stats *stats);
+#endif /* RT_USING_HEAP_STATS */
+};
+
+struct heap_bench_worker
+{
+    const struct heap_bench_ops *ops;
+    rt_uint32_t seed;
+    rt_uint32_t fails;
+    void *slots[HEAP_BENCH_SLOTS];
+};
+
+static struct heap_bench_worker _workers[HEAP_BENCH_THREADS];
+static struct rt_semaphore _done;
+static void *_arena;
+
+/* the private heaps are not thread safe, serialize them like rt_malloc() does */
+static struct rt_mutex _lock;
+
+static void *_sys_alloc(rt_size_t size)
+{
+    return rt_malloc(size);
+}
+
+static void _sys_free(void *ptr)
+{
+    rt_free(ptr);
+}
+
+static rt_err_t _arena_init(void)
+{
+    _arena = rt_malloc_align(HEAP_BENCH_ARENA_SIZE, RT_MM_PAGE_SIZE);
+
+    return (_arena != RT_NULL) ? RT_EOK : -RT_ENOMEM;
+}
+
+#ifdef RT_USING_SMALL_MEM
+static rt_smem_t _smem;
+
+static rt_err_t _smem_init(void)
+{
+    if (_arena_init() != RT_EOK)
+        return -RT_ENOMEM;
+    _smem = rt_smem_init("bsmem", _arena, HEAP_BENCH_ARENA_SIZE);
+
+    return RT_EOK;
+}
+
+static void _smem_deinit(void)
+{
+    rt_smem_detach(_smem);
+    rt_free_align(_arena);
+}
+
+static void *_smem_alloc(rt_size_t size)
+{
+    void *ptr;
+
+    rt_mutex_take(&_lock, RT_WAITING_FOREVER);
+    ptr = rt_smem_alloc(_smem, size);
+    rt_mutex_release(&_lock);
+
+    return ptr;
+}
+
+static void _smem_free(void *ptr)
+{
+    rt_mutex_take(&_lock, RT_WAITING_FOREVER);
+    rt_smem_free(ptr);
+    rt_mutex_release(&_lock);
+}
+
+#ifdef RT_USING_HEAP_STATS
+static rt_err_t _smem_stats(struct rt_heap_stats *stats)
+{
+    return rt_smem_stats(_smem, stats);
+}
+#endif /* RT_USING_HEAP_STATS */
+#endif /* RT_USING_SMALL_MEM */
+
+#ifdef RT_USING_SLAB
+static rt_slab_t _slab;
+
+static rt_err_t _slab_init(void)
+{
+    if (_arena_init() != RT_EOK)
+        return -RT_ENOMEM;
+    _slab = rt_slab_init("bslab", _arena, HEAP_BENCH_ARENA_SIZE);
+
+    return RT_EOK;
+}
+
+static void _slab_deinit(void)
+{
+    rt_slab_detach(_slab);
+    rt_free_align(_arena);
+}
+
+static void *_slab_alloc(rt_size_t size)
+{
+    void *ptr;
+
+    rt_mutex_take(&_lock, RT_WAITING_FOREVER);
+    ptr = rt_slab_alloc(_slab, size);
+    rt_mutex_release(&_lock);
+
+    return ptr;
+}
+
+static void _slab_free(void *ptr)
+{
+    rt_mutex_take(&_lock, RT_WAITING_FOREVER);
+    rt_slab_free(_slab, ptr);
+    rt_mutex_release(&_lock);
+}
+
+#ifdef RT_USING_HEAP_STATS
+static rt_err_t _slab_stats(struct rt_heap_stats *stats)
+{
+    return rt_slab_stats(_slab, stats);
+}
+#endif /* RT_USING_HEAP_STATS */
+#endif /* RT_USING_SLAB */
+
+#ifdef RT_USING_MEMHEAP
+static struct rt_memheap _memheap;
+
+static rt_err_t _memheap_init(void)
+{
+    if (_arena_init() != RT_EOK)
+        return -RT_ENOMEM;
+
+    return rt_memheap_init(&_memheap, "bheap", _arena, HEAP_BENCH_ARENA_SIZE);
+}
+
+static void _memheap_deinit(void)
+{
+    rt_memheap_detach(&_memheap);
+    rt_free_align(_arena);
+}
+
+/* memheap has its own lock */
+static void *_memheap_alloc(rt_size_t size)
+{
+    return rt_memheap_alloc(&_memheap, size);
+}
+
+static void _memheap_free(void *ptr)
+{
+    rt_memheap_free(ptr);
+}
+
+#ifdef RT_USING_HEAP_STATS
+static rt_err_t _memheap_stats(struct rt_heap_stats *stats)
+{
+    return rt_memheap_stats(&_memheap, stats);
+}
+#endif /* RT_USING_HEAP_STATS */
+#endif /* RT_USING_MEMHEAP */
+
+static const struct heap_bench_ops _bench_ops[] =
+{
+#ifdef RT_USING_HEAP_CACHE
+    { "system heap with cache", RT_NULL, RT_NULL, _sys_alloc, _sys_free,
+#else
+    { "system heap", RT_NULL, RT_NULL, _sys_alloc, _sys_free,
+#endif /* RT_USING_HEAP_CACHE */
+#ifdef RT_USING_HEAP_STATS
+      rt_heap_stats,
+#endif /* RT_USING_HEAP_STATS */
+    },
+#ifdef RT_USING_SMALL_MEM
+    { "small-mem", _smem_init, _smem_deinit, _smem_alloc, _smem_free,
+#ifdef RT_USING_HEAP_STATS
+      _smem_stats,
+#endif /* RT_USING_HEAP_STATS */
+    },
+#endif /* RT_USING_SMALL_MEM */
+#ifdef RT_USING_SLAB
+    { "slab", _slab_init, _slab_deinit, _slab_alloc, _slab_free,
+#ifdef RT_USING_HEAP_STATS
+      _slab_stats,
+#endif /* RT_USING_HEAP_STATS */
+    },
+#endif /* RT_USING_SLAB */
+#ifdef RT_USING_MEMHEAP
+    { "memheap", _memheap_init, _memheap_deinit, _memheap_alloc, _memheap_free,
+#ifdef RT_USING_HEAP_STATS
+      _memheap_stats,
+#endif /* RT_USING_HEAP_STATS */
+    },
+#endif /* RT_USING_MEMHEAP */
+};
+
+static rt_uint32_t _bench_random(rt_uint32_t *seed)
+{
+    /* xorshift32, one state per worker */
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+
+    return *seed;
+}
+
+/* mostly small objects as lwIP, ulog and audio allocate, sometimes a larger buffer */
+static rt_size_t _bench_size(rt_uint32_t *seed)
+{
+    rt_uint32_t r = _bench_random(seed);
+
+    if ((r & 0xF) == 0)
+        return 513 + (r >> 8) % 1536;
+
+    return 8 + (r >> 8) % 505;
+}
+
+static void _bench_entry(void *parameter)
+{
+    struct heap_bench_worker *worker = (struct heap_bench_worker *)parameter;
+    const struct heap_bench_ops *ops = worker->ops;
+    rt_size_t size;
+    int i, slot;
+
+    for (i = 0; i < HEAP_BENCH_OPS; i++)
+    {
+        slot = _bench_random(&worker->seed) % HEAP_BENCH_SLOTS;
+        if (worker->slots[slot])
+        {
+            ops->free(worker->slots[slot]);
+            worker->slots[slot] = RT_NULL;
+        }
+        else
+        {
+            size = _bench_size(&worker->seed);
+            worker->slots[slot] = ops->alloc(size);
+            if (worker->slots[slot] == RT_NULL)
+                worker->fails++;
+            else
+                rt_memset(worker->slots[slot], i, size);
+        }
+    }
+
+    /* keep every other block to leave the heap fragmented */
+    for (slot = 0; slot < HEAP_BENCH_SLOTS; slot += 2)
+    {
+        if (worker->slots[slot])
+        {
+            ops->free(worker->slots[slot]);
+            worker->slots[slot] = RT_NULL;
+        }
+    }
+
+    rt_sem_release(&_done);
+}
+
+static void _bench_run(const struct heap_bench_ops *ops)
+{
+    rt_thread_t tid[HEAP_BENCH_THREADS];
+    rt_tick_t begin, elapsed;
+    rt_uint32_t fails = 0;
+    int i, slot;
+
+    if (ops->init && ops->init() != RT_EOK)
+    {
+        LOG_W("%s: no memory for the arena, skipped", ops->name);
+        return;
+    }
+
+    rt_memset(_workers, 0, sizeof(_workers));
+    for (i = 0; i < HEAP_BENCH_THREADS; i++)
+    {
+        _workers[i].ops = ops;
+        _workers[i].seed = 0x9E3779B9 * (i + 1);
+        tid[i] = rt_thread_create("hbench", _bench_entry, &_workers[i], 1024, HEAP_BENCH_PRIORITY, 5);
+        uassert_not_null(tid[i]);
+    }
+
+    begin = rt_tick_get();
+    for (i = 0; i < HEAP_BENCH_THREADS; i++)
+    {
+        if (tid[i])
+            rt_thread_startup(tid[i]);
+    }
+    for (i = 0; i < HEAP_BENCH_THREADS; i++)
+    {
+        if (tid[i])
+            rt_sem_take(&_done, RT_WAITING_FOREVER);
+    }
+    elapsed = rt_tick_get() - begin;
+    if (elapsed == 0)
+        elapsed = 1;
+
+    for (i = 0; i < HEAP_BENCH_THREADS; i++)
+        fails += _workers[i].fails;
+
+    LOG_I("%-24s %8u ops/s, %u failed allocations", ops->name,
+          (rt_uint32_t)((rt_uint64_t)HEAP_BENCH_THREADS * HEAP_BENCH_OPS * RT_TICK_PER_SECOND / elapsed), fails);
+
+#ifdef RT_USING_HEAP_STATS
+    {
+        struct rt_heap_stats stats;
+
+        if (ops->stats(&stats) == RT_EOK)
+        {
+            rt_size_t free_size = stats.total - stats.used;
+
+            /* fragmentation: the share of free memory not in the largest free block */
+            LOG_I("%-24s free %u bytes in %u blocks, largest %u, fragmentation %u%%", ops->name,
+                  free_size, stats.free_blocks, stats.largest_free,
+                  free_size ? (rt_uint32_t)(100 - (rt_uint64_t)stats.largest_free * 100 / free_size) : 0);
+            LOG_I("%-24s alloc cycles p50 %u p99 %u max %u, free cycles p50 %u p99 %u max %u", ops->name,
+                  stats.alloc_p50, stats.alloc_p99, stats.alloc_max,
+                  stats.free_p50, stats.free_p99, stats.free_max);
+        }
+    }
+#endif /* RT_USING_HEAP_STATS */
+
+    for (i = 0; i < HEAP_BENCH_THREADS; i++)
+    {
+        for (slot = 0; slot < HEAP_BENCH_SLOTS; slot++)
+        {
+            if (_workers[i].slots[slot])
+                ops->free(_workers[i].slots[slot]);
+        }
+    }
+
+    if (ops->deinit)
+        ops->deinit();
+}
+
+static void test_heap_bench(void)
+{
+    int i;
+
+    for (i = 0; i < sizeof(_bench_ops) / sizeof(_bench_ops[0]); i++)
+    {
+        _bench_run(&_bench_ops[i]);
+    }
+}
+
+/* no block for 0 byte, with or without the cache */
+static void test_heap_zero(void)
+{
+    void *ptr;
+
+    uassert_null(rt_malloc(0));
+    uassert_null(rt_realloc(RT_NULL, 0));
+
+    ptr = rt_malloc(16);
+    uassert_not_null(ptr);
+    uassert_null(rt_realloc(ptr, 0));
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_done, "hbench", 0, RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&_lock, "hbench", RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_mutex_detach(&_lock);
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_heap_zero);
+    UTEST_UNIT_RUN(test_heap_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.heap_bench_tc", utest_tc_init, utest_tc_cleanup, 120);
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define HEAP_STATS_ARENA_SIZE   (64 * 1024)
+#define HEAP_STATS_BLOCKS       8
+#define HEAP_STATS_BLOCK_SIZE   200
+
+static void *_arena;
+
+/* the invariants every allocator keeps */
+static void _stats_check(const struct rt_heap_stats *stats)
+{
+    rt_size_t blocks = 0;
+    int i;
+
+    for (i = 0; i < RT_HEAP_STATS_HIST_NR; i++)
+        blocks += stats->free_hist[i];
+
+    uassert_int_equal(blocks, stats->free_blocks);
+    uassert_true(stats->used <= stats->total);
+    uassert_true(stats->used <= stats->max_used);
+    uassert_true(stats->largest_free <= stats->total);
+    uassert_true(stats->alloc_p50 <= stats->alloc_p90);
+    uassert_true(stats->alloc_p90 <= stats->alloc_p99);
+    uassert_true(stats->alloc_p99 <= stats->alloc_max);
+    uassert_true(stats->free_p50 <= stats->free_p90);
+    uassert_true(stats->free_p90 <= stats->free_p99);
+    uassert_true(stats->free_p99 <= stats->free_max);
+}
+
+/*
+ * allocate some blocks, free every other one and check the counters and the
+ * holes left between the blocks still in use
+ */
+static void _stats_holes(const char *name,
+                         void *(*alloc)(rt_size_t size), void (*release)(void *ptr),
+                         rt_err_t (*get)(struct rt_heap_stats *stats),
+                         rt_bool_t contiguous)
+{
+    struct rt_heap_stats stats, before;
+    void *blocks[HEAP_STATS_BLOCKS];
+    int i;
+
+    uassert_int_equal(get(&before), RT_EOK);
+    _stats_check(&before);
+
+    for (i = 0; i < HEAP_STATS_BLOCKS; i++)
+    {
+        blocks[i] = alloc(HEAP_STATS_BLOCK_SIZE);
+        uassert_not_null(blocks[i]);
+    }
+    uassert_null(alloc(HEAP_STATS_ARENA_SIZE * 2));
+
+    uassert_int_equal(get(&stats), RT_EOK);
+    _stats_check(&stats);
+    uassert_int_equal(stats.alloc_count - before.alloc_count, HEAP_STATS_BLOCKS);
+    uassert_int_equal(stats.fail_count - before.fail_count, 1);
+    uassert_true(stats.max_used >= stats.used);
+    if (contiguous)
+    {
+        uassert_true(stats.used >= before.used + HEAP_STATS_BLOCKS * HEAP_STATS_BLOCK_SIZE);
+    }
+
+    for (i = 0; i < HEAP_STATS_BLOCKS; i += 2)
+        release(blocks[i]);
+
+    uassert_int_equal(get(&stats), RT_EOK);
+    _stats_check(&stats);
+    uassert_int_equal(stats.free_count - before.free_count, HEAP_STATS_BLOCKS / 2);
+    if (contiguous)
+    {
+        /* each freed block is a hole of its own, the first one may merge with a free block before it */
+        uassert_true(stats.free_blocks >= before.free_blocks + HEAP_STATS_BLOCKS / 2 - 1);
+        uassert_true(stats.free_hist[2] >= HEAP_STATS_BLOCKS / 2 - 1);
+    }
+
+    LOG_I("%-10s used %u peak %u, %u free blocks, largest %u, alloc p50 %u max %u",
+          name, stats.used, stats.max_used, stats.free_blocks, stats.largest_free,
+          stats.alloc_p50, stats.alloc_max);
+
+    for (i = 1; i < HEAP_STATS_BLOCKS; i += 2)
+        release(blocks[i]);
+
+    uassert_int_equal(get(&stats), RT_EOK);
+    _stats_check(&stats);
+    uassert_int_equal(stats.used, before.used);
+    if (contiguous)
+    {
+        uassert_int_equal(stats.free_blocks, before.free_blocks);
+        uassert_int_equal(stats.largest_free, before.largest_free);
+    }
+}
+
+#ifdef RT_USING_SMALL_MEM
+static rt_smem_t _smem;
+
+static void *_smem_alloc(rt_size_t size)
+{
+    return rt_smem_alloc(_smem, size);
+}
+
+static rt_err_t _smem_stats(struct rt_heap_stats *stats)
+{
+    return rt_smem_stats(_smem, stats);
+}
+
+static void test_smem_stats(void)
+{
+    _smem = rt_smem_init("ssmem", _arena, HEAP_STATS_ARENA_SIZE);
+    uassert_not_null(_smem);
+    _stats_holes("small-mem", _smem_alloc, rt_smem_free, _smem_stats, RT_TRUE);
+    rt_smem_detach(_smem);
+}
+#endif /* RT_USING_SMALL_MEM */
+
+#ifdef RT_USING_MEMHEAP
+static struct rt_memheap _memheap;
+
+static void *_memheap_alloc(rt_size_t size)
+{
+    return rt_memheap_alloc(&_memheap, size);
+}
+
+static rt_err_t _memheap_stats(struct rt_heap_stats *stats)
+{
+    return rt_memheap_stats(&_memheap, stats);
+}
+
+static void test_memheap_stats(void)
+{
+    uassert_int_equal(rt_memheap_init(&_memheap, "sheap", _arena, HEAP_STATS_ARENA_SIZE), RT_EOK);
+    _stats_holes("memheap", _memheap_alloc, rt_memheap_free, _memheap_stats, RT_TRUE);
+    rt_memheap_detach(&_memheap);
+}
+#endif /* RT_USING_MEMHEAP */
+
+#ifdef RT_USING_SLAB
+static rt_slab_t _slab;
+
+static void *_slab_alloc(rt_size_t size)
+{
+    return rt_slab_alloc(_slab, size);
+}
+
+static void _slab_free(void *ptr)
+{
+    rt_slab_free(_slab, ptr);
+}
+
+static rt_err_t _slab_stats(struct rt_heap_stats *stats)
+{
+    return rt_slab_stats(_slab, stats);
+}
+
+/* slab keeps blocks of a size in zones, the free blocks are not holes between them */
+static void test_slab_stats(void)
+{
+    _slab = rt_slab_init("sslab", _arena, HEAP_STATS_ARENA_SIZE);
+    uassert_not_null(_slab);
+    _stats_holes("slab", _slab_alloc, _slab_free, _slab_stats, RT_FALSE);
+    rt_slab_detach(_slab);
+}
+#endif /* RT_USING_SLAB */
+
+static void test_system_heap_stats(void)
+{
+    struct rt_heap_stats stats;
+    rt_size_t total, used, max_used;
+
+    uassert_int_equal(rt_heap_stats(&stats), RT_EOK);
+    _stats_check(&stats);
+
+    rt_memory_info(&total, &used, &max_used);
+    uassert_int_equal(stats.total, total);
+    uassert_true(stats.largest_free <= total - used);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _arena = rt_malloc_align(HEAP_STATS_ARENA_SIZE, RT_MM_PAGE_SIZE);
+
+    return (_arena != RT_NULL) ? RT_EOK : -RT_ENOMEM;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free_align(_arena);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+#ifdef RT_USING_SMALL_MEM
+    UTEST_UNIT_RUN(test_smem_stats);
+#endif /* RT_USING_SMALL_MEM */
+#ifdef RT_USING_MEMHEAP
+    UTEST_UNIT_RUN(test_memheap_stats);
+#endif /* RT_USING_MEMHEAP */
+#ifdef RT_USING_SLAB
+    UTEST_UNIT_RUN(test_slab_stats);
+#endif /* RT_USING_SLAB */
+    UTEST_UNIT_RUN(test_system_heap_stats);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.heap_stats_tc", utest_tc_init, utest_tc_cleanup, 10);
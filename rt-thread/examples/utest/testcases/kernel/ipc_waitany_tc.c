@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define WAITANY_HIGH_PRIORITY   (UTEST_THR_PRIORITY - 1)
+#define WAITANY_STACK_SIZE      1024
+#define WAITANY_TIMEOUT         20
+
+static struct rt_semaphore _sem;
+static struct rt_mailbox _mb;
+static rt_ubase_t _mb_pool[4];
+static struct rt_event _event;
+static struct rt_semaphore _done;
+
+static struct rt_ipc_wait_item _items[3];
+
+struct waiter
+{
+    struct rt_ipc_wait_item items[3];
+    rt_int32_t timeout;
+    rt_err_t result;
+    rt_uint8_t index;
+};
+
+static void _items_setup(struct rt_ipc_wait_item items[3], rt_uint32_t set, rt_uint8_t option)
+{
+    rt_memset(items, 0, sizeof(struct rt_ipc_wait_item) * 3);
+    items[0].object = &_sem.parent.parent;
+    items[1].object = &_mb.parent.parent;
+    items[2].object = &_event.parent.parent;
+    items[2].set = set;
+    items[2].option = option;
+}
+
+static rt_bool_t _items_unlinked(void)
+{
+    return rt_list_isempty(&_sem.parent.waitany_list) &&
+           rt_list_isempty(&_mb.parent.waitany_list) &&
+           rt_list_isempty(&_event.parent.waitany_list);
+}
+
+static void _waiter_entry(void *parameter)
+{
+    struct waiter *waiter = (struct waiter *)parameter;
+
+    waiter->index = 0xff;
+    waiter->result = rt_ipc_wait_any(waiter->items, 3, waiter->timeout, &waiter->index);
+
+    rt_sem_release(&_done);
+}
+
+/* a thread pending on the semaphore itself */
+static void _taker_entry(void *parameter)
+{
+    rt_sem_take(&_sem, RT_WAITING_FOREVER);
+
+    rt_sem_release(&_done);
+}
+
+static rt_thread_t _waiter_start(struct waiter *waiter, rt_uint8_t priority)
+{
+    rt_thread_t tid;
+
+    if (waiter)
+        tid = rt_thread_create("waitany", _waiter_entry, waiter, WAITANY_STACK_SIZE, priority, 10);
+    else
+        tid = rt_thread_create("wataker", _taker_entry, RT_NULL, WAITANY_STACK_SIZE, priority, 10);
+    uassert_not_null(tid);
+    if (tid)
+        rt_thread_startup(tid);
+
+    return tid;
+}
+
+static void test_waitany_ready(void)
+{
+    rt_uint8_t index = 0xff;
+    rt_ubase_t mail;
+
+    _items_setup(_items, 0x3, RT_EVENT_FLAG_AND);
+
+    uassert_int_equal(rt_ipc_wait_any(_items, 3, RT_WAITING_NO, &index), -RT_ETIMEOUT);
+
+    /* the object is reported, not taken */
+    rt_mb_send(&_mb, 1);
+    uassert_int_equal(rt_ipc_wait_any(_items, 3, RT_WAITING_NO, &index), RT_EOK);
+    uassert_int_equal(index, 1);
+    uassert_int_equal(rt_mb_recv(&_mb, &mail, RT_WAITING_NO), RT_EOK);
+
+    /* an event item waits for all its bits */
+    rt_event_send(&_event, 0x1);
+    uassert_int_equal(rt_ipc_wait_any(_items, 3, RT_WAITING_NO, &index), -RT_ETIMEOUT);
+    rt_event_send(&_event, 0x2);
+    uassert_int_equal(rt_ipc_wait_any(_items, 3, RT_WAITING_NO, &index), RT_EOK);
+    uassert_int_equal(index, 2);
+    rt_event_control(&_event, RT_IPC_CMD_RESET, RT_NULL);
+}
+
+static void test_waitany_timeout(void)
+{
+    rt_uint8_t index = 0xff;
+    rt_tick_t begin;
+
+    _items_setup(_items, 0x1, RT_EVENT_FLAG_OR);
+
+    begin = rt_tick_get();
+    uassert_int_equal(rt_ipc_wait_any(_items, 3, WAITANY_TIMEOUT, &index), -RT_ETIMEOUT);
+    uassert_true(rt_tick_get() - begin >= WAITANY_TIMEOUT);
+    uassert_int_equal(index, 0xff);
+
+    /* a timed out wait leaves no item behind */
+    uassert_true(_items_unlinked());
+}
+
+/* a waiter is woken by the object which becomes ready, then unlinked from all */
+static void test_waitany_wake(void)
+{
+    struct waiter waiter;
+
+    _items_setup(waiter.items, 0x1, RT_EVENT_FLAG_OR);
+    waiter.timeout = RT_WAITING_FOREVER;
+
+    if (_waiter_start(&waiter, WAITANY_HIGH_PRIORITY) == RT_NULL)
+        return;
+
+    rt_sem_release(&_sem);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(waiter.result, RT_EOK);
+    uassert_int_equal(waiter.index, 0);
+    uassert_true(_items_unlinked());
+    uassert_int_equal(rt_sem_take(&_sem, RT_WAITING_NO), RT_EOK);
+
+    /* a detached object resumes the waiter with an error */
+    if (_waiter_start(&waiter, WAITANY_HIGH_PRIORITY) == RT_NULL)
+        return;
+
+    rt_mb_detach(&_mb);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(waiter.result, -RT_ERROR);
+    uassert_true(_items_unlinked());
+    rt_mb_init(&_mb, "waitany", _mb_pool, sizeof(_mb_pool) / sizeof(_mb_pool[0]), RT_IPC_FLAG_PRIO);
+}
+
+/* one release wakes one waiter, and a thread pending on the object goes first */
+static void test_waitany_one_wake(void)
+{
+    struct waiter first, second;
+    rt_ubase_t mail;
+
+    _items_setup(first.items, 0x1, RT_EVENT_FLAG_OR);
+    _items_setup(second.items, 0x1, RT_EVENT_FLAG_OR);
+    first.timeout = second.timeout = WAITANY_TIMEOUT;
+
+    /* the release goes to the thread pending on the semaphore */
+    if (_waiter_start(RT_NULL, WAITANY_HIGH_PRIORITY) == RT_NULL ||
+            _waiter_start(&first, WAITANY_HIGH_PRIORITY) == RT_NULL)
+        return;
+
+    rt_sem_release(&_sem);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_NO), -RT_ETIMEOUT);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(first.result, -RT_ETIMEOUT);
+
+    if (_waiter_start(&first, WAITANY_HIGH_PRIORITY) == RT_NULL ||
+            _waiter_start(&second, WAITANY_HIGH_PRIORITY) == RT_NULL)
+        return;
+
+    /* FIFO order of the waitany list, the second one is still waiting */
+    rt_mb_send(&_mb, 1);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(first.result, RT_EOK);
+    uassert_int_equal(first.index, 1);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_NO), -RT_ETIMEOUT);
+
+    /* the first one takes the mail, the second one times out */
+    uassert_int_equal(rt_mb_recv(&_mb, &mail, RT_WAITING_NO), RT_EOK);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(second.result, -RT_ETIMEOUT);
+
+    /* an event send wakes every waiter whose condition holds */
+    first.timeout = second.timeout = RT_WAITING_FOREVER;
+    if (_waiter_start(&first, WAITANY_HIGH_PRIORITY) == RT_NULL ||
+            _waiter_start(&second, WAITANY_HIGH_PRIORITY) == RT_NULL)
+        return;
+
+    rt_event_send(&_event, 0x1);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(first.result, RT_EOK);
+    uassert_int_equal(first.index, 2);
+    uassert_int_equal(second.result, RT_EOK);
+    uassert_int_equal(second.index, 2);
+    rt_event_control(&_event, RT_IPC_CMD_RESET, RT_NULL);
+    uassert_true(_items_unlinked());
+}
+
+/*
+ * the waiter times out while the scheduler is locked, then the object is
+ * released before the waiter runs: it must report the object, not the timeout.
+ */
+static void test_waitany_wake_race(void)
+{
+    struct waiter waiter;
+    rt_tick_t begin;
+
+    _items_setup(waiter.items, 0x1, RT_EVENT_FLAG_OR);
+    waiter.timeout = 2;
+
+    if (_waiter_start(&waiter, WAITANY_HIGH_PRIORITY) == RT_NULL)
+        return;
+
+    rt_enter_critical();
+    begin = rt_tick_get();
+    while (rt_tick_get() - begin < 5);
+    rt_sem_release(&_sem);
+    rt_exit_critical();
+
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(waiter.result, RT_EOK);
+    uassert_int_equal(waiter.index, 0);
+    uassert_true(_items_unlinked());
+    uassert_int_equal(rt_sem_take(&_sem, RT_WAITING_NO), RT_EOK);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_sem, "waitany", 0, RT_IPC_FLAG_PRIO);
+    rt_mb_init(&_mb, "waitany", _mb_pool, sizeof(_mb_pool) / sizeof(_mb_pool[0]), RT_IPC_FLAG_PRIO);
+    rt_event_init(&_event, "waitany", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_done, "wadone", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_sem);
+    rt_mb_detach(&_mb);
+    rt_event_detach(&_event);
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_waitany_ready);
+    UTEST_UNIT_RUN(test_waitany_timeout);
+    UTEST_UNIT_RUN(test_waitany_wake);
+    UTEST_UNIT_RUN(test_waitany_one_wake);
+    UTEST_UNIT_RUN(test_waitany_wake_race);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.ipc_waitany_tc", utest_tc_init, utest_tc_cleanup, 10);
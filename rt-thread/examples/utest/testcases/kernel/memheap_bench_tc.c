@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define MEMHEAP_BENCH_SIZE      (128 * 1024)
+#define MEMHEAP_BENCH_OPS       1000000
+#define MEMHEAP_BENCH_SLOTS     256
+#define MEMHEAP_BENCH_MAX_BLOCK 1024
+
+struct memheap_bench_result
+{
+    rt_uint32_t count;
+    rt_uint32_t max;
+    rt_uint64_t sum;
+};
+
+static struct rt_memheap _heap;
+static void *_heap_mem;
+static void *_slots[MEMHEAP_BENCH_SLOTS];
+static rt_uint32_t _seed = 0x2545F491;
+
+static rt_uint32_t _bench_random(void)
+{
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+
+    return _seed;
+}
+
+static void _bench_record(struct memheap_bench_result *result, rt_uint32_t cycles)
+{
+    result->count++;
+    result->sum += cycles;
+    if (cycles > result->max)
+        result->max = cycles;
+}
+
+static const char *_bench_mode(void)
+{
+#if defined(RT_MEMHEAP_SEGREGATED_MODE)
+    return "segregated fit";
+#elif defined(RT_MEMHEAP_BEST_MODE)
+    return "best fit";
+#else
+    return "first fit";
+#endif
+}
+
+/*
+ * random allocations and releases in a heap kept about half full with many
+ * free blocks, every call is measured with interrupt disabled
+ */
+static void test_memheap_bench(void)
+{
+    struct memheap_bench_result alloc = { 0 }, release = { 0 };
+    rt_uint32_t i, slot, elapsed, fails = 0;
+    rt_uint64_t begin;
+    rt_base_t level;
+    rt_size_t size;
+
+    for (i = 0; i < MEMHEAP_BENCH_OPS; i++)
+    {
+        slot = _bench_random() % MEMHEAP_BENCH_SLOTS;
+        if (_slots[slot])
+        {
+            level = rt_hw_interrupt_disable();
+            begin = clock_cpu_gettime();
+            rt_memheap_free(_slots[slot]);
+            elapsed = (rt_uint32_t)(clock_cpu_gettime() - begin);
+            rt_hw_interrupt_enable(level);
+
+            _bench_record(&release, elapsed);
+            _slots[slot] = RT_NULL;
+        }
+        else
+        {
+            size = 8 + _bench_random() % MEMHEAP_BENCH_MAX_BLOCK;
+
+            level = rt_hw_interrupt_disable();
+            begin = clock_cpu_gettime();
+            _slots[slot] = rt_memheap_alloc(&_heap, size);
+            elapsed = (rt_uint32_t)(clock_cpu_gettime() - begin);
+            rt_hw_interrupt_enable(level);
+
+            _bench_record(&alloc, elapsed);
+            if (_slots[slot] == RT_NULL)
+                fails++;
+        }
+    }
+
+    LOG_I("memheap %s, %u ops:", _bench_mode(), MEMHEAP_BENCH_OPS);
+    LOG_I("    alloc %u calls, avg %u max %u cycles, %u failed",
+          alloc.count, (rt_uint32_t)(alloc.sum / alloc.count), alloc.max, fails);
+    LOG_I("    free  %u calls, avg %u max %u cycles",
+          release.count, (rt_uint32_t)(release.sum / release.count), release.max);
+
+    /* about 128 blocks of 520 bytes on average are held at a time, a quarter of the heap */
+    uassert_true(fails < alloc.count / 100);
+}
+
+/*
+ * two free blocks of the same power-of-two size class and nothing larger, the
+ * request fits the second block only
+ */
+static void test_memheap_same_class(void)
+{
+    struct rt_memheap heap;
+    void *big, *small, *ptr;
+    rt_uint8_t *mem;
+
+    mem = rt_malloc(1024);
+    uassert_not_null(mem);
+    if (mem == RT_NULL)
+        return;
+
+    uassert_int_equal(rt_memheap_init(&heap, "mclass", mem, 1024), RT_EOK);
+    big = rt_memheap_alloc(&heap, 120);
+    uassert_not_null(rt_memheap_alloc(&heap, 16));
+    small = rt_memheap_alloc(&heap, 100);
+    uassert_not_null(rt_memheap_alloc(&heap, 16));
+    /* use up the rest */
+    while (rt_memheap_alloc(&heap, 16) != RT_NULL);
+
+    rt_memheap_free(big);
+    rt_memheap_free(small);
+
+    ptr = rt_memheap_alloc(&heap, 110);
+    uassert_true(ptr == big);
+
+    rt_memheap_detach(&heap);
+    rt_free(mem);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _heap_mem = rt_malloc(MEMHEAP_BENCH_SIZE);
+    if (_heap_mem == RT_NULL)
+        return -RT_ENOMEM;
+
+    rt_memset(_slots, 0, sizeof(_slots));
+
+    return rt_memheap_init(&_heap, "mbench", _heap_mem, MEMHEAP_BENCH_SIZE);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    int i;
+
+    for (i = 0; i < MEMHEAP_BENCH_SLOTS; i++)
+    {
+        if (_slots[i])
+            rt_memheap_free(_slots[i]);
+    }
+    rt_memheap_detach(&_heap);
+    rt_free(_heap_mem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_memheap_same_class);
+    UTEST_UNIT_RUN(test_memheap_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.memheap_bench_tc", utest_tc_init, utest_tc_cleanup, 300);
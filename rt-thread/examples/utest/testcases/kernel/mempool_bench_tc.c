@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define MP_BENCH_BLOCKS         64
+#define MP_BENCH_BLOCK_SIZE     64
+#define MP_BENCH_THREADS        4
+#define MP_BENCH_ROUNDS         20000
+#define MP_BENCH_BATCH          16
+#define MP_BENCH_PRIORITY       (UTEST_THR_PRIORITY + 1)
+
+struct mp_bench_ops
+{
+    const char *name;
+    void *(*alloc)(void);
+    void (*free)(void *block);
+};
+
+static struct rt_mempool _mp;
+static rt_uint8_t *_mp_mem;
+static struct rt_semaphore _done;
+static volatile rt_uint32_t _corrupted;
+
+/*
+ * the reference path: one interrupt-disabled section per block, as the memory
+ * pool did before its lock-free fast path
+ */
+static void *_locked_list;
+
+static void *_locked_alloc(void)
+{
+    rt_base_t level;
+    void *block;
+
+    level = rt_hw_interrupt_disable();
+    block = _locked_list;
+    if (block != RT_NULL)
+        _locked_list = *(void **)block;
+    rt_hw_interrupt_enable(level);
+
+    return block;
+}
+
+static void _locked_free(void *block)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *(void **)block = _locked_list;
+    _locked_list = block;
+    rt_hw_interrupt_enable(level);
+}
+
+static void *_mp_alloc(void)
+{
+    return rt_mp_alloc(&_mp, RT_WAITING_NO);
+}
+
+static const struct mp_bench_ops _bench_ops[] =
+{
+    { "irq-off free list", _locked_alloc, _locked_free },
+    { "rt_mp lock-free",   _mp_alloc,     rt_mp_free },
+};
+
+static void _bench_entry(void *parameter)
+{
+    const struct mp_bench_ops *ops = (const struct mp_bench_ops *)parameter;
+    rt_uint32_t *block;
+    rt_uint32_t self = (rt_uint32_t)(rt_ubase_t)rt_thread_self();
+    int i;
+
+    for (i = 0; i < MP_BENCH_ROUNDS; i++)
+    {
+        block = ops->alloc();
+        if (block == RT_NULL)
+            continue;
+
+        /* a block handed out twice would be overwritten by another thread */
+        block[1] = self;
+        block[2] = i;
+        if (block[1] != self || block[2] != i)
+            _corrupted++;
+
+        ops->free(block);
+    }
+
+    rt_sem_release(&_done);
+}
+
+/* threads of the same priority and a one tick slice preempt each other in the middle of alloc/free */
+static rt_uint32_t _bench_run(const struct mp_bench_ops *ops)
+{
+    rt_thread_t tid[MP_BENCH_THREADS];
+    rt_uint64_t begin, elapsed;
+    int i;
+
+    for (i = 0; i < MP_BENCH_THREADS; i++)
+    {
+        tid[i] = rt_thread_create("mpbench", _bench_entry, (void *)ops, 1024, MP_BENCH_PRIORITY, 1);
+        uassert_not_null(tid[i]);
+    }
+
+    begin = clock_cpu_gettime();
+    for (i = 0; i < MP_BENCH_THREADS; i++)
+    {
+        if (tid[i])
+            rt_thread_startup(tid[i]);
+    }
+    for (i = 0; i < MP_BENCH_THREADS; i++)
+    {
+        if (tid[i])
+            rt_sem_take(&_done, RT_WAITING_FOREVER);
+    }
+    elapsed = clock_cpu_gettime() - begin;
+
+    return (rt_uint32_t)(elapsed / (MP_BENCH_THREADS * MP_BENCH_ROUNDS));
+}
+
+static void test_mp_contention(void)
+{
+    rt_uint32_t cycles;
+    int i;
+
+    for (i = 0; i < sizeof(_bench_ops) / sizeof(_bench_ops[0]); i++)
+    {
+        _corrupted = 0;
+        cycles = _bench_run(&_bench_ops[i]);
+        LOG_I("%-18s %d threads: %u cycles per alloc+free", _bench_ops[i].name, MP_BENCH_THREADS, cycles);
+        uassert_int_equal(_corrupted, 0);
+    }
+
+    uassert_int_equal(_mp.block_free_count, MP_BENCH_BLOCKS);
+}
+
+static void test_mp_batch(void)
+{
+    void *blocks[MP_BENCH_BATCH];
+    rt_uint64_t begin;
+    rt_uint32_t single, batch;
+    int i, round;
+
+    begin = clock_cpu_gettime();
+    for (round = 0; round < MP_BENCH_ROUNDS / MP_BENCH_BATCH; round++)
+    {
+        for (i = 0; i < MP_BENCH_BATCH; i++)
+            blocks[i] = rt_mp_alloc(&_mp, RT_WAITING_NO);
+        for (i = 0; i < MP_BENCH_BATCH; i++)
+            rt_mp_free(blocks[i]);
+    }
+    single = (rt_uint32_t)((clock_cpu_gettime() - begin) / (MP_BENCH_ROUNDS / MP_BENCH_BATCH));
+
+    begin = clock_cpu_gettime();
+    for (round = 0; round < MP_BENCH_ROUNDS / MP_BENCH_BATCH; round++)
+    {
+        uassert_int_equal(rt_mp_alloc_batch(&_mp, blocks, MP_BENCH_BATCH, RT_WAITING_NO), MP_BENCH_BATCH);
+        rt_mp_free_batch(blocks, MP_BENCH_BATCH);
+    }
+    batch = (rt_uint32_t)((clock_cpu_gettime() - begin) / (MP_BENCH_ROUNDS / MP_BENCH_BATCH));
+
+    LOG_I("%d blocks: %u cycles one by one, %u cycles in a batch", MP_BENCH_BATCH, single, batch);
+    uassert_int_equal(_mp.block_free_count, MP_BENCH_BLOCKS);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_size_t size = MP_BENCH_BLOCKS * (MP_BENCH_BLOCK_SIZE + sizeof(rt_uint8_t *));
+    int i;
+
+    _mp_mem = rt_malloc(size + MP_BENCH_BLOCKS * MP_BENCH_BLOCK_SIZE);
+    if (_mp_mem == RT_NULL)
+        return -RT_ENOMEM;
+
+    rt_mp_init(&_mp, "mpbench", _mp_mem, size, MP_BENCH_BLOCK_SIZE);
+
+    _locked_list = RT_NULL;
+    for (i = 0; i < MP_BENCH_BLOCKS; i++)
+        _locked_free(_mp_mem + size + i * MP_BENCH_BLOCK_SIZE);
+
+    rt_sem_init(&_done, "mpbench", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+    rt_mp_detach(&_mp);
+    rt_free(_mp_mem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mp_contention);
+    UTEST_UNIT_RUN(test_mp_batch);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.mempool_bench_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define MQ_BENCH_MSGS           4
+#define MQ_BENCH_ROUNDS         2000
+#define MQ_BENCH_MAX_SIZE       2048
+
+static rt_uint8_t *_src, *_dst;
+
+/* messages of both paths share one queue and keep their order */
+static void test_mq_zerocopy(void)
+{
+    rt_mq_t mq;
+    void *buf;
+    rt_uint32_t seq;
+    int i;
+
+    mq = rt_mq_create("mqzc", sizeof(rt_uint32_t) * 4, MQ_BENCH_MSGS, RT_IPC_FLAG_FIFO);
+    uassert_not_null(mq);
+    if (mq == RT_NULL)
+        return;
+
+    for (seq = 0; seq < MQ_BENCH_MSGS; seq++)
+    {
+        if (seq & 1)
+        {
+            uassert_int_equal(rt_mq_send(mq, &seq, sizeof(seq)), RT_EOK);
+        }
+        else
+        {
+            uassert_int_equal(rt_mq_reserve(mq, &buf, RT_WAITING_NO), RT_EOK);
+            *(rt_uint32_t *)buf = seq;
+            uassert_int_equal(rt_mq_commit(mq, buf), RT_EOK);
+        }
+    }
+
+    /* the queue is full */
+    uassert_int_equal(rt_mq_reserve(mq, &buf, RT_WAITING_NO), -RT_EFULL);
+    uassert_int_equal(rt_mq_send(mq, &seq, sizeof(seq)), -RT_EFULL);
+
+    for (i = 0; i < MQ_BENCH_MSGS; i++)
+    {
+        if (i & 1)
+        {
+            uassert_int_equal(rt_mq_peek(mq, &buf, RT_WAITING_NO), RT_EOK);
+            uassert_int_equal(*(rt_uint32_t *)buf, i);
+            uassert_int_equal(rt_mq_release(mq, buf), RT_EOK);
+        }
+        else
+        {
+            seq = ~0;
+            uassert_int_equal(rt_mq_recv(mq, &seq, sizeof(seq), RT_WAITING_NO), RT_EOK);
+            uassert_int_equal(seq, i);
+        }
+    }
+
+    /* the queue is empty */
+    uassert_int_equal(rt_mq_peek(mq, &buf, RT_WAITING_NO), -RT_ETIMEOUT);
+
+    /* a reserved slot that is not sent goes back by release */
+    uassert_int_equal(rt_mq_reserve(mq, &buf, RT_WAITING_NO), RT_EOK);
+    uassert_int_equal(rt_mq_release(mq, buf), RT_EOK);
+    uassert_int_equal(rt_mq_peek(mq, &buf, RT_WAITING_NO), -RT_ETIMEOUT);
+    for (i = 0; i < MQ_BENCH_MSGS; i++)
+        uassert_int_equal(rt_mq_send(mq, &seq, sizeof(seq)), RT_EOK);
+
+    rt_mq_delete(mq);
+}
+
+/* cycles per message through send+recv against reserve/commit/peek/release */
+static void _mq_bench(rt_size_t size)
+{
+    rt_uint64_t begin, copy, zerocopy;
+    rt_uint32_t errors = 0;
+    rt_mq_t mq;
+    void *buf;
+    int i;
+
+    mq = rt_mq_create("mqbench", size, MQ_BENCH_MSGS, RT_IPC_FLAG_FIFO);
+    uassert_not_null(mq);
+    if (mq == RT_NULL)
+        return;
+
+    /* the producer builds the frame aside and the queue copies it in and out */
+    begin = clock_cpu_gettime();
+    for (i = 0; i < MQ_BENCH_ROUNDS; i++)
+    {
+        *(rt_uint32_t *)_src = i;
+        rt_mq_send(mq, _src, size);
+        rt_mq_recv(mq, _dst, size, RT_WAITING_NO);
+        if (*(rt_uint32_t *)_dst != i)
+            errors++;
+    }
+    copy = clock_cpu_gettime() - begin;
+
+    /* the producer builds the frame in the slot and the consumer uses it there */
+    begin = clock_cpu_gettime();
+    for (i = 0; i < MQ_BENCH_ROUNDS; i++)
+    {
+        rt_mq_reserve(mq, &buf, RT_WAITING_NO);
+        *(rt_uint32_t *)buf = i;
+        rt_mq_commit(mq, buf);
+        rt_mq_peek(mq, &buf, RT_WAITING_NO);
+        if (*(rt_uint32_t *)buf != i)
+            errors++;
+        rt_mq_release(mq, buf);
+    }
+    zerocopy = clock_cpu_gettime() - begin;
+
+    LOG_I("msg %4d bytes: %u cycles send+recv, %u cycles reserve/commit/peek/release", size,
+          (rt_uint32_t)(copy / MQ_BENCH_ROUNDS), (rt_uint32_t)(zerocopy / MQ_BENCH_ROUNDS));
+    uassert_int_equal(errors, 0);
+
+    rt_mq_delete(mq);
+}
+
+static void test_mq_zerocopy_bench(void)
+{
+    _mq_bench(16);
+    _mq_bench(128);
+    _mq_bench(512);
+    _mq_bench(1024);
+    _mq_bench(MQ_BENCH_MAX_SIZE);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _src = rt_malloc(MQ_BENCH_MAX_SIZE * 2);
+    if (_src == RT_NULL)
+        return -RT_ENOMEM;
+    _dst = _src + MQ_BENCH_MAX_SIZE;
+
+    rt_memset(_src, 0x5a, MQ_BENCH_MAX_SIZE);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(_src);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mq_zerocopy);
+    UTEST_UNIT_RUN(test_mq_zerocopy_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.mq_zerocopy_bench_tc", utest_tc_init, utest_tc_cleanup, 10);
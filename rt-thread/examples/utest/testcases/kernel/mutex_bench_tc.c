@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define MUTEX_BENCH_ROUNDS      20000
+#define MUTEX_BENCH_THREADS     4
+#define MUTEX_BENCH_PRIORITY    (UTEST_THR_PRIORITY + 1)
+#define MUTEX_HIGH_PRIORITY     (UTEST_THR_PRIORITY - 1)
+
+static struct rt_mutex _mutex;
+static struct rt_semaphore _sem;
+static struct rt_semaphore _done;
+static volatile rt_uint32_t _counter;
+
+/* cycles per take+release pair of one thread, recursion of two levels */
+static void test_mutex_uncontended(void)
+{
+    rt_uint64_t begin;
+    rt_uint32_t mutex, recursive, sem;
+    int i;
+
+    begin = clock_cpu_gettime();
+    for (i = 0; i < MUTEX_BENCH_ROUNDS; i++)
+    {
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&_mutex);
+    }
+    mutex = (rt_uint32_t)((clock_cpu_gettime() - begin) / MUTEX_BENCH_ROUNDS);
+
+    begin = clock_cpu_gettime();
+    for (i = 0; i < MUTEX_BENCH_ROUNDS; i++)
+    {
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&_mutex);
+        rt_mutex_release(&_mutex);
+    }
+    recursive = (rt_uint32_t)((clock_cpu_gettime() - begin) / MUTEX_BENCH_ROUNDS);
+
+    /* the reference, a binary semaphore always takes the interrupt lock */
+    begin = clock_cpu_gettime();
+    for (i = 0; i < MUTEX_BENCH_ROUNDS; i++)
+    {
+        rt_sem_take(&_sem, RT_WAITING_FOREVER);
+        rt_sem_release(&_sem);
+    }
+    sem = (rt_uint32_t)((clock_cpu_gettime() - begin) / MUTEX_BENCH_ROUNDS);
+
+    LOG_I("uncontended: %u cycles mutex, %u cycles recursive mutex, %u cycles semaphore",
+          mutex, recursive, sem);
+
+    /* a non-owner can't release it */
+    rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+    rt_mutex_release(&_mutex);
+    uassert_int_equal(rt_mutex_release(&_mutex), -RT_ERROR);
+}
+
+static void _contend_entry(void *parameter)
+{
+    rt_uint32_t value;
+    int i;
+
+    for (i = 0; i < MUTEX_BENCH_ROUNDS; i++)
+    {
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+
+        /* a lost update shows two owners at the same time */
+        value = _counter;
+        if ((i & 0xff) == 0)
+            rt_thread_yield();
+        _counter = value + 1;
+
+        rt_mutex_release(&_mutex);
+    }
+
+    rt_sem_release(&_done);
+}
+
+/* equal priority threads with a one tick slice, some yield while they hold the mutex */
+static void test_mutex_contended(void)
+{
+    rt_thread_t tid[MUTEX_BENCH_THREADS];
+    rt_uint64_t begin, elapsed;
+    int i, started = 0;
+
+    _counter = 0;
+    for (i = 0; i < MUTEX_BENCH_THREADS; i++)
+    {
+        tid[i] = rt_thread_create("mtxbench", _contend_entry, RT_NULL, 1024, MUTEX_BENCH_PRIORITY, 1);
+        uassert_not_null(tid[i]);
+    }
+
+    begin = clock_cpu_gettime();
+    for (i = 0; i < MUTEX_BENCH_THREADS; i++)
+    {
+        if (tid[i])
+        {
+            rt_thread_startup(tid[i]);
+            started++;
+        }
+    }
+    for (i = 0; i < started; i++)
+        rt_sem_take(&_done, RT_WAITING_FOREVER);
+    elapsed = clock_cpu_gettime() - begin;
+
+    LOG_I("contended: %d threads, %u cycles per take+release", started,
+          (rt_uint32_t)(elapsed / (MUTEX_BENCH_THREADS * MUTEX_BENCH_ROUNDS)));
+    uassert_int_equal(_counter, started * MUTEX_BENCH_ROUNDS);
+}
+
+static void _high_entry(void *parameter)
+{
+    rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+    _counter++;
+    rt_mutex_release(&_mutex);
+
+    rt_sem_release(&_done);
+}
+
+/* a higher priority waiter lifts the owner which took the mutex without contention */
+static void test_mutex_inherit(void)
+{
+    rt_thread_t self = rt_thread_self();
+    rt_uint8_t priority = self->current_priority;
+    rt_thread_t high;
+
+    _counter = 0;
+    uassert_int_equal(rt_mutex_take(&_mutex, RT_WAITING_FOREVER), RT_EOK);
+
+    high = rt_thread_create("mtxhigh", _high_entry, RT_NULL, 1024, MUTEX_HIGH_PRIORITY, 10);
+    uassert_not_null(high);
+    if (high == RT_NULL)
+    {
+        rt_mutex_release(&_mutex);
+        return;
+    }
+    rt_thread_startup(high);
+
+    /* the waiter ran, blocked and lent its priority */
+    uassert_int_equal(_counter, 0);
+    uassert_int_equal(self->current_priority, MUTEX_HIGH_PRIORITY);
+
+    uassert_int_equal(rt_mutex_release(&_mutex), RT_EOK);
+    uassert_int_equal(rt_sem_take(&_done, RT_WAITING_FOREVER), RT_EOK);
+    uassert_int_equal(_counter, 1);
+    uassert_int_equal(self->current_priority, priority);
+
+    /* the mutex is free again for the fast path */
+    uassert_int_equal(rt_mutex_take(&_mutex, RT_WAITING_NO), RT_EOK);
+    uassert_int_equal(rt_mutex_release(&_mutex), RT_EOK);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_mutex_init(&_mutex, "mtxbench", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_sem, "mtxbench", 1, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_done, "mtxdone", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_mutex_detach(&_mutex);
+    rt_sem_detach(&_sem);
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mutex_uncontended);
+    UTEST_UNIT_RUN(test_mutex_contended);
+    UTEST_UNIT_RUN(test_mutex_inherit);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.mutex_bench_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define OBJECT_BENCH_DEVICES    200
+#define OBJECT_BENCH_ROUNDS     20
+
+static struct rt_device *_devices;
+static char _names[OBJECT_BENCH_DEVICES][RT_NAME_MAX];
+
+/* the lookup as rt_object_find() does it without the hash index */
+static rt_object_t _object_walk(const char *name, rt_uint8_t type)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_object *object;
+
+    information = rt_object_get_information((enum rt_object_class_type)type);
+
+    rt_enter_critical();
+    rt_list_for_each(node, &(information->object_list))
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            rt_exit_critical();
+
+            return object;
+        }
+    }
+    rt_exit_critical();
+
+    return RT_NULL;
+}
+
+/* cycles per lookup of each registered device, in a random looking order */
+static rt_uint32_t _bench_find(rt_object_t (*find)(const char *name, rt_uint8_t type))
+{
+    rt_uint64_t begin;
+    int round, i, index;
+
+    begin = clock_cpu_gettime();
+    for (round = 0; round < OBJECT_BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < OBJECT_BENCH_DEVICES; i++)
+        {
+            index = (i * 67 + round) % OBJECT_BENCH_DEVICES;
+            if (find(_names[index], RT_Object_Class_Device) != &_devices[index].parent)
+            {
+                uassert_true(RT_FALSE);
+                return 0;
+            }
+        }
+    }
+
+    return (rt_uint32_t)((clock_cpu_gettime() - begin) / (OBJECT_BENCH_ROUNDS * OBJECT_BENCH_DEVICES));
+}
+
+static void test_object_find_bench(void)
+{
+    rt_uint32_t walk, found;
+
+    walk = _bench_find(_object_walk);
+    found = _bench_find(rt_object_find);
+
+    LOG_I("%d devices: %u cycles per lookup with rt_object_find(), %u with the list walk",
+          OBJECT_BENCH_DEVICES, found, walk);
+    uassert_null(rt_device_find("nodevice"));
+}
+
+static void test_object_rename(void)
+{
+    struct rt_object *object = &_devices[0].parent;
+
+    rt_object_rename(object, "renamed");
+    uassert_null(rt_device_find(_names[0]));
+    uassert_true(rt_object_find("renamed", RT_Object_Class_Device) == object);
+
+    rt_object_rename(object, _names[0]);
+    uassert_null(rt_device_find("renamed"));
+    uassert_true(rt_object_find(_names[0], RT_Object_Class_Device) == object);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int i;
+
+    _devices = rt_calloc(OBJECT_BENCH_DEVICES, sizeof(struct rt_device));
+    if (_devices == RT_NULL)
+        return -RT_ENOMEM;
+
+    for (i = 0; i < OBJECT_BENCH_DEVICES; i++)
+    {
+        rt_snprintf(_names[i], RT_NAME_MAX, "ob%d", i);
+        _devices[i].type = RT_Device_Class_Miscellaneous;
+        if (rt_device_register(&_devices[i], _names[i], RT_DEVICE_FLAG_RDWR) != RT_EOK)
+        {
+            while (i--)
+                rt_device_unregister(&_devices[i]);
+            rt_free(_devices);
+
+            return -RT_ERROR;
+        }
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    int i;
+
+    for (i = 0; i < OBJECT_BENCH_DEVICES; i++)
+        rt_device_unregister(&_devices[i]);
+    rt_free(_devices);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_object_find_bench);
+    UTEST_UNIT_RUN(test_object_rename);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.object_find_bench_tc", utest_tc_init, utest_tc_cleanup, 10);
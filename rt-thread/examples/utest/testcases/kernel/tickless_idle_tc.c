@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+#define TICKLESS_TIMER_NUM  5
+#define TICKLESS_PERIOD     100
+#define TICKLESS_PERIOD_NUM 10
+#define TICK_US             (1000000 / RT_TICK_PER_SECOND)
+
+/* the reference clock keeps counting while the core sleeps */
+static rt_device_t _ref;
+
+static struct rt_timer _timers[TICKLESS_TIMER_NUM];
+static volatile rt_tick_t _fired_tick[TICKLESS_TIMER_NUM];
+static volatile rt_tick_t _period_tick[TICKLESS_PERIOD_NUM];
+static volatile rt_uint32_t _period_count;
+
+static rt_uint64_t _ref_us(void)
+{
+    rt_hwtimerval_t tv;
+
+    rt_device_read(_ref, 0, &tv, sizeof(tv));
+
+    return (rt_uint64_t)tv.sec * 1000000 + tv.usec;
+}
+
+static void test_tickless_delay(void)
+{
+    static const rt_tick_t delays[] = { 3, 10, 100, 1000, 5 * RT_TICK_PER_SECOND };
+    rt_tick_t begin, elapsed;
+    rt_uint64_t ref_begin, ref_elapsed;
+    int i;
+
+    for (i = 0; i < sizeof(delays) / sizeof(delays[0]); i++)
+    {
+        /* start right after a tick boundary */
+        rt_thread_delay(1);
+
+        begin = rt_tick_get();
+        ref_begin = _ref_us();
+        rt_thread_delay(delays[i]);
+        elapsed = rt_tick_get() - begin;
+        ref_elapsed = _ref_us() - ref_begin;
+
+        LOG_I("delay %u ticks: %u ticks, %u us on the reference clock",
+              delays[i], elapsed, (rt_uint32_t)ref_elapsed);
+
+        /* the thread is woken up on the very tick */
+        uassert_int_equal(elapsed, delays[i]);
+        /* and the tick has not drifted from the wall time while sleeping */
+        uassert_in_range(ref_elapsed, (rt_uint64_t)(delays[i] - 1) * TICK_US, (rt_uint64_t)(delays[i] + 1) * TICK_US);
+    }
+}
+
+static void _tickless_timeout(void *parameter)
+{
+    _fired_tick[(rt_ubase_t)parameter] = rt_tick_get();
+}
+
+static void _tickless_period(void *parameter)
+{
+    if (_period_count < TICKLESS_PERIOD_NUM)
+    {
+        _period_tick[_period_count++] = rt_tick_get();
+    }
+}
+
+static void test_tickless_timer(void)
+{
+    static const rt_tick_t timeouts[TICKLESS_TIMER_NUM - 1] = { 7, 33, 250, 1200 };
+    rt_base_t level;
+    rt_tick_t begin;
+    int i;
+
+    for (i = 0; i < TICKLESS_TIMER_NUM - 1; i++)
+    {
+        rt_timer_init(&_timers[i], "tlss", _tickless_timeout, (void *)(rt_ubase_t)i,
+                      timeouts[i], RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+    }
+    rt_timer_init(&_timers[i], "tlsp", _tickless_period, RT_NULL,
+                  TICKLESS_PERIOD, RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+
+    _period_count = 0;
+
+    /* start all of them on the same tick */
+    level = rt_hw_interrupt_disable();
+    begin = rt_tick_get();
+    for (i = 0; i < TICKLESS_TIMER_NUM; i++)
+    {
+        rt_timer_start(&_timers[i]);
+    }
+    rt_hw_interrupt_enable(level);
+
+    rt_thread_delay(TICKLESS_PERIOD * TICKLESS_PERIOD_NUM + 10);
+
+    for (i = 0; i < TICKLESS_TIMER_NUM - 1; i++)
+    {
+        uassert_int_equal(_fired_tick[i] - begin, timeouts[i]);
+    }
+
+    uassert_int_equal(_period_count, TICKLESS_PERIOD_NUM);
+    for (i = 0; i < TICKLESS_PERIOD_NUM; i++)
+    {
+        uassert_int_equal(_period_tick[i] - begin, (i + 1) * TICKLESS_PERIOD);
+    }
+
+    for (i = 0; i < TICKLESS_TIMER_NUM; i++)
+    {
+        rt_timer_detach(&_timers[i]);
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_hwtimer_mode_t mode = HWTIMER_MODE_PERIOD;
+    rt_hwtimerval_t tv = { 1, 0 };
+
+    _ref = rt_device_find(UTEST_TICKLESS_IDLE_REF_HWTIMER);
+    if (_ref == RT_NULL)
+    {
+        LOG_E("hwtimer %s not found", UTEST_TICKLESS_IDLE_REF_HWTIMER);
+        return -RT_ERROR;
+    }
+
+    if (rt_device_open(_ref, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+        return -RT_ERROR;
+
+    rt_device_control(_ref, HWTIMER_CTRL_MODE_SET, &mode);
+    if (rt_device_write(_ref, 0, &tv, sizeof(tv)) != sizeof(tv))
+    {
+        rt_device_close(_ref);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_device_close(_ref);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_tickless_delay);
+    UTEST_UNIT_RUN(test_tickless_timer);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.tickless_idle_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <stdlib.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define TIMER_BENCH_MAX         1000
+#define TIMER_BENCH_ROUNDS      2000
+/* keep every timer far enough in the future to never fire during the test */
+#define TIMER_BENCH_TIMEOUT_MIN (RT_TICK_PER_SECOND * 60)
+#define TIMER_BENCH_TIMEOUT_MAX (RT_TICK_PER_SECOND * 600)
+
+struct timer_bench_result
+{
+    rt_uint32_t start_max;
+    rt_uint32_t stop_max;
+    rt_uint64_t start_sum;
+    rt_uint64_t stop_sum;
+};
+
+static struct rt_timer *_timers;
+
+static void _timer_bench_timeout(void *parameter)
+{
+    /* should never be called */
+    uassert_true(RT_FALSE);
+}
+
+static rt_tick_t _timer_bench_random_tick(void)
+{
+    return TIMER_BENCH_TIMEOUT_MIN + rand() % (TIMER_BENCH_TIMEOUT_MAX - TIMER_BENCH_TIMEOUT_MIN);
+}
+
+/* the whole call is measured with interrupt disabled, it is an upper bound of the interrupt-off window inside */
+static void _timer_bench_run(int count, rt_uint8_t flag, struct timer_bench_result *result)
+{
+    int i;
+    rt_base_t level;
+    rt_tick_t tick;
+    rt_uint32_t elapsed;
+    rt_uint64_t begin;
+
+    rt_memset(result, 0, sizeof(*result));
+
+    for (i = 0; i < count; i++)
+    {
+        rt_timer_init(&_timers[i], "tbench", _timer_bench_timeout, RT_NULL,
+                      _timer_bench_random_tick(), RT_TIMER_FLAG_ONE_SHOT | flag);
+        rt_timer_start(&_timers[i]);
+    }
+
+    for (i = 0; i < TIMER_BENCH_ROUNDS; i++)
+    {
+        struct rt_timer *timer = &_timers[rand() % count];
+
+        tick = _timer_bench_random_tick();
+        rt_timer_control(timer, RT_TIMER_CTRL_SET_TIME, &tick);
+
+        level = rt_hw_interrupt_disable();
+        begin = clock_cpu_gettime();
+        rt_timer_stop(timer);
+        elapsed = (rt_uint32_t)(clock_cpu_gettime() - begin);
+        rt_hw_interrupt_enable(level);
+
+        result->stop_sum += elapsed;
+        if (elapsed > result->stop_max)
+            result->stop_max = elapsed;
+
+        level = rt_hw_interrupt_disable();
+        begin = clock_cpu_gettime();
+        rt_timer_start(timer);
+        elapsed = (rt_uint32_t)(clock_cpu_gettime() - begin);
+        rt_hw_interrupt_enable(level);
+
+        result->start_sum += elapsed;
+        if (elapsed > result->start_max)
+            result->start_max = elapsed;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        uassert_int_equal(rt_timer_detach(&_timers[i]), RT_EOK);
+    }
+}
+
+static void _timer_bench(rt_uint8_t flag)
+{
+    static const int counts[] = { 10, 100, TIMER_BENCH_MAX };
+    struct timer_bench_result result;
+    int i;
+
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        _timer_bench_run(counts[i], flag, &result);
+
+        LOG_I("%s timers %4d: start max %6u avg %6u, stop max %6u avg %6u (cputime ticks)",
+              (flag & RT_TIMER_FLAG_SOFT_TIMER) ? "soft" : "hard", counts[i],
+              result.start_max, (rt_uint32_t)(result.start_sum / TIMER_BENCH_ROUNDS),
+              result.stop_max, (rt_uint32_t)(result.stop_sum / TIMER_BENCH_ROUNDS));
+        LOG_I("    start max %u us, stop max %u us",
+              clock_cpu_microsecond(result.start_max), clock_cpu_microsecond(result.stop_max));
+    }
+}
+
+static void test_timer_bench_hard(void)
+{
+    _timer_bench(RT_TIMER_FLAG_HARD_TIMER);
+}
+
+#ifdef RT_USING_TIMER_SOFT
+static void test_timer_bench_soft(void)
+{
+    _timer_bench(RT_TIMER_FLAG_SOFT_TIMER);
+}
+#endif /* RT_USING_TIMER_SOFT */
+
+static rt_err_t utest_tc_init(void)
+{
+    _timers = rt_malloc(sizeof(struct rt_timer) * TIMER_BENCH_MAX);
+    if (_timers == RT_NULL)
+        return -RT_ENOMEM;
+
+#ifdef RT_USING_TIMER_WHEEL
+    LOG_I("timer backend: timing wheel");
+#else
+    LOG_I("timer backend: sorted list, skip list level %d", RT_TIMER_SKIP_LIST_LEVEL);
+#endif /* RT_USING_TIMER_WHEEL */
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(_timers);
+    _timers = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_timer_bench_hard);
+#ifdef RT_USING_TIMER_SOFT
+    UTEST_UNIT_RUN(test_timer_bench_soft);
+#endif /* RT_USING_TIMER_SOFT */
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.timer_bench_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2006-2023, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     agent        the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <rtdevice.h>
+#include <drivers/cputime.h>
+#include "utest.h"
+
+#define TIMER_LATENCY_NUM       500
+#define TIMER_LATENCY_ROUNDS    10
+/* busy time of each timeout function */
+#define TIMER_LATENCY_BUSY_US   2
+/* the hwtimer interrupt is raised this long after the batch starts */
+#define TIMER_LATENCY_HWTIMER_US 20
+
+static struct rt_timer *_timers;
+static rt_device_t _hwtimer;
+static volatile rt_uint32_t _fired;
+static volatile rt_uint64_t _batch_begin;
+static volatile rt_uint64_t _batch_end;
+static volatile rt_uint64_t _irq_armed;
+static volatile rt_uint64_t _irq_entered;
+
+static void _busy_wait(rt_uint32_t us)
+{
+    rt_uint64_t begin = clock_cpu_gettime();
+
+    while (clock_cpu_microsecond((rt_uint32_t)(clock_cpu_gettime() - begin)) < us);
+}
+
+static rt_err_t _hwtimer_timeout(rt_device_t dev, rt_size_t size)
+{
+    _irq_entered = clock_cpu_gettime();
+
+    return RT_EOK;
+}
+
+static void _timer_timeout(void *parameter)
+{
+    rt_uint64_t now = clock_cpu_gettime();
+
+    if (_fired++ == 0)
+    {
+        rt_hwtimerval_t tv = { 0, TIMER_LATENCY_HWTIMER_US };
+
+        /* the first one of the batch raises the hwtimer interrupt shortly */
+        _batch_begin = now;
+        _irq_armed = clock_cpu_gettime();
+        rt_device_write(_hwtimer, 0, &tv, sizeof(tv));
+    }
+
+    _busy_wait(TIMER_LATENCY_BUSY_US);
+    _batch_end = clock_cpu_gettime();
+}
+
+static void test_timer_irq_latency(void)
+{
+    int i, round;
+    rt_base_t level;
+    rt_uint32_t latency, latency_max = 0, batch, batch_min = RT_UINT32_MAX;
+
+    for (round = 0; round < TIMER_LATENCY_ROUNDS; round++)
+    {
+        _fired = 0;
+        _irq_entered = 0;
+
+        /* all timers are started on the same tick and expire on the same tick */
+        level = rt_hw_interrupt_disable();
+        for (i = 0; i < TIMER_LATENCY_NUM; i++)
+        {
+            rt_timer_start(&_timers[i]);
+        }
+        rt_hw_interrupt_enable(level);
+
+        rt_thread_mdelay(100);
+
+        uassert_int_equal(_fired, TIMER_LATENCY_NUM);
+        uassert_int_not_equal(_irq_entered, 0);
+        if (_fired != TIMER_LATENCY_NUM || _irq_entered == 0)
+            return;
+
+        latency = clock_cpu_microsecond((rt_uint32_t)(_irq_entered - _irq_armed));
+        latency = (latency > TIMER_LATENCY_HWTIMER_US) ? latency - TIMER_LATENCY_HWTIMER_US : 0;
+        batch = clock_cpu_microsecond((rt_uint32_t)(_batch_end - _batch_begin));
+
+        if (latency > latency_max)
+            latency_max = latency;
+        if (batch < batch_min)
+            batch_min = batch;
+    }
+
+    LOG_I("%d timers on one tick: batch takes %u us, max irq latency %u us",
+          TIMER_LATENCY_NUM, batch_min, latency_max);
+
+    /* the interrupt must not wait for the whole batch */
+    uassert_true(latency_max < batch_min / 2);
+}
+
+static struct rt_semaphore _race_sem;
+static struct rt_semaphore _race_done;
+static rt_err_t _race_result;
+
+static void _race_timeout(void *parameter)
+{
+    rt_sem_release(&_race_sem);
+}
+
+static void _race_entry(void *parameter)
+{
+    _race_result = rt_sem_take(&_race_sem, 10);
+    rt_sem_release(&_race_done);
+}
+
+/* the thread timeout and a timer releasing the semaphore expire on the same tick */
+static void test_timer_resume_race(void)
+{
+    int round;
+    rt_thread_t tid;
+    struct rt_timer timer;
+
+    rt_sem_init(&_race_sem, "trace", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_race_done, "tdone", 0, RT_IPC_FLAG_PRIO);
+    rt_timer_init(&timer, "trace", _race_timeout, RT_NULL, 10,
+                  RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+
+    for (round = 0; round < 50; round++)
+    {
+        tid = rt_thread_create("trace", _race_entry, RT_NULL, 1024,
+                               rt_thread_self()->current_priority - 1, 10);
+        uassert_not_null(tid);
+        if (tid == RT_NULL)
+            break;
+
+        /* the new thread preempts us and blocks on the semaphore */
+        rt_thread_startup(tid);
+        rt_timer_start(&timer);
+
+        uassert_int_equal(rt_sem_take(&_race_done, RT_WAITING_FOREVER), RT_EOK);
+        if (_race_result == RT_EOK)
+        {
+            uassert_int_equal(_race_sem.value, 0);
+        }
+        else
+        {
+            /* the release comes after the timeout and is kept by the semaphore */
+            uassert_int_equal(_race_result, -RT_ETIMEOUT);
+            rt_thread_mdelay(20);
+            uassert_int_equal(_race_sem.value, 1);
+            rt_sem_take(&_race_sem, RT_WAITING_NO);
+        }
+    }
+
+    rt_timer_detach(&timer);
+    rt_sem_detach(&_race_done);
+    rt_sem_detach(&_race_sem);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int i;
+    rt_hwtimer_mode_t mode = HWTIMER_MODE_ONESHOT;
+
+    _hwtimer = rt_device_find(UTEST_TIMER_IRQ_LATENCY_HWTIMER);
+    if (_hwtimer == RT_NULL)
+    {
+        LOG_E("hwtimer %s not found", UTEST_TIMER_IRQ_LATENCY_HWTIMER);
+        return -RT_ERROR;
+    }
+
+    if (rt_device_open(_hwtimer, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+        return -RT_ERROR;
+
+    rt_device_set_rx_indicate(_hwtimer, _hwtimer_timeout);
+    rt_device_control(_hwtimer, HWTIMER_CTRL_MODE_SET, &mode);
+
+    _timers = rt_malloc(sizeof(struct rt_timer) * TIMER_LATENCY_NUM);
+    if (_timers == RT_NULL)
+    {
+        rt_device_close(_hwtimer);
+        return -RT_ENOMEM;
+    }
+
+    for (i = 0; i < TIMER_LATENCY_NUM; i++)
+    {
+        rt_timer_init(&_timers[i], "tlat", _timer_timeout, RT_NULL, 10,
+                      RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    int i;
+
+    for (i = 0; i < TIMER_LATENCY_NUM; i++)
+    {
+        rt_timer_detach(&_timers[i]);
+    }
+    rt_free(_timers);
+    _timers = RT_NULL;
+
+    rt_device_close(_hwtimer);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_timer_irq_latency);
+    UTEST_UNIT_RUN(test_timer_resume_race);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.timer_irq_latency_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -415,6 +415,9 @@ struct rt_object
     void      *module_id;                               /**< id of application module */
 #endif /* RT_USING_MODULE */
     rt_list_t  list;                                    /**< list node of kernel object */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object *hash_next;                        /**< next object in the same hash bucket */
+#endif /* RT_USING_OBJECT_HASH */
 };
 typedef struct rt_object *rt_object_t;                  /**< Type for kernel objects. */
 
@@ -539,6 +542,9 @@ struct rt_timer
 
     rt_tick_t        init_tick;                         /**< timer timeout tick */
     rt_tick_t        timeout_tick;                      /**< timeout tick */
+#ifdef RT_USING_TIMER_WHEEL
+    rt_uint8_t       wheel_level;                       /**< timing wheel level the timer is hung on */
+#endif /* RT_USING_TIMER_WHEEL */
 };
 typedef struct rt_timer *rt_timer_t;
 
@@ -596,6 +602,16 @@ typedef void (*rt_sighandler_t)(int signo);
 #define RT_THREAD_CTRL_INFO             0x03                /**< Get thread information. */
 #define RT_THREAD_CTRL_BIND_CPU         0x04                /**< Set thread bind cpu. */
 
+#ifdef RT_USING_CPU_USAGE
+#ifndef RT_CPU_USAGE_PERIOD
+#define RT_CPU_USAGE_PERIOD             1000                /**< CPU usage sampling period in ms. */
+#endif /* RT_CPU_USAGE_PERIOD */
+
+#ifndef RT_CPU_USAGE_WINDOW
+#define RT_CPU_USAGE_WINDOW             4                   /**< CPU usage sampling periods in window. */
+#endif /* RT_CPU_USAGE_WINDOW */
+#endif /* RT_USING_CPU_USAGE */
+
 #ifdef RT_USING_SMP
 
 #define RT_CPU_DETACHED                 RT_CPUS_NR          /**< The thread not running on cpu. */
@@ -709,12 +725,18 @@ struct rt_thread
 
 #ifdef RT_USING_CPU_USAGE
     rt_uint64_t  duration_tick;                         /**< cpu usage tick */
+    rt_uint32_t  usage_run;                             /**< run time in the current period */
+    rt_uint32_t  usage_window[RT_CPU_USAGE_WINDOW];     /**< run time in each of the last periods */
 #endif /* RT_USING_CPU_USAGE */
 
 #ifdef RT_USING_PTHREADS
     void  *pthread_data;                                /**< the handle of pthread data, adapt 32/64bit */
 #endif /* RT_USING_PTHREADS */
 
+#ifdef RT_USING_HEAP_CACHE
+    void  *heap_cache;                                  /**< small block cache in front of system heap */
+#endif /* RT_USING_HEAP_CACHE */
+
     struct rt_timer thread_timer;                       /**< built-in thread timer */
 
     void (*cleanup)(struct rt_thread *tid);             /**< cleanup function when thread exit */
@@ -728,6 +750,21 @@ struct rt_thread
 };
 typedef struct rt_thread *rt_thread_t;
 
+#ifdef RT_USING_CPU_USAGE
+/**
+ * thread statistics
+ */
+struct rt_thread_stats
+{
+    rt_uint64_t run_tick;                               /**< total run time in cputime or tick */
+    rt_uint16_t usage;                                  /**< cpu usage of the last period, in 0.01% */
+    rt_uint16_t usage_avg;                              /**< average cpu usage of the sliding window */
+    rt_uint16_t usage_max;                              /**< peak cpu usage of the sliding window */
+    rt_uint32_t stack_size;                             /**< stack size */
+    rt_uint32_t stack_max_used;                         /**< stack high-water mark */
+};
+#endif /* RT_USING_CPU_USAGE */
+
 /**@}*/
 
 /**
@@ -756,8 +793,60 @@ struct rt_ipc_object
     struct rt_object parent;                            /**< inherit from rt_object */
 
     rt_list_t        suspend_thread;                    /**< threads pended on this resource */
+#ifdef RT_USING_IPC_WAITANY
+    rt_list_t        waitany_list;                      /**< rt_ipc_wait_any() items pended on this resource */
+#endif /* RT_USING_IPC_WAITANY */
+};
+
+#ifdef RT_USING_IPC_WAITANY
+/**
+ * item of rt_ipc_wait_any(), one for each object to wait
+ */
+struct rt_ipc_wait_item
+{
+    rt_object_t          object;                        /**< semaphore, mailbox, messagequeue or event */
+    rt_uint32_t          set;                           /**< event set to wait, event only */
+    rt_uint8_t           option;                        /**< RT_EVENT_FLAG_AND or RT_EVENT_FLAG_OR, event only */
+
+    rt_uint8_t           signaled;                      /**< private, the item woke up the thread */
+    rt_list_t            list;                          /**< private, node of the waitany list of object */
+    struct rt_thread    *thread;                        /**< private, thread waiting on the item */
+};
+#endif /* RT_USING_IPC_WAITANY */
+
+#ifdef RT_USING_LOCKSTAT
+#ifndef RT_LOCKSTAT_TOP_NUM
+#define RT_LOCKSTAT_TOP_NUM             3
+#endif
+
+/**
+ * thread waited on a lock, the time is in cputime counts, or in ticks
+ * without RT_USING_CPUTIME
+ */
+struct rt_lockstat_waiter
+{
+    char                 name[RT_NAME_MAX];             /**< name of thread */
+    struct rt_thread    *thread;                        /**< thread, only used as key */
+    rt_uint32_t          count;                         /**< number of waits */
+    rt_uint64_t          wait_time;                     /**< total wait time */
 };
 
+/**
+ * contention statistics of semaphore, mutex and event
+ */
+struct rt_lockstat
+{
+    rt_uint32_t          acquire;                       /**< successful acquisitions */
+    rt_uint32_t          contended;                     /**< acquisitions which had to wait */
+    rt_uint32_t          failed;                        /**< waits ended without acquisition */
+    rt_uint64_t          wait_total;                    /**< total wait time */
+    rt_uint32_t          wait_max;                      /**< max wait time */
+    rt_uint32_t          hold_max;                      /**< max hold time, mutex only */
+    rt_uint32_t          hold_start;                    /**< time stamp of the last take, mutex only */
+    struct rt_lockstat_waiter top[RT_LOCKSTAT_TOP_NUM]; /**< threads waited longest */
+};
+#endif /* RT_USING_LOCKSTAT */
+
 #ifdef RT_USING_SEMAPHORE
 /**
  * Semaphore structure
@@ -768,6 +857,9 @@ struct rt_semaphore
 
     rt_uint16_t          value;                         /**< value of semaphore. */
     rt_uint16_t          reserved;                      /**< reserved field */
+#ifdef RT_USING_LOCKSTAT
+    struct rt_lockstat   lockstat;                      /**< contention statistics */
+#endif /* RT_USING_LOCKSTAT */
 };
 typedef struct rt_semaphore *rt_sem_t;
 #endif /* RT_USING_SEMAPHORE */
@@ -787,6 +879,12 @@ struct rt_mutex
 
     struct rt_thread    *owner;                         /**< current owner of mutex */
     rt_list_t            taken_list;                    /**< the object list taken by thread */
+#ifdef RT_USING_MUTEX_ADAPTIVE
+    volatile rt_ubase_t  lock;                          /**< owner and slow mode bit for the lock-free path */
+#endif /* RT_USING_MUTEX_ADAPTIVE */
+#ifdef RT_USING_LOCKSTAT
+    struct rt_lockstat   lockstat;                      /**< contention statistics */
+#endif /* RT_USING_LOCKSTAT */
 };
 typedef struct rt_mutex *rt_mutex_t;
 #endif /* RT_USING_MUTEX */
@@ -807,6 +905,9 @@ struct rt_event
     struct rt_ipc_object parent;                        /**< inherit from ipc_object */
 
     rt_uint32_t          set;                           /**< event set */
+#ifdef RT_USING_LOCKSTAT
+    struct rt_lockstat   lockstat;                      /**< contention statistics */
+#endif /* RT_USING_LOCKSTAT */
 };
 typedef struct rt_event *rt_event_t;
 #endif /* RT_USING_EVENT */
@@ -864,6 +965,50 @@ typedef struct rt_messagequeue *rt_mq_t;
 
 /**@{*/
 
+#ifdef RT_USING_HEAP_STATS
+#define RT_HEAP_STATS_HIST_NR           8               /**< free block size classes */
+#define RT_HEAP_STATS_CYCLE_NR          16              /**< log2 buckets of the cycle time */
+
+/*
+ * run-time counters kept by each memory allocator
+ */
+struct rt_heap_counter
+{
+    rt_uint32_t             alloc_count;                /**< successful allocations */
+    rt_uint32_t             free_count;                 /**< successful releases */
+    rt_uint32_t             fail_count;                 /**< failed allocations */
+    rt_uint32_t             alloc_cycle[RT_HEAP_STATS_CYCLE_NR]; /**< allocation cycle-time histogram */
+    rt_uint32_t             free_cycle[RT_HEAP_STATS_CYCLE_NR];  /**< release cycle-time histogram */
+};
+
+/*
+ * fragmentation and latency snapshot of a memory allocator
+ */
+struct rt_heap_stats
+{
+    rt_size_t               total;                      /**< memory size */
+    rt_size_t               used;                       /**< size used */
+    rt_size_t               max_used;                   /**< maximum usage */
+
+    rt_size_t               largest_free;               /**< largest free block */
+    rt_size_t               free_blocks;                /**< number of free blocks */
+    rt_size_t               free_hist[RT_HEAP_STATS_HIST_NR]; /**< free blocks: < 64, < 128, ... , >= 4K bytes */
+
+    rt_uint32_t             alloc_count;                /**< successful allocations */
+    rt_uint32_t             free_count;                 /**< successful releases */
+    rt_uint32_t             fail_count;                 /**< failed allocations */
+
+    rt_uint32_t             alloc_p50;                  /**< allocation cycles, 50th percentile */
+    rt_uint32_t             alloc_p90;                  /**< allocation cycles, 90th percentile */
+    rt_uint32_t             alloc_p99;                  /**< allocation cycles, 99th percentile */
+    rt_uint32_t             alloc_max;                  /**< allocation cycles, worst case */
+    rt_uint32_t             free_p50;                   /**< release cycles, 50th percentile */
+    rt_uint32_t             free_p90;                   /**< release cycles, 90th percentile */
+    rt_uint32_t             free_p99;                   /**< release cycles, 99th percentile */
+    rt_uint32_t             free_max;                   /**< release cycles, worst case */
+};
+#endif /* RT_USING_HEAP_STATS */
+
 #ifdef RT_USING_HEAP
 /*
  * memory structure
@@ -876,6 +1021,9 @@ struct rt_memory
     rt_size_t               total;                  /**< memory size */
     rt_size_t               used;                   /**< size used */
     rt_size_t               max;                    /**< maximum usage */
+#ifdef RT_USING_HEAP_STATS
+    struct rt_heap_counter  counter;                /**< allocation statistics */
+#endif /* RT_USING_HEAP_STATS */
 };
 typedef struct rt_memory *rt_mem_t;
 #endif /* RT_USING_HEAP */
@@ -929,9 +1077,16 @@ struct rt_memheap
 
     struct rt_memheap_item *free_list;                  /**< free block list */
     struct rt_memheap_item  free_header;                /**< free block list header */
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+    rt_uint32_t             free_bitmap;                /**< bitmap of non-empty free bins */
+    struct rt_memheap_item *free_bins[32];              /**< free bin n holds blocks of [2^n, 2^(n+1)) bytes */
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
 
     struct rt_semaphore     lock;                       /**< semaphore lock */
     rt_bool_t               locked;                     /**< External lock mark */
+#ifdef RT_USING_HEAP_STATS
+    struct rt_heap_counter  counter;                    /**< allocation statistics */
+#endif /* RT_USING_HEAP_STATS */
 };
 #endif /* RT_USING_MEMHEAP */
 
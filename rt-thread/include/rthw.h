@@ -12,6 +12,7 @@
  * 2017-10-17     Hichard      add some macros
  * 2018-11-17     Jesven       add rt_hw_spinlock_t
  *                             add smp support
+ * 2026-10-17     agent        add rt_hw_dmb
  */
 
 #ifndef __RT_HW_H__
@@ -43,6 +44,23 @@ extern "C" {
 #define RT_CPU_CACHE_LINE_SZ    32
 #endif
 
+/*
+ * data memory barrier, the memory accesses before it are observed before the
+ * ones after it. An architecture port may define its own one.
+ */
+#ifndef rt_hw_dmb
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(ARCH_ARM_CORTEX_M) || defined(ARCH_ARM_CORTEX_R) || defined(ARCH_ARM_CORTEX_A))
+#define rt_hw_dmb()         __asm volatile ("dmb" ::: "memory")
+#elif defined(__CC_ARM)
+#define rt_hw_dmb()         __dmb(0xF)
+#elif defined(__GNUC__) || defined(__clang__)
+#define rt_hw_dmb()         __sync_synchronize()
+#else
+#define rt_hw_dmb()
+#endif
+#endif /* rt_hw_dmb */
+
 enum RT_HW_CACHE_OPS
 {
     RT_HW_CACHE_FLUSH      = 0x01,
@@ -109,6 +127,17 @@ rt_base_t rt_hw_interrupt_disable(void);
 void rt_hw_interrupt_enable(rt_base_t level);
 #endif /*RT_USING_SMP*/
 
+/*
+ * Atomic interfaces
+ *
+ * The first word of a node in the lock-free single list is the pointer to
+ * the next node. The default implementations disable interrupt.
+ */
+rt_base_t rt_hw_atomic_add(volatile rt_base_t *ptr, rt_base_t value);
+rt_base_t rt_hw_atomic_cas(volatile rt_base_t *ptr, rt_base_t old, rt_base_t value);
+void rt_hw_atomic_slist_push(void **head, void *node);
+void *rt_hw_atomic_slist_pop(void **head);
+
 /*
  * Context interfaces
  */
@@ -137,6 +166,13 @@ void rt_hw_exception_install(rt_err_t (*exception_handle)(void *context));
  */
 void rt_hw_us_delay(rt_uint32_t us);
 
+#ifdef RT_USING_TICKLESS_IDLE
+/*
+ * tickless idle interfaces
+ */
+rt_tick_t rt_hw_tickless_sleep(rt_tick_t ticks);
+#endif /* RT_USING_TICKLESS_IDLE */
+
 #ifdef RT_USING_SMP
 typedef union {
     unsigned long slock;
@@ -61,6 +61,7 @@ void rt_object_delete(rt_object_t object);
 rt_bool_t rt_object_is_systemobject(rt_object_t object);
 rt_uint8_t rt_object_get_type(rt_object_t object);
 rt_object_t rt_object_find(const char *name, rt_uint8_t type);
+void rt_object_rename(rt_object_t object, const char *name);
 
 #ifdef RT_USING_HOOK
 void rt_object_attach_sethook(void (*hook)(struct rt_object *object));
@@ -157,6 +158,9 @@ rt_err_t rt_thread_delay(rt_tick_t tick);
 rt_err_t rt_thread_delay_until(rt_tick_t *tick, rt_tick_t inc_tick);
 rt_err_t rt_thread_mdelay(rt_int32_t ms);
 rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg);
+#ifdef RT_USING_CPU_USAGE
+rt_err_t rt_thread_get_stats(rt_thread_t thread, struct rt_thread_stats *stats);
+#endif /* RT_USING_CPU_USAGE */
 rt_err_t rt_thread_suspend(rt_thread_t thread);
 rt_err_t rt_thread_resume(rt_thread_t thread);
 
@@ -249,6 +253,8 @@ rt_err_t rt_mp_delete(rt_mp_t mp);
 
 void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time);
 void rt_mp_free(void *block);
+rt_size_t rt_mp_alloc_batch(rt_mp_t mp, void **blocks, rt_size_t count, rt_int32_t time);
+void rt_mp_free_batch(void **blocks, rt_size_t count);
 
 #ifdef RT_USING_HOOK
 void rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block));
@@ -274,6 +280,10 @@ void rt_memory_info(rt_size_t *total,
                     rt_size_t *used,
                     rt_size_t *max_used);
 
+#ifdef RT_USING_HEAP_CACHE
+void rt_heap_cache_flush(rt_thread_t thread);
+#endif
+
 #if defined(RT_USING_SLAB) && defined(RT_USING_SLAB_AS_HEAP)
 void *rt_page_alloc(rt_size_t npages);
 void rt_page_free(void *addr, rt_size_t npages);
@@ -284,6 +294,21 @@ void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
 #endif
 
+#ifdef RT_USING_HEAP_STATS
+rt_err_t rt_heap_stats(struct rt_heap_stats *stats);
+#endif
+
+#endif
+
+#ifdef RT_USING_HEAP_STATS
+/*
+ * memory allocator statistics interface
+ */
+rt_uint32_t rt_heap_stats_stamp(void);
+void rt_heap_stats_alloc(struct rt_heap_counter *counter, void *ptr, rt_uint32_t stamp);
+void rt_heap_stats_free(struct rt_heap_counter *counter, rt_uint32_t stamp);
+void rt_heap_stats_block(struct rt_heap_stats *stats, rt_size_t size, rt_size_t count);
+void rt_heap_stats_fill(struct rt_heap_stats *stats, const struct rt_heap_counter *counter);
 #endif
 
 #ifdef RT_USING_SMALL_MEM
@@ -297,6 +322,9 @@ rt_err_t rt_smem_detach(rt_smem_t m);
 void *rt_smem_alloc(rt_smem_t m, rt_size_t size);
 void *rt_smem_realloc(rt_smem_t m, void *rmem, rt_size_t newsize);
 void rt_smem_free(void *rmem);
+#ifdef RT_USING_HEAP_STATS
+rt_err_t rt_smem_stats(rt_smem_t m, struct rt_heap_stats *stats);
+#endif
 #endif
 
 #ifdef RT_USING_MEMHEAP
@@ -315,6 +343,9 @@ void rt_memheap_info(struct rt_memheap *heap,
                      rt_size_t *total,
                      rt_size_t *used,
                      rt_size_t *max_used);
+#ifdef RT_USING_HEAP_STATS
+rt_err_t rt_memheap_stats(struct rt_memheap *heap, struct rt_heap_stats *stats);
+#endif
 #endif
 
 #ifdef RT_USING_SLAB
@@ -328,6 +359,9 @@ void rt_slab_page_free(rt_slab_t m, void *addr, rt_size_t npages);
 void *rt_slab_alloc(rt_slab_t m, rt_size_t size);
 void *rt_slab_realloc(rt_slab_t m, void *ptr, rt_size_t size);
 void rt_slab_free(rt_slab_t m, void *ptr);
+#ifdef RT_USING_HEAP_STATS
+rt_err_t rt_slab_stats(rt_slab_t m, struct rt_heap_stats *stats);
+#endif
 #endif
 
 /**@}*/
@@ -398,6 +432,24 @@ rt_err_t rt_event_recv(rt_event_t   event,
 rt_err_t rt_event_control(rt_event_t event, int cmd, void *arg);
 #endif
 
+#ifdef RT_USING_IPC_WAITANY
+/*
+ * multiple objects wait interface
+ */
+rt_err_t rt_ipc_wait_any(struct rt_ipc_wait_item *items,
+                         rt_uint8_t               count,
+                         rt_int32_t               timeout,
+                         rt_uint8_t              *index);
+#endif
+
+#ifdef RT_USING_LOCKSTAT
+/*
+ * lock contention statistics interface
+ */
+rt_err_t rt_lockstat_get(rt_object_t object, struct rt_lockstat *stat);
+void rt_lockstat_reset(rt_object_t object);
+#endif
+
 #ifdef RT_USING_MAILBOX
 /*
  * mailbox interface
@@ -451,6 +503,10 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     void      *buffer,
                     rt_size_t  size,
                     rt_int32_t timeout);
+rt_err_t rt_mq_reserve(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer);
+rt_err_t rt_mq_peek(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer);
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg);
 #endif
 
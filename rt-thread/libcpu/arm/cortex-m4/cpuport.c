@@ -16,6 +16,9 @@
  * 2018-07-24     aozima       enhancement hard fault exception handler.
  * 2019-07-03     yangjie      add __rt_ffs() for armclang.
  * 2022-06-12     jonas        fixed __rt_ffs() for armclang.
+ * 2026-10-17     agent        add SysTick based tickless sleep.
+ * 2026-10-17     agent        add LDREX/STREX based atomic interfaces.
+ * 2026-10-17     agent        add LDREX/STREX based compare-and-swap.
  */
 
 #include <rtthread.h>
@@ -446,6 +449,224 @@ RT_WEAK void rt_hw_cpu_reset(void)
     SCB_AIRCR = SCB_RESET_VALUE;
 }
 
+#ifdef RT_USING_TICKLESS_IDLE
+#define SYSTICK_CTRL            (*(volatile unsigned *)0xE000E010)  /* SysTick Control and Status Register */
+#define SYSTICK_LOAD            (*(volatile unsigned *)0xE000E014)  /* SysTick Reload Value Register */
+#define SYSTICK_VAL             (*(volatile unsigned *)0xE000E018)  /* SysTick Current Value Register */
+#define SYSTICK_CTRL_ENABLE     (1UL << 0)
+#define SYSTICK_CTRL_COUNTFLAG  (1UL << 16)
+#define SYSTICK_LOAD_MAX        0x00FFFFFFUL
+#define SCB_ICSR                (*(volatile unsigned *)0xE000ED04)  /* Interrupt Control and State Register */
+#define SCB_ICSR_PENDSTSET      (1UL << 26)
+
+#if defined(__CC_ARM)
+#define _tickless_wait()        do { __dsb(0xF); __wfi(); __isb(0xF); } while (0)
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define _tickless_wait()        do { __DSB(); __WFI(); __ISB(); } while (0)
+#else
+#define _tickless_wait()        __asm volatile ("dsb\n wfi\n isb" ::: "memory")
+#endif
+
+/**
+ * This function stretches the SysTick period to sleep for the given ticks, and
+ * restores the periodic tick on wakeup. It shall be invoked with interrupt
+ * disabled; the pending interrupt which wakes up the CPU is served after the
+ * caller enables interrupt again. SysTick keeps running in WFI only, a BSP
+ * which wants a deeper sleep mode uses RT_USING_PM and its lptimer instead.
+ *
+ * @param ticks the ticks to sleep, clamped to the 24-bit SysTick range.
+ *
+ * @return the complete ticks elapsed while sleeping, excluding the tick which
+ * is still going to be signalled by the pending SysTick interrupt.
+ */
+RT_WEAK rt_tick_t rt_hw_tickless_sleep(rt_tick_t ticks)
+{
+    static rt_uint32_t cycles_per_tick = 0;
+    rt_uint32_t reload, ctrl, elapsed, next;
+    rt_tick_t slept;
+
+    /* the periodic reload value is only reliable before the first stretch */
+    if (cycles_per_tick == 0)
+    {
+        cycles_per_tick = SYSTICK_LOAD + 1;
+    }
+
+    if (ticks > SYSTICK_LOAD_MAX / cycles_per_tick)
+    {
+        ticks = SYSTICK_LOAD_MAX / cycles_per_tick;
+    }
+    if (ticks < 2)
+    {
+        return 0;
+    }
+
+    SYSTICK_CTRL &= ~SYSTICK_CTRL_ENABLE;
+    if (SCB_ICSR & SCB_ICSR_PENDSTSET)
+    {
+        /* a tick is already pending, do not sleep */
+        SYSTICK_CTRL |= SYSTICK_CTRL_ENABLE;
+        return 0;
+    }
+
+    /* the rest of the current tick plus the following complete ticks */
+    reload = SYSTICK_VAL + cycles_per_tick * (ticks - 1);
+    SYSTICK_LOAD = reload;
+    SYSTICK_VAL  = 0;
+    SYSTICK_CTRL |= SYSTICK_CTRL_ENABLE;
+
+    _tickless_wait();
+
+    ctrl = SYSTICK_CTRL;
+    SYSTICK_CTRL = ctrl & ~SYSTICK_CTRL_ENABLE;
+
+    if (ctrl & SYSTICK_CTRL_COUNTFLAG)
+    {
+        /* the whole period elapsed, the pending SysTick interrupt brings the last tick */
+        elapsed = reload - SYSTICK_VAL;
+        next = (elapsed < cycles_per_tick - 1) ? (cycles_per_tick - elapsed) : cycles_per_tick;
+        slept = ticks - 1;
+    }
+    else
+    {
+        /* woken up by another interrupt, count the cycles from the last tick boundary */
+        elapsed = ticks * cycles_per_tick - SYSTICK_VAL;
+        slept = elapsed / cycles_per_tick;
+        next = (slept + 1) * cycles_per_tick - elapsed;
+        if (next <= 1)
+        {
+            /* too close to the boundary to program it, signal that tick now */
+            SCB_ICSR = SCB_ICSR_PENDSTSET;
+            next += cycles_per_tick;
+        }
+    }
+
+    /* align the next tick interrupt to the tick boundary, then go periodic again */
+    SYSTICK_LOAD = next - 1;
+    SYSTICK_VAL  = 0;
+    SYSTICK_CTRL |= SYSTICK_CTRL_ENABLE;
+    SYSTICK_LOAD = cycles_per_tick - 1;
+
+    return slept;
+}
+#endif /* RT_USING_TICKLESS_IDLE */
+
+/*
+ * The local exclusive monitor is cleared on exception entry and return, so
+ * the STREX fails if any thread or interrupt runs between LDREX and STREX.
+ * No other store is issued inside an exclusive access.
+ */
+#if defined(__CC_ARM)
+#define _ldrex(ptr)             __ldrex(ptr)
+#define _strex(value, ptr)      __strex(value, ptr)
+#define _clrex()                __clrex()
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define _ldrex(ptr)             __LDREX((unsigned long *)(ptr))
+#define _strex(value, ptr)      __STREX((unsigned long)(value), (unsigned long *)(ptr))
+#define _clrex()                __CLREX()
+#else /* __GNUC__ and __clang__ */
+rt_inline rt_ubase_t _ldrex(volatile void *ptr)
+{
+    rt_ubase_t value;
+
+    __asm volatile ("ldrex %0, [%1]" : "=r"(value) : "r"(ptr) : "memory");
+    return value;
+}
+
+rt_inline rt_ubase_t _strex(rt_ubase_t value, volatile void *ptr)
+{
+    rt_ubase_t result;
+
+    __asm volatile ("strex %0, %2, [%1]" : "=&r"(result) : "r"(ptr), "r"(value) : "memory");
+    return result;
+}
+#define _clrex()                __asm volatile ("clrex" ::: "memory")
+#endif
+
+/**
+ * This function adds a value to a variable atomically.
+ *
+ * @return return the value of the variable before the addition.
+ */
+rt_base_t rt_hw_atomic_add(volatile rt_base_t *ptr, rt_base_t value)
+{
+    rt_base_t old;
+
+    do
+    {
+        old = (rt_base_t)_ldrex(ptr);
+    } while (_strex((rt_ubase_t)(old + value), ptr) != 0);
+
+    return old;
+}
+
+/**
+ * This function replaces the value of a variable atomically if it equals to
+ * the expected one.
+ *
+ * @return return the value of the variable before the operation.
+ */
+rt_base_t rt_hw_atomic_cas(volatile rt_base_t *ptr, rt_base_t old, rt_base_t value)
+{
+    rt_base_t cur;
+
+    do
+    {
+        cur = (rt_base_t)_ldrex(ptr);
+        if (cur != old)
+        {
+            _clrex();
+            break;
+        }
+    } while (_strex((rt_ubase_t)value, ptr) != 0);
+
+    return cur;
+}
+
+/**
+ * This function pushes a node to the head of a single list atomically. The
+ * first word of the node is used as the next pointer.
+ */
+void rt_hw_atomic_slist_push(void **head, void *node)
+{
+    void *first;
+
+    for (;;)
+    {
+        first = *(void * volatile *)head;
+        *(void **)node = first;
+        if ((void *)_ldrex(head) != first)
+            _clrex();
+        else if (_strex((rt_ubase_t)node, head) == 0)
+            break;
+    }
+}
+
+/**
+ * This function pops the first node of a single list atomically. Reading
+ * the next pointer inside the exclusive access makes it free from the ABA
+ * problem.
+ *
+ * @return return the node, or RT_NULL if the list is empty.
+ */
+void *rt_hw_atomic_slist_pop(void **head)
+{
+    void *node;
+
+    do
+    {
+        node = (void *)_ldrex(head);
+        if (node == RT_NULL)
+        {
+            _clrex();
+            break;
+        }
+    } while (_strex((rt_ubase_t)*(void **)node, head) != 0);
+
+    return node;
+}
+
 #ifdef RT_USING_CPU_FFS
 /**
  * This function finds the first bit set (beginning with the least significant bit)
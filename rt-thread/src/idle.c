@@ -16,6 +16,8 @@
  * 2018-11-22     Jesven       add per cpu idle task
  *                             combine the code of primary and secondary cpu
  * 2021-11-15     THEWON       Remove duplicate work between idle and _thread_exit
+ * 2026-10-17     agent        add tickless idle
+ * 2026-10-17     agent        leave due timers to the tick interrupt after tickless sleep
  */
 
 #include <rthw.h>
@@ -218,6 +220,10 @@ static void rt_defunct_execute(void)
         rt_thread_free_sig(thread);
 #endif
 
+#ifdef RT_USING_HEAP_CACHE
+        rt_heap_cache_flush(thread);
+#endif /* RT_USING_HEAP_CACHE */
+
         /* store the point of "thread->cleanup" avoid to lose */
         cleanup = thread->cleanup;
 
@@ -248,6 +254,40 @@ static void rt_defunct_execute(void)
     }
 }
 
+#ifdef RT_USING_TICKLESS_IDLE
+/**
+ * @brief This function will suppress the periodic tick until the next timer
+ *        timeout, then catch up the tick lost while sleeping.
+ */
+static void _idle_tickless_sleep(void)
+{
+    rt_tick_t next_timeout, idle_tick, slept_tick;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+
+    next_timeout = rt_timer_next_timeout_tick();
+    idle_tick = next_timeout - rt_tick_get();
+
+    /* an overdue timer is left to the pending tick interrupt */
+    if ((next_timeout == RT_TICK_MAX || idle_tick < RT_TICK_MAX / 2) &&
+        idle_tick >= RT_TICKLESS_IDLE_THRESHOLD)
+    {
+        slept_tick = rt_hw_tickless_sleep(idle_tick);
+        if (slept_tick)
+        {
+            rt_tick_set(rt_tick_get() + slept_tick);
+        }
+    }
+
+    /*
+     * the sleep ends before the next timeout tick, the timer which becomes due
+     * is fired by rt_tick_increase() in the tick interrupt as usual
+     */
+    rt_hw_interrupt_enable(level);
+}
+#endif /* RT_USING_TICKLESS_IDLE */
+
 static void idle_thread_entry(void *parameter)
 {
 #ifdef RT_USING_SMP
@@ -284,6 +324,10 @@ static void idle_thread_entry(void *parameter)
         void rt_system_power_manager(void);
         rt_system_power_manager();
 #endif /* RT_USING_PM */
+
+#ifdef RT_USING_TICKLESS_IDLE
+        _idle_tickless_sleep();
+#endif /* RT_USING_TICKLESS_IDLE */
     }
 }
 
@@ -44,11 +44,19 @@
  * 2022-04-08     Stanley      Correct descriptions
  * 2022-10-15     Bernard      add nested mutex feature
  * 2022-10-16     Bernard      add prioceiling feature in mutex
+ * 2026-10-17     agent        add zero-copy reserve/commit/peek/release to messagequeue
+ * 2026-10-17     agent        add lock-free fast path to mutex
+ * 2026-10-17     agent        add lock contention statistics
+ * 2026-10-17     agent        add rt_ipc_wait_any()
  */
 
 #include <rtthread.h>
 #include <rthw.h>
 
+#if defined(RT_USING_LOCKSTAT) && defined(RT_USING_CPUTIME)
+#include <drivers/cputime.h>
+#endif /* defined(RT_USING_LOCKSTAT) && defined(RT_USING_CPUTIME) */
+
 #ifndef __on_rt_object_trytake_hook
     #define __on_rt_object_trytake_hook(parent)     __ON_HOOK_ARGS(rt_object_trytake_hook, (parent))
 #endif
@@ -87,6 +95,9 @@ rt_inline rt_err_t _ipc_object_init(struct rt_ipc_object *ipc)
 {
     /* initialize ipc object */
     rt_list_init(&(ipc->suspend_thread));
+#ifdef RT_USING_IPC_WAITANY
+    rt_list_init(&(ipc->waitany_list));
+#endif /* RT_USING_IPC_WAITANY */
 
     return RT_EOK;
 }
@@ -249,7 +260,330 @@ rt_inline rt_err_t _ipc_list_resume_all(rt_list_t *list)
     return RT_EOK;
 }
 
+#ifdef RT_USING_IPC_WAITANY
+/*
+ * rt_ipc_wait_any() does not use _ipc_list_suspend() and _ipc_list_resume().
+ * They link thread->tlist into the suspend list of one object, and a thread
+ * has only one tlist, while it waits on several objects at once here. So the
+ * thread pends one rt_ipc_wait_item per object on the separate waitany_list.
+ * The lists also mean different things: a thread in suspend_thread is resumed
+ * to take the resource handed to it, an item in waitany_list is only told the
+ * object is ready, so release/send first serve suspend_thread and then notify
+ * waitany_list, and the take and receive paths stay as they are.
+ */
+
+/*
+ * get the ipc object of a rt_ipc_wait_any() item, RT_NULL if the object
+ * can't be waited by rt_ipc_wait_any().
+ */
+static struct rt_ipc_object *_ipc_waitany_object(struct rt_ipc_wait_item *item)
+{
+    switch (rt_object_get_type(item->object))
+    {
+#ifdef RT_USING_SEMAPHORE
+    case RT_Object_Class_Semaphore:
+#endif /* RT_USING_SEMAPHORE */
+#ifdef RT_USING_MAILBOX
+    case RT_Object_Class_MailBox:
+#endif /* RT_USING_MAILBOX */
+#ifdef RT_USING_MESSAGEQUEUE
+    case RT_Object_Class_MessageQueue:
+#endif /* RT_USING_MESSAGEQUEUE */
+#ifdef RT_USING_EVENT
+    case RT_Object_Class_Event:
+#endif /* RT_USING_EVENT */
+        return (struct rt_ipc_object *)item->object;
+
+    default:
+        return RT_NULL;
+    }
+}
+
+/*
+ * check whether the object of an item could be taken or received without
+ * waiting, it must be called with interrupt disabled.
+ */
+static rt_bool_t _ipc_waitany_ready(struct rt_ipc_wait_item *item)
+{
+    switch (rt_object_get_type(item->object))
+    {
+#ifdef RT_USING_SEMAPHORE
+    case RT_Object_Class_Semaphore:
+        return ((struct rt_semaphore *)item->object)->value > 0;
+#endif /* RT_USING_SEMAPHORE */
+#ifdef RT_USING_MAILBOX
+    case RT_Object_Class_MailBox:
+        return ((struct rt_mailbox *)item->object)->entry > 0;
+#endif /* RT_USING_MAILBOX */
+#ifdef RT_USING_MESSAGEQUEUE
+    case RT_Object_Class_MessageQueue:
+        return ((struct rt_messagequeue *)item->object)->entry > 0;
+#endif /* RT_USING_MESSAGEQUEUE */
+#ifdef RT_USING_EVENT
+    case RT_Object_Class_Event:
+        {
+            rt_uint32_t set = ((struct rt_event *)item->object)->set;
+
+            if (item->option & RT_EVENT_FLAG_AND)
+                return (set & item->set) == item->set;
+            return (set & item->set) != 0;
+        }
+#endif /* RT_USING_EVENT */
+    default:
+        return RT_FALSE;
+    }
+}
+
+/**
+ * @brief    This function will wake up the threads waiting on an IPC object by rt_ipc_wait_any().
+ *
+ * @note     The items of the threads already woken up by another object or timeout are skipped,
+ *           they are removed by their threads.
+ *
+ * @param    ipc is a pointer to the IPC object.
+ *
+ * @param    all is RT_TRUE to wake up all the threads whose condition is met, otherwise only the first one.
+ *
+ * @return   Return RT_TRUE if a thread has been resumed.
+ *
+ * @warning  This function MUST be called with interrupt disabled, after the object became ready and no
+ *           thread in the suspend list of the object has been resumed to take it.
+ */
+static rt_bool_t _ipc_waitany_notify(struct rt_ipc_object *ipc, rt_bool_t all)
+{
+    struct rt_list_node *n, *next;
+    struct rt_ipc_wait_item *item;
+    rt_bool_t resumed = RT_FALSE;
+
+    for (n = ipc->waitany_list.next; n != &(ipc->waitany_list); n = next)
+    {
+        next = n->next;
+        item = rt_list_entry(n, struct rt_ipc_wait_item, list);
+
+        if ((item->thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_SUSPEND)
+            continue;
+
+        if (_ipc_waitany_ready(item) == RT_FALSE)
+            continue;
+
+        rt_list_remove(&(item->list));
+        item->signaled = 1;
+        item->thread->error = RT_EOK;
+        rt_thread_resume(item->thread);
+        resumed = RT_TRUE;
+
+        if (all == RT_FALSE)
+            break;
+    }
+
+    return resumed;
+}
+
+/*
+ * remove all rt_ipc_wait_any() items of an IPC object being detached or
+ * reset, the waiting threads are resumed with -RT_ERROR.
+ */
+static void _ipc_waitany_resume_all(struct rt_ipc_object *ipc)
+{
+    rt_base_t level;
+    struct rt_ipc_wait_item *item;
+
+    level = rt_hw_interrupt_disable();
+
+    while (!rt_list_isempty(&(ipc->waitany_list)))
+    {
+        item = rt_list_entry(ipc->waitany_list.next, struct rt_ipc_wait_item, list);
+        rt_list_remove(&(item->list));
+
+        if ((item->thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+        {
+            item->thread->error = -RT_ERROR;
+            rt_thread_resume(item->thread);
+        }
+    }
+
+    rt_hw_interrupt_enable(level);
+}
+#else
+#define _ipc_waitany_notify(ipc, all)   RT_FALSE
+#define _ipc_waitany_resume_all(ipc)
+#endif /* RT_USING_IPC_WAITANY */
+
+/**@}*/
+
+#ifdef RT_USING_LOCKSTAT
+/*
+ * the stamps are 32 bits, a wait or hold time is taken as the 32 bits
+ * difference of two of them, which stays right across the wrap of the
+ * counter as long as it is shorter than one wrap period.
+ */
+rt_inline rt_uint32_t _lockstat_get(void)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif /* RT_USING_CPUTIME */
+}
+
+rt_inline void _lockstat_init(struct rt_lockstat *stat)
+{
+    rt_memset(stat, 0, sizeof(struct rt_lockstat));
+}
+
+/*
+ * account a wait which started at start, it must be called with interrupt
+ * disabled. The thread is added to the top waiters if it waited longer in
+ * total than the least one recorded.
+ */
+static void _lockstat_waited(struct rt_lockstat *stat, struct rt_thread *thread,
+                             rt_uint32_t start, rt_bool_t acquired)
+{
+    int index, least;
+    rt_uint32_t wait;
+    struct rt_lockstat_waiter *waiter;
+
+    wait = _lockstat_get() - start;
+    if (acquired)
+    {
+        stat->acquire ++;
+        stat->contended ++;
+    }
+    else
+    {
+        stat->failed ++;
+    }
+    stat->wait_total += wait;
+    if (wait > stat->wait_max)
+        stat->wait_max = wait;
+
+    least = 0;
+    for (index = 0; index < RT_LOCKSTAT_TOP_NUM; index ++)
+    {
+        waiter = &stat->top[index];
+        if (waiter->thread == thread &&
+            rt_strncmp(waiter->name, thread->name, RT_NAME_MAX) == 0)
+        {
+            waiter->count ++;
+            waiter->wait_time += wait;
+            return;
+        }
+
+        if (waiter->wait_time < stat->top[least].wait_time)
+            least = index;
+    }
+
+    waiter = &stat->top[least];
+    if (waiter->thread == RT_NULL || wait > waiter->wait_time)
+    {
+        rt_strncpy(waiter->name, thread->name, RT_NAME_MAX);
+        waiter->thread    = thread;
+        waiter->count     = 1;
+        waiter->wait_time = wait;
+    }
+}
+
+/* account the hold time of a mutex released by its owner */
+rt_inline void _lockstat_held(struct rt_lockstat *stat)
+{
+    rt_uint32_t hold;
+
+    hold = _lockstat_get() - stat->hold_start;
+    if (hold > stat->hold_max)
+        stat->hold_max = hold;
+}
+
+static struct rt_lockstat *_lockstat_of(rt_object_t object)
+{
+    switch (rt_object_get_type(object))
+    {
+#ifdef RT_USING_SEMAPHORE
+    case RT_Object_Class_Semaphore:
+        return &((struct rt_semaphore *)object)->lockstat;
+#endif /* RT_USING_SEMAPHORE */
+#ifdef RT_USING_MUTEX
+    case RT_Object_Class_Mutex:
+        return &((struct rt_mutex *)object)->lockstat;
+#endif /* RT_USING_MUTEX */
+#ifdef RT_USING_EVENT
+    case RT_Object_Class_Event:
+        return &((struct rt_event *)object)->lockstat;
+#endif /* RT_USING_EVENT */
+    default:
+        return RT_NULL;
+    }
+}
+
+/**
+ * @addtogroup IPC
+ */
+
+/**@{*/
+
+/**
+ * @brief    This function will get a snapshot of the contention statistics of a lock.
+ *
+ * @note     The time in statistics is in cputime counts when RT_USING_CPUTIME is enabled,
+ *           otherwise in ticks.
+ *
+ * @param    object is a pointer to a semaphore, mutex or event object.
+ *
+ * @param    stat is a pointer to the buffer to store the statistics.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is -RT_EINVAL, the object is not a semaphore, mutex or event.
+ */
+rt_err_t rt_lockstat_get(rt_object_t object, struct rt_lockstat *stat)
+{
+    rt_base_t level;
+    struct rt_lockstat *lockstat;
+
+    RT_ASSERT(object != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    lockstat = _lockstat_of(object);
+    if (lockstat == RT_NULL)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(stat, lockstat, sizeof(struct rt_lockstat));
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_lockstat_get);
+
+/**
+ * @brief    This function will clear the contention statistics of a lock.
+ *
+ * @param    object is a pointer to a semaphore, mutex or event object.
+ */
+void rt_lockstat_reset(rt_object_t object)
+{
+    rt_base_t level;
+    struct rt_lockstat *lockstat;
+
+    RT_ASSERT(object != RT_NULL);
+
+    lockstat = _lockstat_of(object);
+    if (lockstat == RT_NULL)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    /* keep the hold start of a mutex taken now */
+    lockstat->acquire    = 0;
+    lockstat->contended  = 0;
+    lockstat->failed     = 0;
+    lockstat->wait_total = 0;
+    lockstat->wait_max   = 0;
+    lockstat->hold_max   = 0;
+    rt_memset(lockstat->top, 0, sizeof(lockstat->top));
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_lockstat_reset);
+
 /**@}*/
+#endif /* RT_USING_LOCKSTAT */
 
 #ifdef RT_USING_SEMAPHORE
 /**
@@ -316,6 +650,10 @@ rt_err_t rt_sem_init(rt_sem_t    sem,
     /* set parent */
     sem->parent.parent.flag = flag;
 
+#ifdef RT_USING_LOCKSTAT
+    _lockstat_init(&sem->lockstat);
+#endif /* RT_USING_LOCKSTAT */
+
     return RT_EOK;
 }
 RTM_EXPORT(rt_sem_init);
@@ -348,6 +686,7 @@ rt_err_t rt_sem_detach(rt_sem_t sem)
 
     /* wakeup all suspended threads */
     _ipc_list_resume_all(&(sem->parent.suspend_thread));
+    _ipc_waitany_resume_all(&(sem->parent));
 
     /* detach semaphore object */
     rt_object_detach(&(sem->parent.parent));
@@ -412,6 +751,10 @@ rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
     /* set parent */
     sem->parent.parent.flag = flag;
 
+#ifdef RT_USING_LOCKSTAT
+    _lockstat_init(&sem->lockstat);
+#endif /* RT_USING_LOCKSTAT */
+
     return sem;
 }
 RTM_EXPORT(rt_sem_create);
@@ -446,6 +789,7 @@ rt_err_t rt_sem_delete(rt_sem_t sem)
 
     /* wakeup all suspended threads */
     _ipc_list_resume_all(&(sem->parent.suspend_thread));
+    _ipc_waitany_resume_all(&(sem->parent));
 
     /* delete semaphore object */
     rt_object_delete(&(sem->parent.parent));
@@ -487,6 +831,9 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout)
 {
     rt_base_t level;
     struct rt_thread *thread;
+#ifdef RT_USING_LOCKSTAT
+    rt_uint32_t wait_start;
+#endif /* RT_USING_LOCKSTAT */
 
     /* parameter check */
     RT_ASSERT(sem != RT_NULL);
@@ -506,6 +853,9 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout)
     {
         /* semaphore is available */
         sem->value --;
+#ifdef RT_USING_LOCKSTAT
+        sem->lockstat.acquire ++;
+#endif /* RT_USING_LOCKSTAT */
 
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
@@ -538,6 +888,9 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout)
             _ipc_list_suspend(&(sem->parent.suspend_thread),
                                 thread,
                                 sem->parent.parent.flag);
+#ifdef RT_USING_LOCKSTAT
+            wait_start = _lockstat_get();
+#endif /* RT_USING_LOCKSTAT */
 
             /* has waiting time, start thread timer */
             if (timeout > 0)
@@ -558,6 +911,12 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout)
             /* do schedule */
             rt_schedule();
 
+#ifdef RT_USING_LOCKSTAT
+            level = rt_hw_interrupt_disable();
+            _lockstat_waited(&sem->lockstat, thread, wait_start, thread->error == RT_EOK);
+            rt_hw_interrupt_enable(level);
+#endif /* RT_USING_LOCKSTAT */
+
             if (thread->error != RT_EOK)
             {
                 return thread->error;
@@ -637,6 +996,10 @@ rt_err_t rt_sem_release(rt_sem_t sem)
         if(sem->value < RT_SEM_VALUE_MAX)
         {
             sem->value ++; /* increase value */
+
+            /* wake up a thread waiting on it by rt_ipc_wait_any() */
+            if (_ipc_waitany_notify(&(sem->parent), RT_FALSE))
+                need_schedule = RT_TRUE;
         }
         else
         {
@@ -690,6 +1053,7 @@ rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
 
         /* resume all waiting thread */
         _ipc_list_resume_all(&sem->parent.suspend_thread);
+        _ipc_waitany_resume_all(&(sem->parent));
 
         /* set new value */
         sem->value = (rt_uint16_t)value;
@@ -787,6 +1151,146 @@ rt_inline void _thread_update_priority(struct rt_thread *thread, rt_uint8_t prio
     }
 }
 
+#ifdef RT_USING_MUTEX_ADAPTIVE
+/*
+ * The lock word of mutex is the owner thread, or 0 when the mutex is free.
+ * A mutex in fast mode is taken and released by CAS on the lock word only,
+ * the owner and hold are written by the owner itself and it is not linked in
+ * the taken list. Once a thread has to wait for it, the mutex is switched to
+ * slow mode by setting the low bit of the lock word, and all operations go
+ * through the priority inheritance path with interrupt disabled until the
+ * mutex is free again.
+ */
+#define _MUTEX_LOCK_SLOW        ((rt_ubase_t)0x01)
+
+#ifndef RT_MUTEX_SPIN_COUNT
+#define RT_MUTEX_SPIN_COUNT     1000
+#endif
+
+rt_inline rt_bool_t _mutex_fast_take(struct rt_mutex *mutex, struct rt_thread *thread)
+{
+    rt_ubase_t lock;
+
+    /* the priority ceiling is applied by the slow path */
+    if (mutex->ceiling_priority != 0xFF)
+        return RT_FALSE;
+
+    lock = mutex->lock;
+    if (lock == (rt_ubase_t)thread)
+    {
+        /* it's the same thread, only owner changes hold in fast mode */
+        if (mutex->hold >= RT_MUTEX_HOLD_MAX)
+            return RT_FALSE;
+
+        mutex->hold ++;
+#ifdef RT_USING_LOCKSTAT
+        mutex->lockstat.acquire ++;
+#endif /* RT_USING_LOCKSTAT */
+        return RT_TRUE;
+    }
+
+#ifdef RT_USING_SMP
+    {
+        int spin;
+
+        /*
+         * a short hold in fast mode is likely to end soon on another cpu. Only
+         * the lock word is polled: the owner may exit and be freed meanwhile,
+         * so it is never dereferenced here. A waiter already queued means a
+         * long hold, leave it to the slow path.
+         */
+        for (spin = 0; lock != 0 && spin < RT_MUTEX_SPIN_COUNT; spin++)
+        {
+            if (lock & _MUTEX_LOCK_SLOW)
+                break;
+
+            lock = mutex->lock;
+        }
+    }
+#endif /* RT_USING_SMP */
+
+    if (lock == 0 && rt_hw_atomic_cas((volatile rt_base_t *)&mutex->lock, 0, (rt_base_t)thread) == 0)
+    {
+        mutex->owner = thread;
+        mutex->hold  = 1;
+#ifdef RT_USING_LOCKSTAT
+        /* the statistics except waits are only written by the owner */
+        mutex->lockstat.acquire ++;
+        mutex->lockstat.hold_start = _lockstat_get();
+#endif /* RT_USING_LOCKSTAT */
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+rt_inline rt_bool_t _mutex_fast_release(struct rt_mutex *mutex, struct rt_thread *thread)
+{
+    if (mutex->lock != (rt_ubase_t)thread)
+        return RT_FALSE;
+
+    if (mutex->hold > 1)
+    {
+        mutex->hold --;
+        return RT_TRUE;
+    }
+
+#ifdef RT_USING_LOCKSTAT
+    _lockstat_held(&mutex->lockstat);
+#endif /* RT_USING_LOCKSTAT */
+
+    /* clear owner before the mutex could be taken by others */
+    mutex->owner = RT_NULL;
+    mutex->hold  = 0;
+    if (rt_hw_atomic_cas((volatile rt_base_t *)&mutex->lock, (rt_base_t)thread, 0) == (rt_base_t)thread)
+        return RT_TRUE;
+
+    /* a thread is waiting for it meanwhile, release it by the slow path */
+    mutex->owner = thread;
+    mutex->hold  = 1;
+    return RT_FALSE;
+}
+
+/*
+ * Switch mutex to slow mode, interrupt must be disabled. If the mutex is free
+ * the current thread takes the lock word and the slow path sets the owner,
+ * otherwise the owner which took it by the fast path is adopted.
+ */
+static void _mutex_slow_enter(struct rt_mutex *mutex, struct rt_thread *thread)
+{
+    rt_ubase_t lock;
+    struct rt_thread *owner;
+
+    while (1)
+    {
+        lock = mutex->lock;
+        if (lock & _MUTEX_LOCK_SLOW)
+            return;
+
+        if (lock == 0)
+        {
+            if (rt_hw_atomic_cas((volatile rt_base_t *)&mutex->lock, 0,
+                                 (rt_base_t)((rt_ubase_t)thread | _MUTEX_LOCK_SLOW)) == 0)
+                return;
+        }
+        else if (rt_hw_atomic_cas((volatile rt_base_t *)&mutex->lock, (rt_base_t)lock,
+                                  (rt_base_t)(lock | _MUTEX_LOCK_SLOW)) == (rt_base_t)lock)
+        {
+            break;
+        }
+    }
+
+    owner = (struct rt_thread *)lock;
+    mutex->owner = owner;
+    /* the owner is in the middle of fast take or release */
+    if (mutex->hold == 0)
+        mutex->hold = 1;
+
+    if (mutex->ceiling_priority == 0xFF && rt_list_isempty(&mutex->taken_list))
+        rt_list_insert_after(&owner->taken_object_list, &mutex->taken_list);
+}
+#endif /* RT_USING_MUTEX_ADAPTIVE */
+
 /**
  * @addtogroup mutex
  */
@@ -836,6 +1340,12 @@ rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
     mutex->hold     = 0;
     mutex->ceiling_priority = 0xFF;
     rt_list_init(&(mutex->taken_list));
+#ifdef RT_USING_MUTEX_ADAPTIVE
+    mutex->lock     = 0;
+#endif /* RT_USING_MUTEX_ADAPTIVE */
+#ifdef RT_USING_LOCKSTAT
+    _lockstat_init(&mutex->lockstat);
+#endif /* RT_USING_LOCKSTAT */
 
     /* flag can only be RT_IPC_FLAG_PRIO. RT_IPC_FLAG_FIFO cannot solve the unbounded priority inversion problem */
     mutex->parent.parent.flag = RT_IPC_FLAG_PRIO;
@@ -1025,6 +1535,12 @@ rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
     mutex->hold     = 0;
     mutex->ceiling_priority = 0xFF;
     rt_list_init(&(mutex->taken_list));
+#ifdef RT_USING_MUTEX_ADAPTIVE
+    mutex->lock     = 0;
+#endif /* RT_USING_MUTEX_ADAPTIVE */
+#ifdef RT_USING_LOCKSTAT
+    _lockstat_init(&mutex->lockstat);
+#endif /* RT_USING_LOCKSTAT */
 
     /* flag can only be RT_IPC_FLAG_PRIO. RT_IPC_FLAG_FIFO cannot solve the unbounded priority inversion problem */
     mutex->parent.parent.flag = RT_IPC_FLAG_PRIO;
@@ -1106,6 +1622,9 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
 {
     rt_base_t level;
     struct rt_thread *thread;
+#ifdef RT_USING_LOCKSTAT
+    rt_uint32_t wait_start;
+#endif /* RT_USING_LOCKSTAT */
 
     /* this function must not be used in interrupt even if time = 0 */
     /* current context checking */
@@ -1118,10 +1637,26 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
     /* get current thread */
     thread = rt_thread_self();
 
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+
+#ifdef RT_USING_MUTEX_ADAPTIVE
+    /* uncontended, no need to disable interrupt */
+    if (_mutex_fast_take(mutex, thread) == RT_TRUE)
+    {
+        thread->error = RT_EOK;
+
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif /* RT_USING_MUTEX_ADAPTIVE */
+
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+#ifdef RT_USING_MUTEX_ADAPTIVE
+    _mutex_slow_enter(mutex, thread);
+#endif /* RT_USING_MUTEX_ADAPTIVE */
 
     RT_DEBUG_LOG(RT_DEBUG_IPC,
                  ("mutex_take: current thread %s, hold: %d\n",
@@ -1136,6 +1671,9 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
         {
             /* it's the same thread */
             mutex->hold ++;
+#ifdef RT_USING_LOCKSTAT
+            mutex->lockstat.acquire ++;
+#endif /* RT_USING_LOCKSTAT */
         }
         else
         {
@@ -1152,6 +1690,10 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
             mutex->owner    = thread;
             mutex->priority = 0xff;
             mutex->hold     = 1;
+#ifdef RT_USING_LOCKSTAT
+            mutex->lockstat.acquire ++;
+            mutex->lockstat.hold_start = _lockstat_get();
+#endif /* RT_USING_LOCKSTAT */
 
             if (mutex->ceiling_priority != 0xFF)
             {
@@ -1192,6 +1734,9 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
                                     mutex->parent.parent.flag);
                 /* set pending object in thread to this mutex */
                 thread->pending_object = &(mutex->parent.parent);
+#ifdef RT_USING_LOCKSTAT
+                wait_start = _lockstat_get();
+#endif /* RT_USING_LOCKSTAT */
 
                 /* update the priority level of mutex */
                 if (priority < mutex->priority)
@@ -1226,6 +1771,10 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
                 /* disable interrupt */
                 level = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_LOCKSTAT
+                _lockstat_waited(&mutex->lockstat, thread, wait_start, thread->error == RT_EOK);
+#endif /* RT_USING_LOCKSTAT */
+
                 if (thread->error == RT_EOK)
                 {
                     /* get mutex successfully */
@@ -1341,6 +1890,14 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* get current thread */
     thread = rt_thread_self();
 
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
+
+#ifdef RT_USING_MUTEX_ADAPTIVE
+    /* nobody waits for it, no need to disable interrupt */
+    if (_mutex_fast_release(mutex, thread) == RT_TRUE)
+        return RT_EOK;
+#endif /* RT_USING_MUTEX_ADAPTIVE */
+
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
@@ -1348,8 +1905,6 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
                  ("mutex_release:current thread %s, hold: %d\n",
                   thread->name, mutex->hold));
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
-
     /* mutex only can be released by owner */
     if (thread != mutex->owner)
     {
@@ -1366,6 +1921,10 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* if no hold */
     if (mutex->hold == 0)
     {
+#ifdef RT_USING_LOCKSTAT
+        _lockstat_held(&mutex->lockstat);
+#endif /* RT_USING_LOCKSTAT */
+
         /* remove mutex from thread's taken list */
         rt_list_remove(&mutex->taken_list);
 
@@ -1402,6 +1961,14 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
             mutex->owner = next_thread;
             mutex->hold  = 1;
             rt_list_insert_after(&next_thread->taken_object_list, &mutex->taken_list);
+#ifdef RT_USING_LOCKSTAT
+            /* the next thread holds it from now on */
+            mutex->lockstat.hold_start = _lockstat_get();
+#endif /* RT_USING_LOCKSTAT */
+#ifdef RT_USING_MUTEX_ADAPTIVE
+            /* hand over in slow mode, the new owner is linked in taken list */
+            mutex->lock  = (rt_ubase_t)next_thread | _MUTEX_LOCK_SLOW;
+#endif /* RT_USING_MUTEX_ADAPTIVE */
             /* cleanup pending object */
             next_thread->pending_object = RT_NULL;
 
@@ -1430,6 +1997,10 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
             /* clear owner */
             mutex->owner    = RT_NULL;
             mutex->priority = 0xff;
+#ifdef RT_USING_MUTEX_ADAPTIVE
+            /* free, back to fast mode */
+            mutex->lock     = 0;
+#endif /* RT_USING_MUTEX_ADAPTIVE */
         }
     }
 
@@ -1531,6 +2102,10 @@ rt_err_t rt_event_init(rt_event_t event, const char *name, rt_uint8_t flag)
     /* initialize event */
     event->set = 0;
 
+#ifdef RT_USING_LOCKSTAT
+    _lockstat_init(&event->lockstat);
+#endif /* RT_USING_LOCKSTAT */
+
     return RT_EOK;
 }
 RTM_EXPORT(rt_event_init);
@@ -1563,6 +2138,7 @@ rt_err_t rt_event_detach(rt_event_t event)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(event->parent.suspend_thread));
+    _ipc_waitany_resume_all(&(event->parent));
 
     /* detach event object */
     rt_object_detach(&(event->parent.parent));
@@ -1622,6 +2198,10 @@ rt_event_t rt_event_create(const char *name, rt_uint8_t flag)
     /* initialize event */
     event->set = 0;
 
+#ifdef RT_USING_LOCKSTAT
+    _lockstat_init(&event->lockstat);
+#endif /* RT_USING_LOCKSTAT */
+
     return event;
 }
 RTM_EXPORT(rt_event_create);
@@ -1656,6 +2236,7 @@ rt_err_t rt_event_delete(rt_event_t event)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(event->parent.suspend_thread));
+    _ipc_waitany_resume_all(&(event->parent));
 
     /* delete event object */
     rt_object_delete(&(event->parent.parent));
@@ -1764,6 +2345,10 @@ rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
         }
     }
 
+    /* wake up the threads waiting on it by rt_ipc_wait_any() */
+    if (_ipc_waitany_notify(&(event->parent), RT_TRUE))
+        need_schedule = RT_TRUE;
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -1817,6 +2402,9 @@ rt_err_t rt_event_recv(rt_event_t   event,
     struct rt_thread *thread;
     rt_base_t level;
     rt_base_t status;
+#ifdef RT_USING_LOCKSTAT
+    rt_uint32_t wait_start;
+#endif /* RT_USING_LOCKSTAT */
 
     /* parameter check */
     RT_ASSERT(event != RT_NULL);
@@ -1870,6 +2458,9 @@ rt_err_t rt_event_recv(rt_event_t   event,
         /* received event */
         if (option & RT_EVENT_FLAG_CLEAR)
             event->set &= ~set;
+#ifdef RT_USING_LOCKSTAT
+        event->lockstat.acquire ++;
+#endif /* RT_USING_LOCKSTAT */
     }
     else if (timeout == 0)
     {
@@ -1891,6 +2482,9 @@ rt_err_t rt_event_recv(rt_event_t   event,
         _ipc_list_suspend(&(event->parent.suspend_thread),
                             thread,
                             event->parent.parent.flag);
+#ifdef RT_USING_LOCKSTAT
+        wait_start = _lockstat_get();
+#endif /* RT_USING_LOCKSTAT */
 
         /* if there is a waiting timeout, active thread timer */
         if (timeout > 0)
@@ -1908,6 +2502,12 @@ rt_err_t rt_event_recv(rt_event_t   event,
         /* do a schedule */
         rt_schedule();
 
+#ifdef RT_USING_LOCKSTAT
+        level = rt_hw_interrupt_disable();
+        _lockstat_waited(&event->lockstat, thread, wait_start, thread->error == RT_EOK);
+        rt_hw_interrupt_enable(level);
+#endif /* RT_USING_LOCKSTAT */
+
         if (thread->error != RT_EOK)
         {
             /* return error */
@@ -1961,6 +2561,7 @@ rt_err_t rt_event_control(rt_event_t event, int cmd, void *arg)
 
         /* resume all waiting thread */
         _ipc_list_resume_all(&event->parent.suspend_thread);
+        _ipc_waitany_resume_all(&(event->parent));
 
         /* initialize event set */
         event->set = 0;
@@ -2083,6 +2684,7 @@ rt_err_t rt_mb_detach(rt_mailbox_t mb)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(mb->parent.suspend_thread));
+    _ipc_waitany_resume_all(&(mb->parent));
     /* also resume all mailbox private suspended thread */
     _ipc_list_resume_all(&(mb->suspend_sender_thread));
 
@@ -2195,6 +2797,7 @@ rt_err_t rt_mb_delete(rt_mailbox_t mb)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(mb->parent.suspend_thread));
+    _ipc_waitany_resume_all(&(mb->parent));
 
     /* also resume all mailbox private suspended thread */
     _ipc_list_resume_all(&(mb->suspend_sender_thread));
@@ -2359,6 +2962,17 @@ rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
         return RT_EOK;
     }
 
+    /* wake up a thread waiting on it by rt_ipc_wait_any() */
+    if (_ipc_waitany_notify(&(mb->parent), RT_FALSE))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -2455,11 +3069,22 @@ rt_err_t rt_mb_urgent(rt_mailbox_t mb, rt_ubase_t value)
         return RT_EOK;
     }
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    /* wake up a thread waiting on it by rt_ipc_wait_any() */
+    if (_ipc_waitany_notify(&(mb->parent), RT_FALSE))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
 
-    return RT_EOK;
-}
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
 RTM_EXPORT(rt_mb_urgent);
 
 
@@ -2651,6 +3276,7 @@ rt_err_t rt_mb_control(rt_mailbox_t mb, int cmd, void *arg)
 
         /* resume all waiting thread */
         _ipc_list_resume_all(&(mb->parent.suspend_thread));
+        _ipc_waitany_resume_all(&(mb->parent));
         /* also resume all mailbox private suspended thread */
         _ipc_list_resume_all(&(mb->suspend_sender_thread));
 
@@ -2811,6 +3437,7 @@ rt_err_t rt_mq_detach(rt_mq_t mq)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&mq->parent.suspend_thread);
+    _ipc_waitany_resume_all(&(mq->parent));
     /* also resume all message queue private suspended thread */
     _ipc_list_resume_all(&(mq->suspend_sender_thread));
 
@@ -2948,6 +3575,7 @@ rt_err_t rt_mq_delete(rt_mq_t mq)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(mq->parent.suspend_thread));
+    _ipc_waitany_resume_all(&(mq->parent));
     /* also resume all message queue private suspended thread */
     _ipc_list_resume_all(&(mq->suspend_sender_thread));
 
@@ -2962,66 +3590,31 @@ rt_err_t rt_mq_delete(rt_mq_t mq)
 RTM_EXPORT(rt_mq_delete);
 #endif /* RT_USING_HEAP */
 
-
 /**
- * @brief    This function will send a message to the messagequeue object. If
- *           there is a thread suspended on the messagequeue, the thread will be
- *           resumed.
- *
- * @note     When using this function to send a message, if the messagequeue is
- *           fully used, the current thread will wait for a timeout. If reaching
- *           the timeout and there is still no space available, the sending
- *           thread will be resumed and an error code will be returned. By
- *           contrast, the rt_mq_send() function will return an error code
- *           immediately without waiting when the messagequeue if fully used.
- *
- * @see      rt_mq_send()
- *
- * @param    mq is a pointer to the messagequeue object to be sent.
+ * @brief    Take a free message slot of the messagequeue, the calling thread
+ *           waits for a timeout when the messagequeue is fully used.
  *
- * @param    buffer is the content of the message.
+ * @param    mq is a pointer to the messagequeue object.
  *
- * @param    size is the length of the message(Unit: Byte).
+ * @param    slot is a pointer to the taken message slot.
  *
  * @param    timeout is a timeout period (unit: an OS tick).
  *
- * @return   Return the operation status. When the return value is RT_EOK, the
- *           operation is successful. If the return value is any other values,
- *           it means that the messagequeue detach failed.
- *
- * @warning  This function can be called in interrupt context and thread
- * context.
+ * @return   Return the operation status. When the return value is RT_EOK, the slot is taken.
+ *           If the return value is any other values, it means that the waiting failed.
  */
-rt_err_t rt_mq_send_wait(rt_mq_t     mq,
-                         const void *buffer,
-                         rt_size_t   size,
-                         rt_int32_t  timeout)
+static rt_err_t _mq_slot_alloc(rt_mq_t mq, struct rt_mq_message **slot, rt_int32_t timeout)
 {
     rt_base_t level;
     struct rt_mq_message *msg;
     rt_uint32_t tick_delta;
     struct rt_thread *thread;
 
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* current context checking */
-    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
-
-    /* greater than one message size */
-    if (size > mq->msg_size)
-        return -RT_ERROR;
-
     /* initialize delta tick */
     tick_delta = 0;
     /* get current thread */
     thread = rt_thread_self();
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
-
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
@@ -3106,8 +3699,24 @@ rt_err_t rt_mq_send_wait(rt_mq_t     mq,
 
     /* the msg is the new tailer of list, the next shall be NULL */
     msg->next = RT_NULL;
-    /* copy buffer */
-    rt_memcpy(msg + 1, buffer, size);
+    *slot = msg;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    Link a filled message slot to the tail of the messagequeue, and
+ *           resume the first thread waiting for a message.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is a pointer to the filled message slot.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+static rt_err_t _mq_slot_enqueue(rt_mq_t mq, struct rt_mq_message *msg)
+{
+    rt_base_t level;
 
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
@@ -3148,127 +3757,9 @@ rt_err_t rt_mq_send_wait(rt_mq_t     mq,
         return RT_EOK;
     }
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
-
-    return RT_EOK;
-}
-RTM_EXPORT(rt_mq_send_wait)
-
-
-/**
- * @brief    This function will send a message to the messagequeue object.
- *           If there is a thread suspended on the messagequeue, the thread will be resumed.
- *
- * @note     When using this function to send a message, if the messagequeue is fully used,
- *           the current thread will wait for a timeout.
- *           By contrast, when the messagequeue is fully used, the rt_mq_send_wait() function will
- *           return an error code immediately without waiting.
- *
- * @see      rt_mq_send_wait()
- *
- * @param    mq is a pointer to the messagequeue object to be sent.
- *
- * @param    buffer is the content of the message.
- *
- * @param    size is the length of the message(Unit: Byte).
- *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the messagequeue detach failed.
- *
- * @warning  This function can be called in interrupt context and thread context.
- */
-rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size)
-{
-    return rt_mq_send_wait(mq, buffer, size, 0);
-}
-RTM_EXPORT(rt_mq_send);
-
-
-/**
- * @brief    This function will send an urgent message to the messagequeue object.
- *
- * @note     This function is almost the same as the rt_mq_send() function. The only difference is that
- *           when sending an urgent message, the message is placed at the head of the messagequeue so that
- *           the recipient can receive the urgent message first.
- *
- * @see      rt_mq_send()
- *
- * @param    mq is a pointer to the messagequeue object to be sent.
- *
- * @param    buffer is the content of the message.
- *
- * @param    size is the length of the message(Unit: Byte).
- *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the mailbox detach failed.
- */
-rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
-{
-    rt_base_t level;
-    struct rt_mq_message *msg;
-
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* greater than one message size */
-    if (size > mq->msg_size)
-        return -RT_ERROR;
-
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
-
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
-
-    /* get a free list, there must be an empty item */
-    msg = (struct rt_mq_message *)mq->msg_queue_free;
-    /* message queue is full */
-    if (msg == RT_NULL)
-    {
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
-
-        return -RT_EFULL;
-    }
-    /* move free list pointer */
-    mq->msg_queue_free = msg->next;
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
-
-    /* copy buffer */
-    rt_memcpy(msg + 1, buffer, size);
-
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
-
-    /* link msg to the beginning of message queue */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_head;
-    mq->msg_queue_head = msg;
-
-    /* if there is no tail */
-    if (mq->msg_queue_tail == RT_NULL)
-        mq->msg_queue_tail = msg;
-
-    if(mq->entry < RT_MQ_ENTRY_MAX)
-    {
-        /* increase message entry */
-        mq->entry ++;
-    }
-    else
-    {
-        rt_hw_interrupt_enable(level); /* enable interrupt */
-        return -RT_EFULL; /* value overflowed */
-    }
-
-    /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
+    /* wake up a thread waiting on it by rt_ipc_wait_any() */
+    if (_ipc_waitany_notify(&(mq->parent), RT_FALSE))
     {
-        _ipc_list_resume(&(mq->parent.suspend_thread));
-
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
 
@@ -3282,59 +3773,31 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
 
     return RT_EOK;
 }
-RTM_EXPORT(rt_mq_urgent);
-
 
 /**
- * @brief    This function will receive a message from message queue object,
- *           if there is no message in messagequeue object, the thread shall wait for a specified time.
- *
- * @note     Only when there is mail in the mailbox, the receiving thread can get the mail immediately and return RT_EOK,
- *           otherwise the receiving thread will be suspended until timeout.
- *           If the mail is not received within the specified time, it will return -RT_ETIMEOUT.
- *
- * @param    mq is a pointer to the messagequeue object to be received.
+ * @brief    Unlink the message slot at the head of the messagequeue, the
+ *           calling thread waits for a timeout when the messagequeue is empty.
  *
- * @param    buffer is the content of the message.
- *
- * @param    size is the length of the message(Unit: Byte).
+ * @param    mq is a pointer to the messagequeue object.
  *
- * @param    timeout is a timeout period (unit: an OS tick). If the message is unavailable, the thread will wait for
- *           the message in the queue up to the amount of time specified by this parameter.
+ * @param    slot is a pointer to the unlinked message slot.
  *
- *           NOTE:
- *           If use Macro RT_WAITING_FOREVER to set this parameter, which means that when the
- *           message is unavailable in the queue, the thread will be waiting forever.
- *           If use macro RT_WAITING_NO to set this parameter, which means that this
- *           function is non-blocking and will return immediately.
+ * @param    timeout is a timeout period (unit: an OS tick).
  *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the mailbox release failed.
+ * @return   Return the operation status. When the return value is RT_EOK, the slot is unlinked.
+ *           If the return value is any other values, it means that the waiting failed.
  */
-rt_err_t rt_mq_recv(rt_mq_t    mq,
-                    void      *buffer,
-                    rt_size_t  size,
-                    rt_int32_t timeout)
+static rt_err_t _mq_slot_dequeue(rt_mq_t mq, struct rt_mq_message **slot, rt_int32_t timeout)
 {
     struct rt_thread *thread;
     rt_base_t level;
     struct rt_mq_message *msg;
     rt_uint32_t tick_delta;
 
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* current context checking */
-    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
-
     /* initialize delta tick */
     tick_delta = 0;
     /* get current thread */
     thread = rt_thread_self();
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
 
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
@@ -3429,8 +3892,25 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
-    /* copy message */
-    rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
+    *slot = msg;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    Put a message slot back to the free list of the messagequeue, and
+ *           resume the first thread waiting for a free slot.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is a pointer to the message slot.
+ *
+ * @return   Return RT_TRUE if a sending thread is resumed, the caller shall
+ *           reschedule then.
+ */
+static rt_bool_t _mq_slot_free(rt_mq_t mq, struct rt_mq_message *msg)
+{
+    rt_base_t level;
 
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
@@ -3446,29 +3926,453 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
 
-        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
-
-        rt_schedule();
-
-        return RT_EOK;
+        return RT_TRUE;
     }
 
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
-    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+    return RT_FALSE;
+}
 
-    return RT_EOK;
+/* get the message slot of a buffer lent by rt_mq_reserve() or rt_mq_peek() */
+rt_inline struct rt_mq_message *_mq_buffer_to_slot(rt_mq_t mq, void *buffer)
+{
+    struct rt_mq_message *msg = (struct rt_mq_message *)buffer - 1;
+
+    RT_ASSERT((rt_uint8_t *)msg >= (rt_uint8_t *)mq->msg_pool);
+    RT_ASSERT((rt_uint8_t *)msg < (rt_uint8_t *)mq->msg_pool +
+              mq->max_msgs * (mq->msg_size + sizeof(struct rt_mq_message)));
+    RT_ASSERT(((rt_uint8_t *)msg - (rt_uint8_t *)mq->msg_pool) %
+              (mq->msg_size + sizeof(struct rt_mq_message)) == 0);
+
+    return msg;
 }
-RTM_EXPORT(rt_mq_recv);
+
 
 
 /**
- * @brief    This function will set some extra attributions of a messagequeue object.
- *
- * @note     Currently this function only supports the RT_IPC_CMD_RESET command to reset the messagequeue.
+ * @brief    This function will send a message to the messagequeue object. If
+ *           there is a thread suspended on the messagequeue, the thread will be
+ *           resumed.
  *
- * @param    mq is a pointer to a messagequeue object.
+ * @note     When using this function to send a message, if the messagequeue is
+ *           fully used, the current thread will wait for a timeout. If reaching
+ *           the timeout and there is still no space available, the sending
+ *           thread will be resumed and an error code will be returned. By
+ *           contrast, the rt_mq_send() function will return an error code
+ *           immediately without waiting when the messagequeue if fully used.
+ *
+ * @see      rt_mq_send()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful. If the return value is any other values,
+ *           it means that the messagequeue detach failed.
+ *
+ * @warning  This function can be called in interrupt context and thread
+ * context.
+ */
+rt_err_t rt_mq_send_wait(rt_mq_t     mq,
+                         const void *buffer,
+                         rt_size_t   size,
+                         rt_int32_t  timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    result = _mq_slot_alloc(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
+
+    /* copy buffer */
+    rt_memcpy(msg + 1, buffer, size);
+
+    return _mq_slot_enqueue(mq, msg);
+}
+RTM_EXPORT(rt_mq_send_wait)
+
+
+/**
+ * @brief    This function will send a message to the messagequeue object.
+ *           If there is a thread suspended on the messagequeue, the thread will be resumed.
+ *
+ * @note     When using this function to send a message, if the messagequeue is fully used,
+ *           the current thread will wait for a timeout.
+ *           By contrast, when the messagequeue is fully used, the rt_mq_send_wait() function will
+ *           return an error code immediately without waiting.
+ *
+ * @see      rt_mq_send_wait()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the messagequeue detach failed.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    return rt_mq_send_wait(mq, buffer, size, 0);
+}
+RTM_EXPORT(rt_mq_send);
+
+
+/**
+ * @brief    This function will send an urgent message to the messagequeue object.
+ *
+ * @note     This function is almost the same as the rt_mq_send() function. The only difference is that
+ *           when sending an urgent message, the message is placed at the head of the messagequeue so that
+ *           the recipient can receive the urgent message first.
+ *
+ * @see      rt_mq_send()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the mailbox detach failed.
+ */
+rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    rt_base_t level;
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    /* get a free list, there must be an empty item */
+    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    /* message queue is full */
+    if (msg == RT_NULL)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EFULL;
+    }
+    /* move free list pointer */
+    mq->msg_queue_free = msg->next;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    /* copy buffer */
+    rt_memcpy(msg + 1, buffer, size);
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    /* link msg to the beginning of message queue */
+    msg->next = (struct rt_mq_message *)mq->msg_queue_head;
+    mq->msg_queue_head = msg;
+
+    /* if there is no tail */
+    if (mq->msg_queue_tail == RT_NULL)
+        mq->msg_queue_tail = msg;
+
+    if(mq->entry < RT_MQ_ENTRY_MAX)
+    {
+        /* increase message entry */
+        mq->entry ++;
+    }
+    else
+    {
+        rt_hw_interrupt_enable(level); /* enable interrupt */
+        return -RT_EFULL; /* value overflowed */
+    }
+
+    /* resume suspended thread */
+    if (!rt_list_isempty(&mq->parent.suspend_thread))
+    {
+        _ipc_list_resume(&(mq->parent.suspend_thread));
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    /* wake up a thread waiting on it by rt_ipc_wait_any() */
+    if (_ipc_waitany_notify(&(mq->parent), RT_FALSE))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_urgent);
+
+
+/**
+ * @brief    This function will receive a message from message queue object,
+ *           if there is no message in messagequeue object, the thread shall wait for a specified time.
+ *
+ * @note     Only when there is mail in the mailbox, the receiving thread can get the mail immediately and return RT_EOK,
+ *           otherwise the receiving thread will be suspended until timeout.
+ *           If the mail is not received within the specified time, it will return -RT_ETIMEOUT.
+ *
+ * @param    mq is a pointer to the messagequeue object to be received.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @param    timeout is a timeout period (unit: an OS tick). If the message is unavailable, the thread will wait for
+ *           the message in the queue up to the amount of time specified by this parameter.
+ *
+ *           NOTE:
+ *           If use Macro RT_WAITING_FOREVER to set this parameter, which means that when the
+ *           message is unavailable in the queue, the thread will be waiting forever.
+ *           If use macro RT_WAITING_NO to set this parameter, which means that this
+ *           function is non-blocking and will return immediately.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the mailbox release failed.
+ */
+rt_err_t rt_mq_recv(rt_mq_t    mq,
+                    void      *buffer,
+                    rt_size_t  size,
+                    rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    result = _mq_slot_dequeue(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
+
+    /* copy message */
+    rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
+
+    /* put message to free list */
+    if (_mq_slot_free(mq, msg) == RT_TRUE)
+    {
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv);
+
+
+/**
+ * @brief    This function will reserve a free message slot of the messagequeue
+ *           object, so that the message can be filled in place without copying.
+ *           The slot shall be handed over by rt_mq_commit(), or given back by
+ *           rt_mq_release() if the message is dropped.
+ *
+ * @note     The blocking and timeout behaviour is the same as rt_mq_send_wait().
+ *
+ * @see      rt_mq_commit(), rt_mq_release()
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is a pointer to the reserved buffer of msg_size bytes.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is -RT_EFULL, there is no free slot before timeout.
+ *
+ * @warning  This function can be called in interrupt context with RT_WAITING_NO and thread context.
+ */
+rt_err_t rt_mq_reserve(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    result = _mq_slot_alloc(mq, &msg, timeout);
+    if (result == RT_EOK)
+        *buffer = msg + 1;
+
+    return result;
+}
+RTM_EXPORT(rt_mq_reserve);
+
+/**
+ * @brief    This function will hand a message reserved by rt_mq_reserve() over
+ *           to the messagequeue object. If there is a thread suspended on the
+ *           messagequeue, the thread will be resumed.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the buffer returned by rt_mq_reserve(), the caller
+ *           shall not touch it after commit.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_commit(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    return _mq_slot_enqueue(mq, _mq_buffer_to_slot(mq, buffer));
+}
+RTM_EXPORT(rt_mq_commit);
+
+/**
+ * @brief    This function will take the first message out of the messagequeue
+ *           object and lend its buffer in place without copying. The buffer
+ *           shall be given back by rt_mq_release() after use.
+ *
+ * @note     The blocking and timeout behaviour is the same as rt_mq_recv().
+ *           The message length is not recorded, the buffer is msg_size bytes.
+ *
+ * @see      rt_mq_release()
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is a pointer to the buffer of the received message.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is -RT_ETIMEOUT, there is no message before timeout.
+ */
+rt_err_t rt_mq_peek(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    result = _mq_slot_dequeue(mq, &msg, timeout);
+    if (result == RT_EOK)
+    {
+        *buffer = msg + 1;
+
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+    }
+
+    return result;
+}
+RTM_EXPORT(rt_mq_peek);
+
+/**
+ * @brief    This function will give a buffer lent by rt_mq_peek() or
+ *           rt_mq_reserve() back to the messagequeue object. If there is a
+ *           thread waiting for a free slot, the thread will be resumed.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the buffer returned by rt_mq_peek() or rt_mq_reserve().
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    if (_mq_slot_free(mq, _mq_buffer_to_slot(mq, buffer)) == RT_TRUE)
+        rt_schedule();
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_release);
+
+
+/**
+ * @brief    This function will set some extra attributions of a messagequeue object.
+ *
+ * @note     Currently this function only supports the RT_IPC_CMD_RESET command to reset the messagequeue.
+ *
+ * @param    mq is a pointer to a messagequeue object.
  *
  * @param    cmd is a command used to configure some attributions of the messagequeue.
  *
@@ -3493,6 +4397,7 @@ rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg)
 
         /* resume all waiting thread */
         _ipc_list_resume_all(&mq->parent.suspend_thread);
+        _ipc_waitany_resume_all(&(mq->parent));
         /* also resume all message queue private suspended thread */
         _ipc_list_resume_all(&(mq->suspend_sender_thread));
 
@@ -3531,4 +4436,166 @@ RTM_EXPORT(rt_mq_control);
 /**@}*/
 #endif /* RT_USING_MESSAGEQUEUE */
 
+#ifdef RT_USING_IPC_WAITANY
+/**
+ * @brief    This function will suspend the current thread on several IPC objects until one of them is ready.
+ *
+ * @note     An object is ready when a semaphore could be taken, a mailbox or a message queue is not empty,
+ *           or the set of an event satisfies the set and option of its item. The object is NOT taken or
+ *           received by this function, the thread should take it with a timeout of RT_WAITING_NO. Another
+ *           thread may take the object in the meantime, so the thread should wait again when it fails.
+ *
+ *           Only one thread waiting by this function is woken up when a semaphore is released or a mail or
+ *           message is sent, and only when no thread is suspended on the object itself. All the threads
+ *           whose condition is satisfied are woken up when an event is sent.
+ *
+ * @param    items is an array of the objects to wait, it must stay valid until this function returns.
+ *
+ * @param    count is the number of items.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick). If the objects are not ready in the specified
+ *           time, the thread will be resumed with -RT_ETIMEOUT.
+ *           If use Macro RT_WAITING_FOREVER to set this parameter, which means that when the objects are
+ *           not ready, the thread will be waiting forever.
+ *           If use macro RT_WAITING_NO to set this parameter, which means that this function is non-blocking
+ *           and will return immediately.
+ *
+ * @param    index is a pointer to store the index of the ready item, it can be RT_NULL.
+ *
+ * @return   Return the operation status. ONLY When the return value is RT_EOK, an object is ready.
+ *           If the return value is -RT_ETIMEOUT, no object is ready in time. If the return value is
+ *           -RT_ERROR, one of the objects is detached or reset. If the return value is -RT_EINTR, the
+ *           thread is resumed by others.
+ *
+ * @warning  This function can ONLY be called in the thread context. It MUST NOT BE called in interrupt context.
+ */
+rt_err_t rt_ipc_wait_any(struct rt_ipc_wait_item *items,
+                         rt_uint8_t               count,
+                         rt_int32_t               timeout,
+                         rt_uint8_t              *index)
+{
+    rt_base_t level;
+    rt_err_t result;
+    struct rt_thread *thread;
+    rt_uint8_t i;
+
+    /* parameter check */
+    RT_ASSERT(items != RT_NULL);
+    RT_ASSERT(count > 0);
+
+    for (i = 0; i < count; i ++)
+    {
+        RT_ASSERT(items[i].object != RT_NULL);
+        RT_ASSERT(_ipc_waitany_object(&items[i]) != RT_NULL);
+    }
+
+    /* get current thread */
+    thread = rt_thread_self();
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (i = 0; i < count; i ++)
+    {
+        if (_ipc_waitany_ready(&items[i]))
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
+
+            if (index)
+                *index = i;
+
+            return RT_EOK;
+        }
+    }
+
+    /* no waiting, return with timeout */
+    if (timeout == 0)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_ETIMEOUT;
+    }
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(RT_TRUE);
+
+    /* reset thread error number */
+    thread->error = RT_EOK;
+
+    RT_DEBUG_LOG(RT_DEBUG_IPC, ("ipc wait any: suspend thread - %s\n",
+                                thread->name));
+
+    /* suspend thread, and pend an item on each object in FIFO order */
+    rt_thread_suspend(thread);
+    for (i = 0; i < count; i ++)
+    {
+        items[i].thread   = thread;
+        items[i].signaled = 0;
+        rt_list_insert_before(&(_ipc_waitany_object(&items[i])->waitany_list), &(items[i].list));
+    }
+
+    /* has waiting time, start thread timer */
+    if (timeout > 0)
+    {
+        /* reset the timeout of thread timer and start it */
+        rt_timer_control(&(thread->thread_timer),
+                         RT_TIMER_CTRL_SET_TIME,
+                         &timeout);
+        rt_timer_start(&(thread->thread_timer));
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    /* do schedule */
+    rt_schedule();
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    result = thread->error;
+    if (result == RT_EOK)
+        result = -RT_EINTR;
+
+    /* remove the items, the signaled one has been removed by the object */
+    for (i = 0; i < count; i ++)
+    {
+        rt_list_remove(&(items[i].list));
+
+        if (items[i].signaled)
+        {
+            if (index)
+                *index = i;
+            result = RT_EOK;
+        }
+    }
+
+    /*
+     * an object made ready after the thread was woken by timeout or by others
+     * skipped the thread as it was no longer suspended, report it here rather
+     * than lose it.
+     */
+    if (result == -RT_ETIMEOUT || result == -RT_EINTR)
+    {
+        for (i = 0; i < count; i ++)
+        {
+            if (_ipc_waitany_ready(&items[i]))
+            {
+                if (index)
+                    *index = i;
+                result = RT_EOK;
+                break;
+            }
+        }
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+RTM_EXPORT(rt_ipc_wait_any);
+#endif /* RT_USING_IPC_WAITANY */
+
 /**@}*/
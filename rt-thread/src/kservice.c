@@ -23,6 +23,9 @@
  * 2022-06-04     Meco Man     remove strnlen
  * 2022-08-24     Yunjie       make rt_memset word-independent to adapt to ti c28x (16bit word)
  * 2022-08-30     Yunjie       make rt_vsnprintf adapt to ti c28x (16bit int)
+ * 2026-10-17     agent        add fragmentation and latency statistics of heap
+ * 2026-10-17     agent        add default atomic interfaces
+ * 2026-10-17     agent        add default atomic compare-and-swap
  */
 
 #include <rtthread.h>
@@ -32,6 +35,10 @@
 #include <dlmodule.h>
 #endif /* RT_USING_MODULE */
 
+#if defined(RT_USING_HEAP_STATS) && defined(RT_USING_CPUTIME)
+#include <drivers/cputime.h>
+#endif /* RT_USING_HEAP_STATS && RT_USING_CPUTIME */
+
 /* use precision */
 #define RT_PRINTF_PRECISION
 
@@ -55,6 +62,92 @@ RT_WEAK void rt_hw_us_delay(rt_uint32_t us)
         "Please consider implementing rt_hw_us_delay() in another file.\n"));
 }
 
+/**
+ * @brief This function will add a value to a variable atomically.
+ *
+ * @param ptr is the address of the variable.
+ *
+ * @param value is the value to be added.
+ *
+ * @return Return the value of the variable before the addition.
+ */
+RT_WEAK rt_base_t rt_hw_atomic_add(volatile rt_base_t *ptr, rt_base_t value)
+{
+    rt_base_t level, old;
+
+    level = rt_hw_interrupt_disable();
+    old = *ptr;
+    *ptr = old + value;
+    rt_hw_interrupt_enable(level);
+
+    return old;
+}
+
+/**
+ * @brief This function will replace the value of a variable atomically if it
+ *        equals to the expected one.
+ *
+ * @param ptr is the address of the variable.
+ *
+ * @param old is the expected value.
+ *
+ * @param value is the new value.
+ *
+ * @return Return the value of the variable before the operation, it is equal
+ *         to old if the replacement is done.
+ */
+RT_WEAK rt_base_t rt_hw_atomic_cas(volatile rt_base_t *ptr, rt_base_t old, rt_base_t value)
+{
+    rt_base_t level, cur;
+
+    level = rt_hw_interrupt_disable();
+    cur = *ptr;
+    if (cur == old)
+        *ptr = value;
+    rt_hw_interrupt_enable(level);
+
+    return cur;
+}
+
+/**
+ * @brief This function will push a node to the head of a single list
+ *        atomically.
+ *
+ * @param head is the address of the list head.
+ *
+ * @param node is the node, whose first word is used as the next pointer.
+ */
+RT_WEAK void rt_hw_atomic_slist_push(void **head, void *node)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *(void **)node = *head;
+    *head = node;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * @brief This function will pop the first node of a single list atomically.
+ *
+ * @param head is the address of the list head.
+ *
+ * @return Return the node, or RT_NULL if the list is empty.
+ */
+RT_WEAK void *rt_hw_atomic_slist_pop(void **head)
+{
+    void *node;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    node = *head;
+    if (node != RT_NULL)
+        *head = *(void **)node;
+    rt_hw_interrupt_enable(level);
+
+    return node;
+}
+
 static const char* rt_errno_strs[] =
 {
     "OK",
@@ -1329,6 +1422,172 @@ RT_WEAK int rt_kprintf(const char *fmt, ...)
 RTM_EXPORT(rt_kprintf);
 #endif /* RT_USING_CONSOLE */
 
+#ifdef RT_USING_HEAP_STATS
+rt_inline int _heap_stats_log2(rt_size_t value)
+{
+    int index = 0;
+
+    while (value >>= 1)
+        index ++;
+
+    return index;
+}
+
+static void _heap_stats_cycle(rt_uint32_t *hist, rt_uint32_t stamp)
+{
+    int index;
+
+    index = _heap_stats_log2(rt_heap_stats_stamp() - stamp);
+    if (index >= RT_HEAP_STATS_CYCLE_NR)
+        index = RT_HEAP_STATS_CYCLE_NR - 1;
+    hist[index] ++;
+}
+
+/*
+ * The percentile is reported as the upper bound of the log2 bucket which
+ * holds it, so the result is at most twice the real cycle time.
+ */
+static rt_uint32_t _heap_stats_percentile(const rt_uint32_t *hist, rt_uint32_t percent)
+{
+    int index;
+    rt_uint32_t count, target;
+
+    count = 0;
+    for (index = 0; index < RT_HEAP_STATS_CYCLE_NR; index ++)
+        count += hist[index];
+    if (count == 0)
+        return 0;
+
+    target = (rt_uint32_t)(((rt_uint64_t)count * percent + 99) / 100);
+    count = 0;
+    for (index = 0; index < RT_HEAP_STATS_CYCLE_NR - 1; index ++)
+    {
+        count += hist[index];
+        if (count >= target)
+            break;
+    }
+
+    return (2UL << index) - 1;
+}
+
+/**
+ * @brief This function will return a time stamp to measure the time spent
+ *        in a memory allocator.
+ *
+ * @return the counter of cputime, or 0 if RT_USING_CPUTIME is not enabled.
+ */
+rt_uint32_t rt_heap_stats_stamp(void)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)clock_cpu_gettime();
+#else
+    return 0;
+#endif /* RT_USING_CPUTIME */
+}
+
+/**
+ * @brief This function will account an allocation in the counters of a
+ *        memory allocator.
+ *
+ * @param counter is the counters of the memory allocator.
+ *
+ * @param ptr is the allocated memory, RT_NULL for a failed allocation.
+ *
+ * @param stamp is the value of rt_heap_stats_stamp() before the allocation.
+ */
+void rt_heap_stats_alloc(struct rt_heap_counter *counter, void *ptr, rt_uint32_t stamp)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (ptr != RT_NULL)
+    {
+        counter->alloc_count ++;
+        _heap_stats_cycle(counter->alloc_cycle, stamp);
+    }
+    else
+    {
+        counter->fail_count ++;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * @brief This function will account a release in the counters of a memory
+ *        allocator.
+ *
+ * @param counter is the counters of the memory allocator.
+ *
+ * @param stamp is the value of rt_heap_stats_stamp() before the release.
+ */
+void rt_heap_stats_free(struct rt_heap_counter *counter, rt_uint32_t stamp)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    counter->free_count ++;
+    _heap_stats_cycle(counter->free_cycle, stamp);
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * @brief This function will account free blocks of the same size in the
+ *        statistics.
+ *
+ * @param stats is the statistics to be filled.
+ *
+ * @param size is the size of the free block.
+ *
+ * @param count is the number of the free blocks.
+ */
+void rt_heap_stats_block(struct rt_heap_stats *stats, rt_size_t size, rt_size_t count)
+{
+    int index;
+
+    index = _heap_stats_log2(size) - 5;
+    if (index < 0)
+        index = 0;
+    else if (index >= RT_HEAP_STATS_HIST_NR)
+        index = RT_HEAP_STATS_HIST_NR - 1;
+
+    stats->free_hist[index] += count;
+    stats->free_blocks += count;
+    if (count != 0 && size > stats->largest_free)
+        stats->largest_free = size;
+}
+
+/**
+ * @brief This function will copy the counters of a memory allocator to the
+ *        statistics, and compute the percentiles of the cycle time.
+ *
+ * @param stats is the statistics to be filled.
+ *
+ * @param counter is the counters of the memory allocator.
+ */
+void rt_heap_stats_fill(struct rt_heap_stats *stats, const struct rt_heap_counter *counter)
+{
+    rt_base_t level;
+    struct rt_heap_counter snapshot;
+
+    level = rt_hw_interrupt_disable();
+    rt_memcpy(&snapshot, counter, sizeof(snapshot));
+    rt_hw_interrupt_enable(level);
+
+    stats->alloc_count = snapshot.alloc_count;
+    stats->free_count  = snapshot.free_count;
+    stats->fail_count  = snapshot.fail_count;
+
+    stats->alloc_p50 = _heap_stats_percentile(snapshot.alloc_cycle, 50);
+    stats->alloc_p90 = _heap_stats_percentile(snapshot.alloc_cycle, 90);
+    stats->alloc_p99 = _heap_stats_percentile(snapshot.alloc_cycle, 99);
+    stats->alloc_max = _heap_stats_percentile(snapshot.alloc_cycle, 100);
+    stats->free_p50  = _heap_stats_percentile(snapshot.free_cycle, 50);
+    stats->free_p90  = _heap_stats_percentile(snapshot.free_cycle, 90);
+    stats->free_p99  = _heap_stats_percentile(snapshot.free_cycle, 99);
+    stats->free_max  = _heap_stats_percentile(snapshot.free_cycle, 100);
+}
+#endif /* RT_USING_HEAP_STATS */
+
 #if defined(RT_USING_HEAP) && !defined(RT_USING_USERHEAP)
 #ifdef RT_USING_HOOK
 static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
@@ -1429,6 +1688,8 @@ rt_inline void _smem_info(rt_size_t *total,
     rt_smem_free(_ptr)
 #define _MEM_INFO(_total, _used, _max)  \
     _smem_info(_total, _used, _max)
+#define _MEM_STATS(_stats)  \
+    rt_smem_stats(system_heap, _stats)
 #elif defined(RT_USING_MEMHEAP_AS_HEAP)
 static struct rt_memheap system_heap;
 void *_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
@@ -1444,6 +1705,8 @@ void *_memheap_realloc(struct rt_memheap *heap, void *rmem, rt_size_t newsize);
     _memheap_free(_ptr)
 #define _MEM_INFO(_total, _used, _max)   \
     rt_memheap_info(&system_heap, _total, _used, _max)
+#define _MEM_STATS(_stats)  \
+    rt_memheap_stats(&system_heap, _stats)
 #elif defined(RT_USING_SLAB_AS_HEAP)
 static rt_slab_t system_heap;
 rt_inline void _slab_info(rt_size_t *total,
@@ -1465,14 +1728,271 @@ rt_inline void _slab_info(rt_size_t *total,
 #define _MEM_FREE(_ptr) \
     rt_slab_free(system_heap, _ptr)
 #define _MEM_INFO       _slab_info
+#define _MEM_STATS(_stats)  \
+    rt_slab_stats(system_heap, _stats)
 #else
 #define _MEM_INIT(...)
 #define _MEM_MALLOC(...)     RT_NULL
 #define _MEM_REALLOC(...)    RT_NULL
 #define _MEM_FREE(...)
 #define _MEM_INFO(...)
+#define _MEM_STATS(...)      (-RT_ENOSYS)
 #endif
 
+#ifdef RT_USING_HEAP_CACHE
+#ifndef RT_HEAP_CACHE_BIN_BYTES
+#define RT_HEAP_CACHE_BIN_BYTES     512
+#endif /* RT_HEAP_CACHE_BIN_BYTES */
+
+#ifndef RT_HEAP_CACHE_BATCH
+#define RT_HEAP_CACHE_BATCH         4
+#endif /* RT_HEAP_CACHE_BATCH */
+
+/* each block of the system heap is prefixed with a tag recording its cache class */
+#define _HEAP_CACHE_TAG_SIZE        RT_ALIGN(sizeof(rt_ubase_t), RT_ALIGN_SIZE)
+#define _HEAP_CACHE_TAG_MAGIC       0x1ea70000UL
+#define _HEAP_CACHE_TAG_MAGIC_MASK  0xffff0000UL
+#define _HEAP_CACHE_TAG_CLASS_MASK  0x0000ffffUL
+#define _HEAP_CACHE_CLASS_NONE      0xffff
+#define _HEAP_CACHE_CLASS_NR        10
+#define _HEAP_CACHE_TAG(ptr)        (*(rt_ubase_t *)((rt_uint8_t *)(ptr) - _HEAP_CACHE_TAG_SIZE))
+
+static const rt_uint16_t _heap_cache_class_size[_HEAP_CACHE_CLASS_NR] =
+{
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512
+};
+
+struct rt_heap_cache_bin
+{
+    void        *head;                                  /* free blocks, linked through their first word */
+    rt_uint16_t  count;
+};
+
+struct rt_heap_cache
+{
+    struct rt_heap_cache_bin bin[_HEAP_CACHE_CLASS_NR];
+};
+
+/**
+ * @brief Get the cache class of a size.
+ *
+ * @param size is the requested size.
+ *
+ * @return the class index, or _HEAP_CACHE_CLASS_NONE if the size is not cached.
+ */
+rt_inline int _heap_cache_class(rt_size_t size)
+{
+    int idx;
+
+    for (idx = 0; idx < _HEAP_CACHE_CLASS_NR; idx++)
+    {
+        if (size <= _heap_cache_class_size[idx])
+            return idx;
+    }
+
+    return _HEAP_CACHE_CLASS_NONE;
+}
+
+/**
+ * @brief Get the maximal count of blocks kept by a bin of the class.
+ */
+rt_inline rt_uint16_t _heap_cache_limit(int idx)
+{
+    rt_uint16_t limit = RT_HEAP_CACHE_BIN_BYTES / _heap_cache_class_size[idx];
+
+    return limit < 2 ? 2 : limit;
+}
+
+/**
+ * @brief Get the cache of current thread, it will be allocated at the first use.
+ *
+ * @return the cache of current thread, or RT_NULL when the cache can not be
+ *         used, e.g. in interrupt context or before the scheduler starts.
+ */
+static struct rt_heap_cache *_heap_cache_get(void)
+{
+    rt_thread_t thread;
+    struct rt_heap_cache *cache;
+    rt_base_t level;
+
+    thread = rt_thread_self();
+    if (thread == RT_NULL || rt_interrupt_get_nest() != 0)
+        return RT_NULL;
+
+    if (thread->heap_cache == RT_NULL)
+    {
+        level = _heap_lock();
+        cache = (struct rt_heap_cache *)_MEM_MALLOC(sizeof(struct rt_heap_cache));
+        _heap_unlock(level);
+
+        if (cache != RT_NULL)
+        {
+            rt_memset(cache, 0, sizeof(struct rt_heap_cache));
+        }
+        thread->heap_cache = cache;
+    }
+
+    return (struct rt_heap_cache *)thread->heap_cache;
+}
+
+/**
+ * @brief Allocate a batch of blocks of the class from system heap into the bin.
+ */
+static void _heap_cache_refill(struct rt_heap_cache_bin *bin, int idx)
+{
+    rt_base_t level;
+    rt_uint8_t *raw;
+    void *blk;
+    int i;
+
+    level = _heap_lock();
+    for (i = 0; i < RT_HEAP_CACHE_BATCH; i++)
+    {
+        raw = (rt_uint8_t *)_MEM_MALLOC(_HEAP_CACHE_TAG_SIZE + _heap_cache_class_size[idx]);
+        if (raw == RT_NULL)
+            break;
+
+        blk = raw + _HEAP_CACHE_TAG_SIZE;
+        _HEAP_CACHE_TAG(blk) = _HEAP_CACHE_TAG_MAGIC | idx;
+        *(void **)blk = bin->head;
+        bin->head = blk;
+        bin->count++;
+    }
+    _heap_unlock(level);
+}
+
+/**
+ * @brief Give the blocks of the bin back to system heap until 'keep' blocks remain.
+ */
+static void _heap_cache_drain(struct rt_heap_cache_bin *bin, rt_uint16_t keep)
+{
+    rt_base_t level;
+    void *blk;
+
+    if (bin->count <= keep)
+        return;
+
+    level = _heap_lock();
+    while (bin->count > keep)
+    {
+        blk = bin->head;
+        bin->head = *(void **)blk;
+        bin->count--;
+        _MEM_FREE((rt_uint8_t *)blk - _HEAP_CACHE_TAG_SIZE);
+    }
+    _heap_unlock(level);
+}
+
+/**
+ * @brief Allocate memory from system heap with the cache class tag ahead.
+ */
+static void *_heap_cache_malloc(rt_size_t size)
+{
+    struct rt_heap_cache *cache;
+    struct rt_heap_cache_bin *bin;
+    rt_base_t level;
+    rt_uint8_t *raw;
+    void *blk;
+    int idx;
+
+    /* nothing is allocated for 0 byte, as the system heap does */
+    if (size == 0)
+        return RT_NULL;
+
+    idx = _heap_cache_class(size);
+    if (idx != _HEAP_CACHE_CLASS_NONE && (cache = _heap_cache_get()) != RT_NULL)
+    {
+        /* fast path: the bin is owned by current thread, no lock is needed */
+        bin = &cache->bin[idx];
+        if (bin->head == RT_NULL)
+        {
+            _heap_cache_refill(bin, idx);
+            if (bin->head == RT_NULL)
+                return RT_NULL;
+        }
+
+        blk = bin->head;
+        bin->head = *(void **)blk;
+        bin->count--;
+        return blk;
+    }
+
+    level = _heap_lock();
+    raw = (rt_uint8_t *)_MEM_MALLOC(_HEAP_CACHE_TAG_SIZE + size);
+    _heap_unlock(level);
+    if (raw == RT_NULL)
+        return RT_NULL;
+
+    blk = raw + _HEAP_CACHE_TAG_SIZE;
+    _HEAP_CACHE_TAG(blk) = _HEAP_CACHE_TAG_MAGIC |
+        (idx == _HEAP_CACHE_CLASS_NONE ? _HEAP_CACHE_CLASS_NONE : idx);
+    return blk;
+}
+
+/**
+ * @brief Release memory allocated by _heap_cache_malloc.
+ */
+static void _heap_cache_free(void *rmem)
+{
+    struct rt_heap_cache *cache;
+    struct rt_heap_cache_bin *bin;
+    rt_base_t level;
+    int idx;
+
+    RT_ASSERT((_HEAP_CACHE_TAG(rmem) & _HEAP_CACHE_TAG_MAGIC_MASK) == _HEAP_CACHE_TAG_MAGIC);
+
+    idx = _HEAP_CACHE_TAG(rmem) & _HEAP_CACHE_TAG_CLASS_MASK;
+    if (idx != _HEAP_CACHE_CLASS_NONE && (cache = _heap_cache_get()) != RT_NULL)
+    {
+        /* fast path: the block of any thread can join the bin of current thread */
+        bin = &cache->bin[idx];
+        *(void **)rmem = bin->head;
+        bin->head = rmem;
+        bin->count++;
+
+        if (bin->count > _heap_cache_limit(idx))
+        {
+            _heap_cache_drain(bin, _heap_cache_limit(idx) / 2);
+        }
+        return;
+    }
+
+    level = _heap_lock();
+    _MEM_FREE((rt_uint8_t *)rmem - _HEAP_CACHE_TAG_SIZE);
+    _heap_unlock(level);
+}
+
+/**
+ * @brief This function will give all the blocks cached by a thread back to
+ *        system heap and release the cache. It is invoked when the thread is
+ *        cleaned up.
+ *
+ * @param thread is the thread whose cache will be flushed.
+ */
+void rt_heap_cache_flush(rt_thread_t thread)
+{
+    struct rt_heap_cache *cache;
+    rt_base_t level;
+    int idx;
+
+    RT_ASSERT(thread != RT_NULL);
+
+    cache = (struct rt_heap_cache *)thread->heap_cache;
+    if (cache == RT_NULL)
+        return;
+
+    thread->heap_cache = RT_NULL;
+    for (idx = 0; idx < _HEAP_CACHE_CLASS_NR; idx++)
+    {
+        _heap_cache_drain(&cache->bin[idx], 0);
+    }
+
+    level = _heap_lock();
+    _MEM_FREE(cache);
+    _heap_unlock(level);
+}
+#endif /* RT_USING_HEAP_CACHE */
+
 /**
  * @brief This function will init system heap.
  *
@@ -1502,15 +2022,21 @@ RT_WEAK void rt_system_heap_init(void *begin_addr, void *end_addr)
  */
 RT_WEAK void *rt_malloc(rt_size_t size)
 {
-    rt_base_t level;
     void *ptr;
 
+#ifdef RT_USING_HEAP_CACHE
+    /* allocate memory block from thread cache or system heap */
+    ptr = _heap_cache_malloc(size);
+#else
+    rt_base_t level;
+
     /* Enter critical zone */
     level = _heap_lock();
     /* allocate memory block from system heap */
     ptr = _MEM_MALLOC(size);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
     /* call 'rt_malloc' hook */
     RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
     return ptr;
@@ -1531,6 +2057,49 @@ RT_WEAK void *rt_realloc(void *rmem, rt_size_t newsize)
     rt_base_t level;
     void *nptr;
 
+#ifdef RT_USING_HEAP_CACHE
+    rt_ubase_t tag;
+    int idx;
+
+    if (rmem == RT_NULL)
+        return rt_malloc(newsize);
+
+    if (newsize == 0)
+    {
+        rt_free(rmem);
+        return RT_NULL;
+    }
+
+    tag = _HEAP_CACHE_TAG(rmem);
+    RT_ASSERT((tag & _HEAP_CACHE_TAG_MAGIC_MASK) == _HEAP_CACHE_TAG_MAGIC);
+    idx = tag & _HEAP_CACHE_TAG_CLASS_MASK;
+    if (idx != _HEAP_CACHE_CLASS_NONE)
+    {
+        /* a class block is moved unless it is still large enough */
+        if (newsize <= _heap_cache_class_size[idx])
+            return rmem;
+
+        nptr = rt_malloc(newsize);
+        if (nptr != RT_NULL)
+        {
+            rt_memcpy(nptr, rmem, _heap_cache_class_size[idx]);
+            rt_free(rmem);
+        }
+        return nptr;
+    }
+
+    /* Enter critical zone */
+    level = _heap_lock();
+    /* Change the size of previously allocated memory block, the tag moves along */
+    nptr = _MEM_REALLOC((rt_uint8_t *)rmem - _HEAP_CACHE_TAG_SIZE, _HEAP_CACHE_TAG_SIZE + newsize);
+    /* Exit critical zone */
+    _heap_unlock(level);
+    if (nptr != RT_NULL)
+    {
+        nptr = (rt_uint8_t *)nptr + _HEAP_CACHE_TAG_SIZE;
+    }
+    return nptr;
+#else
     /* Enter critical zone */
     level = _heap_lock();
     /* Change the size of previously allocated memory block */
@@ -1538,6 +2107,7 @@ RT_WEAK void *rt_realloc(void *rmem, rt_size_t newsize)
     /* Exit critical zone */
     _heap_unlock(level);
     return nptr;
+#endif /* RT_USING_HEAP_CACHE */
 }
 RTM_EXPORT(rt_realloc);
 
@@ -1577,17 +2147,24 @@ RTM_EXPORT(rt_calloc);
  */
 RT_WEAK void rt_free(void *rmem)
 {
+#ifndef RT_USING_HEAP_CACHE
     rt_base_t level;
+#endif /* RT_USING_HEAP_CACHE */
 
     /* call 'rt_free' hook */
     RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
     /* NULL check */
     if (rmem == RT_NULL) return;
+#ifdef RT_USING_HEAP_CACHE
+    /* release to thread cache or system heap */
+    _heap_cache_free(rmem);
+#else
     /* Enter critical zone */
     level = _heap_lock();
     _MEM_FREE(rmem);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
 }
 RTM_EXPORT(rt_free);
 
@@ -1615,6 +2192,34 @@ RT_WEAK void rt_memory_info(rt_size_t *total,
 }
 RTM_EXPORT(rt_memory_info);
 
+#ifdef RT_USING_HEAP_STATS
+/**
+ * @brief This function will get the fragmentation and latency statistics of
+ *        the system heap.
+ *
+ * @param stats is a pointer to get the statistics.
+ *
+ * @return Return the operation status. If the return value is RT_EOK, the
+ *         statistics is filled.
+ */
+rt_err_t rt_heap_stats(struct rt_heap_stats *stats)
+{
+    rt_err_t result;
+    rt_base_t level;
+
+    RT_ASSERT(stats != RT_NULL);
+
+    /* Enter critical zone */
+    level = _heap_lock();
+    result = _MEM_STATS(stats);
+    /* Exit critical zone */
+    _heap_unlock(level);
+
+    return result;
+}
+RTM_EXPORT(rt_heap_stats);
+#endif /* RT_USING_HEAP_STATS */
+
 #if defined(RT_USING_SLAB) && defined(RT_USING_SLAB_AS_HEAP)
 void *rt_page_alloc(rt_size_t npages)
 {
@@ -12,6 +12,7 @@
  * 2010-10-14     Bernard      fix rt_realloc issue when realloc a NULL pointer.
  * 2017-07-14     armink       fix rt_realloc issue when new size is 0
  * 2018-10-02     Bernard      Add 64bit support
+ * 2026-10-17     agent        add fragmentation and latency statistics
  */
 
 /*
@@ -267,16 +268,7 @@ RTM_EXPORT(rt_smem_detach);
 
 /**@{*/
 
-/**
- * @brief Allocate a block of memory with a minimum of 'size' bytes.
- *
- * @param m the small memory management object.
- *
- * @param size is the minimum size of the requested block in bytes.
- *
- * @return the pointer to allocated memory or NULL if no free memory was found.
- */
-void *rt_smem_alloc(rt_smem_t m, rt_size_t size)
+static void *_smem_alloc(rt_smem_t m, rt_size_t size)
 {
     rt_size_t ptr, ptr2;
     struct rt_small_mem_item *mem, *mem2;
@@ -406,6 +398,32 @@ void *rt_smem_alloc(rt_smem_t m, rt_size_t size)
 
     return RT_NULL;
 }
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param m the small memory management object.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_smem_alloc(rt_smem_t m, rt_size_t size)
+{
+#ifdef RT_USING_HEAP_STATS
+    void *ptr;
+    rt_uint32_t stamp;
+
+    stamp = rt_heap_stats_stamp();
+    ptr = _smem_alloc(m, size);
+    if (size != 0)
+        rt_heap_stats_alloc(&m->counter, ptr, stamp);
+
+    return ptr;
+#else
+    return _smem_alloc(m, size);
+#endif /* RT_USING_HEAP_STATS */
+}
 RTM_EXPORT(rt_smem_alloc);
 
 /**
@@ -507,13 +525,7 @@ void *rt_smem_realloc(rt_smem_t m, void *rmem, rt_size_t newsize)
 }
 RTM_EXPORT(rt_smem_realloc);
 
-/**
- * @brief This function will release the previously allocated memory block by
- *        rt_mem_alloc. The released memory block is taken back to system heap.
- *
- * @param rmem the address of memory which will be released.
- */
-void rt_smem_free(void *rmem)
+static void _smem_free(void *rmem)
 {
     struct rt_small_mem_item *mem;
     struct rt_small_mem *small_mem;
@@ -557,8 +569,72 @@ void rt_smem_free(void *rmem)
     /* finally, see if prev or next are free also */
     plug_holes(small_mem, mem);
 }
+
+/**
+ * @brief This function will release the previously allocated memory block by
+ *        rt_mem_alloc. The released memory block is taken back to system heap.
+ *
+ * @param rmem the address of memory which will be released.
+ */
+void rt_smem_free(void *rmem)
+{
+#ifdef RT_USING_HEAP_STATS
+    rt_uint32_t stamp;
+    struct rt_small_mem *small_mem;
+
+    if (rmem == RT_NULL)
+        return;
+
+    small_mem = MEM_POOL((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM);
+    stamp = rt_heap_stats_stamp();
+    _smem_free(rmem);
+    rt_heap_stats_free(&small_mem->parent.counter, stamp);
+#else
+    _smem_free(rmem);
+#endif /* RT_USING_HEAP_STATS */
+}
 RTM_EXPORT(rt_smem_free);
 
+#ifdef RT_USING_HEAP_STATS
+/**
+ * @brief This function will get the fragmentation and latency statistics of
+ *        the small memory object.
+ *
+ * @param m the small memory management object.
+ *
+ * @param stats is a pointer to get the statistics.
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_smem_stats(rt_smem_t m, struct rt_heap_stats *stats)
+{
+    struct rt_small_mem_item *mem;
+    struct rt_small_mem *small_mem;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(stats != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+
+    small_mem = (struct rt_small_mem *)m;
+    rt_memset(stats, 0, sizeof(struct rt_heap_stats));
+    stats->total    = m->total;
+    stats->used     = m->used;
+    stats->max_used = m->max;
+
+    for (mem = (struct rt_small_mem_item *)small_mem->heap_ptr;
+         mem != small_mem->heap_end;
+         mem = (struct rt_small_mem_item *)&small_mem->heap_ptr[mem->next])
+    {
+        if (!MEM_ISUSED(mem))
+            rt_heap_stats_block(stats, MEM_SIZE(small_mem, mem), 1);
+    }
+    rt_heap_stats_fill(stats, &m->counter);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_smem_stats);
+#endif /* RT_USING_HEAP_STATS */
+
 #ifdef RT_USING_FINSH
 #include <finsh.h>
 
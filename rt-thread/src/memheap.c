@@ -18,6 +18,9 @@
  * 2013-07-11     Grissiom     fix the memory block splitting issue.
  * 2013-07-15     Grissiom     optimize rt_memheap_realloc
  * 2021-06-03     Flybreak     Fix the crash problem after opening Oz optimization on ac6.
+ * 2026-10-17     agent        add fragmentation and latency statistics
+ * 2026-10-17     agent        add segregated fit mode
+ * 2026-10-17     agent        fall back to first fit in the own size class
  */
 
 #include <rthw.h>
@@ -42,12 +45,128 @@ static void _remove_next_ptr(volatile struct rt_memheap_item *next_ptr)
 {
     /* Fix the crash problem after opening Oz optimization on ac6  */
     /* Fix IAR compiler warning  */
-    next_ptr->next_free->prev_free = next_ptr->prev_free;
-    next_ptr->prev_free->next_free = next_ptr->next_free;
     next_ptr->next->prev = next_ptr->prev;
     next_ptr->prev->next = next_ptr->next;
 }
 
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+#define RT_MEMHEAP_BIN_NR       32
+
+/* index of the most significant bit, the size is never zero and never exceeds the 32-bit heap */
+rt_inline int _memheap_bin_index(rt_size_t size)
+{
+    int index = 0;
+
+    if (size & 0xffff0000UL) { index += 16; size >>= 16; }
+    if (size & 0xff00UL)     { index += 8;  size >>= 8;  }
+    if (size & 0xf0UL)       { index += 4;  size >>= 4;  }
+    if (size & 0xcUL)        { index += 2;  size >>= 2;  }
+    if (size & 0x2UL)        { index += 1; }
+
+    return index;
+}
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
+
+/**
+ * @brief   Insert a free block to the free list of memheap.
+ *
+ * @note    The block must have been linked into the block list, because the
+ *          segregated fit mode picks the free bin by the size of block.
+ */
+static void _memheap_free_insert(struct rt_memheap *heap, struct rt_memheap_item *item)
+{
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+    int index;
+
+    index = _memheap_bin_index(MEMITEM_SIZE(item));
+    item->prev_free = RT_NULL;
+    item->next_free = heap->free_bins[index];
+    if (item->next_free != RT_NULL)
+        item->next_free->prev_free = item;
+    heap->free_bins[index] = item;
+    heap->free_bitmap |= (1UL << index);
+#else
+    item->next_free = heap->free_list->next_free;
+    item->prev_free = heap->free_list;
+    heap->free_list->next_free->prev_free = item;
+    heap->free_list->next_free            = item;
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
+}
+
+/**
+ * @brief   Remove a free block from the free list of memheap.
+ *
+ * @note    The block must be removed before its size is changed.
+ */
+static void _memheap_free_remove(struct rt_memheap *heap, struct rt_memheap_item *item)
+{
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+    int index;
+
+    if (item->prev_free != RT_NULL)
+    {
+        item->prev_free->next_free = item->next_free;
+    }
+    else
+    {
+        index = _memheap_bin_index(MEMITEM_SIZE(item));
+        heap->free_bins[index] = item->next_free;
+        if (item->next_free == RT_NULL)
+            heap->free_bitmap &= ~(1UL << index);
+    }
+    if (item->next_free != RT_NULL)
+        item->next_free->prev_free = item->prev_free;
+#else
+    item->next_free->prev_free = item->prev_free;
+    item->prev_free->next_free = item->next_free;
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
+    item->next_free = RT_NULL;
+    item->prev_free = RT_NULL;
+}
+
+/**
+ * @brief   Find a free block which is not smaller than the size.
+ *
+ * @return  the free block or RT_NULL if there is no such block.
+ */
+static struct rt_memheap_item *_memheap_free_search(struct rt_memheap *heap, rt_size_t size)
+{
+    struct rt_memheap_item *item;
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+    int index;
+    rt_uint32_t bitmap;
+
+    /* the first block of the same size class may be large enough */
+    index = _memheap_bin_index(size);
+    item = heap->free_bins[index];
+    if (item != RT_NULL && MEMITEM_SIZE(item) >= size)
+        return item;
+
+    /* otherwise take any block of the smallest larger size class */
+    bitmap = heap->free_bitmap & ~((2UL << index) - 1);
+    if (bitmap != 0)
+        return heap->free_bins[__rt_ffs((int)bitmap) - 1];
+
+    /* the last resort, a large enough block further down the same size class */
+    for (; item != RT_NULL; item = item->next_free)
+    {
+        if (MEMITEM_SIZE(item) >= size)
+            return item;
+    }
+
+    return RT_NULL;
+#else
+    /* get the first free memory block */
+    for (item = heap->free_list->next_free; item != heap->free_list; item = item->next_free)
+    {
+        if (MEMITEM_SIZE(item) >= size)
+            return item;
+    }
+
+    return RT_NULL;
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
+}
+
 /**
  * @brief   This function initializes a piece of memory called memheap.
  *
@@ -87,6 +206,9 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     memheap->pool_size      = RT_ALIGN_DOWN(size, RT_ALIGN_SIZE);
     memheap->available_size = memheap->pool_size - (2 * RT_MEMHEAP_SIZE);
     memheap->max_used_size  = memheap->pool_size - memheap->available_size;
+#ifdef RT_USING_HEAP_STATS
+    rt_memset(&memheap->counter, 0, sizeof(memheap->counter));
+#endif /* RT_USING_HEAP_STATS */
 
     /* initialize the free list header */
     item            = &(memheap->free_header);
@@ -99,6 +221,10 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
 
     /* set the free list to free list header */
     memheap->free_list = item;
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+    memheap->free_bitmap = 0;
+    rt_memset(memheap->free_bins, 0, sizeof(memheap->free_bins));
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
 
     /* initialize the first big memory block */
     item            = (struct rt_memheap_item *)start_addr;
@@ -121,10 +247,7 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     memheap->block_list = item;
 
     /* place the big memory block to free list */
-    item->next_free = memheap->free_list->next_free;
-    item->prev_free = memheap->free_list;
-    memheap->free_list->next_free->prev_free = item;
-    memheap->free_list->next_free            = item;
+    _memheap_free_insert(memheap, item);
 
     /* move to the end of memory pool to build a small tailer block,
      * which prevents block merging
@@ -171,16 +294,7 @@ rt_err_t rt_memheap_detach(struct rt_memheap *heap)
 }
 RTM_EXPORT(rt_memheap_detach);
 
-/**
- * @brief  Allocate a block of memory with a minimum of 'size' bytes on memheap.
- *
- * @param   heap is a pointer for memheap object.
- *
- * @param   size is the minimum size of the requested block in bytes.
- *
- * @return  the pointer to allocated memory or NULL if no free memory was found.
- */
-void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
+static void *_memheap_alloc_block(struct rt_memheap *heap, rt_size_t size)
 {
     rt_err_t result;
     rt_size_t free_size;
@@ -214,24 +328,18 @@ void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
             }
         }
 
-        /* get the first free memory block */
-        header_ptr = heap->free_list->next_free;
-        while (header_ptr != heap->free_list && free_size < size)
-        {
-            /* get current freed memory block size */
+        header_ptr = _memheap_free_search(heap, size);
+        if (header_ptr != RT_NULL)
             free_size = MEMITEM_SIZE(header_ptr);
-            if (free_size < size)
-            {
-                /* move to next free memory block */
-                header_ptr = header_ptr->next_free;
-            }
-        }
 
         /* determine if the memory is available. */
         if (free_size >= size)
         {
             /* a block that satisfies the request has been found. */
 
+            /* remove header ptr from free list */
+            _memheap_free_remove(heap, header_ptr);
+
             /* determine if the block needs to be split. */
             if (free_size >= (size + RT_MEMHEAP_SIZE + RT_MEMHEAP_MINIALLOC))
             {
@@ -264,17 +372,8 @@ void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
                 header_ptr->next->prev = new_ptr;
                 header_ptr->next       = new_ptr;
 
-                /* remove header ptr from free list */
-                header_ptr->next_free->prev_free = header_ptr->prev_free;
-                header_ptr->prev_free->next_free = header_ptr->next_free;
-                header_ptr->next_free = RT_NULL;
-                header_ptr->prev_free = RT_NULL;
-
                 /* insert new_ptr to free list */
-                new_ptr->next_free = heap->free_list->next_free;
-                new_ptr->prev_free = heap->free_list;
-                heap->free_list->next_free->prev_free = new_ptr;
-                heap->free_list->next_free            = new_ptr;
+                _memheap_free_insert(heap, new_ptr);
                 RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("new ptr: next_free 0x%08x, prev_free 0x%08x\n",
                                                 new_ptr->next_free,
                                                 new_ptr->prev_free));
@@ -293,17 +392,8 @@ void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
                 if (heap->pool_size - heap->available_size > heap->max_used_size)
                     heap->max_used_size = heap->pool_size - heap->available_size;
 
-                /* remove header_ptr from free list */
                 RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
-                             ("one block: block[0x%08x], next_free 0x%08x, prev_free 0x%08x\n",
-                              header_ptr,
-                              header_ptr->next_free,
-                              header_ptr->prev_free));
-
-                header_ptr->next_free->prev_free = header_ptr->prev_free;
-                header_ptr->prev_free->next_free = header_ptr->next_free;
-                header_ptr->next_free = RT_NULL;
-                header_ptr->prev_free = RT_NULL;
+                             ("one block: block[0x%08x]\n", header_ptr));
             }
 
             /* Mark the allocated block as not available. */
@@ -344,6 +434,31 @@ void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
     /* Return the completion status.  */
     return RT_NULL;
 }
+
+/**
+ * @brief  Allocate a block of memory with a minimum of 'size' bytes on memheap.
+ *
+ * @param   heap is a pointer for memheap object.
+ *
+ * @param   size is the minimum size of the requested block in bytes.
+ *
+ * @return  the pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_memheap_alloc(struct rt_memheap *heap, rt_size_t size)
+{
+#ifdef RT_USING_HEAP_STATS
+    void *ptr;
+    rt_uint32_t stamp;
+
+    stamp = rt_heap_stats_stamp();
+    ptr = _memheap_alloc_block(heap, size);
+    rt_heap_stats_alloc(&heap->counter, ptr, stamp);
+
+    return ptr;
+#else
+    return _memheap_alloc_block(heap, size);
+#endif /* RT_USING_HEAP_STATS */
+}
 RTM_EXPORT(rt_memheap_alloc);
 
 /**
@@ -441,6 +556,7 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
                               next_ptr->next_free,
                               next_ptr->prev_free));
 
+                _memheap_free_remove(heap, (struct rt_memheap_item *)next_ptr);
                 _remove_next_ptr(next_ptr);
 
                 /* build a new one on the right place */
@@ -468,10 +584,7 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
                 header_ptr->next       = (struct rt_memheap_item *)next_ptr;
 
                 /* insert next_ptr to free list */
-                next_ptr->next_free = heap->free_list->next_free;
-                next_ptr->prev_free = heap->free_list;
-                heap->free_list->next_free->prev_free = (struct rt_memheap_item *)next_ptr;
-                heap->free_list->next_free            = (struct rt_memheap_item *)next_ptr;
+                _memheap_free_insert(heap, (struct rt_memheap_item *)next_ptr);
                 RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("new ptr: next_free 0x%08x, prev_free 0x%08x",
                                                 next_ptr->next_free,
                                                 next_ptr->prev_free));
@@ -557,19 +670,15 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
                      ("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
                       header_ptr, header_ptr->next_free, header_ptr->prev_free));
 
+        /* remove free ptr from free list */
+        _memheap_free_remove(heap, free_ptr);
+
         free_ptr->next->prev = new_ptr;
         new_ptr->next   = free_ptr->next;
-
-        /* remove free ptr from free list */
-        free_ptr->next_free->prev_free = free_ptr->prev_free;
-        free_ptr->prev_free->next_free = free_ptr->next_free;
     }
 
     /* insert the split block to free list */
-    new_ptr->next_free = heap->free_list->next_free;
-    new_ptr->prev_free = heap->free_list;
-    heap->free_list->next_free->prev_free = new_ptr;
-    heap->free_list->next_free            = new_ptr;
+    _memheap_free_insert(heap, new_ptr);
     RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("new free ptr: next_free 0x%08x, prev_free 0x%08x\n",
                                     new_ptr->next_free,
                                     new_ptr->prev_free));
@@ -588,13 +697,7 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
 }
 RTM_EXPORT(rt_memheap_realloc);
 
-/**
- * @brief This function will release the allocated memory block by
- *        rt_malloc. The released memory block is taken back to system heap.
- *
- * @param ptr the address of memory which will be released.
- */
-void rt_memheap_free(void *ptr)
+static void _memheap_free_block(void *ptr)
 {
     rt_err_t result;
     struct rt_memheap *heap;
@@ -656,14 +759,21 @@ void rt_memheap_free(void *ptr)
         /* adjust the available number of bytes. */
         heap->available_size += RT_MEMHEAP_SIZE;
 
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+        /* the size class of previous neighbor changes, re-insert it later */
+        _memheap_free_remove(heap, header_ptr->prev);
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
+
         /* yes, merge block with previous neighbor. */
         (header_ptr->prev)->next = header_ptr->next;
         (header_ptr->next)->prev = header_ptr->prev;
 
         /* move header pointer to previous. */
         header_ptr = header_ptr->prev;
+#ifndef RT_MEMHEAP_SEGREGATED_MODE
         /* don't insert header to free list */
         insert_header = RT_FALSE;
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
     }
 
     /* determine if the block can be merged with the next neighbor. */
@@ -679,16 +789,18 @@ void rt_memheap_free(void *ptr)
                      ("merge: right node 0x%08x, next_free 0x%08x, prev_free 0x%08x\n",
                       new_ptr, new_ptr->next_free, new_ptr->prev_free));
 
+        /* remove new ptr from free list */
+        _memheap_free_remove(heap, new_ptr);
+
         new_ptr->next->prev = header_ptr;
         header_ptr->next    = new_ptr->next;
-
-        /* remove new ptr from free list */
-        new_ptr->next_free->prev_free = new_ptr->prev_free;
-        new_ptr->prev_free->next_free = new_ptr->next_free;
     }
 
     if (insert_header)
     {
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+        _memheap_free_insert(heap, header_ptr);
+#else
         struct rt_memheap_item *n = heap->free_list->next_free;;
 #if defined(RT_MEMHEAP_BEST_MODE)
         rt_size_t blk_size = MEMITEM_SIZE(header_ptr);
@@ -707,6 +819,8 @@ void rt_memheap_free(void *ptr)
         n->prev_free->next_free = header_ptr;
         n->prev_free = header_ptr;
 
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
+
         RT_DEBUG_LOG(RT_DEBUG_MEMHEAP,
                      ("insert to free list: next_free 0x%08x, prev_free 0x%08x\n",
                       header_ptr->next_free, header_ptr->prev_free));
@@ -722,6 +836,30 @@ void rt_memheap_free(void *ptr)
         rt_sem_release(&(heap->lock));
     }
 }
+
+/**
+ * @brief This function will release the allocated memory block by
+ *        rt_malloc. The released memory block is taken back to system heap.
+ *
+ * @param ptr the address of memory which will be released.
+ */
+void rt_memheap_free(void *ptr)
+{
+#ifdef RT_USING_HEAP_STATS
+    rt_uint32_t stamp;
+    struct rt_memheap *heap;
+
+    if (ptr == RT_NULL)
+        return;
+
+    heap = ((struct rt_memheap_item *)((rt_uint8_t *)ptr - RT_MEMHEAP_SIZE))->pool_ptr;
+    stamp = rt_heap_stats_stamp();
+    _memheap_free_block(ptr);
+    rt_heap_stats_free(&heap->counter, stamp);
+#else
+    _memheap_free_block(ptr);
+#endif /* RT_USING_HEAP_STATS */
+}
 RTM_EXPORT(rt_memheap_free);
 
 /**
@@ -771,6 +909,74 @@ void rt_memheap_info(struct rt_memheap *heap,
     }
 }
 
+#ifdef RT_USING_HEAP_STATS
+/**
+ * @brief This function will get the fragmentation and latency statistics of
+ *        the memheap object.
+ *
+ * @param heap is a pointer to the memheap object.
+ *
+ * @param stats is a pointer to get the statistics.
+ *
+ * @return Return the operation status. If the return value is RT_EOK, the
+ *         statistics is filled, otherwise the lock of memheap is failed.
+ */
+rt_err_t rt_memheap_stats(struct rt_memheap *heap, struct rt_heap_stats *stats)
+{
+    rt_err_t result;
+    struct rt_memheap_item *item;
+
+    RT_ASSERT(heap != RT_NULL);
+    RT_ASSERT(stats != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+
+    if (heap->locked == RT_FALSE)
+    {
+        /* lock memheap */
+        result = rt_sem_take(&(heap->lock), RT_WAITING_FOREVER);
+        if (result != RT_EOK)
+        {
+            rt_set_errno(result);
+            return result;
+        }
+    }
+
+    rt_memset(stats, 0, sizeof(struct rt_heap_stats));
+    stats->total    = heap->pool_size;
+    stats->used     = heap->pool_size - heap->available_size;
+    stats->max_used = heap->max_used_size;
+
+#ifdef RT_MEMHEAP_SEGREGATED_MODE
+    {
+        int index;
+
+        for (index = 0; index < RT_MEMHEAP_BIN_NR; index ++)
+        {
+            for (item = heap->free_bins[index]; item != RT_NULL; item = item->next_free)
+                rt_heap_stats_block(stats, MEMITEM_SIZE(item), 1);
+        }
+    }
+#else
+    for (item = heap->free_list->next_free;
+         item != heap->free_list;
+         item = item->next_free)
+    {
+        rt_heap_stats_block(stats, MEMITEM_SIZE(item), 1);
+    }
+#endif /* RT_MEMHEAP_SEGREGATED_MODE */
+    rt_heap_stats_fill(stats, &heap->counter);
+
+    if (heap->locked == RT_FALSE)
+    {
+        /* release lock */
+        rt_sem_release(&(heap->lock));
+    }
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_memheap_stats);
+#endif /* RT_USING_HEAP_STATS */
+
 #ifdef RT_USING_MEMHEAP_AS_HEAP
 /*
  * rt_malloc port function
@@ -15,6 +15,7 @@
  * 2011-01-24     Bernard      add object allocation check.
  * 2012-03-22     Bernard      fix align issue in rt_mp_init and rt_mp_create.
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to mempool.c
+ * 2026-10-17     agent        add lock-free fast path and batch interfaces
  */
 
 #include <rthw.h>
@@ -309,6 +310,9 @@ RTM_EXPORT(rt_mp_delete);
 /**
  * @brief This function will allocate a block from memory pool.
  *
+ * @note  The free block list is accessed lock-free when there is any free
+ *        block, interrupt is only disabled to suspend the current thread.
+ *
  * @param mp is the memory pool object.
  *
  * @param time is the maximum waiting time for allocating memory.
@@ -326,80 +330,78 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
     /* parameter check */
     RT_ASSERT(mp != RT_NULL);
 
-    /* get current thread */
-    thread = rt_thread_self();
+    /* fast path, take a block without disabling interrupt */
+    block_ptr = (rt_uint8_t *)rt_hw_atomic_slist_pop((void **)&(mp->block_list));
+    if (block_ptr == RT_NULL)
+    {
+        /* get current thread */
+        thread = rt_thread_self();
 
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
 
-    while (mp->block_free_count == 0)
-    {
-        /* memory block is unavailable. */
-        if (time == 0)
+        while ((block_ptr = (rt_uint8_t *)rt_hw_atomic_slist_pop((void **)&(mp->block_list))) == RT_NULL)
         {
-            /* enable interrupt */
-            rt_hw_interrupt_enable(level);
+            /* memory block is unavailable. */
+            if (time == 0)
+            {
+                /* enable interrupt */
+                rt_hw_interrupt_enable(level);
 
-            rt_set_errno(-RT_ETIMEOUT);
+                rt_set_errno(-RT_ETIMEOUT);
 
-            return RT_NULL;
-        }
+                return RT_NULL;
+            }
 
-        RT_DEBUG_NOT_IN_INTERRUPT;
+            RT_DEBUG_NOT_IN_INTERRUPT;
 
-        thread->error = RT_EOK;
+            thread->error = RT_EOK;
 
-        /* need suspend thread */
-        rt_thread_suspend(thread);
-        rt_list_insert_after(&(mp->suspend_thread), &(thread->tlist));
+            /* need suspend thread */
+            rt_thread_suspend(thread);
+            rt_list_insert_after(&(mp->suspend_thread), &(thread->tlist));
 
-        if (time > 0)
-        {
-            /* get the start tick of timer */
-            before_sleep = rt_tick_get();
-
-            /* init thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &time);
-            rt_timer_start(&(thread->thread_timer));
-        }
+            if (time > 0)
+            {
+                /* get the start tick of timer */
+                before_sleep = rt_tick_get();
 
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
+                /* init thread timer and start it */
+                rt_timer_control(&(thread->thread_timer),
+                                 RT_TIMER_CTRL_SET_TIME,
+                                 &time);
+                rt_timer_start(&(thread->thread_timer));
+            }
 
-        /* do a schedule */
-        rt_schedule();
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
 
-        if (thread->error != RT_EOK)
-            return RT_NULL;
+            /* do a schedule */
+            rt_schedule();
 
-        if (time > 0)
-        {
-            time -= rt_tick_get() - before_sleep;
-            if (time < 0)
-                time = 0;
+            if (thread->error != RT_EOK)
+                return RT_NULL;
+
+            if (time > 0)
+            {
+                time -= rt_tick_get() - before_sleep;
+                if (time < 0)
+                    time = 0;
+            }
+            /* disable interrupt */
+            level = rt_hw_interrupt_disable();
         }
-        /* disable interrupt */
-        level = rt_hw_interrupt_disable();
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
     }
 
     /* memory block is available. decrease the free block counter */
-    mp->block_free_count--;
-
-    /* get block from block list */
-    block_ptr = mp->block_list;
-    RT_ASSERT(block_ptr != RT_NULL);
-
-    /* Setup the next free node. */
-    mp->block_list = *(rt_uint8_t **)block_ptr;
+    rt_hw_atomic_add((volatile rt_base_t *)&(mp->block_free_count), -1);
 
     /* point to memory pool */
     *(rt_uint8_t **)block_ptr = (rt_uint8_t *)mp;
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
-
     RT_OBJECT_HOOK_CALL(rt_mp_alloc_hook,
                         (mp, (rt_uint8_t *)(block_ptr + sizeof(rt_uint8_t *))));
 
@@ -407,9 +409,78 @@ void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time)
 }
 RTM_EXPORT(rt_mp_alloc);
 
+/**
+ * @brief This function will allocate a batch of blocks from memory pool.
+ *
+ * @note  Interrupt is disabled only once for the whole batch. If there is
+ *        no free block, the function waits for the first block as
+ *        rt_mp_alloc() does, the rest of the batch is taken without waiting.
+ *
+ * @param mp is the memory pool object.
+ *
+ * @param blocks is the array to store the allocated memory blocks.
+ *
+ * @param count is the number of memory blocks to be allocated.
+ *
+ * @param time is the maximum waiting time for the first memory block.
+ *             - 0 for not waiting, allocating memory immediately.
+ *
+ * @return the number of allocated memory blocks.
+ */
+rt_size_t rt_mp_alloc_batch(rt_mp_t mp, void **blocks, rt_size_t count, rt_int32_t time)
+{
+    rt_size_t index;
+    rt_uint8_t *block_ptr;
+    rt_base_t level;
+
+    /* parameter check */
+    RT_ASSERT(mp != RT_NULL);
+    RT_ASSERT(blocks != RT_NULL);
+
+    if (count == 0)
+        return 0;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    for (index = 0; index < count && mp->block_list != RT_NULL; index ++)
+    {
+        /* get block from block list */
+        block_ptr = mp->block_list;
+        mp->block_list = *(rt_uint8_t **)block_ptr;
+        mp->block_free_count --;
+
+        /* point to memory pool */
+        *(rt_uint8_t **)block_ptr = (rt_uint8_t *)mp;
+        blocks[index] = block_ptr + sizeof(rt_uint8_t *);
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    if (index == 0)
+    {
+        /* no free block, wait for the first one */
+        blocks[0] = rt_mp_alloc(mp, time);
+
+        return blocks[0] != RT_NULL ? 1 : 0;
+    }
+
+    for (count = 0; count < index; count ++)
+    {
+        RT_OBJECT_HOOK_CALL(rt_mp_alloc_hook, (mp, blocks[count]));
+    }
+
+    return index;
+}
+RTM_EXPORT(rt_mp_alloc_batch);
+
 /**
  * @brief This function will release a memory block.
  *
+ * @note  The block is put back without disabling interrupt, unless there
+ *        is any thread waiting for a free block.
+ *
  * @param block the address of memory block to be released.
  */
 void rt_mp_free(void *block)
@@ -428,17 +499,106 @@ void rt_mp_free(void *block)
 
     RT_OBJECT_HOOK_CALL(rt_mp_free_hook, (mp, block));
 
+    /* link the block into the block list */
+    rt_hw_atomic_slist_push((void **)&(mp->block_list), block_ptr);
+
+    /* increase the free block count */
+    rt_hw_atomic_add((volatile rt_base_t *)&(mp->block_free_count), 1);
+
+    /*
+     * A thread is suspended only after it found the block list empty with
+     * interrupt disabled, so it is already on the list if it missed this block.
+     */
+    if (!rt_list_isempty(&(mp->suspend_thread)))
+    {
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        if (!rt_list_isempty(&(mp->suspend_thread)))
+        {
+            /* get the suspended thread */
+            thread = rt_list_entry(mp->suspend_thread.next,
+                                   struct rt_thread,
+                                   tlist);
+
+            /* set error */
+            thread->error = RT_EOK;
+
+            /* resume thread */
+            rt_thread_resume(thread);
+
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
+
+            /* do a schedule */
+            rt_schedule();
+
+            return;
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+    }
+}
+RTM_EXPORT(rt_mp_free);
+
+/**
+ * @brief This function will release a batch of memory blocks.
+ *
+ * @note  All of the blocks must belong to the same memory pool. Interrupt
+ *        is disabled only once for the whole batch, and one waiting thread
+ *        is resumed for each released block.
+ *
+ * @param blocks is the array of memory blocks to be released.
+ *
+ * @param count is the number of memory blocks.
+ */
+void rt_mp_free_batch(void **blocks, rt_size_t count)
+{
+    rt_size_t index;
+    rt_uint8_t **block_ptr;
+    rt_uint8_t *first, **last;
+    struct rt_mempool *mp;
+    struct rt_thread *thread;
+    rt_bool_t need_schedule = RT_FALSE;
+    rt_base_t level;
+
+    /* parameter check */
+    if (blocks == RT_NULL || count == 0) return;
+
+    /* link the blocks into a list, without disabling interrupt */
+    mp    = RT_NULL;
+    first = RT_NULL;
+    last  = RT_NULL;
+    for (index = 0; index < count; index ++)
+    {
+        RT_ASSERT(blocks[index] != RT_NULL);
+
+        block_ptr = (rt_uint8_t **)((rt_uint8_t *)blocks[index] - sizeof(rt_uint8_t *));
+        if (mp == RT_NULL)
+            mp = (struct rt_mempool *)*block_ptr;
+        RT_ASSERT(mp == (struct rt_mempool *)*block_ptr);
+
+        RT_OBJECT_HOOK_CALL(rt_mp_free_hook, (mp, blocks[index]));
+
+        *block_ptr = first;
+        first = (rt_uint8_t *)block_ptr;
+        if (last == RT_NULL)
+            last = block_ptr;
+    }
+
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    /* increase the free block count */
-    mp->block_free_count ++;
+    /* link the list into the block list */
+    *last = mp->block_list;
+    mp->block_list = first;
 
-    /* link the block into the block list */
-    *block_ptr = mp->block_list;
-    mp->block_list = (rt_uint8_t *)block_ptr;
+    /* increase the free block count */
+    mp->block_free_count += count;
 
-    if (!rt_list_isempty(&(mp->suspend_thread)))
+    /* resume one waiting thread for each block */
+    for (index = 0; index < count && !rt_list_isempty(&(mp->suspend_thread)); index ++)
     {
         /* get the suspended thread */
         thread = rt_list_entry(mp->suspend_thread.next,
@@ -450,20 +610,19 @@ void rt_mp_free(void *block)
 
         /* resume thread */
         rt_thread_resume(thread);
+        need_schedule = RT_TRUE;
+    }
 
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
 
+    if (need_schedule == RT_TRUE)
+    {
         /* do a schedule */
         rt_schedule();
-
-        return;
     }
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
 }
-RTM_EXPORT(rt_mp_free);
+RTM_EXPORT(rt_mp_free_batch);
 
 /**@}*/
 
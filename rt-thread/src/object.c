@@ -14,6 +14,8 @@
  * 2017-12-10     Bernard      Add object_info enum.
  * 2018-01-25     Bernard      Fix the object find issue when enable MODULE.
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to object.c
+ * 2026-10-17     agent        add hash index of object name
+ * 2026-10-17     agent        add rt_object_rename to keep the hash index right
  */
 
 #include <rtthread.h>
@@ -114,6 +116,68 @@ static struct rt_object_information _object_container[RT_Object_Info_Unknown] =
 #endif
 };
 
+#ifdef RT_USING_OBJECT_HASH
+#ifndef RT_OBJECT_HASH_SIZE
+#define RT_OBJECT_HASH_SIZE     32
+#endif /* RT_OBJECT_HASH_SIZE */
+
+#if (RT_OBJECT_HASH_SIZE & (RT_OBJECT_HASH_SIZE - 1)) != 0
+#error "RT_OBJECT_HASH_SIZE must be a power of 2"
+#endif
+
+/* objects of all classes in the object container, newest first in each bucket */
+static struct rt_object *_object_hash[RT_OBJECT_HASH_SIZE];
+
+/* FNV-1a hash of the object name, at most RT_NAME_MAX characters */
+static rt_uint32_t _object_hash_index(const char *name)
+{
+    rt_uint32_t hash = 2166136261UL;
+    int index;
+
+    for (index = 0; index < RT_NAME_MAX && name[index] != '\0'; index ++)
+    {
+        hash ^= (rt_uint8_t)name[index];
+        hash *= 16777619UL;
+    }
+
+    return hash & (RT_OBJECT_HASH_SIZE - 1);
+}
+
+/* it shall be invoked with interrupt disabled */
+static void _object_hash_insert(struct rt_object *object)
+{
+    struct rt_object **bucket;
+
+    bucket = &_object_hash[_object_hash_index(object->name)];
+    object->hash_next = *bucket;
+    *bucket = object;
+}
+
+/*
+ * it shall be invoked with interrupt disabled, returns RT_FALSE for the objects
+ * of a module which are not in the hash table
+ */
+static rt_bool_t _object_hash_remove(struct rt_object *object)
+{
+    struct rt_object **prev;
+
+    for (prev = &_object_hash[_object_hash_index(object->name)];
+         *prev != RT_NULL;
+         prev = &((*prev)->hash_next))
+    {
+        if (*prev == object)
+        {
+            *prev = object->hash_next;
+            object->hash_next = RT_NULL;
+
+            return RT_TRUE;
+        }
+    }
+
+    return RT_FALSE;
+}
+#endif /* RT_USING_OBJECT_HASH */
+
 #ifndef __on_rt_object_attach_hook
     #define __on_rt_object_attach_hook(obj)         __ON_HOOK_ARGS(rt_object_attach_hook, (obj))
 #endif
@@ -384,6 +448,9 @@ void rt_object_init(struct rt_object         *object,
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _object_hash_insert(object);
+#endif /* RT_USING_OBJECT_HASH */
     }
 
     /* unlock interrupt */
@@ -413,6 +480,9 @@ void rt_object_detach(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object);
+#endif /* RT_USING_OBJECT_HASH */
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(level);
@@ -480,6 +550,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _object_hash_insert(object);
+#endif /* RT_USING_OBJECT_HASH */
     }
 
     /* unlock interrupt */
@@ -512,6 +585,9 @@ void rt_object_delete(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object);
+#endif /* RT_USING_OBJECT_HASH */
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(level);
@@ -574,7 +650,9 @@ rt_uint8_t rt_object_get_type(rt_object_t object)
 rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 {
     struct rt_object *object = RT_NULL;
+#ifndef RT_USING_OBJECT_HASH
     struct rt_list_node *node = RT_NULL;
+#endif /* RT_USING_OBJECT_HASH */
     struct rt_object_information *information = RT_NULL;
 
     information = rt_object_get_information((enum rt_object_class_type)type);
@@ -588,6 +666,22 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     /* enter critical */
     rt_enter_critical();
 
+#ifdef RT_USING_OBJECT_HASH
+    /* try to find object in the hash bucket */
+    for (object = _object_hash[_object_hash_index(name)];
+         object != RT_NULL;
+         object = object->hash_next)
+    {
+        if ((object->type & ~RT_Object_Class_Static) == information->type &&
+            rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            /* leave critical */
+            rt_exit_critical();
+
+            return object;
+        }
+    }
+#else
     /* try to find object */
     rt_list_for_each(node, &(information->object_list))
     {
@@ -600,6 +694,7 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
             return object;
         }
     }
+#endif /* RT_USING_OBJECT_HASH */
 
     /* leave critical */
     rt_exit_critical();
@@ -607,4 +702,43 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     return RT_NULL;
 }
 
+/**
+ * @brief This function will change the name of an object in the object
+ *        container, the object is found by its new name afterwards.
+ *
+ * @param object is the specified object.
+ *
+ * @param name is the new name of object, at most RT_NAME_MAX characters are kept.
+ *
+ * @note the name of an object shall not be written directly, the hash index
+ *       would no longer find it.
+ */
+void rt_object_rename(rt_object_t object, const char *name)
+{
+    rt_base_t level;
+#ifdef RT_USING_OBJECT_HASH
+    rt_bool_t hashed;
+#endif /* RT_USING_OBJECT_HASH */
+
+    /* parameter check */
+    RT_ASSERT(object != RT_NULL);
+    RT_ASSERT(name != RT_NULL);
+
+    /* lock interrupt */
+    level = rt_hw_interrupt_disable();
+
+#ifdef RT_USING_OBJECT_HASH
+    /* the bucket depends on the name, move the object to the new one */
+    hashed = _object_hash_remove(object);
+    rt_strncpy(object->name, name, RT_NAME_MAX);
+    if (hashed)
+        _object_hash_insert(object);
+#else
+    rt_strncpy(object->name, name, RT_NAME_MAX);
+#endif /* RT_USING_OBJECT_HASH */
+
+    /* unlock interrupt */
+    rt_hw_interrupt_enable(level);
+}
+
 /**@}*/
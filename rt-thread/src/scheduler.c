@@ -28,11 +28,18 @@
  *                             in smp version, rt_hw_context_switch_interrupt maybe switch to
  *                             new task directly
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to scheduler.c
+ * 2026-10-17     agent        add per-thread cpu usage accounting
+ * 2026-10-17     agent        use 32 bits cpu usage deltas, compute the usage in the reader
+ * 2026-10-17     agent        move the usage window roll from the switch to the sampling timer
  */
 
 #include <rtthread.h>
 #include <rthw.h>
 
+#if defined(RT_USING_CPU_USAGE) && defined(RT_USING_CPUTIME)
+#include <drivers/cputime.h>
+#endif /* defined(RT_USING_CPU_USAGE) && defined(RT_USING_CPUTIME) */
+
 rt_list_t rt_thread_priority_table[RT_THREAD_PRIORITY_MAX];
 rt_uint32_t rt_thread_ready_priority_group;
 #if RT_THREAD_PRIORITY_MAX > 32
@@ -89,6 +96,100 @@ void rt_scheduler_switch_sethook(void (*hook)(struct rt_thread *tid))
 /**@}*/
 #endif /* RT_USING_HOOK */
 
+#ifdef RT_USING_CPU_USAGE
+#ifdef RT_USING_SMP
+static rt_uint32_t _cpu_usage_stamp[RT_CPUS_NR];
+#define _CPU_USAGE_STAMP    _cpu_usage_stamp[rt_hw_cpu_id()]
+#else
+static rt_uint32_t _cpu_usage_stamp;
+#define _CPU_USAGE_STAMP    _cpu_usage_stamp
+#endif /* RT_USING_SMP */
+
+static struct rt_timer _cpu_usage_timer;
+static rt_uint32_t _cpu_usage_period_stamp;
+/* the number of finished sampling periods, the next one closed goes to slot epoch % RT_CPU_USAGE_WINDOW */
+rt_uint32_t rt_cpu_usage_epoch;
+/* the length of each finished period */
+rt_uint32_t rt_cpu_usage_period[RT_CPU_USAGE_WINDOW];
+
+/*
+ * only the low 32 bits are used, the DWT cycle counter of Cortex-M is 32 bits
+ * wide and the differences stay right across its wrap
+ */
+rt_inline rt_uint32_t _cpu_usage_get(void)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)clock_cpu_gettime();
+#else
+    return (rt_uint32_t)rt_tick_get();
+#endif /* RT_USING_CPUTIME */
+}
+
+/*
+ * charge the time since the last switch to the thread leaving the cpu,
+ * it must be called with interrupt disabled. It is on the switch path, so
+ * it only reads the clock and adds, the window is rolled by the sampling.
+ */
+rt_inline void _scheduler_cpu_usage(struct rt_thread *from)
+{
+    rt_uint32_t now = _cpu_usage_get();
+    rt_uint32_t delta = now - _CPU_USAGE_STAMP;
+
+    _CPU_USAGE_STAMP = now;
+
+    from->duration_tick += delta;
+    from->usage_run += delta;
+}
+
+/*
+ * close the current period, move the run time of each thread in it to its
+ * window. The usage is worked out by rt_thread_get_stats() from the window
+ * and the period lengths.
+ */
+static void _cpu_usage_sample(void *parameter)
+{
+    struct rt_object_information *information;
+    struct rt_thread *thread;
+    struct rt_list_node *node;
+    rt_uint32_t slot;
+    rt_base_t level;
+
+    information = rt_object_get_information(RT_Object_Class_Thread);
+    RT_ASSERT(information != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+
+    /* charge the running thread up to now */
+    _scheduler_cpu_usage(rt_thread_self());
+
+    slot = rt_cpu_usage_epoch % RT_CPU_USAGE_WINDOW;
+    rt_cpu_usage_period[slot] = _CPU_USAGE_STAMP - _cpu_usage_period_stamp;
+    _cpu_usage_period_stamp = _CPU_USAGE_STAMP;
+
+    rt_list_for_each(node, &(information->object_list))
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+        thread->usage_window[slot] = thread->usage_run;
+        thread->usage_run = 0;
+    }
+
+    rt_cpu_usage_epoch ++;
+
+    rt_hw_interrupt_enable(level);
+}
+
+static void _cpu_usage_start(void)
+{
+    _CPU_USAGE_STAMP = _cpu_usage_get();
+    _cpu_usage_period_stamp = _CPU_USAGE_STAMP;
+
+    rt_timer_init(&_cpu_usage_timer, "usage", _cpu_usage_sample, RT_NULL,
+                  rt_tick_from_millisecond(RT_CPU_USAGE_PERIOD),
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    rt_timer_start(&_cpu_usage_timer);
+}
+#endif /* RT_USING_CPU_USAGE */
+
 #ifdef RT_USING_OVERFLOW_CHECK
 static void _scheduler_stack_check(struct rt_thread *thread)
 {
@@ -261,6 +362,10 @@ void rt_system_scheduler_start(void)
     rt_schedule_remove_thread(to_thread);
     to_thread->stat = RT_THREAD_RUNNING;
 
+#ifdef RT_USING_CPU_USAGE
+    _cpu_usage_start();
+#endif /* RT_USING_CPU_USAGE */
+
     /* switch to new thread */
 #ifdef RT_USING_SMP
     rt_hw_context_switch_to((rt_ubase_t)&to_thread->sp, to_thread);
@@ -365,6 +470,10 @@ void rt_schedule(void)
 
                 RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (current_thread, to_thread));
 
+#ifdef RT_USING_CPU_USAGE
+                _scheduler_cpu_usage(current_thread);
+#endif /* RT_USING_CPU_USAGE */
+
                 rt_schedule_remove_thread(to_thread);
                 to_thread->stat = RT_THREAD_RUNNING | (to_thread->stat & ~RT_THREAD_STAT_MASK);
 
@@ -467,6 +576,10 @@ void rt_schedule(void)
 
                 RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (from_thread, to_thread));
 
+#ifdef RT_USING_CPU_USAGE
+                _scheduler_cpu_usage(from_thread);
+#endif /* RT_USING_CPU_USAGE */
+
                 if (need_insert_from_thread)
                 {
                     rt_schedule_insert_thread(from_thread);
@@ -619,6 +732,10 @@ void rt_scheduler_do_irq_switch(void *context)
 
                 RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (current_thread, to_thread));
 
+#ifdef RT_USING_CPU_USAGE
+                _scheduler_cpu_usage(current_thread);
+#endif /* RT_USING_CPU_USAGE */
+
                 rt_schedule_remove_thread(to_thread);
                 to_thread->stat = RT_THREAD_RUNNING | (to_thread->stat & ~RT_THREAD_STAT_MASK);
 
@@ -13,6 +13,7 @@
  * 2010-07-13     Bernard      fix RT_ALIGN issue found by kuronca
  * 2010-10-23     yi.qiu       add module memory allocator
  * 2010-12-18     yi.qiu       fix zone release bug
+ * 2026-10-17     agent        add fragmentation and latency statistics
  */
 
 /*
@@ -471,20 +472,7 @@ rt_inline int zoneindex(rt_size_t *bytes)
 
 /**@{*/
 
-/**
- * @brief This function will allocate a block from slab object.
- *
- * @note the RT_NULL is returned if
- *         - the nbytes is less than zero.
- *         - there is no nbytes sized memory valid in system.
- *
- * @param m the slab memory management object.
- *
- * @param size is the size of memory to be allocated.
- *
- * @return the allocated memory.
- */
-void *rt_slab_alloc(rt_slab_t m, rt_size_t size)
+static void *_slab_alloc(rt_slab_t m, rt_size_t size)
 {
     struct rt_slab_zone *z;
     rt_int32_t zi;
@@ -651,6 +639,36 @@ void *rt_slab_alloc(rt_slab_t m, rt_size_t size)
 
     return chunk;
 }
+
+/**
+ * @brief This function will allocate a block from slab object.
+ *
+ * @note the RT_NULL is returned if
+ *         - the nbytes is less than zero.
+ *         - there is no nbytes sized memory valid in system.
+ *
+ * @param m the slab memory management object.
+ *
+ * @param size is the size of memory to be allocated.
+ *
+ * @return the allocated memory.
+ */
+void *rt_slab_alloc(rt_slab_t m, rt_size_t size)
+{
+#ifdef RT_USING_HEAP_STATS
+    void *ptr;
+    rt_uint32_t stamp;
+
+    stamp = rt_heap_stats_stamp();
+    ptr = _slab_alloc(m, size);
+    if (size != 0)
+        rt_heap_stats_alloc(&m->counter, ptr, stamp);
+
+    return ptr;
+#else
+    return _slab_alloc(m, size);
+#endif /* RT_USING_HEAP_STATS */
+}
 RTM_EXPORT(rt_slab_alloc);
 
 /**
@@ -725,15 +743,7 @@ void *rt_slab_realloc(rt_slab_t m, void *ptr, rt_size_t size)
 }
 RTM_EXPORT(rt_slab_realloc);
 
-/**
- * @brief This function will release the previous allocated memory block by rt_slab_alloc.
- *
- * @note The released memory block is taken back to system heap.
- *
- * @param m the slab memory management object.
- * @param ptr is the address of memory which will be released
- */
-void rt_slab_free(rt_slab_t m, void *ptr)
+static void _slab_free(rt_slab_t m, void *ptr)
 {
     struct rt_slab_zone *z;
     struct rt_slab_chunk *chunk;
@@ -851,6 +861,81 @@ void rt_slab_free(rt_slab_t m, void *ptr)
         }
     }
 }
+
+/**
+ * @brief This function will release the previous allocated memory block by rt_slab_alloc.
+ *
+ * @note The released memory block is taken back to system heap.
+ *
+ * @param m the slab memory management object.
+ * @param ptr is the address of memory which will be released
+ */
+void rt_slab_free(rt_slab_t m, void *ptr)
+{
+#ifdef RT_USING_HEAP_STATS
+    rt_uint32_t stamp;
+
+    if (ptr == RT_NULL)
+        return;
+
+    stamp = rt_heap_stats_stamp();
+    _slab_free(m, ptr);
+    rt_heap_stats_free(&m->counter, stamp);
+#else
+    _slab_free(m, ptr);
+#endif /* RT_USING_HEAP_STATS */
+}
 RTM_EXPORT(rt_slab_free);
 
+#ifdef RT_USING_HEAP_STATS
+/**
+ * @brief This function will get the fragmentation and latency statistics of
+ *        the slab object.
+ *
+ * @note Free pages, whole free zones and the free chunks of each zone are
+ *       all reported as free blocks.
+ *
+ * @param m the slab memory management object.
+ *
+ * @param stats is a pointer to get the statistics.
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_slab_stats(rt_slab_t m, struct rt_heap_stats *stats)
+{
+    rt_uint32_t zi;
+    struct rt_slab_zone *z;
+    struct rt_slab_page *page;
+    struct rt_slab *slab = (struct rt_slab *)m;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(stats != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+
+    rt_memset(stats, 0, sizeof(struct rt_heap_stats));
+    stats->total    = m->total;
+    stats->used     = m->used;
+    stats->max_used = m->max;
+
+    /* free pages of page allocator */
+    for (page = slab->page_list; page != RT_NULL; page = page->next)
+        rt_heap_stats_block(stats, page->page * RT_MM_PAGE_SIZE, 1);
+
+    /* whole free zones */
+    for (z = slab->zone_free; z != RT_NULL; z = z->z_next)
+        rt_heap_stats_block(stats, slab->zone_size, 1);
+
+    /* free chunks of each zone */
+    for (zi = 0; zi < RT_SLAB_NZONES; zi ++)
+    {
+        for (z = slab->zone_array[zi]; z != RT_NULL; z = z->z_next)
+            rt_heap_stats_block(stats, z->z_chunksize, z->z_nfree);
+    }
+    rt_heap_stats_fill(stats, &m->counter);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_slab_stats);
+#endif /* RT_USING_HEAP_STATS */
+
 #endif /* defined (RT_USING_SLAB) */
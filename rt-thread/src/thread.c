@@ -32,12 +32,21 @@
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to thread.c
  * 2022-01-24     THEWON       let rt_thread_sleep return thread->error when using signal
  * 2022-10-15     Bernard      add nested mutex feature
+ * 2026-10-17     agent        add rt_thread_get_stats
+ * 2026-10-17     agent        check thread state under lock in _thread_timeout
+ * 2026-10-17     agent        work out the cpu usage in rt_thread_get_stats
  */
 
 #include <rthw.h>
 #include <rtthread.h>
 #include <stddef.h>
 
+#ifdef RT_USING_CPU_USAGE
+/* kept by the scheduler */
+extern rt_uint32_t rt_cpu_usage_epoch;
+extern rt_uint32_t rt_cpu_usage_period[RT_CPU_USAGE_WINDOW];
+#endif /* RT_USING_CPU_USAGE */
+
 #ifndef __on_rt_thread_inited_hook
     #define __on_rt_thread_inited_hook(thread)      __ON_HOOK_ARGS(rt_thread_inited_hook, (thread))
 #endif
@@ -133,12 +142,21 @@ static void _thread_timeout(void *parameter)
 
     /* parameter check */
     RT_ASSERT(thread != RT_NULL);
-    RT_ASSERT((thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND);
     RT_ASSERT(rt_object_get_type((rt_object_t)thread) == RT_Object_Class_Thread);
 
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
+    /*
+     * the timeout function runs with interrupt enabled, an interrupt may have
+     * resumed the thread after its timer expired and before we got the lock
+     */
+    if ((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_SUSPEND)
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
     /* set error number */
     thread->error = -RT_ETIMEOUT;
 
@@ -257,8 +275,14 @@ static rt_err_t _thread_init(struct rt_thread *thread,
 
 #ifdef RT_USING_CPU_USAGE
     thread->duration_tick = 0;
+    thread->usage_run = 0;
+    rt_memset(thread->usage_window, 0, sizeof(thread->usage_window));
 #endif /* RT_USING_CPU_USAGE */
 
+#ifdef RT_USING_HEAP_CACHE
+    thread->heap_cache = RT_NULL;
+#endif /* RT_USING_HEAP_CACHE */
+
 #ifdef RT_USING_PTHREADS
     thread->pthread_data = RT_NULL;
 #endif /* RT_USING_PTHREADS */
@@ -971,4 +995,86 @@ rt_thread_t rt_thread_find(char *name)
 
 RTM_EXPORT(rt_thread_find);
 
+#ifdef RT_USING_CPU_USAGE
+/**
+ * @brief   This function will get the run time, cpu usage and stack
+ *          high-water mark of the specified thread.
+ *
+ * @note    The cpu usage is sampled every RT_CPU_USAGE_PERIOD ms, and the
+ *          average and peak are taken over the last RT_CPU_USAGE_WINDOW
+ *          periods. The sampling moves the run time of each thread into
+ *          its window, the usage is worked out here. The run time of the
+ *          current period is not counted until it is closed.
+ *          The stack high-water mark is found by scanning
+ *          the stack for the initial '#' fill pattern.
+ *
+ * @param   thread is the thread to get statistics.
+ *
+ * @param   stats is the buffer to store the statistics.
+ *
+ * @return  Return the operation status. If the return value is RT_EOK, the function is successfully executed.
+ */
+rt_err_t rt_thread_get_stats(rt_thread_t thread, struct rt_thread_stats *stats)
+{
+    rt_base_t level;
+    rt_uint32_t window[RT_CPU_USAGE_WINDOW], period[RT_CPU_USAGE_WINDOW];
+    rt_uint32_t epoch, sum = 0, count = 0, slot;
+    rt_uint16_t usage;
+    rt_uint8_t *ptr;
+    int index;
+
+    /* parameter check */
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(rt_object_get_type((rt_object_t)thread) == RT_Object_Class_Thread);
+    RT_ASSERT(stats != RT_NULL);
+
+    stats->usage_max = 0;
+
+    stats->usage = 0;
+
+    /* copy out the run time of the thread and the length of the periods */
+    level = rt_hw_interrupt_disable();
+    stats->run_tick = thread->duration_tick;
+    epoch = rt_cpu_usage_epoch;
+    rt_memcpy(window, thread->usage_window, sizeof(window));
+    rt_memcpy(period, rt_cpu_usage_period, sizeof(period));
+    rt_hw_interrupt_enable(level);
+
+    /* the finished periods, newest first */
+    for (index = 1; index <= RT_CPU_USAGE_WINDOW && index <= epoch; index ++)
+    {
+        slot = (epoch - index) % RT_CPU_USAGE_WINDOW;
+        if (period[slot] == 0)
+            usage = 0;
+        else if (window[slot] >= period[slot])
+            usage = 10000;
+        else
+            usage = (rt_uint16_t)((rt_uint64_t)window[slot] * 10000 / period[slot]);
+
+        if (index == 1)
+            stats->usage = usage;
+        if (usage > stats->usage_max)
+            stats->usage_max = usage;
+        sum += usage;
+        count ++;
+    }
+
+    stats->usage_avg = count ? (rt_uint16_t)(sum / count) : 0;
+    stats->stack_size = thread->stack_size;
+
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+    ptr = (rt_uint8_t *)thread->stack_addr + thread->stack_size - 1;
+    while (ptr > (rt_uint8_t *)thread->stack_addr && *ptr == '#') ptr --;
+    stats->stack_max_used = (rt_ubase_t)ptr - (rt_ubase_t)thread->stack_addr + 1;
+#else
+    ptr = (rt_uint8_t *)thread->stack_addr;
+    while (ptr < (rt_uint8_t *)thread->stack_addr + thread->stack_size && *ptr == '#') ptr ++;
+    stats->stack_max_used = thread->stack_size - ((rt_ubase_t)ptr - (rt_ubase_t)thread->stack_addr);
+#endif /* ARCH_CPU_STACK_GROWS_UPWARD */
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_thread_get_stats);
+#endif /* RT_USING_CPU_USAGE */
+
 /**@}*/
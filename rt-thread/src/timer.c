@@ -19,13 +19,49 @@
  * 2021-08-15     supperthomas add the comment
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to timer.c
  * 2022-04-19     Stanley      Correct descriptions
+ * 2026-10-17     agent        add hierarchical timing wheel backend
+ * 2026-10-17     agent        invoke hard timer timeout functions with interrupt enabled
+ * 2026-10-17     agent        keep one shot timer activated until its timeout function returns
  */
 
 #include <rtthread.h>
 #include <rthw.h>
 
+#ifdef RT_USING_TIMER_WHEEL
+
+#if RT_TIMER_SKIP_LIST_LEVEL != 1
+#error "RT_USING_TIMER_WHEEL requires RT_TIMER_SKIP_LIST_LEVEL to be 1"
+#endif
+
+#define RT_TIMER_WHEEL_ROOT_SIZE        (1UL << RT_TIMER_WHEEL_ROOT_BITS)
+#define RT_TIMER_WHEEL_ROOT_MASK        (RT_TIMER_WHEEL_ROOT_SIZE - 1)
+#define RT_TIMER_WHEEL_LEVEL_SIZE       (1UL << RT_TIMER_WHEEL_LEVEL_BITS)
+#define RT_TIMER_WHEEL_LEVEL_MASK       (RT_TIMER_WHEEL_LEVEL_SIZE - 1)
+/* outer levels needed to cover the whole 32-bit tick range */
+#define RT_TIMER_WHEEL_OUTER_LEVELS     ((32 - RT_TIMER_WHEEL_ROOT_BITS + RT_TIMER_WHEEL_LEVEL_BITS - 1) / RT_TIMER_WHEEL_LEVEL_BITS)
+#define RT_TIMER_WHEEL_LEVELS           (RT_TIMER_WHEEL_OUTER_LEVELS + 1)
+/* level tag of the timers which are due and wait for their callback */
+#define RT_TIMER_WHEEL_EXPIRED          RT_TIMER_WHEEL_LEVELS
+/* level tag of the timers which are not hung on any wheel */
+#define RT_TIMER_WHEEL_DETACHED         0xFF
+/* tick bit position of the slot index of an outer level */
+#define RT_TIMER_WHEEL_SHIFT(lvl)       (RT_TIMER_WHEEL_ROOT_BITS + ((lvl) - 1) * RT_TIMER_WHEEL_LEVEL_BITS)
+
+struct rt_timer_wheel
+{
+    rt_tick_t   base;                                   /* the next tick to be processed */
+    rt_uint32_t count[RT_TIMER_WHEEL_LEVELS + 1];       /* timers per level, the last one counts the expired list */
+    rt_list_t   expired;                                /* timers due, in expiry order */
+    rt_list_t   root[RT_TIMER_WHEEL_ROOT_SIZE];
+    rt_list_t   outer[RT_TIMER_WHEEL_OUTER_LEVELS][RT_TIMER_WHEEL_LEVEL_SIZE];
+};
+
+/* hard timer wheel */
+static struct rt_timer_wheel _timer_wheel;
+#else
 /* hard timer list */
 static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_USING_TIMER_WHEEL */
 
 #ifdef RT_USING_TIMER_SOFT
 
@@ -42,8 +78,13 @@ static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 
 /* soft timer status */
 static rt_uint8_t _soft_timer_status = RT_SOFT_TIMER_IDLE;
+#ifdef RT_USING_TIMER_WHEEL
+/* soft timer wheel */
+static struct rt_timer_wheel _soft_timer_wheel;
+#else
 /* soft timer list */
 static rt_list_t _soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_USING_TIMER_WHEEL */
 static struct rt_thread _timer_thread;
 ALIGN(RT_ALIGN_SIZE)
 static rt_uint8_t _timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
@@ -142,8 +183,319 @@ static void _timer_init(rt_timer_t timer,
     {
         rt_list_init(&(timer->row[i]));
     }
+#ifdef RT_USING_TIMER_WHEEL
+    timer->wheel_level = RT_TIMER_WHEEL_DETACHED;
+#endif /* RT_USING_TIMER_WHEEL */
+}
+
+#ifdef RT_USING_TIMER_WHEEL
+/**
+ * @brief Get the timing wheel which the timer belongs to
+ *
+ * @param timer the point of the timer
+ *
+ * @return the timing wheel of the timer
+ */
+rt_inline struct rt_timer_wheel *_timer_wheel_of(rt_timer_t timer)
+{
+#ifdef RT_USING_TIMER_SOFT
+    if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
+    {
+        return &_soft_timer_wheel;
+    }
+#endif /* RT_USING_TIMER_SOFT */
+
+    return &_timer_wheel;
 }
 
+/**
+ * @brief Initialize a timing wheel
+ *
+ * @param wheel is the timing wheel
+ */
+static void _timer_wheel_init(struct rt_timer_wheel *wheel)
+{
+    rt_size_t i, j;
+
+    wheel->base = rt_tick_get();
+    for (i = 0; i < sizeof(wheel->count) / sizeof(wheel->count[0]); i++)
+    {
+        wheel->count[i] = 0;
+    }
+
+    rt_list_init(&wheel->expired);
+    for (i = 0; i < RT_TIMER_WHEEL_ROOT_SIZE; i++)
+    {
+        rt_list_init(&wheel->root[i]);
+    }
+    for (i = 0; i < RT_TIMER_WHEEL_OUTER_LEVELS; i++)
+    {
+        for (j = 0; j < RT_TIMER_WHEEL_LEVEL_SIZE; j++)
+        {
+            rt_list_init(&wheel->outer[i][j]);
+        }
+    }
+}
+
+/**
+ * @brief Check whether there is any timer hung on the timing wheel
+ *
+ * @param wheel is the timing wheel
+ *
+ * @return RT_TRUE if no timer is on the wheel
+ */
+rt_inline rt_bool_t _timer_wheel_is_empty(struct rt_timer_wheel *wheel)
+{
+    int lvl;
+
+    for (lvl = 0; lvl <= RT_TIMER_WHEEL_LEVELS; lvl++)
+    {
+        if (wheel->count[lvl])
+        {
+            return RT_FALSE;
+        }
+    }
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief Hang the timer on the slot matching its timeout tick, relative to
+ *        the tick the wheel is going to process next.
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param timer the point of the timer
+ */
+static void _timer_wheel_place(struct rt_timer_wheel *wheel, rt_timer_t timer)
+{
+    rt_tick_t delta;
+    rt_list_t *slot;
+    rt_uint8_t lvl;
+
+    delta = timer->timeout_tick - wheel->base;
+    if (delta >= RT_TICK_MAX / 2)
+    {
+        /* already timeout, fire it on the next processed tick */
+        lvl  = 0;
+        slot = &wheel->root[wheel->base & RT_TIMER_WHEEL_ROOT_MASK];
+    }
+    else if (delta < RT_TIMER_WHEEL_ROOT_SIZE)
+    {
+        lvl  = 0;
+        slot = &wheel->root[timer->timeout_tick & RT_TIMER_WHEEL_ROOT_MASK];
+    }
+    else
+    {
+        for (lvl = 1; lvl < RT_TIMER_WHEEL_LEVELS - 1; lvl++)
+        {
+            if (delta < ((rt_tick_t)1 << RT_TIMER_WHEEL_SHIFT(lvl + 1)))
+                break;
+        }
+        slot = &wheel->outer[lvl - 1][(timer->timeout_tick >> RT_TIMER_WHEEL_SHIFT(lvl)) & RT_TIMER_WHEEL_LEVEL_MASK];
+    }
+
+    /* keep the insertion order for the timers with the same timeout tick */
+    rt_list_insert_before(slot, &(timer->row[0]));
+    timer->wheel_level = lvl;
+    wheel->count[lvl]++;
+}
+
+/**
+ * @brief Move the timers of the current slot of an outer level down to the
+ *        lower levels.
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param lvl is the outer level to be cascaded
+ */
+static void _timer_wheel_cascade(struct rt_timer_wheel *wheel, int lvl)
+{
+    struct rt_timer *t;
+    rt_list_t *slot;
+
+    slot = &wheel->outer[lvl - 1][(wheel->base >> RT_TIMER_WHEEL_SHIFT(lvl)) & RT_TIMER_WHEEL_LEVEL_MASK];
+    while (!rt_list_isempty(slot))
+    {
+        t = rt_list_entry(slot->next, struct rt_timer, row[0]);
+        rt_list_remove(&(t->row[0]));
+        wheel->count[lvl]--;
+        _timer_wheel_place(wheel, t);
+    }
+}
+
+/**
+ * @brief Process the ticks of the timing wheel up to current tick, moving
+ *        the timers which are due to the expired list.
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param current_tick is the current tick
+ */
+static void _timer_wheel_advance(struct rt_timer_wheel *wheel, rt_tick_t current_tick)
+{
+    struct rt_timer *t;
+    rt_list_t *slot;
+    rt_tick_t next, step;
+    int lvl;
+
+    while ((current_tick - wheel->base) < RT_TICK_MAX / 2)
+    {
+        /* cascade the outer levels whose slot begins at this tick */
+        for (lvl = 1; lvl < RT_TIMER_WHEEL_LEVELS; lvl++)
+        {
+            if (wheel->base & (((rt_tick_t)1 << RT_TIMER_WHEEL_SHIFT(lvl)) - 1))
+                break;
+            _timer_wheel_cascade(wheel, lvl);
+        }
+
+        slot = &wheel->root[wheel->base & RT_TIMER_WHEEL_ROOT_MASK];
+        while (!rt_list_isempty(slot))
+        {
+            t = rt_list_entry(slot->next, struct rt_timer, row[0]);
+            rt_list_remove(&(t->row[0]));
+            rt_list_insert_before(&wheel->expired, &(t->row[0]));
+            t->wheel_level = RT_TIMER_WHEEL_EXPIRED;
+            wheel->count[0]--;
+            wheel->count[RT_TIMER_WHEEL_EXPIRED]++;
+        }
+        wheel->base++;
+
+        if (wheel->count[0])
+            continue;
+
+        /* skip the ticks which neither expire nor cascade any timer */
+        for (lvl = 1; lvl < RT_TIMER_WHEEL_LEVELS; lvl++)
+        {
+            if (wheel->count[lvl])
+                break;
+        }
+        if (lvl == RT_TIMER_WHEEL_LEVELS)
+        {
+            wheel->base = current_tick + 1;
+            break;
+        }
+
+        step = (rt_tick_t)1 << RT_TIMER_WHEEL_SHIFT(lvl);
+        next = (wheel->base + step - 1) & ~(step - 1);
+        if ((next - wheel->base) > (current_tick + 1 - wheel->base))
+        {
+            next = current_tick + 1;
+        }
+        wheel->base = next;
+    }
+}
+
+/**
+ * @brief Get the first timer which is due on the timing wheel
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param current_tick is the current tick
+ *
+ * @return the timer which is due, or RT_NULL if there is none
+ */
+static struct rt_timer *_timer_wheel_fetch(struct rt_timer_wheel *wheel, rt_tick_t current_tick)
+{
+    if (rt_list_isempty(&wheel->expired))
+    {
+        _timer_wheel_advance(wheel, current_tick);
+        if (rt_list_isempty(&wheel->expired))
+        {
+            return RT_NULL;
+        }
+    }
+
+    return rt_list_entry(wheel->expired.next, struct rt_timer, row[0]);
+}
+
+/**
+ * @brief  Find the next timeout tick on the timing wheel
+ *
+ * @param wheel is the timing wheel
+ *
+ * @param timeout_tick is the next timer's ticks
+ *
+ * @return  Return the operation status. If the return value is RT_EOK, the function is successfully executed.
+ *          If the return value is any other values, it means this operation failed.
+ */
+static rt_err_t _timer_wheel_next_timeout(struct rt_timer_wheel *wheel, rt_tick_t *timeout_tick)
+{
+    struct rt_timer *t;
+    rt_list_t *slot, *node;
+    rt_tick_t next = 0, idx, start;
+    rt_bool_t found = RT_FALSE;
+    rt_base_t level;
+    rt_size_t i;
+    int lvl;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    if (!rt_list_isempty(&wheel->expired))
+    {
+        t = rt_list_entry(wheel->expired.next, struct rt_timer, row[0]);
+        next  = t->timeout_tick;
+        found = RT_TRUE;
+        goto __exit;
+    }
+
+    /* the timers on the root wheel expire exactly on their slot tick */
+    if (wheel->count[0])
+    {
+        idx = wheel->base & RT_TIMER_WHEEL_ROOT_MASK;
+        for (i = 0; i < RT_TIMER_WHEEL_ROOT_SIZE; i++)
+        {
+            if (!rt_list_isempty(&wheel->root[(idx + i) & RT_TIMER_WHEEL_ROOT_MASK]))
+            {
+                next  = wheel->base + i;
+                found = RT_TRUE;
+                break;
+            }
+        }
+    }
+
+    /* the slots of an outer level are ordered, so only the first non-empty one matters */
+    for (lvl = 1; lvl < RT_TIMER_WHEEL_LEVELS; lvl++)
+    {
+        if (wheel->count[lvl] == 0)
+            continue;
+
+        idx = (wheel->base >> RT_TIMER_WHEEL_SHIFT(lvl)) & RT_TIMER_WHEEL_LEVEL_MASK;
+        /* the current slot is not cascaded yet while the wheel stands on its beginning */
+        start = (wheel->base & (((rt_tick_t)1 << RT_TIMER_WHEEL_SHIFT(lvl)) - 1)) ? 1 : 0;
+        for (i = start; i < RT_TIMER_WHEEL_LEVEL_SIZE + start; i++)
+        {
+            slot = &wheel->outer[lvl - 1][(idx + i) & RT_TIMER_WHEEL_LEVEL_MASK];
+            if (rt_list_isempty(slot))
+                continue;
+
+            for (node = slot->next; node != slot; node = node->next)
+            {
+                t = rt_list_entry(node, struct rt_timer, row[0]);
+                if (!found || (t->timeout_tick - wheel->base) < (next - wheel->base))
+                {
+                    next  = t->timeout_tick;
+                    found = RT_TRUE;
+                }
+            }
+            break;
+        }
+    }
+
+__exit:
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    if (!found)
+    {
+        return -RT_ERROR;
+    }
+
+    *timeout_tick = next;
+    return RT_EOK;
+}
+#else
 /**
  * @brief  Find the next emtpy timer ticks
  *
@@ -180,6 +532,138 @@ static rt_err_t _timer_list_next_timeout(rt_list_t timer_list[], rt_tick_t *time
     return -RT_ERROR;
 }
 
+/**
+ * @brief Insert the timer into the timer list, sorted by timeout tick
+ *
+ * @param timer_list is the array of time list
+ *
+ * @param timer the point of the timer
+ */
+static void _timer_list_insert(rt_list_t timer_list[], rt_timer_t timer)
+{
+    unsigned int row_lvl;
+    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
+    unsigned int tst_nr;
+    static unsigned int random_nr;
+
+    row_head[0]  = &timer_list[0];
+    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
+             row_head[row_lvl]  = row_head[row_lvl]->next)
+        {
+            struct rt_timer *t;
+            rt_list_t *p = row_head[row_lvl]->next;
+
+            /* fix up the entry pointer */
+            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
+
+            /* If we have two timers that timeout at the same time, it's
+             * preferred that the timer inserted early get called early.
+             * So insert the new timer to the end the the some-timeout timer
+             * list.
+             */
+            if ((t->timeout_tick - timer->timeout_tick) == 0)
+            {
+                continue;
+            }
+            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
+            {
+                break;
+            }
+        }
+        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
+            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
+    }
+
+    /* Interestingly, this super simple timer insert counter works very very
+     * well on distributing the list height uniformly. By means of "very very
+     * well", I mean it beats the randomness of timer->timeout_tick very easily
+     * (actually, the timeout_tick is not random and easy to be attacked). */
+    random_nr++;
+    tst_nr = random_nr;
+
+    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
+                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
+            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
+                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
+        else
+            break;
+        /* Shift over the bits we have tested. Works well with 1 bit and 2
+         * bits. */
+        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
+    }
+}
+
+/**
+ * @brief Get the first timer which is due on the timer list
+ *
+ * @param timer_list is the array of time list
+ *
+ * @param current_tick is the current tick
+ *
+ * @return the timer which is due, or RT_NULL if there is none
+ */
+static struct rt_timer *_timer_list_fetch(rt_list_t timer_list[], rt_tick_t current_tick)
+{
+    struct rt_timer *t;
+
+    if (rt_list_isempty(&timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+    {
+        return RT_NULL;
+    }
+
+    t = rt_list_entry(timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
+                      struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+
+    /*
+     * It supposes that the new tick shall less than the half duration of
+     * tick max.
+     */
+    if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
+    {
+        return t;
+    }
+
+    return RT_NULL;
+}
+#endif /* RT_USING_TIMER_WHEEL */
+
+/**
+ * @brief Insert the timer into the hard or soft timer container
+ *
+ * @param timer the point of the timer
+ */
+static void _timer_insert(rt_timer_t timer)
+{
+#ifdef RT_USING_TIMER_WHEEL
+    struct rt_timer_wheel *wheel = _timer_wheel_of(timer);
+
+    /* an idle wheel may lag far behind, catch it up before using it as reference */
+    if (_timer_wheel_is_empty(wheel))
+    {
+        wheel->base = rt_tick_get();
+    }
+    _timer_wheel_place(wheel, timer);
+#else
+#ifdef RT_USING_TIMER_SOFT
+    if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
+    {
+        /* insert timer to soft timer list */
+        _timer_list_insert(_soft_timer_list, timer);
+    }
+    else
+#endif /* RT_USING_TIMER_SOFT */
+    {
+        /* insert timer to system timer list */
+        _timer_list_insert(_timer_list, timer);
+    }
+#endif /* RT_USING_TIMER_WHEEL */
+}
+
 /**
  * @brief Remove the timer
  *
@@ -189,6 +673,14 @@ rt_inline void _timer_remove(rt_timer_t timer)
 {
     int i;
 
+#ifdef RT_USING_TIMER_WHEEL
+    if (timer->wheel_level != RT_TIMER_WHEEL_DETACHED)
+    {
+        _timer_wheel_of(timer)->count[timer->wheel_level]--;
+        timer->wheel_level = RT_TIMER_WHEEL_DETACHED;
+    }
+#endif /* RT_USING_TIMER_WHEEL */
+
     for (i = 0; i < RT_TIMER_SKIP_LIST_LEVEL; i++)
     {
         rt_list_remove(&timer->row[i]);
@@ -406,13 +898,8 @@ RTM_EXPORT(rt_timer_delete);
  */
 rt_err_t rt_timer_start(rt_timer_t timer)
 {
-    unsigned int row_lvl;
-    rt_list_t *timer_list;
     rt_base_t level;
     rt_bool_t need_schedule;
-    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
-    unsigned int tst_nr;
-    static unsigned int random_nr;
 
     /* parameter check */
     RT_ASSERT(timer != RT_NULL);
@@ -431,69 +918,7 @@ rt_err_t rt_timer_start(rt_timer_t timer)
 
     timer->timeout_tick = rt_tick_get() + timer->init_tick;
 
-#ifdef RT_USING_TIMER_SOFT
-    if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
-    {
-        /* insert timer to soft timer list */
-        timer_list = _soft_timer_list;
-    }
-    else
-#endif /* RT_USING_TIMER_SOFT */
-    {
-        /* insert timer to system timer list */
-        timer_list = _timer_list;
-    }
-
-    row_head[0]  = &timer_list[0];
-    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
-    {
-        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
-             row_head[row_lvl]  = row_head[row_lvl]->next)
-        {
-            struct rt_timer *t;
-            rt_list_t *p = row_head[row_lvl]->next;
-
-            /* fix up the entry pointer */
-            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
-
-            /* If we have two timers that timeout at the same time, it's
-             * preferred that the timer inserted early get called early.
-             * So insert the new timer to the end the the some-timeout timer
-             * list.
-             */
-            if ((t->timeout_tick - timer->timeout_tick) == 0)
-            {
-                continue;
-            }
-            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
-            {
-                break;
-            }
-        }
-        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
-            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
-    }
-
-    /* Interestingly, this super simple timer insert counter works very very
-     * well on distributing the list height uniformly. By means of "very very
-     * well", I mean it beats the randomness of timer->timeout_tick very easily
-     * (actually, the timeout_tick is not random and easy to be attacked). */
-    random_nr++;
-    tst_nr = random_nr;
-
-    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
-                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
-    {
-        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
-            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
-                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
-        else
-            break;
-        /* Shift over the bits we have tested. Works well with 1 bit and 2
-         * bits. */
-        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
-    }
+    _timer_insert(timer);
 
     timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
 
@@ -624,6 +1049,14 @@ RTM_EXPORT(rt_timer_control);
  * @brief This function will check timer list, if a timeout event happens,
  *        the corresponding timeout function will be invoked.
  *
+ *        The timers which are due are detached into a local batch with
+ *        interrupt disabled, then their timeout functions are invoked one by
+ *        one with interrupt enabled, so a slow timeout function or a burst of
+ *        timers expiring on the same tick does not block the other interrupts.
+ *        A timer stays activated while its timeout function runs, an interrupt
+ *        may stop it in the meantime, so the timeout function has to check the
+ *        state it acts on under its own lock.
+ *
  * @note This function shall be invoked in operating system timer interrupt.
  */
 void rt_timer_check(void)
@@ -631,8 +1064,10 @@ void rt_timer_check(void)
     struct rt_timer *t;
     rt_tick_t current_tick;
     rt_base_t level;
+    rt_list_t batch;
     rt_list_t list;
 
+    rt_list_init(&batch);
     rt_list_init(&list);
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("timer check enter\n"));
@@ -642,41 +1077,61 @@ void rt_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+    /* detach all the timers which are due into the local batch */
+#ifdef RT_USING_TIMER_WHEEL
+    while ((t = _timer_wheel_fetch(&_timer_wheel, current_tick)) != RT_NULL)
+#else
+    while ((t = _timer_list_fetch(_timer_list, current_tick)) != RT_NULL)
+#endif /* RT_USING_TIMER_WHEEL */
     {
-        t = rt_list_entry(_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
-                          struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+        /* remove timer from timer list firstly */
+        _timer_remove(t);
+        rt_list_insert_before(&batch, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+    }
 
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    while (1)
+    {
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        /* the timers stopped or restarted by a former timeout function have left the batch */
+        if (rt_list_isempty(&batch))
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+
+        t = rt_list_entry(batch.next, struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+        rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
         /*
-         * It supposes that the new tick shall less than the half duration of
-         * tick max.
+         * keep the timer activated until its timeout function returns, so an
+         * interrupt which stops it meanwhile still takes it off the temporary
+         * list and nothing is done with it after the timeout function
          */
-        if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
-        {
-            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+        /* add timer to temporary list  */
+        rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
 
-            /* remove timer from timer list firstly */
-            _timer_remove(t);
-            if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
-            {
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-            }
-            /* add timer to temporary list  */
-            rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            /* call timeout function */
-            t->timeout_func(t->parameter);
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
 
-            /* re-get tick */
-            current_tick = rt_tick_get();
+        RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
 
-            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
-            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+        /* call timeout function */
+        t->timeout_func(t->parameter);
 
-            /* Check whether the timer object is detached or started again */
-            if (rt_list_isempty(&list))
-            {
-                continue;
-            }
+        RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", rt_tick_get()));
+
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        /* Check whether the timer object is detached or started again */
+        if (!rt_list_isempty(&list))
+        {
             rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
             if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
                 (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
@@ -685,12 +1140,16 @@ void rt_timer_check(void)
                 t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
                 rt_timer_start(t);
             }
+            else
+            {
+                /* one shot timer is done */
+                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            }
         }
-        else break;
-    }
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+    }
 
     RT_DEBUG_LOG(RT_DEBUG_TIMER, ("timer check leave\n"));
 }
@@ -703,7 +1162,11 @@ void rt_timer_check(void)
 rt_tick_t rt_timer_next_timeout_tick(void)
 {
     rt_tick_t next_timeout = RT_TICK_MAX;
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_wheel_next_timeout(&_timer_wheel, &next_timeout);
+#else
     _timer_list_next_timeout(_timer_list, &next_timeout);
+#endif /* RT_USING_TIMER_WHEEL */
     return next_timeout;
 }
 
@@ -726,59 +1189,58 @@ void rt_soft_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+    while (1)
     {
-        t = rt_list_entry(_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
-                            struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
-
         current_tick = rt_tick_get();
 
-        /*
-         * It supposes that the new tick shall less than the half duration of
-         * tick max.
-         */
-        if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
+#ifdef RT_USING_TIMER_WHEEL
+        t = _timer_wheel_fetch(&_soft_timer_wheel, current_tick);
+#else
+        t = _timer_list_fetch(_soft_timer_list, current_tick);
+#endif /* RT_USING_TIMER_WHEEL */
+        if (t == RT_NULL)
         {
-            RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+            break; /* not check anymore */
+        }
 
-            /* remove timer from timer list firstly */
-            _timer_remove(t);
-            if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
-            {
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-            }
-            /* add timer to temporary list  */
-            rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
 
-            _soft_timer_status = RT_SOFT_TIMER_BUSY;
-            /* enable interrupt */
-            rt_hw_interrupt_enable(level);
+        /* remove timer from timer list firstly */
+        _timer_remove(t);
+        if (!(t->parent.flag & RT_TIMER_FLAG_PERIODIC))
+        {
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+        /* add timer to temporary list  */
+        rt_list_insert_after(&list, &(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
 
-            /* call timeout function */
-            t->timeout_func(t->parameter);
+        _soft_timer_status = RT_SOFT_TIMER_BUSY;
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
 
-            RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
-            RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
+        /* call timeout function */
+        t->timeout_func(t->parameter);
 
-            /* disable interrupt */
-            level = rt_hw_interrupt_disable();
+        RT_OBJECT_HOOK_CALL(rt_timer_exit_hook, (t));
+        RT_DEBUG_LOG(RT_DEBUG_TIMER, ("current tick: %d\n", current_tick));
 
-            _soft_timer_status = RT_SOFT_TIMER_IDLE;
-            /* Check whether the timer object is detached or started again */
-            if (rt_list_isempty(&list))
-            {
-                continue;
-            }
-            rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-            if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
-                (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
-            {
-                /* start it */
-                t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
-                rt_timer_start(t);
-            }
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        _soft_timer_status = RT_SOFT_TIMER_IDLE;
+        /* Check whether the timer object is detached or started again */
+        if (rt_list_isempty(&list))
+        {
+            continue;
+        }
+        rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        if ((t->parent.flag & RT_TIMER_FLAG_PERIODIC) &&
+            (t->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        {
+            /* start it */
+            t->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+            rt_timer_start(t);
         }
-        else break; /* not check anymore */
     }
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
@@ -798,7 +1260,11 @@ static void _timer_thread_entry(void *parameter)
     while (1)
     {
         /* get the next timeout tick */
+#ifdef RT_USING_TIMER_WHEEL
+        if (_timer_wheel_next_timeout(&_soft_timer_wheel, &next_timeout) != RT_EOK)
+#else
         if (_timer_list_next_timeout(_soft_timer_list, &next_timeout) != RT_EOK)
+#endif /* RT_USING_TIMER_WHEEL */
         {
             /* no software timer exist, suspend self. */
             rt_thread_suspend(rt_thread_self());
@@ -832,12 +1298,16 @@ static void _timer_thread_entry(void *parameter)
  */
 void rt_system_timer_init(void)
 {
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_wheel_init(&_timer_wheel);
+#else
     rt_size_t i;
 
     for (i = 0; i < sizeof(_timer_list) / sizeof(_timer_list[0]); i++)
     {
         rt_list_init(_timer_list + i);
     }
+#endif /* RT_USING_TIMER_WHEEL */
 }
 
 /**
@@ -848,6 +1318,9 @@ void rt_system_timer_init(void)
 void rt_system_timer_thread_init(void)
 {
 #ifdef RT_USING_TIMER_SOFT
+#ifdef RT_USING_TIMER_WHEEL
+    _timer_wheel_init(&_soft_timer_wheel);
+#else
     int i;
 
     for (i = 0;
@@ -856,6 +1329,7 @@ void rt_system_timer_thread_init(void)
     {
         rt_list_init(_soft_timer_list + i);
     }
+#endif /* RT_USING_TIMER_WHEEL */
 
     /* start software timer thread */
     rt_thread_init(&_timer_thread,